@@ -31,6 +31,7 @@ option(USE_MS_THREADPOOL_FOR_DNNL "Use ms threadpool for onednn ops" ON)
 option(ONLY_BUILD_DEVICE_PLUGINS "Only build device plugins" OFF)
 option(ENABLE_AIO "Enable aio plugin on linux" OFF)
 option(ENABLE_DVM "enable dvm" OFF)
+option(ENABLE_CPU_KERNEL_PERF "Build the cpu kernel micro benchmark, on with the testcases" OFF)
 
 if(ONLY_BUILD_DEVICE_PLUGINS)
     if(NOT CMAKE_SYSTEM_NAME MATCHES "Linux")
@@ -133,6 +134,7 @@ endif()
 
 if(ENABLE_TESTCASES)
     add_compile_definitions(ENABLE_TEST)
+    set(ENABLE_CPU_KERNEL_PERF ON)
 endif()
 
 if(ENABLE_TESTCASES OR (NOT ENABLE_D))
@@ -85,6 +85,25 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
     stream_id = kDefaultStreamIndex;
   }
   size_t align_size = AlignMemorySize(size);
+  // The small memory of the default stream is served by the thread cache without the lock of the pool.
+  if (!from_persistent_mem && !need_recycle && stream_id == kDefaultStreamIndex &&
+      DynamicMemThreadCache::IsCacheable(align_size) && !IsMemoryPoolRecycle()) {
+    auto thread_cache = GetThreadCache();
+    if (thread_cache != nullptr) {
+      auto device_addr = thread_cache->Alloc(align_size);
+      if (device_addr != nullptr) {
+        MS_LOG(DEBUG) << "Alloc memory from thread cache, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
+                      << ", address:" << device_addr << ", size:" << size << "B.";
+        return device_addr;
+      }
+    }
+  }
+  return AllocTensorMemFromPool(size, from_persistent_mem, need_recycle, stream_id);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemFromPool(size_t size, bool from_persistent_mem, bool need_recycle,
+                                                           uint32_t stream_id) {
+  size_t align_size = AlignMemorySize(size);
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -141,8 +160,11 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const
                                                                           uint32_t stream_id) {
   std::vector<DeviceMemPtr> device_addr_list;
   size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false, false, stream_id);
+  if (stream_id == UINT32_MAX) {
+    stream_id = kDefaultStreamIndex;
+  }
+  // Pre-alloc the one whole piece memory, it is split in the pool, so it never comes from the thread cache.
+  auto device_addr = AllocTensorMemFromPool(total_size, false, false, stream_id);
   if (!device_addr) {
     return device_addr_list;
   }
@@ -525,7 +547,28 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
   return nullptr;
 }
 
+DynamicMemThreadCache *DynamicMemPoolBestFit::GetThreadCache() {
+  std::call_once(thread_cache_init_flag_, [this]() {
+    if (!IsEnableThreadCache()) {
+      return;
+    }
+    thread_cache_holder_ = std::make_unique<DynamicMemThreadCache>(
+      [this](size_t size) { return AllocTensorMemFromPool(size, false, false, kDefaultStreamIndex); });
+    thread_cache_ = thread_cache_holder_.get();
+  });
+  return thread_cache_;
+}
+
+ThreadCacheStats DynamicMemPoolBestFit::ThreadCacheStatistics() const {
+  auto thread_cache = thread_cache_.load();
+  return thread_cache == nullptr ? ThreadCacheStats() : thread_cache->Statistics();
+}
+
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  auto thread_cache = thread_cache_.load();
+  if (thread_cache != nullptr && thread_cache->Free(device_addr)) {
+    return;
+  }
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -810,6 +853,17 @@ std::tuple<DynamicMemBlockPtr, DynamicMemBufPtr, MemStatusManagerPtr> DynamicMem
 }
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  // A thread refilling its cache holds the lock of the cache while it waits for the lock of the pool, so the thread
+  // cache is only touched without the lock of the pool.
+  auto thread_cache = thread_cache_.load();
+  if (thread_cache != nullptr) {
+    const auto &stats = thread_cache->Statistics();
+    MS_LOG(INFO) << "The thread cache hit rate:" << stats.HitRate() << ", hit count:" << stats.hit_count_
+                 << ", miss count:" << stats.miss_count_ << ", free count:" << stats.free_count_
+                 << ", flush count:" << stats.flush_count_ << ", span mem:" << stats.span_mem_size_ / kMBToByte
+                 << "M, cached mem:" << stats.cached_mem_size_ / kMBToByte << "M.";
+    thread_cache->Clear();
+  }
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -0,0 +1,414 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "include/backend/mem_reuse/mem_dynamic_thread_cache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kSizeClassAlignSize = 512;
+constexpr size_t kLinearSizeClassMax = 4 << 10;
+constexpr size_t kSizeClassesPerPowerOfTwo = 4;
+constexpr size_t kMinBatchCount = 2;
+constexpr size_t kMaxBatchCount = 64;
+
+// Multiples of 512 up to 4K, then four size classes per power of two up to kThreadCacheMaxSize.
+std::vector<size_t> BuildSizeClasses() {
+  std::vector<size_t> size_classes;
+  for (size_t size = kSizeClassAlignSize; size <= kLinearSizeClassMax; size += kSizeClassAlignSize) {
+    size_classes.push_back(size);
+  }
+  for (size_t base = kLinearSizeClassMax; base < kThreadCacheMaxSize; base <<= 1) {
+    for (size_t i = 1; i <= kSizeClassesPerPowerOfTwo; ++i) {
+      size_classes.push_back(base + base / kSizeClassesPerPowerOfTwo * i);
+    }
+  }
+  return size_classes;
+}
+
+const std::vector<size_t> &SizeClasses() {
+  static const std::vector<size_t> size_classes = BuildSizeClasses();
+  return size_classes;
+}
+
+size_t SizeClassOf(size_t align_size) {
+  const auto &size_classes = SizeClasses();
+  return static_cast<size_t>(std::lower_bound(size_classes.begin(), size_classes.end(), align_size) -
+                             size_classes.begin());
+}
+
+// The number of memory bufs moved between a thread and the central free lists at a time.
+size_t BatchCount(size_t size_class) {
+  return std::clamp(kThreadCacheBatchBytes / SizeClasses()[size_class], kMinBatchCount, kMaxBatchCount);
+}
+
+uintptr_t PageIndex(const DeviceMemPtr &device_addr) {
+  return reinterpret_cast<uintptr_t>(device_addr) / kThreadCachePageSize;
+}
+
+// The size class of every page of the spans, a radix tree on the page index which is read without a lock. The nodes
+// are only added under the lock of the central and only deleted with the thread cache, so a free looks up the size
+// class of its memory with a few atomic loads.
+class PageMap {
+ public:
+  PageMap() = default;
+  ~PageMap() { DeleteChildren(&root_, 0); }
+  PageMap(const PageMap &) = delete;
+  PageMap &operator=(const PageMap &) = delete;
+
+  // -1 if the page is not in a span.
+  int Get(uintptr_t page) const {
+    const Interior *interior = &root_;
+    for (size_t level = 0; level + kLeafLevels < kLevels; ++level) {
+      interior = static_cast<const Interior *>(interior->children_[Index(page, level)].load(std::memory_order_acquire));
+      if (interior == nullptr) {
+        return -1;
+      }
+    }
+    auto &leaf_child = interior->children_[Index(page, kLevels - kLeafLevels)];
+    auto leaf = static_cast<const Leaf *>(leaf_child.load(std::memory_order_acquire));
+    if (leaf == nullptr) {
+      return -1;
+    }
+    return leaf->size_classes_[Index(page, kLevels - 1)].load(std::memory_order_acquire);
+  }
+
+  // The caller holds the lock of the central, which serializes the writers.
+  void Set(uintptr_t page, int size_class) {
+    Interior *interior = &root_;
+    for (size_t level = 0; level + kLeafLevels < kLevels; ++level) {
+      interior = ChildOf<Interior>(interior, Index(page, level));
+    }
+    auto leaf = ChildOf<Leaf>(interior, Index(page, kLevels - kLeafLevels));
+    leaf->size_classes_[Index(page, kLevels - 1)].store(static_cast<int8_t>(size_class), std::memory_order_release);
+  }
+
+  // Marks all the pages out of the spans but keeps the nodes, a concurrent reader may still walk them.
+  void Reset() { ResetChildren(&root_, 0); }
+
+ private:
+  // 4 levels of 4096 entries cover the 48 bit page indexes of the 64 bit addresses.
+  static constexpr size_t kLevelBits = 12;
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kLeafLevels = 2;
+  static constexpr size_t kFanout = 1 << kLevelBits;
+  static_assert((uint64_t{1} << (64 - kLevelBits * kLevels)) <= kThreadCachePageSize,
+                "The page map must cover all the page indexes.");
+
+  struct Interior {
+    std::atomic<void *> children_[kFanout]{};
+  };
+
+  struct Leaf {
+    Leaf() {
+      for (auto &size_class : size_classes_) {
+        size_class.store(-1, std::memory_order_relaxed);
+      }
+    }
+    std::atomic<int8_t> size_classes_[kFanout];
+  };
+
+  static size_t Index(uintptr_t page, size_t level) {
+    return (page >> ((kLevels - 1 - level) * kLevelBits)) & (kFanout - 1);
+  }
+
+  template <typename Node>
+  static Node *ChildOf(Interior *interior, size_t index) {
+    auto &child = interior->children_[index];
+    auto node = static_cast<Node *>(child.load(std::memory_order_relaxed));
+    if (node == nullptr) {
+      node = new Node();
+      child.store(node, std::memory_order_release);
+    }
+    return node;
+  }
+
+  static void DeleteChildren(Interior *interior, size_t level) {
+    for (auto &child : interior->children_) {
+      auto node = child.load(std::memory_order_relaxed);
+      if (node == nullptr) {
+        continue;
+      }
+      if (level + kLeafLevels < kLevels) {
+        DeleteChildren(static_cast<Interior *>(node), level + 1);
+        delete static_cast<Interior *>(node);
+      } else {
+        delete static_cast<Leaf *>(node);
+      }
+    }
+  }
+
+  static void ResetChildren(Interior *interior, size_t level) {
+    for (auto &child : interior->children_) {
+      auto node = child.load(std::memory_order_relaxed);
+      if (node == nullptr) {
+        continue;
+      }
+      if (level + kLeafLevels < kLevels) {
+        ResetChildren(static_cast<Interior *>(node), level + 1);
+      } else {
+        for (auto &size_class : static_cast<Leaf *>(node)->size_classes_) {
+          size_class.store(-1, std::memory_order_release);
+        }
+      }
+    }
+  }
+
+  Interior root_;
+};
+
+// The local caches the current thread uses, they are flushed to their thread caches when the thread exits.
+struct LocalCacheEntry {
+  uint64_t central_id;
+  std::shared_ptr<void> local_cache;
+  std::function<void()> on_thread_exit;
+};
+
+struct ThreadLocalCaches {
+  ~ThreadLocalCaches() {
+    for (auto &entry : entries_) {
+      entry.on_thread_exit();
+    }
+  }
+  std::vector<LocalCacheEntry> entries_;
+};
+
+thread_local ThreadLocalCaches thread_local_caches;
+std::atomic<uint64_t> central_count{0};
+}  // namespace
+
+struct DynamicMemThreadCache::LocalCache {
+  LocalCache() : free_lists_(SizeClasses().size()) {}
+
+  // Only contended when another thread clears the thread cache or reads the statistics.
+  std::mutex mutex_;
+  std::vector<std::vector<DeviceMemPtr>> free_lists_;
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  size_t free_count_{0};
+};
+
+struct DynamicMemThreadCache::Central {
+  explicit Central(const SpanAllocator &span_allocator)
+      : id_(central_count++), span_allocator_(span_allocator), free_lists_(SizeClasses().size()) {}
+
+  const uint64_t id_;
+  SpanAllocator span_allocator_;
+
+  std::mutex mutex_;
+  std::vector<std::vector<DeviceMemPtr>> free_lists_;
+  size_t span_mem_size_{0};
+  size_t flush_count_{0};
+  // The counts of the exited threads.
+  size_t exited_hit_count_{0};
+  size_t exited_miss_count_{0};
+  size_t exited_free_count_{0};
+
+  // The size class of every page of the spans, written under mutex_ and read without a lock.
+  PageMap page_map_;
+
+  std::mutex local_caches_mutex_;
+  std::vector<std::shared_ptr<LocalCache>> local_caches_;
+};
+
+DynamicMemThreadCache::DynamicMemThreadCache(const SpanAllocator &span_allocator)
+    : central_(std::make_shared<Central>(span_allocator)) {
+  MS_LOG(INFO) << "Enable the thread cache of the memory pool for the memory not larger than " << kThreadCacheMaxSize
+               << "B, size class number: " << SizeClasses().size();
+}
+
+DynamicMemThreadCache::~DynamicMemThreadCache() { Clear(); }
+
+DynamicMemThreadCache::LocalCache *DynamicMemThreadCache::GetLocalCache() {
+  for (const auto &entry : thread_local_caches.entries_) {
+    if (entry.central_id == central_->id_) {
+      return static_cast<LocalCache *>(entry.local_cache.get());
+    }
+  }
+
+  auto local_cache = std::make_shared<LocalCache>();
+  {
+    std::lock_guard<std::mutex> lock(central_->local_caches_mutex_);
+    central_->local_caches_.push_back(local_cache);
+  }
+  // Give the memory of an exiting thread back to the central free lists, unless the thread cache is gone already.
+  std::weak_ptr<Central> weak_central = central_;
+  auto on_thread_exit = [weak_central, local_cache]() {
+    auto central = weak_central.lock();
+    if (central == nullptr) {
+      return;
+    }
+    {
+      std::scoped_lock lock(local_cache->mutex_, central->mutex_);
+      for (size_t i = 0; i < local_cache->free_lists_.size(); ++i) {
+        auto &free_list = local_cache->free_lists_[i];
+        central->free_lists_[i].insert(central->free_lists_[i].end(), free_list.begin(), free_list.end());
+        free_list.clear();
+      }
+      central->exited_hit_count_ += local_cache->hit_count_;
+      central->exited_miss_count_ += local_cache->miss_count_;
+      central->exited_free_count_ += local_cache->free_count_;
+      local_cache->hit_count_ = 0;
+      local_cache->miss_count_ = 0;
+      local_cache->free_count_ = 0;
+    }
+    std::lock_guard<std::mutex> lock(central->local_caches_mutex_);
+    auto &local_caches = central->local_caches_;
+    (void)local_caches.erase(std::remove(local_caches.begin(), local_caches.end(), local_cache), local_caches.end());
+  };
+  thread_local_caches.entries_.push_back({central_->id_, local_cache, on_thread_exit});
+  return local_cache.get();
+}
+
+DeviceMemPtr DynamicMemThreadCache::Alloc(size_t align_size) {
+  size_t size_class = SizeClassOf(align_size);
+  auto local_cache = GetLocalCache();
+  std::lock_guard<std::mutex> lock(local_cache->mutex_);
+  auto &free_list = local_cache->free_lists_[size_class];
+  if (free_list.empty()) {
+    local_cache->miss_count_++;
+    if (!Refill(size_class, local_cache)) {
+      return nullptr;
+    }
+  } else {
+    local_cache->hit_count_++;
+  }
+  auto device_addr = free_list.back();
+  free_list.pop_back();
+  return device_addr;
+}
+
+bool DynamicMemThreadCache::Free(const DeviceMemPtr &device_addr) {
+  int size_class = FindSizeClass(device_addr);
+  if (size_class < 0) {
+    return false;
+  }
+  auto local_cache = GetLocalCache();
+  std::lock_guard<std::mutex> lock(local_cache->mutex_);
+  auto &free_list = local_cache->free_lists_[size_class];
+  free_list.push_back(device_addr);
+  local_cache->free_count_++;
+  // Keep at most two batches, so that a thread which only frees does not hold the memory of the others.
+  if (free_list.size() > BatchCount(size_class) * 2) {
+    Flush(size_class, local_cache);
+  }
+  return true;
+}
+
+bool DynamicMemThreadCache::Refill(size_t size_class, LocalCache *local_cache) {
+  std::unique_lock<std::mutex> central_lock(central_->mutex_);
+  auto &central_list = central_->free_lists_[size_class];
+  if (central_list.empty() && !AddSpan(size_class, &central_lock)) {
+    return false;
+  }
+  size_t count = std::min(BatchCount(size_class), central_list.size());
+  auto &free_list = local_cache->free_lists_[size_class];
+  free_list.insert(free_list.end(), central_list.end() - count, central_list.end());
+  central_list.resize(central_list.size() - count);
+  return true;
+}
+
+void DynamicMemThreadCache::Flush(size_t size_class, LocalCache *local_cache) {
+  auto &free_list = local_cache->free_lists_[size_class];
+  size_t count = BatchCount(size_class);
+  std::lock_guard<std::mutex> central_lock(central_->mutex_);
+  auto &central_list = central_->free_lists_[size_class];
+  // The oldest ones go back, the recently freed ones are likely still in the cache of the cpu.
+  central_list.insert(central_list.end(), free_list.begin(), free_list.begin() + count);
+  (void)free_list.erase(free_list.begin(), free_list.begin() + count);
+  central_->flush_count_++;
+}
+
+bool DynamicMemThreadCache::AddSpan(size_t size_class, std::unique_lock<std::mutex> *central_lock) {
+  // The best fit pool takes its own lock, do not hold the central lock meanwhile.
+  central_lock->unlock();
+  DeviceMemPtr span_addr = central_->span_allocator_(kThreadCacheSpanSize + kThreadCachePageSize);
+  central_lock->lock();
+  if (span_addr == nullptr) {
+    MS_LOG(WARNING) << "The thread cache of the memory pool failed to take a span for the size class "
+                    << SizeClasses()[size_class] << "B.";
+    return false;
+  }
+  auto base = (reinterpret_cast<uintptr_t>(span_addr) + kThreadCachePageSize - 1) / kThreadCachePageSize *
+              kThreadCachePageSize;
+  for (size_t offset = 0; offset < kThreadCacheSpanSize; offset += kThreadCachePageSize) {
+    central_->page_map_.Set((base + offset) / kThreadCachePageSize, static_cast<int>(size_class));
+  }
+  size_t class_size = SizeClasses()[size_class];
+  auto &central_list = central_->free_lists_[size_class];
+  for (size_t offset = 0; offset + class_size <= kThreadCacheSpanSize; offset += class_size) {
+    central_list.push_back(reinterpret_cast<DeviceMemPtr>(base + offset));
+  }
+  central_->span_mem_size_ += kThreadCacheSpanSize + kThreadCachePageSize;
+  return true;
+}
+
+int DynamicMemThreadCache::FindSizeClass(const DeviceMemPtr &device_addr) const {
+  return central_->page_map_.Get(PageIndex(device_addr));
+}
+
+void DynamicMemThreadCache::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(central_->local_caches_mutex_);
+    for (auto &local_cache : central_->local_caches_) {
+      std::lock_guard<std::mutex> local_lock(local_cache->mutex_);
+      for (auto &free_list : local_cache->free_lists_) {
+        free_list.clear();
+      }
+    }
+  }
+  std::lock_guard<std::mutex> central_lock(central_->mutex_);
+  for (auto &free_list : central_->free_lists_) {
+    free_list.clear();
+  }
+  central_->span_mem_size_ = 0;
+  central_->page_map_.Reset();
+}
+
+ThreadCacheStats DynamicMemThreadCache::Statistics() const {
+  ThreadCacheStats stats;
+  const auto &size_classes = SizeClasses();
+  {
+    std::lock_guard<std::mutex> lock(central_->local_caches_mutex_);
+    for (auto &local_cache : central_->local_caches_) {
+      std::lock_guard<std::mutex> local_lock(local_cache->mutex_);
+      stats.hit_count_ += local_cache->hit_count_;
+      stats.miss_count_ += local_cache->miss_count_;
+      stats.free_count_ += local_cache->free_count_;
+      for (size_t i = 0; i < size_classes.size(); ++i) {
+        stats.cached_mem_size_ += local_cache->free_lists_[i].size() * size_classes[i];
+      }
+    }
+  }
+  std::lock_guard<std::mutex> central_lock(central_->mutex_);
+  stats.hit_count_ += central_->exited_hit_count_;
+  stats.miss_count_ += central_->exited_miss_count_;
+  stats.free_count_ += central_->exited_free_count_;
+  stats.flush_count_ = central_->flush_count_;
+  stats.span_mem_size_ = central_->span_mem_size_;
+  for (size_t i = 0; i < size_classes.size(); ++i) {
+    stats.cached_mem_size_ += central_->free_lists_[i].size() * size_classes[i];
+  }
+  return stats;
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,350 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/common/session/kernel_select_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include "include/backend/anf_runtime_algorithm.h"
+#include "include/common/debug/common.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/utils/compile_cache_context.h"
+#include "include/common/utils/utils.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "kernel/kernel_build_info.h"
+#include "utils/anf_utils.h"
+#include "utils/convert_utils_base.h"
+#include "utils/file_utils.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "utils/system/sha256.h"
+
+namespace mindspore::session {
+namespace {
+constexpr char kCacheKernels[] = "kernels";
+constexpr char kCacheOp[] = "op";
+constexpr char kCacheBuildInfo[] = "build_info";
+constexpr char kCacheDynInputSizes[] = "dyn_input_sizes";
+constexpr char kInfoKernelType[] = "kernel_type";
+constexpr char kInfoOpType[] = "op_type";
+constexpr char kInfoOriginFormat[] = "origin_format";
+constexpr char kInfoInputFormats[] = "input_formats";
+constexpr char kInfoOutputFormats[] = "output_formats";
+constexpr char kInfoInputDeviceTypes[] = "input_device_types";
+constexpr char kInfoOutputDeviceTypes[] = "output_device_types";
+constexpr char kInfoInputReshapeTypes[] = "input_reshape_types";
+constexpr char kInfoOutputReshapeTypes[] = "output_reshape_types";
+constexpr char kInfoInputObjectTypes[] = "input_object_types";
+constexpr char kInfoOutputObjectTypes[] = "output_object_types";
+constexpr char kInfoOutputElementObjectTypes[] = "output_element_object_types";
+constexpr char kInfoOutputDataDesc[] = "output_data_desc";
+constexpr char kInfoCoreType[] = "core_type";
+constexpr char kInfoFusionType[] = "fusion_type";
+constexpr char kInfoProcessor[] = "processor";
+constexpr char kInfoOpPattern[] = "op_pattern";
+constexpr char kInfoValid[] = "valid";
+
+// The attrs which change from run to run without changing the compiled result.
+const std::set<std::string> kVolatileAttrs = {"instance_name", "shared_name"};
+
+void AppendValue(const ValuePtr &value, std::ostringstream *buf);
+
+void AppendAttrs(const mindspore::HashMap<std::string, ValuePtr> &attrs, std::ostringstream *buf) {
+  std::map<std::string, ValuePtr> sorted_attrs(attrs.begin(), attrs.end());
+  *buf << "{";
+  for (const auto &[name, attr] : sorted_attrs) {
+    if (kVolatileAttrs.count(name) != 0) {
+      continue;
+    }
+    *buf << name << "=";
+    AppendValue(attr, buf);
+    *buf << ",";
+  }
+  *buf << "}";
+}
+
+void AppendValue(const ValuePtr &value, std::ostringstream *buf) {
+  if (value == nullptr) {
+    *buf << "null";
+  } else if (value->isa<Primitive>()) {
+    auto prim = value->cast<PrimitivePtr>();
+    *buf << "prim:" << prim->name();
+    AppendAttrs(prim->attrs(), buf);
+  } else if (value->isa<tensor::Tensor>()) {
+    // The constant tensors are compared by content, their string form only shows a part of the data.
+    auto tensor = value->cast<tensor::TensorPtr>();
+    *buf << "tensor:" << TypeIdToString(tensor->data_type()) << ShapeVectorToStr(tensor->shape()) << ":"
+         << system::sha256::GetHashFromString(
+              std::string(static_cast<const char *>(tensor->data_c()), tensor->Size()));
+  } else if (value->isa<ValueSequence>()) {
+    *buf << "(";
+    for (const auto &element : value->cast<ValueSequencePtr>()->value()) {
+      AppendValue(element, buf);
+      *buf << ",";
+    }
+    *buf << ")";
+  } else {
+    *buf << value->type_name() << ":" << value->ToString();
+  }
+}
+
+void AppendAbstract(const AbstractBasePtr &abs, std::ostringstream *buf) {
+  if (abs == nullptr) {
+    *buf << "[]";
+    return;
+  }
+  auto shape = abs->GetShape();
+  auto type = abs->GetType();
+  *buf << "[" << (shape == nullptr ? "" : shape->ToString()) << "|" << (type == nullptr ? "" : type->ToString())
+       << "]";
+}
+
+nlohmann::json BuildInfoToJson(const kernel::KernelBuildInfo &build_info) {
+  nlohmann::json info_json;
+  info_json[kInfoKernelType] = build_info.kernel_type();
+  info_json[kInfoOpType] = build_info.op_type();
+  info_json[kInfoOriginFormat] = build_info.GetOriginDataFormat();
+  info_json[kInfoInputFormats] = build_info.GetAllInputFormats();
+  info_json[kInfoOutputFormats] = build_info.GetAllOutputFormats();
+  info_json[kInfoInputDeviceTypes] = build_info.GetAllInputDeviceTypes();
+  info_json[kInfoOutputDeviceTypes] = build_info.GetAllOutputDeviceTypes();
+  info_json[kInfoInputReshapeTypes] = build_info.GetAllInputReshapeType();
+  info_json[kInfoOutputReshapeTypes] = build_info.GetAllOutputReshapeType();
+  info_json[kInfoInputObjectTypes] = build_info.GetAllInputKernelObjectTypes();
+  info_json[kInfoOutputObjectTypes] = build_info.GetAllOutputKernelObjectTypes();
+  info_json[kInfoOutputElementObjectTypes] = build_info.GetAllOutputElementsKernelObjectTypes();
+  info_json[kInfoOutputDataDesc] = build_info.output_data_desc();
+  info_json[kInfoCoreType] = build_info.core_type();
+  info_json[kInfoFusionType] = build_info.fusion_type();
+  info_json[kInfoProcessor] = build_info.processor();
+  info_json[kInfoOpPattern] = build_info.op_pattern();
+  info_json[kInfoValid] = build_info.valid();
+  return info_json;
+}
+
+kernel::KernelBuildInfoPtr JsonToBuildInfo(const nlohmann::json &info_json) {
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetKernelType(info_json.at(kInfoKernelType).get<KernelType>());
+  builder.SetOpType(info_json.at(kInfoOpType).get<kernel::OpType>());
+  builder.SetOriginDataFormat(info_json.at(kInfoOriginFormat).get<std::string>());
+  builder.SetInputsFormat(info_json.at(kInfoInputFormats).get<std::vector<std::string>>());
+  builder.SetOutputsFormat(info_json.at(kInfoOutputFormats).get<std::vector<std::string>>());
+  builder.SetInputsDeviceType(info_json.at(kInfoInputDeviceTypes).get<std::vector<TypeId>>());
+  builder.SetOutputsDeviceType(info_json.at(kInfoOutputDeviceTypes).get<std::vector<TypeId>>());
+  builder.SetInputsReshapeType(info_json.at(kInfoInputReshapeTypes).get<std::vector<std::string>>());
+  builder.SetOutputsReshapeType(info_json.at(kInfoOutputReshapeTypes).get<std::vector<std::string>>());
+  builder.SetInputsKernelObjectType(
+    info_json.at(kInfoInputObjectTypes).get<std::vector<kernel::KernelObjectType>>());
+  builder.SetOutputsKernelObjectType(
+    info_json.at(kInfoOutputObjectTypes).get<std::vector<kernel::KernelObjectType>>());
+  builder.SetOutputElementsKernelObjectType(
+    info_json.at(kInfoOutputElementObjectTypes).get<std::vector<kernel::KernelObjectType>>());
+  builder.SetOutputDataDesc(info_json.at(kInfoOutputDataDesc).get<std::vector<nlohmann::json>>());
+  builder.SetCoreType(info_json.at(kInfoCoreType).get<std::string>());
+  builder.SetFusionType(info_json.at(kInfoFusionType).get<std::string>());
+  builder.SetProcessor(info_json.at(kInfoProcessor).get<kernel::Processor>());
+  builder.SetOpPattern(info_json.at(kInfoOpPattern).get<kernel::OpPattern>());
+  builder.SetValid(info_json.at(kInfoValid).get<bool>());
+  return builder.Build();
+}
+
+std::string GetEntryPath(const std::string &key) {
+  return Common::GetCompilerCachePath() + kBackendKernelSelectCacheSubDir + "/" + key + kJsonSuffix;
+}
+}  // namespace
+
+KernelSelectCache &KernelSelectCache::GetInstance() {
+  static KernelSelectCache instance;
+  return instance;
+}
+
+bool KernelSelectCache::Enable() { return CompileCacheEnable(); }
+
+std::string KernelSelectCache::GraphKey(const KernelGraphPtr &graph, const std::string &device_name,
+                                           const KernelFingerprint &kernel_fingerprint) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(kernel_fingerprint);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  std::ostringstream buf;
+  buf << MSVERSION << ";" << device_name << ";" << context->get_param<uint32_t>(MS_CTX_DEVICE_ID) << ";"
+      << context->get_param<std::string>(MS_CTX_PRECISION_MODE) << ";";
+  // The nodes are numbered in the topological order, so the key does not depend on the names or ids of the nodes.
+  mindspore::HashMap<AnfNodePtr, size_t> node_indexes;
+  for (const auto &node : TopoSort(graph->get_return())) {
+    MS_EXCEPTION_IF_NULL(node);
+    auto index = node_indexes.size();
+    node_indexes[node] = index;
+    buf << index << ":";
+    if (node->isa<Parameter>()) {
+      buf << (node->cast<ParameterPtr>()->has_default() ? "W" : "P");
+    } else if (node->isa<ValueNode>()) {
+      auto value = node->cast<ValueNodePtr>()->value();
+      if (value != nullptr && value->isa<FuncGraph>()) {
+        return "";
+      }
+      buf << "V";
+      AppendValue(value, &buf);
+    } else if (node->isa<CNode>()) {
+      auto cnode = node->cast<CNodePtr>();
+      buf << "C(";
+      for (const auto &input : cnode->inputs()) {
+        auto iter = node_indexes.find(input);
+        if (iter == node_indexes.end()) {
+          return "";
+        }
+        buf << iter->second << ",";
+      }
+      buf << ")";
+      AppendAttrs(cnode->attrs(), &buf);
+      if (AnfUtils::IsRealKernel(cnode)) {
+        buf << "K{" << kernel_fingerprint(cnode) << "}";
+      }
+    } else {
+      return "";
+    }
+    AppendAbstract(node->abstract(), &buf);
+    buf << ";";
+  }
+  return system::sha256::GetHashFromString(buf.str());
+}
+
+bool KernelSelectCache::FindEntry(const std::string &key, nlohmann::json *entry) {
+  MS_EXCEPTION_IF_NULL(entry);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    *entry = iter->second;
+    return true;
+  }
+  if (!Enable()) {
+    return false;
+  }
+  std::ifstream ifs(GetEntryPath(key));
+  if (!ifs.is_open()) {
+    return false;
+  }
+  try {
+    ifs >> *entry;
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the kernel select cache file " << GetEntryPath(key) << " failed: " << e.what();
+    return false;
+  }
+  entries_[key] = *entry;
+  return true;
+}
+
+void KernelSelectCache::PersistEntry(const std::string &key, const nlohmann::json &entry) const {
+  auto real_path = Common::CreatePrefixPath(GetEntryPath(key), true);
+  if (!real_path.has_value()) {
+    MS_LOG(WARNING) << "Get the real path of the kernel select cache file " << GetEntryPath(key) << " failed.";
+    return;
+  }
+  // The processes of the other ranks may write the same entry, publish the file by rename.
+  std::string tmp_file = real_path.value() + ".tmp" + Common::GetRandomStr();
+  std::ofstream ofs(tmp_file);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open the kernel select cache file " << tmp_file << " failed.";
+    return;
+  }
+  ofs << entry.dump();
+  ofs.close();
+  ChangeFileMode(tmp_file, S_IRUSR | S_IWUSR);
+  if (std::rename(tmp_file.c_str(), real_path.value().c_str()) != 0) {
+    MS_LOG(WARNING) << "Save the kernel select cache file " << real_path.value() << " failed, errno: " << errno;
+    (void)std::remove(tmp_file.c_str());
+  }
+}
+
+bool KernelSelectCache::LoadKernelBuildInfo(const std::string &key, const std::vector<CNodePtr> &kernels) {
+  nlohmann::json entry;
+  if (key.empty() || !FindEntry(key, &entry)) {
+    return false;
+  }
+  std::vector<kernel::KernelBuildInfoPtr> build_infos;
+  std::vector<std::vector<int64_t>> dyn_input_sizes;
+  try {
+    const auto &kernels_json = entry.at(kCacheKernels);
+    if (kernels_json.size() != kernels.size()) {
+      MS_LOG(INFO) << "The kernel select cache " << key << " has " << kernels_json.size() << " kernels, but got "
+                   << kernels.size();
+      return false;
+    }
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      const auto &kernel_json = kernels_json[i];
+      if (kernel_json.at(kCacheOp).get<std::string>() != common::AnfAlgo::GetCNodeName(kernels[i])) {
+        MS_LOG(INFO) << "The kernel " << i << " of the kernel select cache " << key << " is "
+                     << kernel_json.at(kCacheOp) << ", but got " << kernels[i]->fullname_with_scope();
+        return false;
+      }
+      (void)build_infos.emplace_back(JsonToBuildInfo(kernel_json.at(kCacheBuildInfo)));
+      (void)dyn_input_sizes.emplace_back(kernel_json.value(kCacheDynInputSizes, std::vector<int64_t>()));
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the kernel select cache " << key << " failed: " << e.what();
+    return false;
+  }
+
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    AnfAlgo::SetSelectKernelBuildInfo(build_infos[i], kernels[i].get());
+    if (!dyn_input_sizes[i].empty()) {
+      common::AnfAlgo::SetNodeAttr(kAttrDynInputSizes, MakeValue(dyn_input_sizes[i]), kernels[i]);
+    }
+  }
+  MS_LOG(INFO) << "Load the kernel build info of " << kernels.size() << " kernels from the kernel select cache "
+               << key;
+  return true;
+}
+
+void KernelSelectCache::SaveKernelBuildInfo(const std::string &key, const std::vector<CNodePtr> &kernels) {
+  if (key.empty()) {
+    return;
+  }
+  nlohmann::json kernels_json = nlohmann::json::array();
+  for (const auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto build_info = AnfAlgo::GetSelectKernelBuildInfo(kernel);
+    if (build_info == nullptr) {
+      MS_LOG(DEBUG) << "The kernel " << kernel->fullname_with_scope() << " is not selected, skip the cache " << key;
+      return;
+    }
+    nlohmann::json kernel_json;
+    kernel_json[kCacheOp] = common::AnfAlgo::GetCNodeName(kernel);
+    kernel_json[kCacheBuildInfo] = BuildInfoToJson(*build_info);
+    if (common::AnfAlgo::HasNodeAttr(kAttrDynInputSizes, kernel)) {
+      kernel_json[kCacheDynInputSizes] = common::AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel, kAttrDynInputSizes);
+    }
+    kernels_json.push_back(kernel_json);
+  }
+  nlohmann::json entry;
+  entry[kCacheKernels] = kernels_json;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = entry;
+  }
+  if (Enable()) {
+    PersistEntry(key, entry);
+  }
+}
+
+void KernelSelectCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+}  // namespace mindspore::session
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_COMMON_SESSION_KERNEL_SELECT_CACHE_H
+#define MINDSPORE_CCSRC_BACKEND_COMMON_SESSION_KERNEL_SELECT_CACHE_H
+
+#include <map>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "include/backend/kernel_graph.h"
+#include "include/backend/visible.h"
+
+namespace mindspore::session {
+/*
+ * The KernelSelectCache keeps the kernel selection result of each kernel graph, ie. the kernel build info and the
+ * dyn_input_sizes attr of its kernels, by the structural hash of the graph, which covers the nodes, the edges, the
+ * primitives with their attrs, the constants and the abstracts of the inputs. Only the kernel selection is skipped on a
+ * hit, the kernel mods, the memory plan and the actor set are still built on each compile, and the front end compile is
+ * not cached here. An edit of the network only misses the kernel graphs it changes, and the identical kernel graphs,
+ * eg. the repeated cells, share the selection in one process. The entries are saved under the compile cache path if
+ * the compile cache is enabled.
+ */
+class BACKEND_EXPORT KernelSelectCache {
+ public:
+  static KernelSelectCache &GetInstance();
+
+  // Whether the cache is enabled, it follows the switch of the compile cache.
+  static bool Enable();
+
+  // Describes the kernels registered on the device for the op of a kernel, eg. their supported kernel attrs.
+  using KernelFingerprint = std::function<std::string(const CNodePtr &)>;
+
+  // The structural hash of the graph on the device, empty if the graph can not be cached, eg. it calls other graphs.
+  // It also covers the version of MindSpore, the device id, the precision mode and the registered kernels of the
+  // real kernels, so an upgrade or a change of the kernel registry misses the saved entries.
+  static std::string GraphKey(const KernelGraphPtr &graph, const std::string &device_name,
+                              const KernelFingerprint &kernel_fingerprint);
+
+  // Set the cached kernel build info of the key to the kernels, return false without changing the kernels if the key
+  // misses or the cached kernels do not match them.
+  bool LoadKernelBuildInfo(const std::string &key, const std::vector<CNodePtr> &kernels);
+  // Save the selected kernel build info of the kernels, all the kernels should have been selected.
+  void SaveKernelBuildInfo(const std::string &key, const std::vector<CNodePtr> &kernels);
+
+  void Clear();
+
+ private:
+  KernelSelectCache() = default;
+  ~KernelSelectCache() = default;
+  KernelSelectCache(const KernelSelectCache &) = delete;
+  KernelSelectCache &operator=(const KernelSelectCache &) = delete;
+
+  bool FindEntry(const std::string &key, nlohmann::json *entry);
+  void PersistEntry(const std::string &key, const nlohmann::json &entry) const;
+
+  std::mutex mutex_;
+  // The entries loaded or saved in this process, the key is the structural hash of the graph.
+  std::map<std::string, nlohmann::json> entries_;
+};
+}  // namespace mindspore::session
+#endif  // MINDSPORE_CCSRC_BACKEND_COMMON_SESSION_KERNEL_SELECT_CACHE_H
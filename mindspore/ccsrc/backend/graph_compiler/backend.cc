@@ -961,15 +961,15 @@ void MindRTBackend::DispatchOpTask(bool single_op_cache_hit, VectorRef *outputs,
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
   auto infer_flag = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
-  auto run_op_context =
-    std::make_shared<runtime::OpTaskContext>(graph->graph_id(), graph, op_run_info, op_compiler_info, infer_flag);
+  auto run_op_context = runtime::MakePooledTask<runtime::OpTaskContext>(graph->graph_id(), graph, op_run_info,
+                                                                        op_compiler_info, infer_flag);
 
   auto &op_executor = runtime::OpExecutor::GetInstance();
   if (!single_op_cache_hit) {
     CompileSingleOpGraph(op_compiler_info, op_compiler_info->device_context_);
   }
 
-  auto run_task = std::make_shared<runtime::DeviceOpRunTask>(
+  auto run_task = runtime::MakePooledTask<runtime::DeviceOpRunTask>(
     run_op_context, [this](const std::shared_ptr<runtime::OpTaskContext> &ctx) { OpRunCallback(ctx); });
   run_task->set_task_id(op_compiler_info->graph_id_);
   op_executor.PushOpRunTask(run_task);
@@ -985,11 +985,11 @@ void MindRTBackend::DispatchOpTaskDynamic(VectorRef *outputs, const OpCompilerIn
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
   auto infer_flag = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
-  auto run_op_context =
-    std::make_shared<runtime::OpTaskContext>(graph->graph_id(), graph, op_run_info, op_compiler_info, infer_flag);
+  auto run_op_context = runtime::MakePooledTask<runtime::OpTaskContext>(graph->graph_id(), graph, op_run_info,
+                                                                        op_compiler_info, infer_flag);
 
   auto &op_executor = runtime::OpExecutor::GetInstance();
-  auto task = std::make_shared<runtime::DeviceOpRunTask>(
+  auto task = runtime::MakePooledTask<runtime::DeviceOpRunTask>(
     run_op_context, [this](const std::shared_ptr<runtime::OpTaskContext> &ctx) { OpRunCallbackDynamic(ctx); });
   task->set_task_id(op_compiler_info->graph_id_);
   op_executor.PushOpRunTask(task);
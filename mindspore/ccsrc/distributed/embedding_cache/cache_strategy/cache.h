@@ -45,6 +45,27 @@ class Cache {
   // on different cache strategies.
   virtual bool Get(const KeyType &key, ValueType *value) = 0;
 
+  // Batch version of Get for all the keys of a batch, whose results are the same as calling Get for the keys in order.
+  // The Value of the key hit is assigned to `values[i]` if `values` is not nullptr, and `hits[i]` records whether the
+  // key hits. Return the number of keys hit.
+  virtual size_t BatchGet(const KeyType *keys, size_t key_num, ValueType *values, bool *hits) {
+    size_t hit_num = 0;
+    ValueType value{};
+    for (size_t i = 0; i < key_num; ++i) {
+      hits[i] = Get(keys[i], values == nullptr ? &value : values + i);
+      hit_num += hits[i] ? 1 : 0;
+    }
+    return hit_num;
+  }
+
+  // Batch version of Put for all the key-value pairs of a batch, whose results are the same as calling Put for the
+  // key-value pairs in order.
+  virtual void BatchPut(const KeyType *keys, const ValueType *values, size_t key_num) {
+    for (size_t i = 0; i < key_num; ++i) {
+      Put(keys[i], values[i]);
+    }
+  }
+
   // Get the most recently used element.
   virtual const Element &Front() const = 0;
 
@@ -0,0 +1,416 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_SLRU_CHCHE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_SLRU_CHCHE_H_
+
+#include <list>
+#include <vector>
+#include <mutex>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// A count-min sketch which estimates the recent access frequency of the keys in a fixed size table. All the counters
+// are halved periodically, so the frequency of the keys which are no longer accessed decays.
+template <typename KeyType, typename Hash = std::hash<KeyType>>
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity) {
+    // The table width is power of two and not less than the capacity of the cache, but no more than 16M counters.
+    constexpr size_t kMinWidth = 64;
+    constexpr size_t kMaxWidth = static_cast<size_t>(1) << 24;
+    size_t width = kMinWidth;
+    while (width < capacity && width < kMaxWidth) {
+      width <<= 1;
+    }
+    counters_.resize(width * kDepth, 0);
+    mask_ = width - 1;
+    constexpr size_t kSampleRatio = 10;
+    sample_size_ = width * kSampleRatio;
+  }
+  ~FrequencySketch() = default;
+
+  // Record an access of the key.
+  void Increment(const KeyType &key) {
+    uint64_t hash = Hash()(key);
+    bool added = false;
+    for (size_t i = 0; i < kDepth; ++i) {
+      auto &counter = counters_[i * (mask_ + 1) + Index(hash, i)];
+      if (counter < kMaxFrequency) {
+        ++counter;
+        added = true;
+      }
+    }
+    if (added && ++additions_ >= sample_size_) {
+      Reset();
+    }
+  }
+
+  // Estimate the recent access frequency of the key.
+  uint8_t Frequency(const KeyType &key) const {
+    uint64_t hash = Hash()(key);
+    uint8_t frequency = kMaxFrequency;
+    for (size_t i = 0; i < kDepth; ++i) {
+      frequency = std::min(frequency, counters_[i * (mask_ + 1) + Index(hash, i)]);
+    }
+    return frequency;
+  }
+
+ private:
+  size_t Index(uint64_t hash, size_t depth) const {
+    // Remix the hash with a different seed for each row, the std::hash of integers is identity.
+    constexpr uint64_t kSeeds[] = {0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL,
+                                   0xd6e8feb86659fd93ULL};
+    hash = (hash + kSeeds[depth]) * kSeeds[(depth + 1) % kDepth];
+    return static_cast<size_t>(hash ^ (hash >> 32)) & mask_;
+  }
+
+  void Reset() {
+    for (auto &counter : counters_) {
+      counter >>= 1;
+    }
+    additions_ /= 2;
+  }
+
+  static constexpr size_t kDepth = 4;
+  static constexpr uint8_t kMaxFrequency = 15;
+
+  std::vector<uint8_t> counters_;
+  size_t mask_{0};
+  size_t additions_{0};
+  size_t sample_size_{0};
+};
+
+// This class implements a segmented LRU caching strategy with a frequency based admission, which resists the scan of
+// the keys accessed only once:
+// 1. The new elements are put into the probation segment, the elements accessed again are promoted to the protected
+// segment, the overflow of the protected segment is demoted back to the probation segment.
+// 2. The elements are evicted from the tail of the probation segment first, so the one-off keys never evict the hot
+// keys in the protected segment.
+// 3. The recent access frequency of all keys including the evicted ones is recorded by a count-min sketch, a new key
+// which is hotter than the coldest element of the full protected segment is put into the protected segment directly
+// and the coldest one is demoted, so the hot keys evicted once come back quickly.
+// The elements are stored in a flat array linked by indices. The array and the buckets of the hash table are reserved
+// for the capacity at construction, so Put and Get never reallocate them, but the hash table still allocates a node
+// for each inserted key unless the fast hash table is enabled. All the interfaces are thread-safe, the batch
+// interfaces lock the cache once for a batch.
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class SLRUCache : public Cache<KeyType, ValueType> {
+ public:
+  // The elements in cache are stored as key-value pairs.
+  using Element = typename Cache<KeyType, ValueType>::Element;
+
+  explicit SLRUCache(size_t capacity) : Cache<KeyType, ValueType>(capacity), sketch_(capacity) {
+    // The protected segment takes 80% of the capacity.
+    constexpr size_t kProtectedRatioNumerator = 4;
+    constexpr size_t kProtectedRatioDenominator = 5;
+    protected_capacity_ = std::max(capacity * kProtectedRatioNumerator / kProtectedRatioDenominator,
+                                   static_cast<size_t>(1));
+    nodes_.reserve(capacity);
+    element_keys_to_indices_.reserve(capacity);
+  }
+
+  ~SLRUCache() override = default;
+
+  // Insert an element (key-value pair) into the slru cache.
+  // The newly inserted element is put at the head of the probation segment, or the head of the protected segment if the
+  // key is hotter than the coldest protected element. Putting an existing key counts as an access of the element.
+  void Put(const KeyType &key, const ValueType &value) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PutImpl(key, value);
+  }
+
+  // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
+  // is assigned to parameter value and return true. If the element does not exist, return false.
+  // The accessed element is moved to the head of the protected segment.
+  bool Get(const KeyType &key, ValueType *value) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetImpl(key, value);
+  }
+
+  size_t BatchGet(const KeyType *keys, size_t key_num, ValueType *values, bool *hits) override {
+    MS_EXCEPTION_IF_NULL(keys);
+    MS_EXCEPTION_IF_NULL(hits);
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t hit_num = 0;
+    ValueType value{};
+    for (size_t i = 0; i < key_num; ++i) {
+      hits[i] = GetImpl(keys[i], values == nullptr ? &value : values + i);
+      hit_num += hits[i] ? 1 : 0;
+    }
+    return hit_num;
+  }
+
+  void BatchPut(const KeyType *keys, const ValueType *values, size_t key_num) override {
+    MS_EXCEPTION_IF_NULL(keys);
+    MS_EXCEPTION_IF_NULL(values);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < key_num; ++i) {
+      PutImpl(keys[i], values[i]);
+    }
+  }
+
+  // Get the most recently used element.
+  const Element &Front() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto &probation_head = segments_[kProbation].head;
+    const auto &protected_head = segments_[kProtected].head;
+    if (probation_head == kNil && protected_head == kNil) {
+      MS_LOG(EXCEPTION) << "There is no element in slru cache.";
+    }
+    if (probation_head == kNil) {
+      return nodes_[protected_head].element;
+    }
+    if (protected_head == kNil) {
+      return nodes_[probation_head].element;
+    }
+    return nodes_[probation_head].access_time > nodes_[protected_head].access_time ? nodes_[probation_head].element
+                                                                                  : nodes_[protected_head].element;
+  }
+
+  // Get the element which will be evicted next.
+  const Element &Back() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size_ == 0) {
+      MS_LOG(EXCEPTION) << "There is no element in slru cache.";
+    }
+    return nodes_[Victim()].element;
+  }
+
+  // Query whether the element corresponding to a particular key exists in the cache.
+  bool Exists(const KeyType &key) const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return element_keys_to_indices_.find(key) != element_keys_to_indices_.end();
+  }
+
+  // When the size of the cache is close to capacity, you can use this interface to evict some non-hot data to reserve
+  // space for new elements to be inserted into the cache. If the current cache has enough free space, this function
+  // does nothing.
+  // The elements are evicted from the tail of the probation segment, then the tail of the protected segment.
+  // The input parameter 'reserve_size' indicates the number of element slots that are expected to be reserved. If the
+  // reserve_size is less than or equal to the number of slots remaining in the cache, the function does nothing.
+  // The output parameter 'evicted_elements' is used to hold the evicted element.
+  void TryEvict(size_t reserve_size, std::vector<Element> *evicted_elements) override {
+    MS_EXCEPTION_IF_NULL(evicted_elements);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    if (reserve_size > capacity) {
+      MS_LOG(EXCEPTION) << "The evict number must be less or equal to slru cache capacity: " << capacity
+                        << ", but got: " << reserve_size;
+    }
+
+    while (size_ > capacity - reserve_size) {
+      size_t index = Victim();
+      auto &node = nodes_[index];
+      evicted_elements->emplace_back(node.element.first, node.element.second);
+      Unlink(index);
+      (void)element_keys_to_indices_.erase(node.element.first);
+      node.next = free_head_;
+      free_head_ = index;
+      --size_;
+    }
+  }
+
+  // Check whether the number of elements in cache reaches capacity.
+  bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
+
+  // Get the current number of elements in the cache.
+  size_t size() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  // Dump all elements in the slru cache, the elements of the protected segment come first and each segment is ordered
+  // from the most recently used to the least recently used.
+  const std::list<Element> &Export() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exported_elements_.clear();
+    for (auto segment : {kProtected, kProbation}) {
+      for (size_t index = segments_[segment].head; index != kNil; index = nodes_[index].next) {
+        exported_elements_.push_back(nodes_[index].element);
+      }
+    }
+    return exported_elements_;
+  }
+
+  // Get the number of elements in the protected segment.
+  size_t protected_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_[kProtected].size;
+  }
+
+ private:
+  enum SegmentType : uint8_t { kProbation = 0, kProtected = 1, kSegmentNum = 2 };
+  static constexpr size_t kNil = std::numeric_limits<size_t>::max();
+  // The new key whose frequency is less than this threshold is never put into the protected segment directly, the key
+  // accessed by Get before Put for the first time has frequency 1.
+  static constexpr uint8_t kMinProtectedFrequency = 2;
+
+  struct Node {
+    Element element;
+    size_t prev{kNil};
+    size_t next{kNil};
+    uint64_t access_time{0};
+    SegmentType segment{kProbation};
+  };
+
+  struct Segment {
+    size_t head{kNil};
+    size_t tail{kNil};
+    size_t size{0};
+  };
+
+  bool GetImpl(const KeyType &key, ValueType *value) {
+    MS_EXCEPTION_IF_NULL(value);
+    sketch_.Increment(key);
+    const auto &iter = element_keys_to_indices_.find(key);
+    if (iter == element_keys_to_indices_.end()) {
+      return false;
+    }
+    Touch(iter->second);
+    *value = nodes_[iter->second].element.second;
+    return true;
+  }
+
+  void PutImpl(const KeyType &key, const ValueType &value) {
+    const auto &iter = element_keys_to_indices_.find(key);
+    // The key exist in slru cache, update the value and promote this element.
+    if (iter != element_keys_to_indices_.end()) {
+      nodes_[iter->second].element.second = value;
+      Touch(iter->second);
+      return;
+    }
+
+    if (size_ >= Cache<KeyType, ValueType>::capacity()) {
+      MS_LOG(EXCEPTION) << "There is no space in slru cache.";
+    }
+
+    // Take a node from the free list or the unused part of the flat array, which is reserved at construction.
+    size_t index = free_head_;
+    if (index != kNil) {
+      free_head_ = nodes_[index].next;
+      nodes_[index].element = Element(key, value);
+    } else {
+      index = nodes_.size();
+      (void)nodes_.emplace_back(Node{Element(key, value)});
+    }
+    (void)element_keys_to_indices_.emplace(key, index);
+    ++size_;
+
+    // The frequency based admission to the protected segment, which only happens when the protected segment is full,
+    // otherwise the element is promoted by the next access without evicting any protected element.
+    bool admit_protected = false;
+    if (segments_[kProtected].size >= protected_capacity_) {
+      auto frequency = sketch_.Frequency(key);
+      admit_protected = frequency >= kMinProtectedFrequency &&
+                        frequency > sketch_.Frequency(nodes_[segments_[kProtected].tail].element.first);
+    }
+    PushFront(index, admit_protected ? kProtected : kProbation);
+    if (admit_protected) {
+      DemoteOverflow();
+    }
+  }
+
+  // Move the accessed element to the head of the protected segment.
+  void Touch(size_t index) {
+    Unlink(index);
+    PushFront(index, kProtected);
+    DemoteOverflow();
+  }
+
+  // Demote the tail of the protected segment to the head of the probation segment if the protected segment is full.
+  void DemoteOverflow() {
+    while (segments_[kProtected].size > protected_capacity_) {
+      size_t tail = segments_[kProtected].tail;
+      uint64_t access_time = nodes_[tail].access_time;
+      Unlink(tail);
+      PushFront(tail, kProbation);
+      // The demoted element keeps its access time, it is not accessed recently.
+      nodes_[tail].access_time = access_time;
+    }
+  }
+
+  size_t Victim() const {
+    return segments_[kProbation].tail != kNil ? segments_[kProbation].tail : segments_[kProtected].tail;
+  }
+
+  void PushFront(size_t index, SegmentType segment_type) {
+    auto &node = nodes_[index];
+    auto &segment = segments_[segment_type];
+    node.segment = segment_type;
+    node.access_time = ++clock_;
+    node.prev = kNil;
+    node.next = segment.head;
+    if (segment.head != kNil) {
+      nodes_[segment.head].prev = index;
+    } else {
+      segment.tail = index;
+    }
+    segment.head = index;
+    ++segment.size;
+  }
+
+  void Unlink(size_t index) {
+    auto &node = nodes_[index];
+    auto &segment = segments_[node.segment];
+    if (node.prev != kNil) {
+      nodes_[node.prev].next = node.next;
+    } else {
+      segment.head = node.next;
+    }
+    if (node.next != kNil) {
+      nodes_[node.next].prev = node.prev;
+    } else {
+      segment.tail = node.prev;
+    }
+    node.prev = kNil;
+    node.next = kNil;
+    --segment.size;
+  }
+
+  // The flat array used to hold elements, the free nodes are linked by `next` from `free_head_`.
+  std::vector<Node> nodes_;
+  size_t free_head_{kNil};
+  size_t size_{0};
+
+  Segment segments_[kSegmentNum];
+  size_t protected_capacity_{0};
+  // The logical clock used to record the access time of elements.
+  uint64_t clock_{0};
+
+  // The hash table used to quickly find the index of an element in the flat array.
+  mindspore::HashMap<KeyType, size_t, Hash, KeyEqual> element_keys_to_indices_;
+
+  FrequencySketch<KeyType, Hash> sketch_;
+
+  // The elements dumped by Export.
+  mutable std::list<Element> exported_elements_;
+
+  // This mutex is to guarantee the thread-safe of the slru cache.
+  mutable std::mutex mutex_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_SLRU_CHCHE_H_
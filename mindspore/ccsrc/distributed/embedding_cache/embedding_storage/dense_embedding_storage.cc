@@ -172,8 +172,11 @@ void DenseEmbeddingStorage<KeyType, ValueType, Allocator>::QueryCache(const KeyT
   MS_EXCEPTION_IF_NULL(indices_in_cache);
   MS_EXCEPTION_IF_NULL(this->cache_);
 
+  // Query the cache for the whole batch at once.
+  std::unique_ptr<bool[]> cache_hit = std::make_unique<bool[]>(key_num);
+  (void)this->cache_->BatchGet(keys, key_num, indices_in_cache, cache_hit.get());
   for (size_t i = 0; i < key_num; i++) {
-    if (this->cache_->Get(keys[i], indices_in_cache + i)) {
+    if (cache_hit[i]) {
       continue;
     }
 
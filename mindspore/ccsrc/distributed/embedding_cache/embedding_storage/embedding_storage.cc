@@ -18,6 +18,7 @@
 #include <map>
 #include <string>
 #include "distributed/embedding_cache/cache_strategy/lru_cache.h"
+#include "distributed/embedding_cache/cache_strategy/slru_cache.h"
 #include "distributed/persistent/storage/local_file.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "include/backend/distributed/ps/ps_context.h"
@@ -33,6 +34,9 @@ namespace {
 constexpr auto kEnvEmbeddingRemoteStoragePath = "MS_EMBEDDING_REMOTE_STORAGE_PATH";
 // Default value for embedding remote persistent file storage path.
 constexpr auto kDefaultEmbeddingRemoteStoragePath = "./embedding_storage";
+// The environment variable used to set the cache strategy of the host cache, 'lru'(default) or 'slru'.
+constexpr auto kEnvEmbeddingCacheStrategy = "MS_EMBEDDING_CACHE_STRATEGY";
+constexpr auto kSLRUCacheStrategy = "slru";
 
 // Get embedding remote persistent file storage path from environment variable.
 std::string GetEmbeddingRemoteStoragePath() {
@@ -57,7 +61,12 @@ void EmbeddingStorage<KeyType, ValueType, Allocator>::Initialize(const DeviceAdd
 #endif
 
   // 2. Create the host memory cache instance.
-  cache_ = std::make_unique<LRUCache<KeyType, int>>(cache_capacity_);
+  if (common::GetEnv(kEnvEmbeddingCacheStrategy) == kSLRUCacheStrategy) {
+    MS_LOG(INFO) << "Use slru cache strategy for embedding storage: " << embedding_key_;
+    cache_ = std::make_unique<SLRUCache<KeyType, int>>(cache_capacity_);
+  } else {
+    cache_ = std::make_unique<LRUCache<KeyType, int>>(cache_capacity_);
+  }
   MS_EXCEPTION_IF_NULL(cache_);
 
   // 3. Create the persistent storage instance.
@@ -150,16 +150,14 @@ void SparseEmbeddingStorage<KeyType, ValueType, Allocator>::QueryCache(const Key
   MS_EXCEPTION_IF_NULL(cache_hit);
   MS_EXCEPTION_IF_NULL(this->cache_);
 
-  int fake_index;
+  // Touch keys to affect the location or order of the elements in the cache, the return value for hash table is
+  // useless.
+  (void)this->cache_->BatchGet(keys, key_num, nullptr, cache_hit);
   for (size_t i = 0; i < key_num; i++) {
-    if (this->cache_->Get(keys[i], &fake_index)) {
-      // Touch keys to affect the location or order of the elements in the cache, the return value for hash table is
-      // useless.
-      cache_hit[i] = true;
+    if (cache_hit[i]) {
       continue;
     }
 
-    cache_hit[i] = false;
     // Record cache miss key's offset in all query keys.
     cache_miss_offsets[(*cache_miss_cnt)++] = i;
   }
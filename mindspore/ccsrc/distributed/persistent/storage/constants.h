@@ -40,6 +40,17 @@ constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
 
 constexpr char kElementSize[] = "element_size";
+
+// Asynchronous checkpoint related.
+// Set the config to "true" to write the dirty blocks in the background, the caller only waits for the snapshot.
+constexpr char kAsyncWrite[] = "async_write";
+// The blocks of a checkpoint are written to the temporary files first, which replace the block files after the
+// manifest of the checkpoint is written.
+constexpr char kTmpSuffix[] = ".tmp";
+constexpr char kCheckpointManifest[] = "checkpoint_manifest";
+constexpr char kManifestBlocks[] = "blocks";
+// The number of threads which write and hash the blocks of a checkpoint.
+constexpr size_t kCheckpointThreadNum = 4;
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -20,6 +20,10 @@
 #ifdef _MSC_VER
 #include <direct.h>  // for _mkdir on windows
 #endif
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include "mindspore/core/utils/file_utils.h"
 #include "utils/convert_utils_base.h"
 #include "utils/log_adapter.h"
@@ -86,6 +90,44 @@ bool FileIOUtils::Write(const std::string &file_name, const std::vector<std::pai
   return true;
 }
 
+bool FileIOUtils::WriteAndSync(const std::string &file_name, const void *data, size_t size) {
+#if defined(_WIN32) || defined(_WIN64)
+  return Write(file_name, {{data, size}});
+#else
+  if (file_name.empty()) {
+    MS_LOG(ERROR) << "The file name is empty";
+    return false;
+  }
+  MS_ERROR_IF_NULL(data);
+
+  int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file failed, file name: " << file_name << ", errno: " << errno;
+    return false;
+  }
+  const char *buf = reinterpret_cast<const char *>(data);
+  size_t written = 0;
+  while (written < size) {
+    ssize_t ret = write(fd, buf + written, size - written);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      MS_LOG(ERROR) << "Write file failed, file name: " << file_name << ", errno: " << errno;
+      (void)close(fd);
+      return false;
+    }
+    written += static_cast<size_t>(ret);
+  }
+  if (fsync(fd) != 0) {
+    MS_LOG(ERROR) << "Sync file failed, file name: " << file_name << ", errno: " << errno;
+    (void)close(fd);
+    return false;
+  }
+  return close(fd) == 0;
+#endif
+}
+
 bool FileIOUtils::Read(const std::string &file_name, const std::vector<std::pair<void *, size_t>> &outputs) {
   if (file_name.empty()) {
     MS_LOG(ERROR) << "The file name is empty";
@@ -34,6 +34,9 @@ class FileIOUtils {
   // Write memory buffer to the file on overwriting mode, create a new file if the file is not exist.
   static bool Write(const std::string &file_name, const std::vector<std::pair<const void *, size_t>> &inputs);
 
+  // Write the memory buffer to the file on overwriting mode and flush it to the disk before returning.
+  static bool WriteAndSync(const std::string &file_name, const void *data, size_t size);
+
   // Read file and load the context into memory buffer, return false if the file is not exist.
   static bool Read(const std::string &file_name, const std::vector<std::pair<void *, size_t>> &outputs);
 
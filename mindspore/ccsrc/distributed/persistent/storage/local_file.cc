@@ -16,8 +16,13 @@
 
 #include "distributed/persistent/storage/local_file.h"
 #include <dirent.h>
+#include <securec.h>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <numeric>
 #include <tuple>
 #include <utility>
@@ -26,6 +31,7 @@
 #include "utils/log_adapter.h"
 #include "distributed/persistent/storage/constants.h"
 #include "utils/system/env.h"
+#include "utils/system/sha256.h"
 #include "base/float16.h"
 #include "base/bfloat16.h"
 
@@ -52,10 +58,14 @@ LocalFile<KeyType, ValueType>::LocalFile(const std::map<std::string, std::string
   } else {
     element_size_ = 0;
   }
+
+  auto async_write_iter = storage_config.find(kAsyncWrite);
+  async_write_ = async_write_iter != storage_config.end() && async_write_iter->second == "true";
 }
 
 template <typename KeyType, typename ValueType>
 LocalFile<KeyType, ValueType>::~LocalFile() {
+  StopCheckpointThread();
   for (const auto &file : block_files_) {
     if (file == nullptr) {
       continue;
@@ -72,10 +82,19 @@ void LocalFile<KeyType, ValueType>::Initialize() {
 
   MS_EXCEPTION_IF_ZERO("element_size_", element_size_);
   block_size_ = max_block_length_ / (element_size_ * sizeof(ValueType));
+
+  if (async_write_ && !checkpoint_thread_.joinable()) {
+    stop_checkpoint_ = false;
+    checkpoint_thread_ = std::thread(&LocalFile<KeyType, ValueType>::CheckpointLoop, this);
+  }
 }
 
 template <typename KeyType, typename ValueType>
 void LocalFile<KeyType, ValueType>::Finalize() {
+  if (async_write_) {
+    WaitForCheckpoints();
+    StopCheckpointThread();
+  }
   block_files_.clear();
   fs_ = nullptr;
   keys_to_locations_.clear();
@@ -93,6 +112,22 @@ void LocalFile<KeyType, ValueType>::Write(const std::vector<InputData> &inputs,
     MS_LOG(EXCEPTION) << "The inputs is empty";
   }
 
+  if (async_write_) {
+    std::vector<int> block_indices;
+    {
+      std::lock_guard<std::mutex> lock(block_meta_mutex_);
+      if (finish_create_block_files_) {
+        TransformDirtyInfoToBlockIndices(dirty_info, &block_indices);
+      } else {
+        CreateBlocks(inputs);
+        block_indices.resize(block_list_.size());
+        std::iota(block_indices.begin(), block_indices.end(), 0);
+      }
+    }
+    WriteBlockFilesAsync(block_indices, inputs);
+    return;
+  }
+
   // The block file has been created, only the blocks related to the dirty information need to be rewritten.
   if (finish_create_block_files_) {
     std::vector<int> block_indices;
@@ -150,6 +185,16 @@ void LocalFile<KeyType, ValueType>::TransformDirtyInfoToBlockIndices(const Dirty
 
 template <typename KeyType, typename ValueType>
 void LocalFile<KeyType, ValueType>::WriteBlockFiles(const std::vector<InputData> &inputs) {
+  CreateBlocks(inputs);
+
+  // Write inputs_data to block files and Gen Sha256 seq.
+  for (size_t block_index = 0; block_index < block_list_.size(); ++block_index) {
+    WriteOneBlockFile(block_index, inputs);
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::CreateBlocks(const std::vector<InputData> &inputs) {
   if (inputs.empty()) {
     MS_LOG(EXCEPTION) << "The inputs is empty";
   }
@@ -205,11 +250,6 @@ void LocalFile<KeyType, ValueType>::WriteBlockFiles(const std::vector<InputData>
   }
 
   finish_create_block_files_ = true;
-
-  // Write inputs_data to block files and Gen Sha256 seq.
-  for (size_t block_index = 0; block_index < block_num; ++block_index) {
-    WriteOneBlockFile(block_index, inputs);
-  }
 }
 
 template <typename KeyType, typename ValueType>
@@ -239,6 +279,249 @@ void LocalFile<KeyType, ValueType>::WriteOneBlockFile(size_t block_index, const
   block_ptr->GenSha256Seq();
 }
 
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::WriteBlockFilesAsync(const std::vector<int> &block_indices,
+                                                         const std::vector<InputData> &inputs) {
+  std::unique_ptr<Checkpoint> checkpoint;
+  {
+    // Wait for the staging buffer, the previous checkpoint may still be being written meanwhile.
+    std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+    checkpoint_cv_.wait(lock, [this] { return staged_checkpoint_ == nullptr || !checkpoint_error_.empty(); });
+    if (!checkpoint_error_.empty()) {
+      MS_LOG(EXCEPTION) << "Write checkpoint to [" << file_path_ << "] failed: " << checkpoint_error_;
+    }
+    checkpoint = free_checkpoint_ != nullptr ? std::move(free_checkpoint_) : std::make_unique<Checkpoint>();
+  }
+
+  // The inputs may be modified once this method returns, so copy the blocks to write, the strings of the reused
+  // buffer keep their capacity.
+  checkpoint->resize(block_indices.size());
+  for (size_t i = 0; i < block_indices.size(); ++i) {
+    size_t block_index = IntToSize(block_indices[i]);
+    size_t field_size = 0;
+    size_t offset = 0;
+    {
+      std::lock_guard<std::mutex> lock(block_meta_mutex_);
+      const auto &block_meta_ptr = block_meta_list_.at(block_index);
+      MS_EXCEPTION_IF_NULL(block_meta_ptr);
+      field_size = block_meta_ptr->template Get<size_t>(kFieldsLength);
+      offset = block_meta_ptr->template Get<size_t>(kOffset);
+    }
+
+    auto &snapshot = checkpoint->at(i);
+    snapshot.block_index = block_index;
+    snapshot.data.resize(field_size * inputs.size());
+    for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
+      const char *data_ptr = reinterpret_cast<const char *>(std::get<1>(inputs[input_index])) + offset;
+      size_t dst_offset = input_index * field_size;
+      auto ret = memcpy_s(&snapshot.data[dst_offset], snapshot.data.size() - dst_offset, data_ptr, field_size);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Copy block " << block_index << " to the checkpoint buffer failed, errno[" << ret << "]";
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    staged_checkpoint_ = std::move(checkpoint);
+  }
+  checkpoint_cv_.notify_all();
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::CheckpointLoop() {
+  while (true) {
+    std::unique_ptr<Checkpoint> checkpoint;
+    {
+      std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+      checkpoint_cv_.wait(lock, [this] { return staged_checkpoint_ != nullptr || stop_checkpoint_; });
+      // The staged checkpoint is still written when stopping.
+      if (staged_checkpoint_ == nullptr) {
+        return;
+      }
+      checkpoint = std::move(staged_checkpoint_);
+      checkpoint_running_ = true;
+    }
+    // The staging buffer is free for the next snapshot.
+    checkpoint_cv_.notify_all();
+
+    std::string error;
+    try {
+      CommitCheckpoint(checkpoint.get());
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+      checkpoint_running_ = false;
+      if (!error.empty() && checkpoint_error_.empty()) {
+        checkpoint_error_ = error;
+      }
+      free_checkpoint_ = std::move(checkpoint);
+    }
+    checkpoint_cv_.notify_all();
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::CommitCheckpoint(Checkpoint *checkpoint) {
+  MS_EXCEPTION_IF_NULL(checkpoint);
+  size_t block_num = checkpoint->size();
+  if (block_num == 0) {
+    return;
+  }
+
+  // 1. Hash the blocks and write them to the temporary files in parallel.
+  std::vector<std::string> tmp_file_names(block_num);
+  for (size_t i = 0; i < block_num; ++i) {
+    const auto &block_ptr = block_list_.at(checkpoint->at(i).block_index);
+    MS_EXCEPTION_IF_NULL(block_ptr);
+    tmp_file_names[i] = block_ptr->block_file_name() + kTmpSuffix;
+  }
+  std::atomic<size_t> next_block{0};
+  std::atomic<bool> success{true};
+  auto write_blocks = [&]() {
+    for (size_t i = next_block++; i < block_num; i = next_block++) {
+      auto &snapshot = (*checkpoint)[i];
+      snapshot.hash_seq = system::sha256::GetHashFromString(snapshot.data);
+      if (!FileIOUtils::WriteAndSync(tmp_file_names[i], snapshot.data.data(), snapshot.data.size())) {
+        success = false;
+      }
+    }
+  };
+  size_t thread_num = std::min(kCheckpointThreadNum, block_num);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    (void)threads.emplace_back(write_blocks);
+  }
+  write_blocks();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (!success) {
+    MS_LOG(EXCEPTION) << "Write the blocks of the checkpoint to [" << file_path_ << "] failed.";
+  }
+
+  // 2. Commit the checkpoint by renaming the manifest, the block files are replaced only after this point.
+  nlohmann::json manifest;
+  manifest[kManifestBlocks] = nlohmann::json::array();
+  for (const auto &snapshot : *checkpoint) {
+    manifest[kManifestBlocks].push_back(nlohmann::json::array({snapshot.block_index, snapshot.hash_seq}));
+  }
+  std::string manifest_file_name = file_path_ + "/" + kCheckpointManifest;
+  std::string manifest_tmp_file_name = manifest_file_name + kTmpSuffix;
+  std::string manifest_content = manifest.dump();
+  if (!FileIOUtils::WriteAndSync(manifest_tmp_file_name, manifest_content.data(), manifest_content.size())) {
+    MS_LOG(EXCEPTION) << "Write checkpoint manifest [" << manifest_tmp_file_name << "] failed.";
+  }
+  if (std::rename(manifest_tmp_file_name.c_str(), manifest_file_name.c_str()) != 0) {
+    MS_LOG(EXCEPTION) << "Rename checkpoint manifest [" << manifest_tmp_file_name << "] failed, errno[" << errno
+                      << "]";
+  }
+
+  // 3. Replace the block files and update the hash in the block metas.
+  ApplyCheckpointManifest(manifest, false);
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::ApplyCheckpointManifest(const nlohmann::json &manifest, bool recovering) {
+  try {
+    for (const auto &item : manifest.at(kManifestBlocks)) {
+      size_t block_index = item.at(0).get<size_t>();
+      std::string hash_seq = item.at(1).get<std::string>();
+      std::string block_file_name = file_path_ + "/" + kBlockFilePrefix + std::to_string(block_index);
+      std::string tmp_file_name = block_file_name + kTmpSuffix;
+      // The temporary file is gone if the block file has been replaced before the process exited.
+      if (FileIOUtils::IsFileOrDirExist(tmp_file_name) &&
+          std::rename(tmp_file_name.c_str(), block_file_name.c_str()) != 0) {
+        MS_LOG(EXCEPTION) << "Rename block file [" << tmp_file_name << "] failed, errno[" << errno << "]";
+      }
+      ChangeFileMode(block_file_name, S_IRUSR | S_IWUSR);
+
+      if (recovering) {
+        BlockMeta block_meta(file_path_ + "/" + kBlockMetaFilePrefix + std::to_string(block_index) + kJsonSuffix);
+        if (!block_meta.Initialize()) {
+          MS_LOG(EXCEPTION) << "Initialize block meta failed, block index [" << block_index << "]";
+        }
+        block_meta.Insert(kHashSeq, hash_seq);
+      } else {
+        std::lock_guard<std::mutex> lock(block_meta_mutex_);
+        const auto &block_meta_ptr = block_meta_list_.at(block_index);
+        MS_EXCEPTION_IF_NULL(block_meta_ptr);
+        block_meta_ptr->Insert(kHashSeq, hash_seq);
+      }
+    }
+  } catch (nlohmann::json::exception &e) {
+    MS_LOG(EXCEPTION) << "Parse checkpoint manifest in [" << file_path_ << "] failed, the exception: " << e.what();
+  }
+
+  std::string manifest_file_name = file_path_ + "/" + kCheckpointManifest;
+  if (std::remove(manifest_file_name.c_str()) != 0) {
+    MS_LOG(EXCEPTION) << "Remove checkpoint manifest [" << manifest_file_name << "] failed, errno[" << errno << "]";
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::RecoverCheckpoint() {
+  std::string manifest_file_name = file_path_ + "/" + kCheckpointManifest;
+  if (FileIOUtils::IsFileOrDirExist(manifest_file_name)) {
+    MS_LOG(WARNING) << "Finish the committed checkpoint in [" << file_path_ << "].";
+    nlohmann::json manifest;
+    std::ifstream manifest_file(manifest_file_name);
+    try {
+      manifest_file >> manifest;
+    } catch (nlohmann::json::exception &e) {
+      MS_LOG(EXCEPTION) << "Parse checkpoint manifest [" << manifest_file_name << "] failed, the exception: "
+                        << e.what();
+    }
+    manifest_file.close();
+    ApplyCheckpointManifest(manifest, true);
+  }
+
+  // The temporary files left now belong to the checkpoint which was not committed, the block files are intact.
+  DIR *dir = opendir(file_path_.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  std::vector<std::string> tmp_file_names;
+  struct dirent *entry;
+  size_t tmp_suffix_len = strlen(kTmpSuffix);
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string file_name = entry->d_name;
+    if (file_name.length() > tmp_suffix_len && file_name.substr(file_name.length() - tmp_suffix_len) == kTmpSuffix) {
+      tmp_file_names.push_back(file_path_ + "/" + file_name);
+    }
+  }
+  (void)closedir(dir);
+  for (const auto &tmp_file_name : tmp_file_names) {
+    MS_LOG(WARNING) << "Remove the uncommitted checkpoint file [" << tmp_file_name << "].";
+    (void)std::remove(tmp_file_name.c_str());
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::WaitForCheckpoints() {
+  std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+  checkpoint_cv_.wait(lock, [this] { return staged_checkpoint_ == nullptr && !checkpoint_running_; });
+  if (!checkpoint_error_.empty()) {
+    MS_LOG(EXCEPTION) << "Write checkpoint to [" << file_path_ << "] failed: " << checkpoint_error_;
+  }
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::StopCheckpointThread() {
+  if (!checkpoint_thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    stop_checkpoint_ = true;
+  }
+  checkpoint_cv_.notify_all();
+  checkpoint_thread_.join();
+}
+
 template <typename KeyType, typename ValueType>
 void LocalFile<KeyType, ValueType>::Write(const ConstDataWithLen &keys, const ConstDataWithLen &values) {
   // Check input data valid.
@@ -307,6 +590,10 @@ void LocalFile<KeyType, ValueType>::Read(const OutputData &output) {
 
 template <typename KeyType, typename ValueType>
 void LocalFile<KeyType, ValueType>::Read(const std::vector<OutputData> &outputs) {
+  if (async_write_) {
+    WaitForCheckpoints();
+  }
+
   if (block_list_.empty() || block_meta_list_.empty()) {
     // Load file list info of block files and block meta files in the current folder to block list and block meta list.
     if (!LoadBlocksInfo()) {
@@ -342,6 +629,9 @@ void LocalFile<KeyType, ValueType>::Read(const std::vector<OutputData> &outputs)
 
 template <typename KeyType, typename ValueType>
 bool LocalFile<KeyType, ValueType>::LoadBlocksInfo() {
+  // Finish or drop the checkpoint interrupted by the exit of the last process before loading the block files.
+  RecoverCheckpoint();
+
   DIR *dir = opendir(file_path_.c_str());
   if (dir == nullptr) {
     MS_LOG(ERROR) << "The file path [" << file_path_ << "] is not exist";
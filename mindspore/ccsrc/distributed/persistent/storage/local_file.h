@@ -17,9 +17,12 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOCAL_FILE_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOCAL_FILE_H_
 
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 
@@ -51,6 +54,8 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
   // The following two methods are override version function for Write:
   // 1. Create blocks and block metas.
   // 2. Write input data to block files and Generate sha256 sequence for every block file.
+  // In the async write mode, the blocks to write are copied into a staging buffer and the method returns, the
+  // checkpoint thread writes and hashes them in parallel and commits them by a manifest.
   // Write the entire blob data of tensor to the block files on disk:
   void Write(const InputData &input, const DirtyInfo &dirty_info) override;
   // Write the entire blob data composed of multiple tensors to the block files on disk:
@@ -83,9 +88,42 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
   // Create blocks and block metas and write input data to block files.
   void WriteBlockFiles(const std::vector<InputData> &inputs);
 
+  // Create blocks and block metas for the inputs.
+  void CreateBlocks(const std::vector<InputData> &inputs);
+
   // Write shardding data to one specific block file by block index and generate sha256.
   void WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
 
+  // The content of a block file copied from the inputs, and its sha256 computed by the checkpoint thread.
+  struct BlockSnapshot {
+    size_t block_index{0};
+    std::string data;
+    std::string hash_seq;
+  };
+  using Checkpoint = std::vector<BlockSnapshot>;
+
+  // Copy the blocks from the inputs into the staging buffer and hand them to the checkpoint thread.
+  void WriteBlockFilesAsync(const std::vector<int> &block_indices, const std::vector<InputData> &inputs);
+
+  // The loop of the checkpoint thread.
+  void CheckpointLoop();
+
+  // Write the blocks of the checkpoint to the temporary files and hash them in parallel, then write the manifest and
+  // replace the block files.
+  void CommitCheckpoint(Checkpoint *checkpoint);
+
+  // Replace the block files with the temporary files in the manifest and update the hash of the block metas.
+  void ApplyCheckpointManifest(const nlohmann::json &manifest, bool recovering);
+
+  // Finish the checkpoint committed but not applied before the process exited, and drop the uncommitted one.
+  void RecoverCheckpoint();
+
+  // Wait for the staged and running checkpoints, throw the error of them if any.
+  void WaitForCheckpoints();
+
+  // Stop the checkpoint thread after the staged checkpoint is written.
+  void StopCheckpointThread();
+
   // Obtain the corresponding file block index according to dirty info, only need to rewrite these file blocks, and
   // dirty info needs to be sorted in ascending order.
   void TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, std::vector<int> *block_indices) const;
@@ -129,6 +167,21 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
 
   // Record latest used position in latest created block file.
   size_t current_offset_in_block_{0};
+
+  // The following variables are used in the async write mode.
+  bool async_write_{false};
+  std::thread checkpoint_thread_;
+  std::mutex checkpoint_mutex_;
+  std::condition_variable checkpoint_cv_;
+  // Double buffering: one checkpoint is staged while the previous one is being written, and the buffer of the written
+  // one is reused by the next snapshot.
+  std::unique_ptr<Checkpoint> staged_checkpoint_;
+  std::unique_ptr<Checkpoint> free_checkpoint_;
+  bool checkpoint_running_{false};
+  bool stop_checkpoint_{false};
+  std::string checkpoint_error_;
+  // Guards the block metas which are updated by the checkpoint thread.
+  mutable std::mutex block_meta_mutex_;
 };
 }  // namespace storage
 }  // namespace distributed
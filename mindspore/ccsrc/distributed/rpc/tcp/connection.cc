@@ -16,6 +16,7 @@
 
 #include "distributed/rpc/tcp/connection.h"
 
+#include <securec.h>
 #include <memory>
 #include <utility>
 
@@ -32,6 +33,16 @@ static std::mutex kPrintCountMutex;
 const size_t kPrintCountInterval = 1000;
 const int kPrintTimeInterval = 50000;
 
+static void SetMagicId(const char *magic_id, size_t magic_id_len, MessageHeader *header) {
+  for (unsigned int i = 0; i < MAGICID_LEN; i++) {
+    if (i < magic_id_len) {
+      header->magic[i] = magic_id[i];
+    } else {
+      header->magic[i] = '\0';
+    }
+  }
+}
+
 // Handle socket events like read/write.
 void SocketEventHandler(int fd, uint32_t events, void *context) {
   Connection *conn = reinterpret_cast<Connection *>(context);
@@ -159,13 +170,7 @@ Connection::Connection()
   // Initialize the send message header.
   // This variable will be deleted in the `Close` method.
   send_metrics = new SendMetrics();
-  for (unsigned int i = 0; i < MAGICID_LEN; i++) {
-    if (i < sizeof(RPC_MAGICID) - 1) {
-      send_msg_header.magic[i] = RPC_MAGICID[i];
-    } else {
-      send_msg_header.magic[i] = '\0';
-    }
-  }
+  SetMagicId(RPC_MAGICID, sizeof(RPC_MAGICID) - 1, &send_msg_header);
 
   // Initialize the send kernel message structure.
   send_kernel_msg.msg_control = nullptr;
@@ -269,6 +274,9 @@ void Connection::Close() {
     delete send_metrics;
     send_metrics = nullptr;
   }
+
+  send_shm_ring.reset();
+  recv_shm_ring.reset();
 }
 
 int Connection::ReceiveMessage() {
@@ -313,7 +321,8 @@ void Connection::CheckMessageType() {
     }
     return;
   }
-  if (strncmp(RPC_MAGICID, magic_id.c_str(), sizeof(RPC_MAGICID) - 1) == 0) {
+  if (strncmp(RPC_MAGICID, magic_id.c_str(), sizeof(RPC_MAGICID) - 1) == 0 ||
+      strncmp(RPC_SHM_MAGICID, magic_id.c_str(), sizeof(RPC_SHM_MAGICID) - 1) == 0) {
     recv_state = State::kMsgHeader;
     recv_message_type = ParseType::kTcpMsg;
   }
@@ -365,6 +374,7 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_to = msg->to;
       send_from = msg->from;
       FillMessageHeader(*msg, &send_msg_header);
+      SetMagicId(RPC_MAGICID, sizeof(RPC_MAGICID) - 1, &send_msg_header);
 
       send_io_vec[index].iov_base = &send_msg_header;
       send_io_vec[index].iov_len = sizeof(send_msg_header);
@@ -382,11 +392,17 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       // The real size of the data body.
       size_t real_data_size = GetMessageBaseRealDataSize(msg);
       send_io_vec[index].iov_len = real_data_size;
+      if (msg->name == RPC_SHM_ATTACH_MSG_NAME) {
+        SetMagicId(RPC_SHM_MAGICID, sizeof(RPC_SHM_MAGICID) - 1, &send_msg_header);
+      } else if (SendShmPayload(send_io_vec[index].iov_base, real_data_size)) {
+        send_io_vec[index].iov_base = &send_shm_desc;
+        send_io_vec[index].iov_len = sizeof(send_shm_desc);
+      }
       ++index;
       send_kernel_msg.msg_iov = send_io_vec;
       send_kernel_msg.msg_iovlen = index;
-      total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + real_data_size;
+      total_send_len = UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() +
+                       send_io_vec[index - 1].iov_len;
       send_message = msg;
 
       // update metrics
@@ -443,7 +459,15 @@ void Connection::FillRecvMessage() {
   recv_to.resize(recvToLen);
   recv_from.resize(recvFromLen);
 
-  if (allocate_cb_) {
+  // The body of the shared memory message is the descriptor of the payload, which is received in place.
+  if (recv_shm_msg) {
+    if (recvBodyLen != sizeof(recv_shm_desc)) {
+      MS_LOG(ERROR) << "Drop invalid shared memory message, body len: " << recvBodyLen;
+      delete msg;
+      state = ConnectionState::kDisconnecting;
+      return;
+    }
+  } else if (allocate_cb_) {
     void *allocated_mem = allocate_cb_(recvBodyLen);
     msg->data = allocated_mem;
     msg->size = recvBodyLen;
@@ -460,10 +484,15 @@ void Connection::FillRecvMessage() {
   recv_io_vec[i].iov_base = const_cast<char *>(recv_from.data());
   recv_io_vec[i].iov_len = recv_from.size();
   ++i;
-  recv_io_vec[i].iov_base = GetMessageBaseRealData(msg);
-  // The real size of the data body.
-  size_t real_data_size = GetMessageBaseRealDataSize(msg);
-  recv_io_vec[i].iov_len = real_data_size;
+  if (recv_shm_msg) {
+    recv_io_vec[i].iov_base = &recv_shm_desc;
+    recv_io_vec[i].iov_len = sizeof(recv_shm_desc);
+  } else {
+    recv_io_vec[i].iov_base = GetMessageBaseRealData(msg);
+    // The real size of the data body.
+    recv_io_vec[i].iov_len = GetMessageBaseRealDataSize(msg);
+  }
+  size_t real_data_size = recv_io_vec[i].iov_len;
   ++i;
 
   recv_kernel_msg.msg_iov = recv_io_vec;
@@ -544,7 +573,8 @@ bool Connection::ParseMessage() {
       }
       recv_len = 0;
 
-      if (strncmp(recv_msg_header.magic, RPC_MAGICID, sizeof(RPC_MAGICID) - 1) != 0) {
+      recv_shm_msg = (strncmp(recv_msg_header.magic, RPC_SHM_MAGICID, sizeof(RPC_SHM_MAGICID) - 1) == 0);
+      if (!recv_shm_msg && strncmp(recv_msg_header.magic, RPC_MAGICID, sizeof(RPC_MAGICID) - 1) != 0) {
         MS_LOG(ERROR) << "Failed to check magicid, RPC_MAGICID: " << RPC_MAGICID
                       << ", recv magic_id: " << recv_msg_header.magic;
         state = ConnectionState::kDisconnecting;
@@ -569,6 +599,10 @@ bool Connection::ParseMessage() {
         total_recv_len -= recvLen;
         return false;
       }
+      if (recv_shm_msg && !ReceiveShmPayload()) {
+        recv_state = State::kMsgHeader;
+        return false;
+      }
       if (!SetUrlForRecvMessage()) {
         MS_LOG(ERROR) << "Set url info for recv message failed.";
         return false;
@@ -581,6 +615,90 @@ bool Connection::ParseMessage() {
   return true;
 }
 
+bool Connection::InitShmTransport() {
+  if (is_remote || enable_ssl || send_shm_ring != nullptr) {
+    return false;
+  }
+  auto shm_ring = std::make_unique<ShmRing>();
+  if (!shm_ring->Create(kShmRingCapacity)) {
+    return false;
+  }
+
+  MessageBase *msg = new (std::nothrow) MessageBase();
+  MS_EXCEPTION_IF_NULL(msg);
+  msg->name = RPC_SHM_ATTACH_MSG_NAME;
+  msg->from = AID("", source);
+  msg->to = AID("", destination);
+  ShmPayloadDesc attach_desc = shm_ring->AttachDesc();
+  msg->body.assign(reinterpret_cast<const char *>(&attach_desc), sizeof(attach_desc));
+  send_shm_ring = std::move(shm_ring);
+
+  if (total_send_len == 0) {
+    FillSendMessage(msg, source, false);
+  } else {
+    (void)send_message_queue.emplace(msg);
+  }
+  (void)Flush();
+  MS_LOG(INFO) << "Send the shared memory ring attach request to " << destination << ", fd: " << socket_fd;
+  return true;
+}
+
+bool Connection::SendShmPayload(const void *data, size_t size) {
+  if (send_shm_ring == nullptr || size < kShmPayloadMinSize || !send_shm_ring->IsAttached()) {
+    return false;
+  }
+  // Fall back to the socket if the ring is full, the ring is released by the peer in the order of the messages.
+  if (!send_shm_ring->Write(data, size, &send_shm_desc)) {
+    return false;
+  }
+  send_msg_header.body_len = htonl(static_cast<uint32_t>(sizeof(send_shm_desc)));
+  SetMagicId(RPC_SHM_MAGICID, sizeof(RPC_SHM_MAGICID) - 1, &send_msg_header);
+  return true;
+}
+
+bool Connection::ReceiveShmPayload() {
+  MS_EXCEPTION_IF_NULL(recv_message);
+  // The attach request carries no payload and is not passed to the message handler.
+  if (recv_shm_desc.length == 0) {
+    delete recv_message;
+    recv_message = nullptr;
+    auto shm_ring = std::make_unique<ShmRing>();
+    if (recv_shm_ring == nullptr && shm_ring->Attach(recv_shm_desc)) {
+      recv_shm_ring = std::move(shm_ring);
+      MS_LOG(INFO) << "Attached the shared memory ring of " << peer << ", fd: " << socket_fd;
+    } else {
+      MS_LOG(INFO) << "The shared memory ring of " << peer << " is not attached, use the socket only.";
+    }
+    return false;
+  }
+
+  const void *payload = recv_shm_ring == nullptr ? nullptr : recv_shm_ring->Payload(recv_shm_desc);
+  if (payload == nullptr || recv_shm_desc.length > MAX_KMSG_BODY_LEN) {
+    MS_LOG(ERROR) << "Drop invalid shared memory payload, length: " << recv_shm_desc.length;
+    delete recv_message;
+    recv_message = nullptr;
+    state = ConnectionState::kDisconnecting;
+    return false;
+  }
+  size_t length = static_cast<size_t>(recv_shm_desc.length);
+  void *dst = nullptr;
+  if (allocate_cb_) {
+    recv_message->data = allocate_cb_(length);
+    recv_message->size = length;
+    dst = recv_message->data;
+  } else {
+    recv_message->body.resize(length);
+    dst = const_cast<char *>(recv_message->body.data());
+  }
+  MS_EXCEPTION_IF_NULL(dst);
+  auto ret = memcpy_s(dst, length, payload, length);
+  recv_shm_ring->Release(recv_shm_desc);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "Failed to copy the payload out of the shared memory ring, ret: " << ret;
+  }
+  return true;
+}
+
 bool Connection::SetUrlForRecvMessage() {
   auto recv_from_separator_pos = recv_from.find('@');
   auto recv_to_separator_pos = recv_to.find('@');
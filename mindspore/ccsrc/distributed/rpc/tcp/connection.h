@@ -26,6 +26,7 @@
 #include "include/backend/distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/event_loop.h"
 #include "distributed/rpc/tcp/socket_operation.h"
+#include "distributed/rpc/tcp/shm_ring.h"
 
 namespace mindspore {
 namespace distributed {
@@ -105,6 +106,10 @@ struct Connection {
 
   void FillRecvMessage();
 
+  // Create the shared memory ring of this client connection and ask the peer on the same host to attach it. The large
+  // payloads go through the ring once the peer attached it, and through the socket otherwise.
+  bool InitShmTransport();
+
   bool IsSame(const Connection *that) {
     return !(that != nullptr && that->destination == destination && that->is_remote == is_remote);
   }
@@ -235,6 +240,16 @@ struct Connection {
   // The method used to free the memory after client sending data to the remote.
   MemFreeCallback free_cb_;
 
+  // The shared memory ring created by the client side to send the large payloads.
+  std::unique_ptr<ShmRing> send_shm_ring;
+  // The shared memory ring of the client attached by the server side to receive the large payloads.
+  std::unique_ptr<ShmRing> recv_shm_ring;
+
+  // The descriptors of the payloads in the shared memory rings, which are the bodies of the messages on the socket.
+  ShmPayloadDesc send_shm_desc;
+  ShmPayloadDesc recv_shm_desc;
+  bool recv_shm_msg{false};
+
  private:
   // Add handler for socket connect event.
   int AddConnnectEventHandler();
@@ -242,6 +257,13 @@ struct Connection {
   // Parse message from socket recv buffer.
   bool ParseMessage();
 
+  // Attach the shared memory ring or copy the payload out of it after the descriptor is received, return false if
+  // there is no message for the handler.
+  bool ReceiveShmPayload();
+
+  // Write the payload into the shared memory ring and point the message body to its descriptor if possible.
+  bool SendShmPayload(const void *data, size_t size);
+
   // After ParseMessage, set from url and to url into recv message.
   bool SetUrlForRecvMessage();
 
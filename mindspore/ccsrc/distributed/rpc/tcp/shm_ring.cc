@@ -0,0 +1,182 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/tcp/shm_ring.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <securec.h>
+#include <cerrno>
+#include <new>
+#include <random>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+constexpr uint64_t kShmRingMagic = 0x5250435348524e47;
+// The data area starts at the page after the header.
+constexpr size_t kShmRingHeaderSize = 4096;
+}  // namespace
+
+struct ShmRing::Header {
+  uint64_t magic;
+  uint64_t token;
+  uint64_t capacity;
+  // Written by the consumer when the payloads are released.
+  alignas(64) std::atomic<uint64_t> read_pos;
+  // Set by the consumer when it attached the ring.
+  std::atomic<uint32_t> attached;
+};
+
+ShmRing::~ShmRing() {
+  if (header_ != nullptr && shmdt(header_) != 0) {
+    MS_LOG(WARNING) << "Failed to detach the shared memory ring " << shm_id_ << ", errno: " << errno;
+  }
+  header_ = nullptr;
+  data_ = nullptr;
+}
+
+bool ShmRing::Create(size_t capacity) {
+  static_assert(sizeof(Header) <= kShmRingHeaderSize, "The header of the shared memory ring is too large.");
+  if (header_ != nullptr || capacity == 0) {
+    return false;
+  }
+  int shm_id = shmget(IPC_PRIVATE, kShmRingHeaderSize + capacity, IPC_CREAT | 0600);
+  if (shm_id < 0) {
+    MS_LOG(WARNING) << "Failed to create the shared memory ring of size " << capacity << ", errno: " << errno;
+    return false;
+  }
+  void *addr = shmat(shm_id, nullptr, 0);
+  // Mark the segment removed at once so it never outlives both ends, Linux still allows attaching it by the id.
+  if (shmctl(shm_id, IPC_RMID, nullptr) != 0) {
+    MS_LOG(WARNING) << "Failed to mark the shared memory ring " << shm_id << " removed, errno: " << errno;
+  }
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory ring " << shm_id << ", errno: " << errno;
+    return false;
+  }
+
+  std::random_device rd;
+  header_ = new (addr) Header();
+  header_->magic = kShmRingMagic;
+  header_->token = (static_cast<uint64_t>(rd()) << 32) | rd();
+  header_->capacity = capacity;
+  header_->read_pos.store(0, std::memory_order_relaxed);
+  header_->attached.store(0, std::memory_order_release);
+  shm_id_ = shm_id;
+  data_ = reinterpret_cast<uint8_t *>(addr) + kShmRingHeaderSize;
+  capacity_ = capacity;
+  write_pos_ = 0;
+  return true;
+}
+
+bool ShmRing::Attach(const ShmPayloadDesc &desc) {
+  if (header_ != nullptr || desc.shm_id < 0) {
+    return false;
+  }
+  // Check the size before touching the segment, the id may belong to another segment in this IPC namespace.
+  struct shmid_ds stat;
+  if (shmctl(desc.shm_id, IPC_STAT, &stat) != 0 || stat.shm_segsz < kShmRingHeaderSize) {
+    MS_LOG(WARNING) << "The shared memory ring " << desc.shm_id << " is not accessible, errno: " << errno;
+    return false;
+  }
+  void *addr = shmat(desc.shm_id, nullptr, 0);
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory ring " << desc.shm_id << ", errno: " << errno;
+    return false;
+  }
+  auto header = reinterpret_cast<Header *>(addr);
+  if (header->magic != kShmRingMagic || header->token != desc.token ||
+      header->capacity + kShmRingHeaderSize > stat.shm_segsz) {
+    MS_LOG(WARNING) << "The shared memory segment " << desc.shm_id << " is not the ring of the peer.";
+    (void)shmdt(addr);
+    return false;
+  }
+
+  header_ = header;
+  shm_id_ = desc.shm_id;
+  data_ = reinterpret_cast<uint8_t *>(addr) + kShmRingHeaderSize;
+  capacity_ = header->capacity;
+  header_->attached.store(1, std::memory_order_release);
+  return true;
+}
+
+ShmPayloadDesc ShmRing::AttachDesc() const {
+  ShmPayloadDesc desc;
+  if (header_ != nullptr) {
+    desc.shm_id = shm_id_;
+    desc.token = header_->token;
+  }
+  return desc;
+}
+
+bool ShmRing::IsAttached() const {
+  return header_ != nullptr && header_->attached.load(std::memory_order_acquire) != 0;
+}
+
+bool ShmRing::Write(const void *data, size_t size, ShmPayloadDesc *desc) {
+  if (header_ == nullptr || data == nullptr || desc == nullptr || size == 0 || size > capacity_) {
+    return false;
+  }
+  // A payload never wraps around, the tail of the ring is skipped if it is too small.
+  uint64_t pos = write_pos_;
+  uint64_t offset = pos % capacity_;
+  if (offset + size > capacity_) {
+    pos += capacity_ - offset;
+    offset = 0;
+  }
+  uint64_t end_pos = pos + size;
+  if (end_pos - header_->read_pos.load(std::memory_order_acquire) > capacity_) {
+    return false;
+  }
+  auto ret = memcpy_s(data_ + offset, capacity_ - offset, data, size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "Failed to copy the payload into the shared memory ring, ret: " << ret;
+    return false;
+  }
+  // The descriptor is sent after the payload is visible to the consumer.
+  std::atomic_thread_fence(std::memory_order_release);
+  write_pos_ = end_pos;
+
+  desc->shm_id = shm_id_;
+  desc->token = header_->token;
+  desc->offset = offset;
+  desc->length = size;
+  desc->end_pos = end_pos;
+  return true;
+}
+
+const void *ShmRing::Payload(const ShmPayloadDesc &desc) const {
+  if (header_ == nullptr || desc.shm_id != shm_id_ || desc.token != header_->token || desc.length == 0 ||
+      desc.offset + desc.length > capacity_) {
+    return nullptr;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return data_ + desc.offset;
+}
+
+void ShmRing::Release(const ShmPayloadDesc &desc) {
+  if (header_ == nullptr) {
+    return;
+  }
+  header_->read_pos.store(desc.end_pos, std::memory_order_release);
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
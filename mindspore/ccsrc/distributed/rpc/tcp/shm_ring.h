@@ -0,0 +1,93 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_RING_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// The default byte size of the data area of a shared memory ring.
+constexpr size_t kShmRingCapacity = 64 << 20;
+// The payloads smaller than this size are cheaper to send through the socket directly.
+constexpr size_t kShmPayloadMinSize = 64 << 10;
+
+/*
+ * The ShmPayloadDesc is sent through the socket as the message body instead of the payload written into the ring.
+ * A descriptor with zero length is the attach request which carries the ring to the receiver.
+ */
+struct ShmPayloadDesc {
+  int32_t shm_id{-1};
+  uint32_t reserved{0};
+  // The random token of the ring, which guards against attaching another segment with the same id.
+  uint64_t token{0};
+  uint64_t offset{0};
+  uint64_t length{0};
+  // The read position of the ring after the payload is released.
+  uint64_t end_pos{0};
+};
+
+/*
+ * A single producer single consumer byte ring in a SysV shared memory segment. The sender of a connection creates the
+ * ring and writes the large payloads into it, the receiver attaches it by the attach request and releases the
+ * payloads in the order they are written.
+ */
+class ShmRing {
+ public:
+  ShmRing() = default;
+  ~ShmRing();
+  ShmRing(const ShmRing &) = delete;
+  ShmRing &operator=(const ShmRing &) = delete;
+
+  // Create a new ring as the producer, return false if the shared memory is not available.
+  bool Create(size_t capacity);
+  // Attach the ring in the attach request as the consumer, return false if it is not the ring of the producer, eg.
+  // the producer lives in another IPC namespace.
+  bool Attach(const ShmPayloadDesc &desc);
+
+  // The attach request of the producer.
+  ShmPayloadDesc AttachDesc() const;
+  // Whether the consumer has attached the ring.
+  bool IsAttached() const;
+
+  // Copy the payload into the ring and fill its descriptor, return false if the ring has no room for it.
+  bool Write(const void *data, size_t size, ShmPayloadDesc *desc);
+  // The payload of the descriptor in the ring, nullptr if the descriptor is invalid.
+  const void *Payload(const ShmPayloadDesc &desc) const;
+  // Give the room of the payload and all the payloads before it back to the producer.
+  void Release(const ShmPayloadDesc &desc);
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct Header;
+
+  int shm_id_{-1};
+  Header *header_{nullptr};
+  uint8_t *data_{nullptr};
+  size_t capacity_{0};
+  // The write position is only touched by the producer, the read position lives in the shared header.
+  uint64_t write_pos_{0};
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_RING_H_
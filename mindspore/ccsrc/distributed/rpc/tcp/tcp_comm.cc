@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "actor/aid.h"
+#include "utils/ms_utils.h"
 #include "include/backend/distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 
@@ -42,6 +43,12 @@ void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   return;
 }
 
+// Whether the peer of the client connection lives on the same host, so that the shared memory transport applies.
+static bool IsSameHost(const std::string &dst_ip, const std::string &src_ip) {
+  const std::string loopback_prefix = "127.";
+  return dst_ip == src_ip || dst_ip == "localhost" || dst_ip.compare(0, loopback_prefix.size(), loopback_prefix) == 0;
+}
+
 void ConnectedEventHandler(int fd, uint32_t events, void *context) {
   uint32_t error = events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP);
   int soError = 0;
@@ -470,6 +477,12 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
     }
     conn_pool_->AddConnection(conn);
     conn->SetMessageFreeCallback(free_cb);
+
+    // The large payloads to the peer on the same host go through a shared memory ring instead of the socket.
+    if (!enable_ssl_ && common::GetEnv(kEnvRpcShmTransport) != "0" &&
+        IsSameHost(SocketOperation::GetIP(dst_url), dst_url_to_src_ip_[dst_url])) {
+      (void)conn->InitShmTransport();
+    }
   }
   conn_pool_->AddConnInfo(conn->socket_fd, dst_url, nullptr);
   MS_LOG(INFO) << "Connected to destination: " << dst_url;
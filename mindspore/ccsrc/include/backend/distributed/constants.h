@@ -60,6 +60,9 @@ const std::set<std::string> kValidRoleName = {kEnvRoleOfServer, kEnvRoleOfPServe
 // Denote which ip address is used for cluster building.
 constexpr char kEnvWorkerIp[] = "MS_WORKER_IP";
 
+// Set to "0" to send the messages between the processes on the same host through the socket only.
+constexpr char kEnvRpcShmTransport[] = "MS_RPC_SHM_TRANSPORT";
+
 // Used in parameter server embedding cache scenarios to identify the same Parameter between Worker and Server.
 constexpr char kParameterKey[] = "parameter_key";
 // Embedding cache lookup operation.
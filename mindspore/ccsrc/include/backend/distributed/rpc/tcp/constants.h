@@ -73,6 +73,10 @@ static const int SOCKET_KEEPINTERVAL = 5;
 static const int SOCKET_KEEPCOUNT = 3;
 
 static const char RPC_MAGICID[] = "RPC0";
+// The magic id of the messages whose body is the descriptor of a payload in the shared memory ring.
+static const char RPC_SHM_MAGICID[] = "RPC1";
+// The name of the message which asks the peer to attach the shared memory ring of the connection.
+static const char RPC_SHM_ATTACH_MSG_NAME[] = "__rpc_shm_attach__";
 static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
 static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
 
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <map>
@@ -34,6 +35,7 @@
 
 #include "utils/ms_utils.h"
 #include "include/backend/visible.h"
+#include "include/backend/mem_reuse/mem_dynamic_thread_cache.h"
 #include "include/common/utils/stream_util.h"
 #include "ir/device_event.h"
 #ifdef __APPLE__
@@ -120,6 +122,8 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   size_t TotalEagerFreeMemStatistics() const;
   size_t UsedMemPeakStatistics() const;
   size_t ActualPeakStatistics() const;
+  // The statistics information of the thread cache, all zero if the thread cache is not enabled.
+  ThreadCacheStats ThreadCacheStatistics() const;
 
   // Display the brief state information of memory block and memory buf.
   void DumpDynamicMemPoolStateInfo();
@@ -161,8 +165,12 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   virtual size_t AllocDeviceMemByEagerFree(size_t size, DeviceMemPtr *addr) { return 0; }
   virtual size_t FreeDeviceMemByEagerFree(const DeviceMemPtr addr, const size_t size) { return 0; }
   const size_t FreeIdleMemsByEagerFree();
+  // Whether the small memory of the default stream is served by a per thread cache in front of the pool.
+  virtual const bool IsEnableThreadCache() const { return false; }
 
  private:
+  // Alloc memory from the best fit pool, bypassing the thread cache.
+  DeviceMemPtr AllocTensorMemFromPool(size_t size, bool from_persistent_mem, bool need_recycle, uint32_t stream_id);
   // Find available memory buf from total pools by status, which contains idle and eager free.
   DeviceMemPtr FindAvailableMemBuf(size_t size, bool from_persistent_mem, uint32_t stream_id);
   // Find the target status memory buf from total pools by aligned size when memory alloc.
@@ -210,6 +218,8 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   DynamicMemBufPtr FindMemBufByKeepAddr(const DeviceMemPtr &device_addr, const DynamicMemBlockPtr &mem_block) const;
   // Sync all events inner without lock.
   bool SyncAllEventsInner();
+  // Get the thread cache, which is created at the first call, nullptr if it is not enabled.
+  DynamicMemThreadCache *GetThreadCache();
 
 #ifdef __APPLE__
   // There are some problems with using mutex on Mac, use spinlocks instead.
@@ -228,6 +238,11 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
 
   // key : <user_stream_id, memory_stream_id>
   std::unordered_map<std::pair<uint32_t, uint32_t>, std::set<DynamicMemBufPtr>, pair_hash> stream_pair_addresses_;
+
+  std::once_flag thread_cache_init_flag_;
+  std::unique_ptr<DynamicMemThreadCache> thread_cache_holder_{nullptr};
+  // Read by the frees without the lock, it is only set once.
+  std::atomic<DynamicMemThreadCache *> thread_cache_{nullptr};
 };
 
 // Recording information for debugging the memory allocator.
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_THREAD_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_THREAD_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace device {
+using DeviceMemPtr = void(*);
+
+// The largest aligned size served by the thread cache, the larger ones go to the best fit pool directly.
+constexpr size_t kThreadCacheMaxSize = 64 << 10;
+// The thread cache carves the memory of a size class out of spans of this size taken from the best fit pool.
+constexpr size_t kThreadCacheSpanSize = 2 << 20;
+// The spans are aligned to pages of this size, so that the size class of an address is found by its page.
+constexpr size_t kThreadCachePageSize = 64 << 10;
+// The bytes moved between a thread and the central free lists at a time.
+constexpr size_t kThreadCacheBatchBytes = 256 << 10;
+
+// The statistics information of the thread cache.
+struct ThreadCacheStats {
+  // Allocations served from the free list of the thread.
+  size_t hit_count_{0};
+  // Allocations which refilled the free list of the thread from the central free lists first.
+  size_t miss_count_{0};
+  // Memory bufs freed to the free list of the thread.
+  size_t free_count_{0};
+  // Batches flushed from the free lists of the threads to the central free lists.
+  size_t flush_count_{0};
+  // Memory taken from the best fit pool as spans.
+  size_t span_mem_size_{0};
+  // Memory idle in the free lists of the threads and the central free lists.
+  size_t cached_mem_size_{0};
+
+  double HitRate() const {
+    size_t total = hit_count_ + miss_count_;
+    return total == 0 ? 0 : static_cast<double>(hit_count_) / total;
+  }
+};
+
+// A tcmalloc style front end of the best fit pool for the small allocations. Every thread keeps a free list per size
+// class, which is refilled from and flushed to the central free lists in batches, so most of the small allocations
+// and frees neither take the lock of the pool nor search its multimap. The memory of a size class is carved from
+// spans which stay allocated in the best fit pool until the device resource is released.
+class BACKEND_EXPORT DynamicMemThreadCache {
+ public:
+  // The span allocator takes memory of the given size from the best fit pool, nullptr if failed.
+  using SpanAllocator = std::function<DeviceMemPtr(size_t)>;
+
+  explicit DynamicMemThreadCache(const SpanAllocator &span_allocator);
+  ~DynamicMemThreadCache();
+
+  // Whether the aligned size is served by the thread cache.
+  static bool IsCacheable(size_t align_size) { return align_size <= kThreadCacheMaxSize; }
+  // Alloc memory of the aligned size, nullptr if no span can be taken from the best fit pool.
+  DeviceMemPtr Alloc(size_t align_size);
+  // Free the memory if it belongs to the thread cache, return false otherwise.
+  bool Free(const DeviceMemPtr &device_addr);
+  // Drop all the cached memory and spans, the memory of the best fit pool is released by the caller.
+  void Clear();
+
+  ThreadCacheStats Statistics() const;
+
+ private:
+  struct LocalCache;
+  struct Central;
+
+  LocalCache *GetLocalCache();
+  // Take a batch of the size class into the free list of the thread, the caller holds the lock of the local cache.
+  bool Refill(size_t size_class, LocalCache *local_cache);
+  // Give a batch of the size class of the thread back to the central free lists.
+  void Flush(size_t size_class, LocalCache *local_cache);
+  // Carve a new span for the size class into the central free lists, the caller holds the lock of the central.
+  bool AddSpan(size_t size_class, std::unique_lock<std::mutex> *central_lock);
+  // The size class of the memory, -1 if it is not carved from a span. Takes no lock, so frees do not contend.
+  int FindSizeClass(const DeviceMemPtr &device_addr) const;
+
+  std::shared_ptr<Central> central_;
+};
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_THREAD_CACHE_H_
@@ -28,6 +28,7 @@
 namespace mindspore {
 constexpr char kGraphCacheSubDir[] = "graph_cache";
 constexpr char kBackendGraphCacheSubDir[] = "backend_graph_cache";
+constexpr char kBackendKernelSelectCacheSubDir[] = "backend_kernel_select_cache";
 constexpr char kCompileCacheFileName[] = "compile_cache";
 constexpr char kBackendCompileCacheFileName[] = "backend_compile_cache";
 constexpr char kMindIrSuffix[] = ".mindir";
@@ -69,6 +69,8 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_enable_autotune_model", &ConfigManager::set_enable_autotune_model)
+                    .def("get_enable_autotune_model", &ConfigManager::enable_autotune_model)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
@@ -81,6 +83,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_debug_mode", &ConfigManager::get_debug_mode)
                     .def("set_error_samples_mode", &ConfigManager::set_error_samples_mode)
                     .def("get_error_samples_mode", &ConfigManager::get_error_samples_mode)
+                    .def("set_enable_mindrecord_mmap", &ConfigManager::set_enable_mindrecord_mmap)
+                    .def("get_enable_mindrecord_mmap", &ConfigManager::enable_mindrecord_mmap)
+                    .def("set_global_shuffle_window", &ConfigManager::set_global_shuffle_window)
+                    .def("get_global_shuffle_window", &ConfigManager::global_shuffle_window)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -93,6 +93,8 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_num_connections(j.value("numConnections", num_connections_));
   set_cache_prefetch_size(j.value("cachePrefetchSize", cache_prefetch_size_));
   set_debug_mode(j.value("debug_mode_flag", debug_mode_flag_));
+  set_enable_mindrecord_mmap(j.value("enable_mindrecord_mmap", enable_mindrecord_mmap_));
+  set_global_shuffle_window(j.value("global_shuffle_window", global_shuffle_window_));
   return Status::OK();
 }
 
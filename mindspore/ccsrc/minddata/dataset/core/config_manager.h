@@ -260,6 +260,14 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // setter function
+  // @param enable - To tune all the ops at once from a throughput model fitted in the first epoch
+  void set_enable_autotune_model(bool enable) { enable_autotune_model_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether autotune uses the throughput model instead of the per op heuristics
+  bool enable_autotune_model() const { return enable_autotune_model_; }
+
   // setter function
   // @param enable - To enable watchdog python thread
   void set_enable_watchdog(bool enable) { enable_watchdog_ = enable; }
@@ -320,6 +328,22 @@ class ConfigManager {
   // @notes This method is used for internal processing, using enum type
   ErrorSamplesMode error_samples_mode() const { return error_samples_mode_; }
 
+  // setter function
+  // @param enable - Set whether MindRecord blob data is read through memory mapped files
+  void set_enable_mindrecord_mmap(const bool enable) { enable_mindrecord_mmap_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether MindRecord blob data is read through memory mapped files
+  bool enable_mindrecord_mmap() const { return enable_mindrecord_mmap_; }
+
+  // setter function
+  // @param window - Number of row ids kept in memory by the global shuffle of mappable datasets, 0 to disable it
+  void set_global_shuffle_window(const int64_t window) { global_shuffle_window_ = window; }
+
+  // getter function
+  // @return - Number of row ids kept in memory by the global shuffle of mappable datasets, 0 if it is disabled
+  int64_t global_shuffle_window() const { return global_shuffle_window_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -350,6 +374,7 @@ class ConfigManager {
   bool enable_autotune_;
   bool save_autoconfig_;  // True if should save AutoTune configuration
   int64_t autotune_interval_;
+  bool enable_autotune_model_{false};  // Tune from a throughput model of the ops instead of per op heuristics
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
@@ -357,6 +382,8 @@ class ConfigManager {
   bool fast_recovery_{true};     // Used for failover scenario to recover quickly or produce same augmentations
   bool debug_mode_flag_{false};  // Indicator for debug mode
   ErrorSamplesMode error_samples_mode_{ErrorSamplesMode::kReturn};  // The method to process erroneous samples
+  bool enable_mindrecord_mmap_{false};  // Read MindRecord blob data through memory mapped files
+  int64_t global_shuffle_window_{0};    // Replace shuffle over mappable sources by a windowed global shuffle
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -63,7 +63,11 @@ namespace dataset {
 Tensor::Tensor(TensorShape shape, DataType type) : shape_(std::move(shape)), type_(type), data_(nullptr) {}
 
 Tensor::Tensor(Tensor &&other) noexcept
-    : shape_(std::move(other.shape_)), type_(other.type_), data_(other.data_), data_end_(other.data_end_) {
+    : shape_(std::move(other.shape_)),
+      type_(other.type_),
+      data_(other.data_),
+      data_end_(other.data_end_),
+      data_owner_(std::move(other.data_owner_)) {
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -85,6 +89,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     data_ = other.data_;
     data_end_ = other.data_end_;
     yuv_shape_ = std::move(other.yuv_shape_);
+    data_owner_ = std::move(other.data_owner_);
 #ifdef ENABLE_PYTHON
     if (type_.value() == DataType::DE_PYTHON) {
       py::gil_scoped_acquire gil_acquire;
@@ -151,6 +156,25 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryNoCopy(const TensorShape &shape, const DataType &type, const uchar *src,
+                                      std::shared_ptr<void> owner, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Failed to create tensor view, tensor shape is unknown.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Failed to create tensor view, data type should be numeric.");
+  CHECK_FAIL_RETURN_UNEXPECTED(owner != nullptr, "Failed to create tensor view, owner of the memory is null.");
+  *out = std::make_shared<Tensor>(shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED(out != nullptr, "Allocate memory failed.");
+  int64_t byte_size = (*out)->SizeInBytes();
+  if (byte_size == 0) {
+    return Status::OK();
+  }
+  RETURN_UNEXPECTED_IF_NULL(src);
+  (*out)->data_ = const_cast<uchar *>(src);
+  (*out)->data_end_ = (*out)->data_ + byte_size;
+  (*out)->data_owner_ = std::move(owner);
+  return Status::OK();
+}
+
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, const dsize_t &length,
                                 TensorPtr *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
@@ -458,6 +482,12 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
+  if (data_owner_ != nullptr) {
+    // the data is viewed from an external owner, only drop the reference
+    data_ = nullptr;
+    data_end_ = nullptr;
+    data_owner_.reset();
+  }
 #ifdef ENABLE_PYTHON
   if (!static_cast<bool>(python_array_)) {  // the data is not np.ndarray from python layer
 #endif
@@ -627,6 +657,33 @@ Status Tensor::AllocateBuffer(const dsize_t &length) {
   return Status::OK();
 }
 
+Status Tensor::DetachFromOwner() {
+  if (data_owner_ == nullptr) {
+    return Status::OK();
+  }
+  uchar *viewed_data = data_;
+  uchar *viewed_data_end = data_end_;
+  int64_t byte_size = viewed_data_end - viewed_data;
+  data_ = nullptr;
+  data_end_ = nullptr;
+  Status rc = AllocateBuffer(byte_size);
+  if (rc.IsError()) {
+    data_ = viewed_data;
+    data_end_ = viewed_data_end;
+    return rc;
+  }
+  // the tensor owns its buffer from here on, the owner is only kept alive until the data is copied
+  std::shared_ptr<void> owner = std::move(data_owner_);
+  if (byte_size < SECUREC_MEM_MAX_LEN) {
+    int ret_code = memcpy_s(data_, byte_size, viewed_data, byte_size);
+    CHECK_FAIL_RETURN_UNEXPECTED(ret_code == EOK, "Failed to copy the viewed data into tensor.");
+  } else {
+    auto ret_code = std::memcpy(data_, viewed_data, byte_size);
+    CHECK_FAIL_RETURN_UNEXPECTED(ret_code == data_, "Failed to copy the viewed data into tensor.");
+  }
+  return Status::OK();
+}
+
 Status Tensor::Reshape(const TensorShape &shape) {
   if (shape.NumOfElements() == shape_.NumOfElements()) {
     shape_ = shape;
@@ -642,6 +699,7 @@ void Tensor::Invalidate() {
   type_ = DataType(DataType::DE_UNKNOWN);
   data_ = nullptr;
   data_end_ = nullptr;
+  data_owner_.reset();
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -107,6 +107,19 @@ class DATASET_API Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor which views memory owned by someone else, no data is copied.
+  /// \note The memory must stay valid while `owner` is alive, the tensor keeps a reference to `owner`.
+  ///     The viewed memory is never written, the tensor copies the data into its own buffer on the first mutable
+  ///     access (GetMutableBuffer, SetItemAt, Fill, begin/end ...) and then drops `owner`.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, must be numeric
+  /// \param[in] src pointer to the source data
+  /// \param[in] owner object which owns the memory pointed by src
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryNoCopy(const TensorShape &shape, const DataType &type, const uchar *src,
+                                       std::shared_ptr<void> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -344,6 +357,7 @@ class DATASET_API Tensor {
   /// \param[in] value of type `T`
   template <typename T>
   Status SetItemAt(const std::vector<dsize_t> &index, const T &value) {
+    RETURN_IF_NOT_OK(DetachFromOwner());
     T *ptr = nullptr;
     RETURN_IF_NOT_OK(GetItemPtr<T>(&ptr, index));
     *ptr = value;
@@ -354,6 +368,7 @@ class DATASET_API Tensor {
   /// \param[in] index
   /// \param[in] value of type std::string
   Status SetItemAt(const std::vector<dsize_t> &index, const std::string &value) {
+    RETURN_IF_NOT_OK(DetachFromOwner());
     RETURN_UNEXPECTED_IF_NULL(data_);
     uchar *ptr = nullptr;
     offset_t length = 0;
@@ -382,6 +397,7 @@ class DATASET_API Tensor {
   template <typename T>
   Status Fill(const T &value) {
     CHECK_FAIL_RETURN_UNEXPECTED(!type_.IsString(), "Can not fill on tensor of type string or bytes.");
+    RETURN_IF_NOT_OK(DetachFromOwner());
     const int64_t cellSize = type_.SizeInBytes();
     if ((data_ != nullptr) && type_.IsCompatible<T>()) {
       for (dsize_t i = 0; i < Size(); i++) {
@@ -772,7 +788,7 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> begin() {
-    return TensorIterator<T>(data_);
+    return DetachFromOwner().IsOk() ? TensorIterator<T>(data_) : TensorIterator<T>(nullptr);
   }
 
   /// Return a linear iterator that points to the place after the last element of the Tensor.
@@ -780,7 +796,7 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> end() {
-    return TensorIterator<T>(data_end_);
+    return DetachFromOwner().IsOk() ? TensorIterator<T>(data_end_) : TensorIterator<T>(nullptr);
   }
 
   /// Copies the last dimension at `index` from Tensor `src` to this Tensor.
@@ -790,9 +806,9 @@ class DATASET_API Tensor {
   Status CopyLastDimAt(const std::shared_ptr<Tensor> &src, const std::vector<dsize_t> &index);
 
   /// Get the starting memory address for the data of the tensor.  This potentially
-  /// drives an allocation if the data is null.
-  /// \return unsigned char*
-  unsigned char *GetMutableBuffer() { return data_; }
+  /// drives an allocation if the data is null or viewed from an external owner.
+  /// \return unsigned char*, null if the viewed data can not be copied
+  unsigned char *GetMutableBuffer() { return DetachFromOwner().IsOk() ? data_ : nullptr; }
 
  protected:
   /// Allocate memory for the tensor using the data_allocator
@@ -800,6 +816,11 @@ class DATASET_API Tensor {
   /// \return Error Status
   Status AllocateBuffer(const dsize_t &length);
 
+  /// Copy the data viewed from an external owner into a buffer of the tensor and drop the owner, the viewed
+  /// memory may be read-only or shared by other tensors. Does nothing if the tensor owns its data.
+  /// \return Error Status
+  Status DetachFromOwner();
+
   /// A function that prints Tensor recursively, first called by print
   /// \param[in] out
   /// \param[in] cur_dim
@@ -860,6 +881,9 @@ class DATASET_API Tensor {
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
 
+  /// Hold the owner of the memory when the data is viewed without memcpy, see CreateFromMemoryNoCopy
+  std::shared_ptr<void> data_owner_;
+
 #ifdef ENABLE_PYTHON
   /// Store python dictionary wrapper
   py::object python_dict_;
@@ -443,13 +443,15 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
-                  << std::endl;
+                  << std::setw(12) << "Mem hit" << std::setw(12) << "Disk hit" << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
           std::string stat_mem_cached;
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_mem_hit;
+          std::string stat_disk_hit;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -460,10 +462,15 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          stat_mem_hit =
+            (curr_session.stats.num_mem_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_mem_hit);
+          stat_disk_hit =
+            (curr_session.stats.num_disk_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_disk_hit);
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(12) << stat_mem_hit << std::setw(12)
+                    << stat_disk_hit << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
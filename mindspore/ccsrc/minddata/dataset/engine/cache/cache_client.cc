@@ -17,6 +17,7 @@
 #include "minddata/dataset/engine/cache/cache_client.h"
 #include "minddata/dataset/engine/cache/cache_fbb.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
 #include "minddata/dataset/util/bit.h"
 #include "minddata/dataset/util/task_manager.h"
 
@@ -62,13 +63,16 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
-      fetch_all_keys_(true) {
+      fetch_all_keys_(true),
+      ring_(nullptr),
+      ring_failed_(false) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname, port, num_connections_);
 }
 
 CacheClient::~CacheClient() {
   cache_miss_keys_wp_.Set();
+  ReleaseRing();
   // Manually release the async buffer because we need the comm layer.
   if (async_buffer_stream_) {
     Status rc = async_buffer_stream_->ReleaseBuffer();
@@ -129,15 +133,14 @@ Status CacheClient::AsyncWriteRow(const TensorRow &row) {
 Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto rq = std::make_shared<BatchFetchRequest>(this, row_id);
-  RETURN_IF_NOT_OK(PushRequest(rq));
+  RETURN_IF_NOT_OK(SendBatchFetch(rq, row_id));
   RETURN_IF_NOT_OK(rq->Wait());
   int64_t mem_addr;
   Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
   // Free the memory by sending a request back to the server.
   if (mem_addr != -1) {
-    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, mem_addr);
-    Status rc2 = PushRequest(mfree_req);
     // But we won't wait for the result for the sake of performance.
+    Status rc2 = FreeSharedBlock(mem_addr);
     if (rc.IsOk() && rc2.IsError()) {
       rc = rc2;
     }
@@ -145,6 +148,78 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   return rc;
 }
 
+Status CacheClient::SendBatchFetch(const std::shared_ptr<BatchFetchRequest> &rq,
+                                   const std::vector<row_id_type> &row_id) const {
+  if (ring_ == nullptr || ring_failed_ || row_id.empty() || row_id.size() > static_cast<size_t>(kCacheRingMaxRows)) {
+    return PushRequest(rq);
+  }
+  // The reply is filled in as if it came back through grpc, so the rows are restored the same way.
+  BaseRequest *base_rq = rq.get();
+  Status rc = ring_->BatchFetch(row_id, &base_rq->reply_);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Cache ring stops working, fetching rows through grpc instead. " << rc;
+    ring_failed_ = true;
+    return PushRequest(rq);
+  }
+  base_rq->wp_.Set();
+  return Status::OK();
+}
+
+Status CacheClient::FreeSharedBlock(int64_t addr) const {
+  if (ring_ != nullptr && !ring_failed_) {
+    Status rc = ring_->FreeBlock(addr);
+    if (rc.IsOk()) {
+      return rc;
+    }
+    MS_LOG(WARNING) << "Cache ring stops working, freeing memory through grpc instead. " << rc;
+    ring_failed_ = true;
+  }
+  auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, addr);
+  return PushRequest(mfree_req);
+}
+
+Status CacheClient::InitRing() {
+  // The ring needs to start on a cache line. The base of the shared memory is page aligned.
+  auto mem_rq = std::make_shared<AllocateSharedBlockRequest>(server_connection_id_, client_id_,
+                                                             sizeof(CacheRing) + kCacheRingAlignment);
+  RETURN_IF_NOT_OK(PushRequest(mem_rq));
+  RETURN_IF_NOT_OK(mem_rq->Wait());
+  int64_t block = mem_rq->GetAddr();
+  const auto alignment = static_cast<int64_t>(kCacheRingAlignment);
+  int64_t addr = (block + alignment - 1) & ~(alignment - 1);
+  auto *base = SharedMemoryBaseAddr();
+  auto *ring = CacheRing::CreateInPlace(reinterpret_cast<void *>(reinterpret_cast<int64_t>(base) + addr));
+  // Once registered, the block is freed by the server when it stops serving the ring.
+  auto rq = std::make_shared<RegisterRingRequest>(server_connection_id_, client_id_, addr, block);
+  Status rc = PushRequest(rq);
+  if (rc.IsOk()) {
+    rc = rq->Wait();
+  }
+  if (rc.IsError()) {
+    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, block);
+    (void)PushRequest(mfree_req);
+    return rc;
+  }
+  ring_ = ring;
+  return Status::OK();
+}
+
+void CacheClient::ReleaseRing() {
+  if (ring_ == nullptr) {
+    return;
+  }
+  // The server frees the block of the ring once no ring worker is looking at it any more.
+  auto rq = std::make_shared<UnregisterRingRequest>(server_connection_id_, client_id_);
+  Status rc = PushRequest(rq);
+  if (rc.IsOk()) {
+    rc = rq->Wait();
+  }
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << rc;
+  }
+  ring_ = nullptr;
+}
+
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
@@ -214,6 +289,11 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
       if (local_bypass_) {
         async_buffer_stream_ = std::make_shared<AsyncBufferStream>();
         RETURN_IF_NOT_OK(async_buffer_stream_->Init(this));
+        // Without the ring the rows are still fetched through grpc.
+        Status ring_rc = InitRing();
+        if (ring_rc.IsError()) {
+          MS_LOG(WARNING) << "Cache ring is not in use. " << ring_rc;
+        }
       }
     }
     // We are not resetting the Duplicate key return code. We are passing it back to the CacheOp. This will tell the
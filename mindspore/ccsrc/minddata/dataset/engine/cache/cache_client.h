@@ -43,6 +43,8 @@
 
 namespace mindspore {
 namespace dataset {
+class CacheRing;
+
 /// \brief A CacheClient is a bridge between a DatasetOp and a CacheServer. All communications are through
 /// a CacheClient. Typical tasks including like creating a cache service, cache a data buffer, restore a previously
 /// rows, etc.
@@ -354,6 +356,19 @@ class CacheClient {
     int32_t cur_;
   };
   std::shared_ptr<AsyncBufferStream> async_buffer_stream_;
+
+  /// \brief Set up the ring in the shared memory through which a local client fetches rows without grpc.
+  Status InitRing();
+  /// \brief Stop the server from serving the ring, the server frees it.
+  /// /note but needs comm layer to be alive.
+  void ReleaseRing();
+  /// \brief Fetch rows through the ring, or through grpc if the ring can't take the request.
+  Status SendBatchFetch(const std::shared_ptr<BatchFetchRequest> &rq, const std::vector<row_id_type> &row_id) const;
+  /// \brief Free a shared block through the ring, or through grpc if the ring can't take the request.
+  Status FreeSharedBlock(int64_t addr) const;
+
+  CacheRing *ring_;                        // nullptr if the server does not serve a ring for us
+  mutable std::atomic<bool> ring_failed_;  // The server stopped answering, use grpc from now on
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,14 +15,32 @@
  */
 #include "minddata/dataset/engine/cache/cache_pool.h"
 
+#include <limits>
+#include <random>
+
 #include "minddata/dataset/engine/cache/cache_server.h"
+#include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/services.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace dataset {
 CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      freq_(nullptr),
+      num_access_(0),
+      min_key_(std::numeric_limits<key_type>::max()),
+      max_key_(std::numeric_limits<key_type>::min()),
+      num_mem_hit_(0),
+      num_disk_hit_(0),
+      num_promoted_(0),
+      num_demoted_(0),
+      reclaimed_bytes_(0),
+      epoch_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -38,6 +56,11 @@ Status CachePool::DoServiceStart() {
     auto &cs = CacheServer::GetInstance();
     sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
     RETURN_IF_NOT_OK(sm_->ServiceStart());
+    // Buffers only move between memory and disk when there is a disk.
+    freq_ = std::make_unique<std::atomic<uint8_t>[]>(kFreqSketchSize);
+    for (size_t i = 0; i < kFreqSketchSize; ++i) {
+      freq_[i].store(0, std::memory_order_relaxed);
+    }
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
   }
   return Status::OK();
@@ -47,6 +70,11 @@ Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
   if (sm_ != nullptr) {
+    int64_t stored_sz = 0;
+    int64_t sz = 0;
+    sm_->GetSpillSize(&stored_sz, &sz);
+    MS_LOG(INFO) << "CachePool " << subfolder_ << " spilled " << sz << " bytes into " << stored_sz
+                 << " bytes on disk. Buffers moved to memory: " << num_promoted_ << ", moved to disk: " << num_demoted_;
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
       rc2 = rc;
@@ -57,8 +85,13 @@ Status CachePool::DoServiceStop() {
   // We used to free the memory allocated from each DataLocator but
   // since all of them are coming from NumaMemoryPool and we will
   // skip this and release the whole NumaMemoryPool instead. Otherwise
-  // release each buffer in the DataLocator one by one.
-
+  // release each buffer in the DataLocator one by one. The same goes for the retired buffers.
+  {
+    std::lock_guard<std::mutex> lck(retire_mux_);
+    retired_.clear();
+    active_fetches_.clear();
+  }
+  freq_.reset();
   tree_.reset();
   if (!root_.ToString().empty()) {
     Path spill = GetSpillPath();
@@ -79,6 +112,44 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
+Status CachePool::AllocateBuffer(size_t sz, pointer *p, bool promote) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  // Memory freed by moving buffers to disk is still held by the memory pool, and not seen by the soft limit, so the
+  // buffers moved back to memory take it first.
+  if (promote) {
+    auto reclaimed = reclaimed_bytes_.load();
+    while (reclaimed >= static_cast<int64_t>(sz)) {
+      if (reclaimed_bytes_.compare_exchange_weak(reclaimed, reclaimed - static_cast<int64_t>(sz))) {
+        Status rc = mp_->Allocate(sz, reinterpret_cast<void **>(p));
+        if (rc.IsError()) {
+          reclaimed_bytes_ += static_cast<int64_t>(sz);
+        }
+        return rc;
+      }
+    }
+  }
+  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
+  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
+  // than the lower bound. (The default is 20% of physical RAM)
+  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+    if (!promote) {
+      MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
+                      << ". The cache server will not cache any more data.";
+    }
+    return STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+  }
+  Status rc = mp_->Allocate(sz, reinterpret_cast<void **>(p));
+  // Adjust the soft limit and usage counting when every 100M memory are used.
+  if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
+    soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
+    temp_mem_usage_ = 0;
+  }
+  if (rc.IsOk()) {
+    temp_mem_usage_ += sz;
+  }
+  return rc;
+}
+
 Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
   DataLocator bl;
   Status rc;
@@ -88,33 +159,20 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
-  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
-  // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
-    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
-                    << ". The cache server will not cache any more data.";
-    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
-  } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
-    // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
-      soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
-      temp_mem_usage_ = 0;
-    }
-  }
+  pointer p = nullptr;
+  rc = AllocateBuffer(sz, &p, false);
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
+    bl.ptr = p;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
       auto &cs = CacheServer::GetInstance();
       auto node_id = cs.GetHWControl()->GetMyNode();
-      bl.node_id = mp_->FindNode(bl.ptr);
+      bl.node_id = mp_->FindNode(p);
       CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
       bl.node_hit = (bl.node_id == node_id);
     }
     // We will do a piecewise copy.
-    WritableSlice dest(bl.ptr, bl.sz);
+    WritableSlice dest(p, bl.sz);
     size_t pos = 0;
     for (auto &v : buf) {
       WritableSlice out(dest, pos);
@@ -125,8 +183,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       pos += v.GetSize();
     }
     if (rc.IsError()) {
-      mp_->Deallocate(bl.ptr);
-      bl.ptr = nullptr;
+      mp_->Deallocate(p);
       return rc;
     }
   } else if (rc == StatusCode::kMDOutOfMemory) {
@@ -134,6 +191,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      bl.on_disk = true;
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -149,40 +207,222 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
   }
   // Duplicate key is treated as error and we will also free the memory.
-  if (rc.IsError() && bl.ptr != nullptr) {
-    mp_->Deallocate(bl.ptr);
-    bl.ptr = nullptr;
+  if (rc.IsError()) {
+    if (p != nullptr) {
+      mp_->Deallocate(p);
+    }
     return rc;
   }
+  // The range of the keys buffers to move to disk are sampled from.
+  auto lo = min_key_.load();
+  while (key < lo && !min_key_.compare_exchange_weak(lo, key)) {
+  }
+  auto hi = max_key_.load();
+  while (key > hi && !max_key_.compare_exchange_weak(hi, key)) {
+  }
   return rc;
 }
 
-Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) {
   RETURN_UNEXPECTED_IF_NULL(dest);
-  auto r = tree_->Search(key);
-  if (r.second) {
+  bool from_disk = false;
+  size_t sz = 0;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
     auto &it = r.first;
-    if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
+    sz = it->sz;
+    // The buffer may move to disk while it is copied.
+    auto epoch = BeginFetch();
+    pointer p = it->ptr.load(std::memory_order_acquire);
+    Status rc;
+    if (p != nullptr) {
+      ReadableSlice src(p, sz);
+      rc = WritableSlice::Copy(dest, src);
+    }
+    EndFetch(epoch);
+    RETURN_IF_NOT_OK(rc);
+    if (p == nullptr && sm_ != nullptr) {
       size_t expectedLength = 0;
       RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
+      if (expectedLength != sz) {
+        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << sz << "."
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      from_disk = true;
+    }
+  }
+  // The iterator holds a shared lock on the leaf, it must be gone before the buffer moves.
+  if (from_disk) {
+    MaybePromote(key, ReadableSlice(dest->GetPointer(), sz));
+  }
+  if (bytesRead != nullptr) {
+    *bytesRead = sz;
+  }
+  return Status::OK();
+}
+
+uint8_t CachePool::Frequency(key_type key) const {
+  if (freq_ == nullptr) {
+    return 0;
+  }
+  // Fibonacci hashing, the keys are mostly consecutive row ids.
+  auto index = (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> (64 - kFreqSketchBits);
+  return freq_[index].load(std::memory_order_relaxed);
+}
+
+void CachePool::RecordAccess(key_type key) {
+  if (freq_ == nullptr) {
+    return;
+  }
+  auto index = (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> (64 - kFreqSketchBits);
+  // A lost update under contention only makes the count a little lower.
+  auto count = freq_[index].load(std::memory_order_relaxed);
+  if (count < std::numeric_limits<uint8_t>::max()) {
+    freq_[index].store(count + 1, std::memory_order_relaxed);
+  }
+  if (++num_access_ % kFreqAgingPeriod == 0) {
+    for (size_t i = 0; i < kFreqSketchSize; ++i) {
+      freq_[i].store(freq_[i].load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+  }
+}
+
+void CachePool::MaybePromote(key_type key, const ReadableSlice &src) {
+  auto freq = Frequency(key);
+  if (freq < kPromoteThreshold) {
+    return;
+  }
+  // Skip it if another buffer is moving, a buffer read often enough gets another chance soon.
+  std::unique_lock<std::mutex> lck(tier_mux_, std::try_to_lock);
+  if (!lck.owns_lock()) {
+    return;
+  }
+  pointer p = nullptr;
+  Status rc = AllocateBuffer(src.GetSize(), &p, true);
+  if (rc.IsError()) {
+    // Make room for the buffer to move in on one of its next reads.
+    rc = DemoteColderThan(freq);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to move a buffer to disk. " << rc.ToString();
     }
-    if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+    return;
+  }
+  WritableSlice dest(p, src.GetSize());
+  rc = WritableSlice::Copy(&dest, src);
+  if (rc.IsOk()) {
+    auto r = tree_->Search(key);
+    pointer expected = nullptr;
+    if (r.second && r.first->ptr.compare_exchange_strong(expected, p, std::memory_order_release)) {
+      ++num_promoted_;
+      return;
+    }
+  }
+  mp_->Deallocate(p);
+  reclaimed_bytes_ += static_cast<int64_t>(src.GetSize());
+}
+
+Status CachePool::DemoteColderThan(uint8_t freq) {
+  const key_type lo = min_key_;
+  const key_type hi = max_key_;
+  if (hi < lo) {
+    return Status::OK();
+  }
+  // Sample a few keys rather than keeping an order of all the buffers, the coldest one of them moves to disk.
+  auto rnd = GetRandomDevice();
+  std::uniform_int_distribution<key_type> dist(lo, hi);
+  key_type victim = -1;
+  uint8_t victim_freq = freq;
+  for (int32_t i = 0; i < kEvictionSamples; ++i) {
+    auto key = dist(rnd);
+    auto key_freq = Frequency(key);
+    if (key_freq >= victim_freq) {
+      continue;
+    }
+    auto r = tree_->Search(key);
+    if (r.second && r.first->ptr.load() != nullptr) {
+      victim = key;
+      victim_freq = key_freq;
     }
-  } else {
-    RETURN_STATUS_UNEXPECTED("Key not found");
   }
+  if (victim == -1) {
+    return Status::OK();
+  }
+  // tier_mux_ is held, so the victim can only move to disk here. Take a copy of its locator and release the leaf.
+  DataLocator bl;
+  {
+    auto r = tree_->Search(victim);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    bl = r.first.value();
+  }
+  pointer p = bl.ptr.load();
+  if (p == nullptr) {
+    return Status::OK();
+  }
+  // A buffer promoted earlier still has its copy on disk.
+  if (!bl.on_disk) {
+    RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, {ReadableSlice(p, bl.sz)}));
+    bl.on_disk = true;
+  }
+  const size_t sz = bl.sz;
+  bl.ptr = nullptr;
+  // The new locator is swapped in under the exclusive lock of the leaf, so a reader sees either the old one or the
+  // new one as a whole.
+  auto old = tree_->DoUpdate(victim, std::make_unique<DataLocator>(std::move(bl)));
+  CHECK_FAIL_RETURN_UNEXPECTED(old != nullptr, "Key not found");
+  ++num_demoted_;
+  Retire(p, sz);
   return Status::OK();
 }
 
+uint64_t CachePool::BeginFetch() {
+  std::lock_guard<std::mutex> lck(retire_mux_);
+  ++active_fetches_[epoch_];
+  return epoch_;
+}
+
+void CachePool::EndFetch(uint64_t epoch) {
+  std::vector<RetiredBuffer> to_free;
+  {
+    std::lock_guard<std::mutex> lck(retire_mux_);
+    auto it = active_fetches_.find(epoch);
+    if (it != active_fetches_.end() && --(it->second) == 0) {
+      active_fetches_.erase(it);
+    }
+    TakeRetired(&to_free);
+  }
+  FreeRetired(to_free);
+}
+
+void CachePool::Retire(pointer p, size_t sz) {
+  std::vector<RetiredBuffer> to_free;
+  {
+    std::lock_guard<std::mutex> lck(retire_mux_);
+    // Readers registered from now on can not see p.
+    retired_.push_back({epoch_++, p, sz});
+    TakeRetired(&to_free);
+  }
+  FreeRetired(to_free);
+}
+
+void CachePool::TakeRetired(std::vector<RetiredBuffer> *to_free) {
+  // A buffer retired in epoch e may be used by the readers registered in epoch e or before.
+  while (!retired_.empty() && (active_fetches_.empty() || retired_.front().epoch < active_fetches_.begin()->first)) {
+    to_free->push_back(retired_.front());
+    retired_.pop_front();
+  }
+}
+
+void CachePool::FreeRetired(const std::vector<RetiredBuffer> &to_free) {
+  for (auto &b : to_free) {
+    mp_->Deallocate(b.ptr);
+    reclaimed_bytes_ += static_cast<int64_t>(b.sz);
+  }
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -190,7 +430,7 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, num_mem_hit_, num_disk_hit_};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -198,7 +438,7 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
+      if (it.value().ptr.load() != nullptr) {
         ++cs.num_mem_cached;
       } else {
         ++cs.num_disk_cached;
@@ -228,16 +468,23 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
 }
 
 Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb,
-                                 flatbuffers::Offset<DataLocatorMsg> *out) const {
+                                 flatbuffers::Offset<DataLocatorMsg> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    pointer p = it->ptr.load(std::memory_order_acquire);
+    RecordAccess(key);
+    if (p != nullptr) {
+      ++num_mem_hit_;
+    } else {
+      ++num_disk_hit_;
+    }
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
     bld.add_size(it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    bld.add_addr(reinterpret_cast<int64_t>(p));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -16,6 +16,9 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -45,41 +48,64 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
-  // An internal class to locate the whereabouts of a backed up buffer which can be either in
+  // An internal class to locate the whereabouts of a backed up buffer which can be either in memory or on disk, or
+  // both when a spilled buffer is promoted back to memory. The pointer is atomic because a buffer can move between
+  // memory and disk while it is being read.
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0), on_disk(false) {}
     ~DataLocator() = default;
-    DataLocator(const DataLocator &other) = default;
-    DataLocator &operator=(const DataLocator &other) = default;
+    DataLocator(const DataLocator &other)
+        : ptr(other.ptr.load()),
+          sz(other.sz),
+          node_id(other.node_id),
+          node_hit(other.node_hit),
+          storage_key(other.storage_key),
+          on_disk(other.on_disk) {}
+    DataLocator &operator=(const DataLocator &other) {
+      if (&other != this) {
+        ptr = other.ptr.load();
+        sz = other.sz;
+        node_id = other.node_id;
+        node_hit = other.node_hit;
+        storage_key = other.storage_key;
+        on_disk = other.on_disk;
+      }
+      return *this;
+    }
     DataLocator(DataLocator &&other) noexcept {
-      ptr = other.ptr;
+      ptr = other.ptr.load();
       sz = other.sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
+      on_disk = other.on_disk;
       other.ptr = nullptr;
       other.sz = 0;
       other.storage_key = 0;
+      other.on_disk = false;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
-        ptr = other.ptr;
+        ptr = other.ptr.load();
         sz = other.sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
+        on_disk = other.on_disk;
         other.ptr = nullptr;
         other.sz = 0;
         other.storage_key = 0;
+        other.on_disk = false;
       }
       return *this;
     }
-    pointer ptr;
+    std::atomic<pointer> ptr;  // nullptr if the buffer is only on disk
     size_t sz;
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
+    bool on_disk;  // storage_key is valid. Set before ptr is cleared, and a promoted buffer keeps its copy on disk.
   };
 
   using data_index = BPlusTree<int64_t, DataLocator>;
@@ -95,6 +121,8 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_mem_hit;   // rows fetched from memory
+    int64_t num_disk_hit;  // rows fetched from disk
     std::vector<key_type> gap;
   };
 
@@ -122,16 +150,27 @@ class CachePool : public Service {
   /// \return Error code
   Status Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf);
 
-  /// \brief Restore a cached buffer (from memory or disk)
+  /// \brief Restore a cached buffer (from memory or disk). A buffer read from disk often enough is moved back to
+  /// memory, making room for it by moving a buffer read less often to disk.
   /// \param[in] key A previous key returned from Insert
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
   /// \param[out] bytesRead Optional. Number of bytes read.
   /// \return Error code
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr);
 
-  /// \brief Serialize a DataLocator
+  /// \brief Serialize a DataLocator. It also counts the access of the key.
+  /// \note The memory address in it stays valid until EndFetch of the epoch returned by the BeginFetch called
+  /// before it.
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
-                        flatbuffers::Offset<DataLocatorMsg> *) const;
+                        flatbuffers::Offset<DataLocatorMsg> *);
+
+  /// \brief Register a reader of the memory addresses handed out by GetDataLocator. The memory of a buffer moved to
+  /// disk is only released once all the readers registered before the move are done.
+  /// \return Epoch to pass to EndFetch
+  uint64_t BeginFetch();
+
+  /// \brief Unregister a reader registered by BeginFetch
+  void EndFetch(uint64_t epoch);
 
   /// \brief Get statistics.
   /// \return CacheStat object
@@ -139,6 +178,13 @@ class CachePool : public Service {
 
   std::string MyName() const { return subfolder_; }
 
+  /// \brief Leave room in memory for only sz more bytes, the buffers beyond are written to disk.
+  /// \note For testing only. The limit is refreshed from the available memory of the machine every 100Mb.
+  void SetMemoryCap(uint64_t sz) {
+    soft_mem_limit_ = min_avail_mem_ + sz;
+    temp_mem_usage_ = 0;
+  }
+
   /// \brief Toggle locking
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
@@ -154,6 +200,61 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  // A spilled buffer read this many times, aged over time, is moved back to memory
+  constexpr static uint8_t kPromoteThreshold = 4;
+  // log2 of the number of counters of the access frequency sketch
+  constexpr static int kFreqSketchBits = 20;
+  constexpr static size_t kFreqSketchSize = 1u << kFreqSketchBits;
+  // The counters are halved after this many accesses so that the frequency follows recent accesses
+  constexpr static int64_t kFreqAgingPeriod = 8 * kFreqSketchSize;
+  // Number of buffers sampled to pick the one moved to disk
+  constexpr static int32_t kEvictionSamples = 8;
+
+  std::unique_ptr<std::atomic<uint8_t>[]> freq_;  // saturating access counters indexed by a hash of the key
+  std::atomic<int64_t> num_access_;
+  std::atomic<key_type> min_key_;
+  std::atomic<key_type> max_key_;
+  std::mutex tier_mux_;  // one buffer moves between memory and disk at a time
+  std::atomic<int64_t> num_mem_hit_;
+  std::atomic<int64_t> num_disk_hit_;
+  std::atomic<int64_t> num_promoted_;
+  std::atomic<int64_t> num_demoted_;
+  std::atomic<int64_t> reclaimed_bytes_;  // memory freed by moving buffers to disk, for buffers moved back
+  struct RetiredBuffer {
+    uint64_t epoch;
+    pointer ptr;
+    size_t sz;
+  };
+  std::mutex retire_mux_;
+  uint64_t epoch_;
+  std::map<uint64_t, int64_t> active_fetches_;  // number of readers registered in each epoch
+  std::deque<RetiredBuffer> retired_;           // memory of the buffers moved to disk
+
+  /// \brief Allocate memory for a buffer within the memory cap.
+  /// \param promote If true, the memory freed by moving buffers to disk is used first and nothing is logged.
+  Status AllocateBuffer(size_t sz, pointer *p, bool promote);
+
+  uint8_t Frequency(key_type key) const;
+
+  /// \brief Count an access of the key, and age all the counters once in a while.
+  void RecordAccess(key_type key);
+
+  /// \brief Move a spilled buffer which has just been read back to memory if it is read often.
+  void MaybePromote(key_type key, const ReadableSlice &src);
+
+  /// \brief Move a buffer read less often than freq from memory to disk.
+  /// \return Status object
+  Status DemoteColderThan(uint8_t freq);
+
+  /// \brief Free the memory of a buffer moved to disk once no reader can use it.
+  void Retire(pointer p, size_t sz);
+
+  /// \brief Take the retired memory older than all the registered readers. retire_mux_ must be held.
+  void TakeRetired(std::vector<RetiredBuffer> *to_free);
+
+  /// \brief Free the memory taken by TakeRetired.
+  void FreeRetired(const std::vector<RetiredBuffer> &to_free);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -45,6 +45,8 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
 };
 
 struct CacheServerCfgInfo {
@@ -87,6 +89,8 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kRegisterRing = 22,
+    kUnregisterRing = 23,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -148,7 +152,8 @@ class BaseRequest {
            type_ == RequestType::kCacheSchema || type_ == RequestType::kFetchSchema ||
            type_ == RequestType::kBuildPhaseDone || type_ == RequestType::kToggleWriteMode ||
            type_ == RequestType::kConnectReset || type_ == RequestType::kStopService ||
-           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys;
+           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys ||
+           type_ == RequestType::kRegisterRing || type_ == RequestType::kUnregisterRing;
   }
 
   /// \brief Return if the request is of session request type
@@ -489,6 +494,32 @@ class ConnectResetRequest : public BaseRequest {
   }
 };
 
+/// \brief Request to serve the requests posted to a ring in the shared memory, see CacheRing
+class RegisterRingRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  explicit RegisterRingRequest(connection_id_type connection_id, int32_t client_id, int64_t addr, int64_t block)
+      : BaseRequest(RequestType::kRegisterRing) {
+    rq_.set_connection_id(connection_id);
+    rq_.add_buf_data(std::to_string(addr));
+    rq_.add_buf_data(std::to_string(block));
+    rq_.set_client_id(client_id);
+  }
+  ~RegisterRingRequest() override = default;
+};
+
+/// \brief Request to stop serving the ring of a client, the server frees the ring afterwards
+class UnregisterRingRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  explicit UnregisterRingRequest(connection_id_type connection_id, int32_t client_id)
+      : BaseRequest(RequestType::kUnregisterRing) {
+    rq_.set_connection_id(connection_id);
+    rq_.set_client_id(client_id);
+  }
+  ~UnregisterRingRequest() override = default;
+};
+
 class BatchCacheRowsRequest : public BaseRequest {
  public:
   friend class CacheServer;
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The ring is shared by two processes, so its counters must not fall back to a lock inside the process.
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "CacheRing needs lock-free 64 bit atomics");
+
+constexpr int64_t kNumSpins = 64;
+constexpr int64_t kNumYields = 256;
+constexpr int64_t kMaxSleepInUs = 50;
+
+bool TimedOut(const std::chrono::steady_clock::time_point &start, int64_t timeout_in_ms) {
+  return std::chrono::steady_clock::now() - start > std::chrono::milliseconds(timeout_in_ms);
+}
+}  // namespace
+
+void CacheRingBackoff::Pause() {
+  if (count_ < kNumSpins) {
+    ++count_;
+  } else if (count_ < kNumYields) {
+    ++count_;
+    std::this_thread::yield();
+  } else {
+    auto sleep_in_us = std::min(count_ - kNumYields + 1, kMaxSleepInUs);
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_in_us));
+    if (sleep_in_us < kMaxSleepInUs) {
+      ++count_;
+    }
+  }
+}
+
+CacheRing::CacheRing() : magic_(kMagic), tail_(0), head_(0) {
+  for (uint64_t i = 0; i < kCacheRingNumSlots; ++i) {
+    slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+}
+
+CacheRing *CacheRing::CreateInPlace(void *p) {
+  auto *ring = new (p) CacheRing();
+  std::atomic_thread_fence(std::memory_order_release);
+  return ring;
+}
+
+Status CacheRing::Attach(void *p, CacheRing **out) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(reinterpret_cast<uintptr_t>(p) % alignof(CacheRing) == 0, "Misaligned cache ring");
+  auto *ring = static_cast<CacheRing *>(p);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  CHECK_FAIL_RETURN_UNEXPECTED(ring->magic_ == kMagic, "Not a cache ring");
+  *out = ring;
+  return Status::OK();
+}
+
+Status CacheRing::Acquire(uint64_t *ticket, int64_t timeout_in_ms) {
+  CacheRingBackoff backoff;
+  auto start = std::chrono::steady_clock::now();
+  uint64_t t = tail_.load(std::memory_order_relaxed);
+  while (true) {
+    auto diff = static_cast<int64_t>(GetSlot(t)->seq.load(std::memory_order_acquire) - t);
+    if (diff == 0) {
+      // A failed exchange reloads t, another client has taken that ticket.
+      if (tail_.compare_exchange_weak(t, t + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The slot is still in use by the ticket of the previous lap, the ring is full.
+      CHECK_FAIL_RETURN_UNEXPECTED(!TimedOut(start, timeout_in_ms),
+                                   "Timeout waiting for a free slot in the cache ring");
+      backoff.Pause();
+      t = tail_.load(std::memory_order_relaxed);
+    } else {
+      t = tail_.load(std::memory_order_relaxed);
+    }
+  }
+  *ticket = t;
+  return Status::OK();
+}
+
+Status CacheRing::BatchFetch(const std::vector<row_id_type> &row_id, CacheReply *reply, int64_t timeout_in_ms) {
+  RETURN_UNEXPECTED_IF_NULL(reply);
+  CHECK_FAIL_RETURN_UNEXPECTED(!row_id.empty() && row_id.size() <= static_cast<size_t>(kCacheRingMaxRows),
+                               "Number of rows out of range: " + std::to_string(row_id.size()));
+  uint64_t t;
+  RETURN_IF_NOT_OK(Acquire(&t, timeout_in_ms));
+  CacheRingSlot *slot = GetSlot(t);
+  slot->op = CacheRingSlot::Op::kBatchFetch;
+  slot->num_rows = static_cast<int32_t>(row_id.size());
+  std::copy(row_id.begin(), row_id.end(), slot->row_id);
+  slot->seq.store(t + 1, std::memory_order_release);
+  CacheRingBackoff backoff;
+  auto start = std::chrono::steady_clock::now();
+  while (slot->seq.load(std::memory_order_acquire) != t + 2) {
+    if (TimedOut(start, timeout_in_ms)) {
+      // Hand the request over to the server, which frees the block of a reply that comes too late. If the reply
+      // comes in just now, take it as usual.
+      uint64_t expected = t + 1;
+      if (slot->seq.compare_exchange_strong(expected, t + 3, std::memory_order_acq_rel)) {
+        RETURN_STATUS_UNEXPECTED("Timeout waiting for the cache server to reply");
+      }
+      break;
+    }
+    backoff.Pause();
+  }
+  reply->set_rc(slot->rc);
+  reply->set_msg(slot->msg);
+  if (slot->rc == static_cast<int32_t>(StatusCode::kSuccess)) {
+    reply->set_flag(kDataIsInSharedMemory);
+    reply->set_result(std::to_string(slot->addr));
+  }
+  slot->seq.store(t + kCacheRingNumSlots, std::memory_order_release);
+  return Status::OK();
+}
+
+Status CacheRing::FreeBlock(int64_t addr) {
+  uint64_t t;
+  RETURN_IF_NOT_OK(Acquire(&t, kCacheRingTimeoutInMs));
+  CacheRingSlot *slot = GetSlot(t);
+  slot->op = CacheRingSlot::Op::kFreeBlock;
+  slot->num_rows = 0;
+  slot->addr = addr;
+  slot->seq.store(t + 1, std::memory_order_release);
+  return Status::OK();
+}
+
+bool CacheRing::TryPop(uint64_t *ticket) {
+  uint64_t h = head_.load(std::memory_order_relaxed);
+  uint64_t seq;
+  // A request abandoned before the server takes it is taken as well, so the slot is released.
+  while ((seq = GetSlot(h)->seq.load(std::memory_order_acquire)) == h + 1 || seq == h + 3) {
+    // A failed exchange reloads h, and another server thread has taken that request.
+    if (head_.compare_exchange_weak(h, h + 1, std::memory_order_relaxed)) {
+      *ticket = h;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CacheRing::Reply(uint64_t ticket, const Status &rc, int64_t addr) {
+  CacheRingSlot *slot = GetSlot(ticket);
+  std::string msg = rc.ToString();
+  auto len = std::min(msg.size(), static_cast<size_t>(kSharedMessageSize - 1));
+  (void)msg.copy(slot->msg, len);
+  slot->msg[len] = '\0';
+  slot->rc = static_cast<int32_t>(rc.StatusCode());
+  slot->addr = addr;
+  // The client may give up while the reply is filled in, it does not read the slot then.
+  uint64_t expected = ticket + 1;
+  if (!slot->seq.compare_exchange_strong(expected, ticket + 2, std::memory_order_acq_rel)) {
+    Release(ticket);
+    return false;
+  }
+  return true;
+}
+
+void CacheRing::Release(uint64_t ticket) {
+  GetSlot(ticket)->seq.store(ticket + kCacheRingNumSlots, std::memory_order_release);
+}
+
+CacheRingRegistry::CacheRingRegistry(FetchFunc fetch_func, FreeFunc free_func)
+    : fetch_func_(std::move(fetch_func)), free_func_(std::move(free_func)), version_(0), stop_(false) {}
+
+void CacheRingRegistry::AddRing(int32_t client_id, connection_id_type connection_id, CacheRing *ring,
+                                int64_t block) {
+  auto owner = std::make_shared<RingOwner>(client_id, connection_id, ring, block, free_func_);
+  std::unique_lock<std::mutex> lck(mux_);
+  rings_[RingKey(connection_id, client_id)] = std::move(owner);
+  ++version_;
+  cv_.NotifyAll();
+}
+
+void CacheRingRegistry::RemoveRing(int32_t client_id, connection_id_type connection_id) {
+  std::shared_ptr<RingOwner> owner;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto it = rings_.find(RingKey(connection_id, client_id));
+    if (it == rings_.end()) {
+      return;
+    }
+    owner = std::move(it->second);
+    (void)rings_.erase(it);
+    ++version_;
+  }
+  // The block is freed outside the lock if no thread is serving the ring.
+  owner.reset();
+}
+
+size_t CacheRingRegistry::NumRings() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return rings_.size();
+}
+
+void CacheRingRegistry::Stop() {
+  // The blocks are freed outside the lock, once the serving threads let the rings go.
+  std::map<RingKey, std::shared_ptr<RingOwner>> rings;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    stop_ = true;
+    rings.swap(rings_);
+    ++version_;
+    cv_.NotifyAll();
+  }
+}
+
+Status CacheRingRegistry::Serve() {
+  std::vector<std::shared_ptr<RingOwner>> rings;
+  uint64_t version = 0;
+  CacheRingBackoff backoff;
+  while (!stop_ && !this_thread::is_interrupted()) {
+    if (rings.empty() || version != version_) {
+      // Let go of the rings removed since the last copy before waiting, so their blocks can be freed.
+      rings.clear();
+      std::unique_lock<std::mutex> lck(mux_);
+      RETURN_IF_NOT_OK(cv_.Wait(&lck, [this]() { return stop_ || !rings_.empty(); }));
+      version = version_;
+      for (auto &it : rings_) {
+        rings.push_back(it.second);
+      }
+      continue;
+    }
+    bool found = false;
+    for (auto &owner : rings) {
+      uint64_t ticket;
+      if (owner->ring->TryPop(&ticket)) {
+        ServeRequest(*owner, ticket);
+        found = true;
+      }
+    }
+    if (found) {
+      backoff.Reset();
+    } else {
+      backoff.Pause();
+    }
+  }
+  return Status::OK();
+}
+
+void CacheRingRegistry::ServeRequest(const RingOwner &owner, uint64_t ticket) {
+  CacheRing *ring = owner.ring;
+  CacheRingSlot *slot = ring->GetSlot(ticket);
+  if (ring->Abandoned(ticket)) {
+    ring->Release(ticket);
+    return;
+  }
+  // The slot is in memory the client can write to, so nothing in it is trusted.
+  if (slot->op == CacheRingSlot::Op::kFreeBlock) {
+    int64_t addr = slot->addr;
+    ring->Release(ticket);
+    if (addr >= 0) {
+      free_func_(owner.client_id, addr);
+    }
+    return;
+  }
+  Status rc;
+  int64_t addr = -1;
+  int32_t num_rows = slot->num_rows;
+  if (slot->op != CacheRingSlot::Op::kBatchFetch) {
+    rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, "Unknown ring request");
+  } else if (num_rows <= 0 || num_rows > kCacheRingMaxRows) {
+    rc = STATUS_ERROR(StatusCode::kMDUnexpectedError, "Number of rows out of range: " + std::to_string(num_rows));
+  } else {
+    std::vector<row_id_type> row_id(slot->row_id, slot->row_id + num_rows);
+    rc = fetch_func_(owner.connection_id, owner.client_id, row_id, &addr);
+  }
+  if (!ring->Reply(ticket, rc, addr) && rc.IsOk() && addr >= 0) {
+    // Nobody is going to read the rows.
+    free_func_(owner.client_id, addr);
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,218 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/cache/cache_common.h"
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/intrp_service.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Number of requests a ring can hold at a time.
+constexpr static int32_t kCacheRingNumSlots = 64;
+/// \brief A batch fetch with more row ids than this goes through grpc.
+constexpr static int32_t kCacheRingMaxRows = 512;
+/// \brief Cache line size the producer and the consumer counters are padded to.
+constexpr static size_t kCacheRingAlignment = 64;
+/// \brief How long a client waits for the reply of the server. A fetch can wait for rows spilled to disk, only a
+/// server which is gone takes this long.
+constexpr static int64_t kCacheRingTimeoutInMs = 60000;
+
+/// \brief One request in the ring, and the reply of the server to it.
+/// The seq of the slot of ticket t goes through t (free), t + 1 (request posted), t + 2 (reply posted)
+/// and t + kCacheRingNumSlots (free again for the ticket of the next lap). A client which times out moves the
+/// request from t + 1 to t + 3 (abandoned), and the server then gives back the block of the reply itself.
+struct CacheRingSlot {
+  enum class Op : int32_t { kBatchFetch = 0, kFreeBlock = 1 };
+  alignas(kCacheRingAlignment) std::atomic<uint64_t> seq;
+  Op op;
+  int32_t num_rows;
+  int32_t rc;
+  int64_t addr;  // Block to free for kFreeBlock, offset of the fetched rows in the reply of kBatchFetch
+  char msg[kSharedMessageSize];
+  row_id_type row_id[kCacheRingMaxRows];
+};
+
+/// \brief Waits in increasing steps, a reply usually comes back within a few spins, but an idle peer should not
+/// keep a core busy.
+class CacheRingBackoff {
+ public:
+  CacheRingBackoff() : count_(0) {}
+  ~CacheRingBackoff() = default;
+
+  /// \brief Wait a little longer than the previous call.
+  void Pause();
+
+  /// \brief Go back to spinning.
+  void Reset() { count_ = 0; }
+
+ private:
+  int64_t count_;
+};
+
+/// \brief A lock-free ring of requests in the shared memory of the cache server. It lets a local client fetch
+/// cached rows and free its shared blocks without a grpc round trip, any number of client threads post requests
+/// and any number of server threads serve them. Only plain data and offsets from the base of the shared memory
+/// are placed in the ring so it can be mapped at different addresses by the two processes.
+class CacheRing {
+ public:
+  /// \brief Construct an empty ring in place.
+  /// \param p Memory of at least sizeof(CacheRing) bytes.
+  /// \return The ring.
+  static CacheRing *CreateInPlace(void *p);
+
+  /// \brief Check the memory of a ring created by the client.
+  /// \param p Address of the ring.
+  /// \param[out] out The ring.
+  /// \return Status object
+  static Status Attach(void *p, CacheRing **out);
+
+  /// \brief Client side. Fetch a batch of rows into a shared block.
+  /// \param row_id Row ids to fetch, at most kCacheRingMaxRows.
+  /// \param[out] reply Reply of the server, filled in as if it came back through grpc.
+  /// \param timeout_in_ms How long to wait for a free slot, and then for the reply.
+  /// \return Status object, an error if the server does not reply in time.
+  Status BatchFetch(const std::vector<row_id_type> &row_id, CacheReply *reply,
+                    int64_t timeout_in_ms = kCacheRingTimeoutInMs);
+
+  /// \brief Client side. Give back a shared block returned by BatchFetch, it does not wait for the server.
+  /// \param addr Offset of the block.
+  /// \return Status object
+  Status FreeBlock(int64_t addr);
+
+  /// \brief Server side. Take the oldest posted request if there is one.
+  /// \param[out] ticket Ticket of the request.
+  /// \return True if a request is taken.
+  bool TryPop(uint64_t *ticket);
+
+  /// \brief Server side. The slot of a taken request.
+  CacheRingSlot *GetSlot(uint64_t ticket) { return &slots_[ticket % kCacheRingNumSlots]; }
+
+  /// \brief Server side. Check if the client has stopped waiting for the reply of a request.
+  bool Abandoned(uint64_t ticket) { return GetSlot(ticket)->seq.load(std::memory_order_acquire) == ticket + 3; }
+
+  /// \brief Server side. Post the reply of a kBatchFetch request.
+  /// \return False if the client has stopped waiting, the slot is released and the caller owns the block.
+  bool Reply(uint64_t ticket, const Status &rc, int64_t addr);
+
+  /// \brief Server side. Hand a kFreeBlock request, which has no reply, back to the clients.
+  void Release(uint64_t ticket);
+
+ private:
+  static constexpr uint64_t kMagic = 0x4d53434143484552;  // "MSCACHER"
+
+  CacheRing();
+
+  /// \brief Take a ticket once its slot is free. A client which gives up on a full ring has not taken a ticket, so
+  /// every ticket taken is posted and the server never waits for a ticket nobody posts.
+  /// \param[out] ticket The ticket.
+  /// \param timeout_in_ms How long to wait for a free slot.
+  /// \return Status object, an error if the ring stays full.
+  Status Acquire(uint64_t *ticket, int64_t timeout_in_ms);
+
+  uint64_t magic_;
+  alignas(kCacheRingAlignment) std::atomic<uint64_t> tail_;  // Next ticket of the clients
+  alignas(kCacheRingAlignment) std::atomic<uint64_t> head_;  // Next ticket of the server
+  CacheRingSlot slots_[kCacheRingNumSlots];
+};
+
+/// \brief The rings of the local clients and the threads of the server serving them. A thread serves a copy of
+/// the list of rings and holds no lock while it serves, because a fetch waits for the server workers which also
+/// register and unregister the rings. The shared block of a ring is given back by the server once no thread uses
+/// the ring any more, and the threads block while there is no ring.
+class CacheRingRegistry {
+ public:
+  /// \brief Fetch the rows of a connection into a shared block of the client, and return the offset of the block.
+  using FetchFunc = std::function<Status(connection_id_type connection_id, int32_t client_id,
+                                         const std::vector<row_id_type> &row_id, int64_t *addr)>;
+  /// \brief Give back the shared block of a client at the given offset.
+  using FreeFunc = std::function<void(int32_t client_id, int64_t addr)>;
+
+  CacheRingRegistry(FetchFunc fetch_func, FreeFunc free_func);
+  ~CacheRingRegistry() = default;
+
+  /// \brief Let an interrupt of the task group wake up the threads waiting for a ring.
+  /// \param svc Interrupt service of the task group.
+  /// \return Status object
+  Status Register(const std::shared_ptr<IntrpService> &svc) { return cv_.Register(svc); }
+
+  /// \brief Serve a ring, a ring registered before by the same client of the same connection is replaced. The client
+  /// ids of each cache start from 0, so a client is only identified together with its connection.
+  /// \param client_id Client id.
+  /// \param connection_id Connection the client fetches from.
+  /// \param ring The ring.
+  /// \param block Offset of the shared block holding the ring, freed with the ring. -1 if it is not freed.
+  void AddRing(int32_t client_id, connection_id_type connection_id, CacheRing *ring, int64_t block);
+
+  /// \brief Stop serving the ring of a client. A thread may still finish the request it has taken.
+  /// \param client_id Client id.
+  /// \param connection_id Connection the client fetches from.
+  void RemoveRing(int32_t client_id, connection_id_type connection_id);
+
+  /// \brief Number of rings being served.
+  size_t NumRings() const;
+
+  /// \brief Remove all the rings and let every serving thread return.
+  void Stop();
+
+  /// \brief Entry point of a serving thread. It returns once Stop is called or the thread is interrupted.
+  /// \return Status object
+  Status Serve();
+
+ private:
+  /// \brief A registered ring, its block is freed once the last thread serving it lets it go.
+  struct RingOwner {
+    RingOwner(int32_t client_id, connection_id_type connection_id, CacheRing *ring, int64_t block,
+              const FreeFunc &free_func)
+        : client_id(client_id), connection_id(connection_id), ring(ring), block(block), free_func(free_func) {}
+    ~RingOwner() {
+      if (block >= 0) {
+        free_func(client_id, block);
+      }
+    }
+    int32_t client_id;
+    connection_id_type connection_id;
+    CacheRing *ring;
+    int64_t block;
+    FreeFunc free_func;
+  };
+
+  /// \brief Serve one request taken from a ring.
+  void ServeRequest(const RingOwner &owner, uint64_t ticket);
+
+  FetchFunc fetch_func_;
+  FreeFunc free_func_;
+  mutable std::mutex mux_;
+  CondVar cv_;
+  using RingKey = std::pair<connection_id_type, int32_t>;
+  std::map<RingKey, std::shared_ptr<RingOwner>> rings_;  // keyed by connection id and client id
+  std::atomic<uint64_t> version_;                        // Bumped on every change of rings_
+  std::atomic<bool> stop_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
@@ -106,6 +106,28 @@ Status CacheServer::DoServiceStart() {
       RETURN_IF_NOT_OK(SetAffinity(*pTask, i % num_numa_nodes));
     }
   }
+#ifdef CACHE_LOCAL_CLIENT
+  // Local clients can also send their fetch requests through a ring in the shared memory.
+  rings_ = std::make_unique<CacheRingRegistry>(
+    [this](connection_id_type connection_id, int32_t client_id, const std::vector<row_id_type> &row_id,
+           int64_t *addr) {
+      // The rows always go to the shared memory since there is no other way back.
+      return BatchFetchRows(connection_id, client_id, row_id, 0, addr, nullptr);
+    },
+    [this](int32_t client_id, int64_t addr) {
+      auto *base = SharedMemoryBaseAddr();
+      DeallocateSharedMemory(client_id, reinterpret_cast<void *>(reinterpret_cast<int64_t>(base) + addr));
+    });
+  RETURN_IF_NOT_OK(rings_->Register(vg_.GetIntrpService()));
+  auto g = std::bind(&CacheServer::RingRequest, this, std::placeholders::_1);
+  for (auto i = 0; i < num_grpc_workers_; ++i) {
+    Task *pTask;
+    RETURN_IF_NOT_OK(vg_.CreateAsyncTask("ring worker", std::bind(g, i), &pTask));
+    if (IsNumaAffinityOn()) {
+      RETURN_IF_NOT_OK(SetAffinity(*pTask, i % num_numa_nodes));
+    }
+  }
+#endif
   return Status::OK();
 }
 
@@ -114,6 +136,10 @@ Status CacheServer::DoServiceStop() {
   Status rc2;
   // First stop all the threads.
   RETURN_IF_NOT_OK(vg_.ServiceStop());
+  // No thread serves the rings now, give back their blocks.
+  if (rings_ != nullptr) {
+    rings_->Stop();
+  }
   // Clean up all the caches if any.
   UniqueLock lck(&rwLock_);
   auto it = all_caches_.begin();
@@ -491,77 +517,103 @@ Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuil
 }
 
 Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
-  auto connection_id = rq->connection_id();
-  auto client_id = rq->client_id();
+  CHECK_FAIL_RETURN_UNEXPECTED(!rq->buf_data().empty(), "Missing row id");
+  auto &row_id_buf = rq->buf_data(0);
+  auto p = flatbuffers::GetRoot<TensorRowIds>(row_id_buf.data());
+  RETURN_UNEXPECTED_IF_NULL(p);
+  std::vector<row_id_type> row_id;
+  auto sz = p->row_id()->size();
+  row_id.reserve(sz);
+  for (uint32_t i = 0; i < sz; ++i) {
+    row_id.push_back(p->row_id()->Get(i));
+  }
+  auto client_flag = rq->flag();
+  bool local_client = BitTest(client_flag, kLocalClientSupport);
+  // For large amount data to be sent back, we will use shared memory provided it is a local
+  // client that has local bypass support
+  int64_t shm_threshold = local_client ? kLocalByPassThreshold : -1;
+  int64_t shm_addr = -1;
+  // We are going to use std::string to allocate and hold the result which will be eventually
+  // 'moved' to the protobuf message (which underneath is also a std::string) for the purpose
+  // to minimize memory copy.
+  std::string mem;
+  RETURN_IF_NOT_OK(BatchFetchRows(rq->connection_id(), rq->client_id(), row_id, shm_threshold, &shm_addr, &mem));
+  bool local_bypass = shm_addr != -1;
+  reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
+  if (local_bypass) {
+    reply->set_result(std::to_string(shm_addr));
+  } else {
+    reply->set_result(std::move(mem));
+  }
+  return Status::OK();
+}
+
+Status CacheServer::BatchFetchRows(connection_id_type connection_id, int32_t client_id,
+                                   const std::vector<row_id_type> &row_id, int64_t shm_threshold, int64_t *shm_addr,
+                                   std::string *out) {
+  RETURN_UNEXPECTED_IF_NULL(shm_addr);
+  *shm_addr = -1;
   // Hold the shared lock to prevent the cache from being dropped.
   SharedLock lck(&rwLock_);
   CacheService *cs = GetService(connection_id);
   if (cs == nullptr) {
     std::string errMsg = "Cache id " + std::to_string(connection_id) + " not found";
     RETURN_STATUS_UNEXPECTED(errMsg);
-  } else {
-    CHECK_FAIL_RETURN_UNEXPECTED(!rq->buf_data().empty(), "Missing row id");
-    auto &row_id_buf = rq->buf_data(0);
-    auto p = flatbuffers::GetRoot<TensorRowIds>(row_id_buf.data());
-    RETURN_UNEXPECTED_IF_NULL(p);
-    std::vector<row_id_type> row_id;
-    auto sz = p->row_id()->size();
-    row_id.reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-      row_id.push_back(p->row_id()->Get(i));
-    }
-    std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
-    RETURN_IF_NOT_OK(cs->PreBatchFetch(connection_id, row_id, fbb));
-    // Let go of the shared lock. We don't need to interact with the CacheService anymore.
-    // We shouldn't be holding any lock while we can wait for a long time for the rows to come back.
-    lck.Unlock();
-    auto locator = flatbuffers::GetRoot<BatchDataLocatorMsg>(fbb->GetBufferPointer());
-    int64_t mem_sz = sizeof(int64_t) * (sz + 1);
-    for (auto i = 0; i < sz; ++i) {
-      auto row_sz = locator->rows()->Get(i)->size();
-      // row_sz is the size of the cached data. Later we will spawn multiple threads
-      // each of which will copy the data into either shared memory or protobuf concurrently but
-      // to different region.
-      // To avoid false sharing, we will bump up row_sz to be a multiple of 4k, i.e. 4096 bytes
-      row_sz = round_up_4K(row_sz);
-      mem_sz += row_sz;
+  }
+  std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  uint64_t epoch = 0;
+  RETURN_IF_NOT_OK(cs->PreBatchFetch(connection_id, row_id, fbb, &epoch));
+  // Let go of the shared lock. We don't need to interact with the CacheService anymore.
+  // We shouldn't be holding any lock while we can wait for a long time for the rows to come back.
+  lck.Unlock();
+  Status rc = CopyBatch(client_id, fbb, row_id.size(), shm_threshold, shm_addr, out);
+  // The memory of the rows moved to disk during the copy can be released now.
+  lck.Lock();
+  cs = GetService(connection_id);
+  if (cs != nullptr) {
+    cs->PostBatchFetch(epoch);
+  }
+  return rc;
+}
+
+Status CacheServer::CopyBatch(int32_t client_id, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb,
+                              size_t sz, int64_t shm_threshold, int64_t *shm_addr, std::string *out) {
+  auto locator = flatbuffers::GetRoot<BatchDataLocatorMsg>(fbb->GetBufferPointer());
+  int64_t mem_sz = sizeof(int64_t) * (sz + 1);
+  for (auto i = 0; i < sz; ++i) {
+    auto row_sz = locator->rows()->Get(i)->size();
+    // row_sz is the size of the cached data. Later we will spawn multiple threads
+    // each of which will copy the data into either shared memory or protobuf concurrently but
+    // to different region.
+    // To avoid false sharing, we will bump up row_sz to be a multiple of 4k, i.e. 4096 bytes
+    row_sz = round_up_4K(row_sz);
+    mem_sz += row_sz;
+  }
+  bool local_bypass = shm_threshold >= 0 && mem_sz >= shm_threshold;
+  if (local_bypass) {
+    // We will use shared memory
+    auto *base = SharedMemoryBaseAddr();
+    void *q = nullptr;
+    RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
+    WritableSlice dest(q, mem_sz);
+    Status rc = BatchFetch(fbb, &dest);
+    if (rc.IsError()) {
+      DeallocateSharedMemory(client_id, q);
+      return rc;
     }
-    auto client_flag = rq->flag();
-    bool local_client = BitTest(client_flag, kLocalClientSupport);
-    // For large amount data to be sent back, we will use shared memory provided it is a local
-    // client that has local bypass support
-    bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
-    reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
-    if (local_bypass) {
-      // We will use shared memory
-      auto *base = SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
-      WritableSlice dest(q, mem_sz);
-      Status rc = BatchFetch(fbb, &dest);
-      if (rc.IsError()) {
-        DeallocateSharedMemory(client_id, q);
-        return rc;
-      }
-      // We can't return the absolute address which makes no sense to the client.
-      // Instead we return the difference.
-      auto difference = reinterpret_cast<int64_t>(q) - reinterpret_cast<int64_t>(base);
-      reply->set_result(std::to_string(difference));
-    } else {
-      // We are going to use std::string to allocate and hold the result which will be eventually
-      // 'moved' to the protobuf message (which underneath is also a std::string) for the purpose
-      // to minimize memory copy.
-      std::string mem;
-      try {
-        mem.resize(mem_sz);
-        CHECK_FAIL_RETURN_UNEXPECTED(mem.capacity() >= mem_sz, "Programming error");
-      } catch (const std::bad_alloc &e) {
-        RETURN_STATUS_OOM("Out of memory.");
-      }
-      WritableSlice dest(mem.data(), mem_sz);
-      RETURN_IF_NOT_OK(BatchFetch(fbb, &dest));
-      reply->set_result(std::move(mem));
+    // We can't return the absolute address which makes no sense to the client.
+    // Instead we return the difference.
+    *shm_addr = reinterpret_cast<int64_t>(q) - reinterpret_cast<int64_t>(base);
+  } else {
+    RETURN_UNEXPECTED_IF_NULL(out);
+    try {
+      out->resize(mem_sz);
+      CHECK_FAIL_RETURN_UNEXPECTED(out->capacity() >= mem_sz, "Programming error");
+    } catch (const std::bad_alloc &e) {
+      RETURN_STATUS_OOM("Out of memory.");
     }
+    WritableSlice dest(out->data(), mem_sz);
+    RETURN_IF_NOT_OK(BatchFetch(fbb, &dest));
   }
   return Status::OK();
 }
@@ -586,6 +638,8 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -719,7 +773,8 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.stat_.num_mem_hit, svc_stat.stat_.num_disk_hit);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -747,6 +802,10 @@ Status CacheServer::ListSessions(CacheReply *reply) {
 
 Status CacheServer::ConnectReset(CacheRequest *rq) {
   auto connection_id = rq->connection_id();
+  // The client should have unregistered its ring already. Stop serving it anyway.
+  if (rings_ != nullptr) {
+    rings_->RemoveRing(rq->client_id(), connection_id);
+  }
   // Hold the shared lock to prevent the cache from being dropped.
   SharedLock lck(&rwLock_);
   CacheService *cs = GetService(connection_id);
@@ -936,6 +995,14 @@ Status CacheServer::ProcessAdminRequest(CacheServerRequest *cache_req) {
       cache_req->rc_ = GetCacheState(&rq, &reply);
       break;
     }
+    case BaseRequest::RequestType::kRegisterRing: {
+      cache_req->rc_ = RegisterRing(&rq);
+      break;
+    }
+    case BaseRequest::RequestType::kUnregisterRing: {
+      cache_req->rc_ = UnregisterRing(&rq);
+      break;
+    }
     default:
       std::string errMsg("Internal error, request type is not admin request: ");
       errMsg += std::to_string(static_cast<uint16_t>(cache_req->type_));
@@ -1173,6 +1240,45 @@ Status CacheServer::RpcRequest(worker_id_t worker_id) {
   return Status::OK();
 }
 
+Status CacheServer::RingRequest(worker_id_t worker_id) {
+  TaskManager::FindMe()->Post();
+  RETURN_IF_NOT_OK(rings_->Serve());
+  return Status::OK();
+}
+
+Status CacheServer::RegisterRing(CacheRequest *rq) {
+  auto client_id = rq->client_id();
+  CHECK_FAIL_RETURN_UNEXPECTED(client_id != -1, "Client ID not set");
+  CHECK_FAIL_RETURN_UNEXPECTED(rings_ != nullptr, "Cache ring is not supported");
+  // First one is the address of the ring, followed by the block holding it.
+  enum BufDataIndex : uint8_t { kAddr = 0, kBlock = 1 };
+  constexpr int32_t kExpectedBufDataSize = 2;
+  CHECK_FAIL_RETURN_UNEXPECTED(rq->buf_data().size() == kExpectedBufDataSize, "Expect two pieces of data");
+  auto addr = strtoll(rq->buf_data(kAddr).data(), nullptr, kDecimal);
+  auto block = strtoll(rq->buf_data(kBlock).data(), nullptr, kDecimal);
+  // Value is in GB. Convert into bytes.
+  int64_t shm_mem_sz = static_cast<int64_t>(shared_memory_sz_in_gb_) * 1073741824L;
+  CHECK_FAIL_RETURN_UNEXPECTED(block >= 0 && block <= addr, "Cache ring out of its block");
+  CHECK_FAIL_RETURN_UNEXPECTED(addr + static_cast<int64_t>(sizeof(CacheRing)) <= shm_mem_sz,
+                               "Cache ring out of the shared memory");
+  auto *base = const_cast<void *>(SharedMemoryBaseAddr());
+  CacheRing *ring = nullptr;
+  RETURN_IF_NOT_OK(CacheRing::Attach(reinterpret_cast<void *>(reinterpret_cast<int64_t>(base) + addr), &ring));
+  // From now on the server frees the block, once the ring is removed and no thread serves it.
+  rings_->AddRing(client_id, rq->connection_id(), ring, block);
+  MS_LOG(INFO) << "Client id " << client_id << " of connection " << rq->connection_id() << " registers a cache ring";
+  return Status::OK();
+}
+
+Status CacheServer::UnregisterRing(CacheRequest *rq) {
+  auto client_id = rq->client_id();
+  CHECK_FAIL_RETURN_UNEXPECTED(client_id != -1, "Client ID not set");
+  if (rings_ != nullptr) {
+    rings_->RemoveRing(client_id, rq->connection_id());
+  }
+  return Status::OK();
+}
+
 Status CacheServer::AcknowledgeShutdown(CacheServerRequest *cache_req) {
   auto *rq = &cache_req->rq_;
   auto *reply = &cache_req->reply_;
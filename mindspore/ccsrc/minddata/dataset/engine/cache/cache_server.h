@@ -38,6 +38,7 @@
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_grpc_server.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/arena.h"
@@ -298,6 +299,7 @@ class CacheServer : public Service {
   bool numa_affinity_;
   std::vector<int32_t> shutdown_qIDs_;
   std::unique_ptr<CachedSharedMemory> shm_;
+  std::unique_ptr<CacheRingRegistry> rings_;  // Rings of the local clients, they free their blocks in shm_
 
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
@@ -333,6 +335,21 @@ class CacheServer : public Service {
   /// \return
   Status RpcRequest(worker_id_t worker_id);
 
+  /// \brief Entry point for the threads serving the rings of the local clients. They run beside the server workers
+  /// because a fetch waits for the rows from the server workers, and they sleep while there is no ring.
+  /// \return Status object
+  Status RingRequest(worker_id_t worker_id);
+
+  /// \brief Handle kRegisterRing request
+  /// \param rq
+  /// \return Status object
+  Status RegisterRing(CacheRequest *rq);
+
+  /// \brief Handle kUnregisterRing request
+  /// \param rq
+  /// \return Status object
+  Status UnregisterRing(CacheRequest *rq);
+
   Status DestroySession(CacheRequest *rq);
 
   /// \brief Create a connection id from a session id and a crc
@@ -469,6 +486,18 @@ class CacheServer : public Service {
   /// \return Status object
   Status BatchFetchRows(CacheRequest *rq, CacheReply *reply);
 
+  /// \brief Fetch rows in batch either into a shared memory block of the client or into a string
+  /// \param[in] shm_threshold Use shared memory if the rows take at least this many bytes, -1 to never use it.
+  /// \param[out] shm_addr Offset of the shared memory block, -1 if the rows are in out.
+  /// \param[out] out The rows if not in shared memory.
+  /// \return Status object
+  Status BatchFetchRows(connection_id_type connection_id, int32_t client_id, const std::vector<row_id_type> &row_id,
+                        int64_t shm_threshold, int64_t *shm_addr, std::string *out);
+
+  /// \brief Copy the rows located by PreBatchFetch, see BatchFetchRows
+  Status CopyBatch(int32_t client_id, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, size_t sz,
+                   int64_t shm_threshold, int64_t *shm_addr, std::string *out);
+
   /// \brief Main function to fetch rows in batch. The output is a contiguous memory which will be decoded
   /// by the CacheClient. Cache miss is not an error, and will be coded in the output to mark an empty row.
   /// \param[in] v A vector of row id.
@@ -232,18 +232,24 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
 }
 
 Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
-                                   const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb) {
+                                   const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, uint64_t *epoch) {
+  RETURN_UNEXPECTED_IF_NULL(epoch);
   SharedLock rw(&rw_lock_);
   if (HasBuildPhase() && st_ != CacheServiceState::kFetchPhase) {
     // For this kind of cache service, we can't fetch yet until we are done with caching all the rows.
     RETURN_STATUS_UNEXPECTED("Can't accept fetch request in non-fetch phase. Current phase: " +
                              std::to_string(static_cast<int>(st_.load())));
   }
+  *epoch = cp_->BeginFetch();
   std::vector<flatbuffers::Offset<DataLocatorMsg>> datalocator_v;
   datalocator_v.reserve(v.size());
   for (auto row_id : v) {
     flatbuffers::Offset<DataLocatorMsg> offset;
-    RETURN_IF_NOT_OK(cp_->GetDataLocator(row_id, fbb, &offset));
+    Status rc = cp_->GetDataLocator(row_id, fbb, &offset);
+    if (rc.IsError()) {
+      cp_->EndFetch(*epoch);
+      return rc;
+    }
     datalocator_v.push_back(offset);
   }
   auto offset_v = fbb->CreateVector(datalocator_v);
@@ -255,6 +261,11 @@ Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::
   return Status::OK();
 }
 
+void CacheService::PostBatchFetch(uint64_t epoch) {
+  SharedLock rw(&rw_lock_);
+  cp_->EndFetch(epoch);
+}
+
 Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   RETURN_UNEXPECTED_IF_NULL(p);
   SharedLock rw(&rw_lock_);
@@ -71,9 +71,14 @@ class CacheService : public Service {
   /// \brief This function is used in preparation for batch fetching.
   /// It calculates how much memory we should allocate and which row id are present, etc.
   /// All needed results are stored in the flat buffer.
+  /// \param[out] epoch The memory addresses in the flat buffer stay valid until PostBatchFetch of it.
   /// \return Status object
   Status PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
-                       const std::shared_ptr<flatbuffers::FlatBufferBuilder> &);
+                       const std::shared_ptr<flatbuffers::FlatBufferBuilder> &, uint64_t *epoch);
+
+  /// \brief Called once the rows located by PreBatchFetch are copied.
+  /// \param epoch Returned by PreBatchFetch
+  void PostBatchFetch(uint64_t epoch);
 
   /// \brief Getter function
   /// \return Spilling path
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "minddata/dataset/engine/cache/storage_manager.h"
+#include <zlib.h>
 #include <iomanip>
+#include <limits>
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
@@ -22,6 +24,63 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Deflate the slices into out. compressed is false if the result does not shrink enough to be kept.
+Status Deflate(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out, bool *compressed) {
+  *compressed = false;
+  auto limit = static_cast<size_t>(static_cast<double>(sz) * StorageManager::kMinCompressionRatio);
+  if (limit == 0 || sz > std::numeric_limits<uInt>::max()) {
+    return Status::OK();
+  }
+  try {
+    out->resize(limit);
+  } catch (const std::bad_alloc &e) {
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  z_stream strm{};
+  if (deflateInit(&strm, Z_BEST_SPEED) != Z_OK) {
+    RETURN_STATUS_UNEXPECTED("Failed to initialize zlib to compress the spilled data.");
+  }
+  strm.next_out = reinterpret_cast<Bytef *>(&(*out)[0]);
+  strm.avail_out = static_cast<uInt>(limit);
+  bool fits = true;
+  for (size_t i = 0; i < buf.size() && fits; ++i) {
+    int flush = (i + 1 == buf.size()) ? Z_FINISH : Z_NO_FLUSH;
+    if (buf[i].GetSize() == 0 && flush == Z_NO_FLUSH) {
+      continue;
+    }
+    strm.next_in = const_cast<Bytef *>(static_cast<const Bytef *>(buf[i].GetPointer()));
+    strm.avail_in = static_cast<uInt>(buf[i].GetSize());
+    int rc = deflate(&strm, flush);
+    // Running out of the output space means the data does not compress well enough.
+    fits = (flush == Z_FINISH) ? (rc == Z_STREAM_END) : (rc == Z_OK && strm.avail_in == 0);
+  }
+  if (fits) {
+    out->resize(strm.total_out);
+    *compressed = true;
+  }
+  (void)deflateEnd(&strm);
+  return Status::OK();
+}
+
+Status Inflate(const std::string &src, void *dest, size_t sz) {
+  z_stream strm{};
+  if (inflateInit(&strm) != Z_OK) {
+    RETURN_STATUS_UNEXPECTED("Failed to initialize zlib to decompress the spilled data.");
+  }
+  strm.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(src.data()));
+  strm.avail_in = static_cast<uInt>(src.size());
+  strm.next_out = static_cast<Bytef *>(dest);
+  strm.avail_out = static_cast<uInt>(sz);
+  int rc = inflate(&strm, Z_FINISH);
+  auto total_out = strm.total_out;
+  (void)inflateEnd(&strm);
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == Z_STREAM_END && total_out == sz,
+                               "Failed to decompress the spilled data, zlib error: " + std::to_string(rc));
+  return Status::OK();
+}
+}  // namespace
+
 std::string StorageManager::GetBaseName(const std::string &prefix, int32_t file_id) {
   std::ostringstream oss;
   oss << prefix << std::setfill('0') << std::setw(5) << file_id;
@@ -73,6 +132,15 @@ Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &bu
   if (sz == 0) {
     RETURN_STATUS_UNEXPECTED("Unexpected 0 length");
   }
+  std::string mem;
+  bool compressed = false;
+  RETURN_IF_NOT_OK(Deflate(buf, sz, &mem, &compressed));
+  std::vector<ReadableSlice> compressed_buf;
+  if (compressed) {
+    compressed_buf.emplace_back(mem.data(), mem.size());
+  }
+  const std::vector<ReadableSlice> &data = compressed ? compressed_buf : buf;
+  size_t stored_sz = compressed ? mem.size() : sz;
   auto mt = GetRandomDevice();
   std::shared_ptr<StorageContainer> cont;
   key_type out_key;
@@ -107,7 +175,7 @@ Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &bu
     size_t cont_index = writable_containers_pool_.at(pos_in_pool);
     cont = containers_.at(cont_index);
     off64_t offset;
-    Status rc = cont->Insert(buf, &offset);
+    Status rc = cont->Insert(data, &offset);
     if (rc.StatusCode() == StatusCode::kMDBuddySpaceFull) {
       create_new_container = true;
       old_container_pos = pos_in_pool;
@@ -115,9 +183,11 @@ Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &bu
       // if someone has already created it.
       last_num_container = num_containers;
     } else if (rc.IsOk()) {
-      out_value = std::make_pair(cont_index, std::make_pair(offset, sz));
+      out_value = StorageLocation{static_cast<int>(cont_index), offset, stored_sz, sz};
       RETURN_IF_NOT_OK(index_.insert(out_value, &out_key));
       *key = out_key;
+      stored_bytes_ += static_cast<int64_t>(stored_sz);
+      raw_bytes_ += static_cast<int64_t>(sz);
       break;
     } else {
       return rc;
@@ -132,9 +202,9 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   if (r.second) {
     auto &it = r.first;
     value_type v = *it;
-    size_t container_inx = v.first;
-    off_t offset = v.second.first;
-    size_t sz = v.second.second;
+    size_t container_inx = v.container;
+    off_t offset = v.offset;
+    size_t sz = v.sz;
     if (dest->GetSize() < sz) {
       std::string errMsg = "Destination buffer too small. Expect at least " + std::to_string(sz) +
                            " but length = " + std::to_string(dest->GetSize());
@@ -144,7 +214,19 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
       *bytesRead = sz;
     }
     auto cont = containers_.at(container_inx);
-    RETURN_IF_NOT_OK(cont->Read(dest, offset));
+    if (v.stored_sz == sz) {
+      RETURN_IF_NOT_OK(cont->Read(dest, offset));
+    } else {
+      std::string mem;
+      try {
+        mem.resize(v.stored_sz);
+      } catch (const std::bad_alloc &e) {
+        return Status(StatusCode::kMDOutOfMemory);
+      }
+      WritableSlice src(mem.data(), v.stored_sz);
+      RETURN_IF_NOT_OK(cont->Read(&src, offset));
+      RETURN_IF_NOT_OK(Inflate(mem, dest->GetMutablePointer(), sz));
+    }
   } else {
     RETURN_STATUS_UNEXPECTED("Key not found");
   }
@@ -168,10 +250,11 @@ Status StorageManager::DoServiceStop() noexcept {
   return rc1;
 }
 
-StorageManager::StorageManager(const Path &root) : root_(root), file_id_(0), index_(), pool_size_(1) {}
+StorageManager::StorageManager(const Path &root)
+    : root_(root), file_id_(0), index_(), pool_size_(1), stored_bytes_(0), raw_bytes_(0) {}
 
 StorageManager::StorageManager(const Path &root, size_t pool_size)
-    : root_(root), file_id_(0), index_(), pool_size_(pool_size) {}
+    : root_(root), file_id_(0), index_(), pool_size_(pool_size), stored_bytes_(0), raw_bytes_(0) {}
 
 StorageManager::~StorageManager() { (void)StorageManager::DoServiceStop(); }
 
@@ -18,6 +18,7 @@
 
 #include <unistd.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -47,10 +48,20 @@ class StorageManager : public Service {
     // Number of slots in each inner node of the tree
     static constexpr slot_type kInnerSlots = 256;
   };
-  using value_type = std::pair<int, std::pair<off_t, size_t>>;
+  /// \brief Where a buffer is kept in the containers
+  struct StorageLocation {
+    int container;
+    off_t offset;
+    size_t stored_sz;  // number of bytes on disk, less than sz if the buffer is compressed
+    size_t sz;         // number of bytes of the buffer
+  };
+  using value_type = StorageLocation;
   using storage_index = AutoIndexObj<value_type, std::allocator<value_type>, StorageBPlusTreeTraits>;
   using key_type = storage_index::key_type;
   constexpr static int32_t kMaxNumContainers = 1000;
+  /// A buffer is kept compressed only if it shrinks to this fraction of its size, otherwise the cost of inflating
+  /// it on every read is not worth the disk bandwidth saved.
+  constexpr static double kMinCompressionRatio = 0.875;
 
   explicit StorageManager(const Path &);
 
@@ -62,10 +73,26 @@ class StorageManager : public Service {
 
   StorageManager &operator=(const StorageManager &) = delete;
 
+  /// \brief Write a buffer to one of the containers. It is deflated with the fastest level of zlib first, since
+  /// spilled rows are read back many times and the disk is the bottleneck rather than the cpu.
+  /// \param[out] out_key Key to read the buffer back
+  /// \param buf A sequence of ReadableSlice objects consolidated into one buffer
+  /// \return Status object
   Status Write(key_type *out_key, const std::vector<ReadableSlice> &buf);
 
+  /// \brief Read a buffer back, inflating it if needed.
+  /// \param key Key returned by Write
+  /// \param[out] dest Destination of at least the size of the buffer
+  /// \param[out] bytesRead Size of the buffer before compression
+  /// \return Status object
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Number of bytes written to the containers and the size of the buffers they hold.
+  void GetSpillSize(int64_t *stored_sz, int64_t *sz) const {
+    *stored_sz = stored_bytes_;
+    *sz = raw_bytes_;
+  }
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -80,6 +107,8 @@ class StorageManager : public Service {
   storage_index index_;
   std::vector<size_t> writable_containers_pool_;
   size_t pool_size_;
+  std::atomic<int64_t> stored_bytes_;
+  std::atomic<int64_t> raw_bytes_;
 
   static std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
@@ -62,6 +62,8 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  shard_reader_->SetMmapRead(GlobalContext::config_manager()->enable_mindrecord_mmap());
+  shard_reader_->SetColumnarRead(true);
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
 
@@ -204,14 +206,20 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
   RETURN_UNEXPECTED_IF_NULL(fetched_row);
+  if (shard_reader_->IsMmapRead()) {
+    return GetRowViewFromReader(fetched_row, row_id, worker_id);
+  }
   *fetched_row = {};
   auto task_content_ptr = std::make_shared<mindrecord::TASK_CONTENT>(
     mindrecord::TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>());
   RETURN_IF_NOT_OK(shard_reader_->GetNextById(row_id, worker_id, &task_content_ptr));
   auto task_type = task_content_ptr->first;
   auto tupled_buffer = task_content_ptr->second;
+  std::shared_ptr<mindrecord::ShardColumnBuffer> raw_columns;
+  uint64_t raw_row = 0;
+  RETURN_IF_NOT_OK(shard_reader_->GetRawColumnsById(row_id, &raw_columns, &raw_row));
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, std::vector<uint8_t>(), mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -221,9 +229,9 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type, raw_columns.get(), raw_row));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -233,8 +241,54 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
+Status MindRecordOp::GetRowViewFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
+  RETURN_UNEXPECTED_IF_NULL(fetched_row);
+  *fetched_row = {};
+  std::shared_ptr<mindrecord::TASK_CONTENT_VIEW> task_content_ptr;
+  RETURN_IF_NOT_OK(shard_reader_->GetNextViewById(row_id, worker_id, &task_content_ptr));
+  if (task_content_ptr == nullptr) {
+    return Status::OK();
+  }
+  auto task_type = task_content_ptr->first;
+  const auto &tupled_buffer = task_content_ptr->second;
+  std::shared_ptr<mindrecord::ShardColumnBuffer> raw_columns;
+  uint64_t raw_row = 0;
+  RETURN_IF_NOT_OK(shard_reader_->GetRawColumnsById(row_id, &raw_columns, &raw_row));
+  if (task_type == mindrecord::TaskType::kPaddedTask) {
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, nullptr, 0, nullptr, mindrecord::json(), task_type));
+    std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+    fetched_row->setPath(file_path);
+    fetched_row->setId(row_id);
+    return Status::OK();
+  }
+  for (const auto &tupled_row : tupled_buffer) {
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, std::get<0>(tupled_row), std::get<1>(tupled_row), task_type,
+                                   raw_columns.get(), raw_row));
+    std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+    fetched_row->setPath(file_path);
+    fetched_row->setId(row_id);
+  }
+  return Status::OK();
+}
+
 Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
+                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                                   const mindrecord::ShardColumnBuffer *raw_columns, uint64_t raw_row) {
+  return LoadTensorRow(tensor_row, columns_blob.data(), columns_blob.size(), nullptr, columns_json, task_type,
+                       raw_columns, raw_row);
+}
+
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &blob_view,
+                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                                   const mindrecord::ShardColumnBuffer *raw_columns, uint64_t raw_row) {
+  return LoadTensorRow(tensor_row, blob_view.data, blob_view.size, blob_view.file, columns_json, task_type,
+                       raw_columns, raw_row);
+}
+
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                                   const std::shared_ptr<void> &blob_owner, const mindrecord::json &columns_json,
+                                   const mindrecord::TaskType task_type,
+                                   const mindrecord::ShardColumnBuffer *raw_columns, uint64_t raw_row) {
   RETURN_UNEXPECTED_IF_NULL(tensor_row);
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -246,6 +300,7 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     mindrecord::ColumnDataType column_data_type = mindrecord::ColumnNoDataType;
     uint64_t column_data_type_size = 1;
     std::vector<int64_t> column_shape;
+    int raw_column = raw_columns == nullptr ? -1 : raw_columns->GetColumnIndex(column_name);
 
     // Get column data
     auto shard_column = shard_reader_->GetShardColumn();
@@ -270,10 +325,16 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       if (data == nullptr) {
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
+    } else if (raw_column >= 0) {
+      // the raw field was decoded into the column buffer of the reader, no json is involved
+      mindrecord::ColumnCategory category;
+      RETURN_IF_NOT_OK(shard_column->GetColumnTypeByName(column_name, &column_data_type, &column_data_type_size,
+                                                         &column_shape, &category));
+      RETURN_IF_NOT_OK(raw_columns->GetColumnValue(raw_column, raw_row, &data, &n_bytes));
     } else {
-      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
-                                                          &n_bytes, &column_data_type, &column_data_type_size,
-                                                          &column_shape));
+      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data,
+                                                          &data_ptr, &n_bytes, &column_data_type,
+                                                          &column_data_type_size, &column_shape));
     }
 
     std::shared_ptr<Tensor> tensor;
@@ -284,6 +345,10 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     CHECK_FAIL_RETURN_UNEXPECTED(column_data_type_size != 0,
                                  "[Internal ERROR] Found memory size of column data type is 0.");
     auto num_elements = n_bytes / column_data_type_size;
+    // the tensor may view the blob only if the data was not decoded into a private buffer and it is aligned for
+    // its type, otherwise it is copied as usual. Raw fields are shared by all epochs, so they are always copied.
+    bool view_blob = blob_owner != nullptr && raw_column < 0 && data_ptr == nullptr && data != nullptr &&
+                     num_elements > 0 && reinterpret_cast<uintptr_t>(data) % column_data_type_size == 0;
     if (type == DataType::DE_STRING) {
       std::string s{data, data + n_bytes};
       RETURN_IF_NOT_OK(Tensor::CreateScalar(s, &tensor));
@@ -299,11 +364,19 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       } else {
         RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      if (view_blob) {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemoryNoCopy(new_shape, type, data, blob_owner, &tensor));
+      } else {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      }
     } else {
       std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
       auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      if (view_blob) {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemoryNoCopy(new_shape, type, data, blob_owner, &tensor));
+      } else {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      }
     }
     tensor_row->push_back(std::move(tensor));
   }
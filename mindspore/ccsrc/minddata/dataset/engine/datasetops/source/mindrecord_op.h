@@ -124,8 +124,30 @@ class MindRecordOp : public MappableLeafOp {
   /// @param tensor_row - the tensor row to put the parsed data in
   /// @param columns_blob - the blob data received from the reader
   /// @param columns_json - the data for fields received from the reader
+  /// @param raw_columns - the column buffer holding the raw fields instead of columns_json, may be null
+  /// @param raw_row - the position of the row in raw_columns
   Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
+                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                       const mindrecord::ShardColumnBuffer *raw_columns = nullptr, uint64_t raw_row = 0);
+
+  /// Parses a single cell from a blob which is viewed in a memory mapped file, numeric blob columns are not copied
+  /// @param tensor_row - the tensor row to put the parsed data in
+  /// @param blob_view - the view of the blob data received from the reader
+  /// @param columns_json - the data for fields received from the reader
+  /// @param raw_columns - the column buffer holding the raw fields instead of columns_json, may be null
+  /// @param raw_row - the position of the row in raw_columns
+  Status LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &blob_view,
+                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type,
+                       const mindrecord::ShardColumnBuffer *raw_columns = nullptr, uint64_t raw_row = 0);
+
+  /// Common implementation of LoadTensorRow, blob_owner is null when the blob is a private copy
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                       const std::shared_ptr<void> &blob_owner, const mindrecord::json &columns_json,
+                       const mindrecord::TaskType task_type, const mindrecord::ShardColumnBuffer *raw_columns = nullptr,
+                       uint64_t raw_row = 0);
+
+  /// Fetch a row through the memory mapped reader
+  Status GetRowViewFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
     return Status(StatusCode::kMDSyntaxError, "[Internal ERROR] Cannot call this method.");
@@ -0,0 +1,243 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/datasetops/source/sampler/global_shuffle_sampler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mindspore {
+namespace dataset {
+GlobalShuffleSamplerRT::GlobalShuffleSamplerRT(int64_t num_samples, uint32_t seed, bool reshuffle_each_epoch,
+                                               int64_t window_size)
+    : SamplerRT(num_samples, window_size),
+      seed_(seed),
+      reshuffle_each_epoch_(reshuffle_each_epoch),
+      window_size_(window_size),
+      num_buckets_(0),
+      index_(nullptr),
+      index_size_(0),
+      window_pos_(0),
+      next_bucket_(0),
+      next_id_(0) {}
+
+GlobalShuffleSamplerRT::~GlobalShuffleSamplerRT() { UnmapIndexFile(); }
+
+Status GlobalShuffleSamplerRT::GetNextSample(TensorRow *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (next_id_ > num_samples_) {
+    RETURN_STATUS_UNEXPECTED(
+      "[Internal ERROR] Sampler index must be less than or equal to num_samples(total rows in dataset), but got" +
+      std::to_string(next_id_) + ", num_samplers:" + std::to_string(num_samples_));
+  } else if (next_id_ == num_samples_) {
+    (*out) = TensorRow(TensorRow::kFlagEOE);
+  } else {
+    // the ids of the child are needed for the whole epoch, so they are fetched once at its start
+    if (HasChildSampler() && next_id_ == 0) {
+      RETURN_IF_NOT_OK(child_[0]->GetNextSample(&child_ids_));
+    }
+
+    std::shared_ptr<Tensor> sample_ids;
+    int64_t last_id = std::min(samples_per_tensor_ + next_id_, num_samples_);
+    RETURN_IF_NOT_OK(CreateSamplerTensor(&sample_ids, last_id - next_id_));
+    auto id_ptr = sample_ids->begin<int64_t>();
+    for (; next_id_ < last_id; ++next_id_) {
+      if (window_pos_ == window_.size()) {
+        RETURN_IF_NOT_OK(LoadWindow());
+      }
+      int64_t sampled_id = window_[window_pos_++];
+      if (HasChildSampler()) {
+        RETURN_IF_NOT_OK(GetAssociatedChildId(&sampled_id, sampled_id));
+      }
+      *id_ptr = sampled_id;
+      ++id_ptr;
+    }
+    (*out) = {sample_ids};
+  }
+  return Status::OK();
+}
+
+Status GlobalShuffleSamplerRT::InitSampler() {
+  if (is_initialized) {
+    return Status::OK();
+  }
+  // Special value of 0 for num_samples means that the user wants to sample the entire set of data.
+  // If the user asked to sample more rows than exists in the dataset, adjust the num_samples accordingly.
+  if (num_samples_ == 0 || num_samples_ > num_rows_) {
+    num_samples_ = num_rows_;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    num_samples_ > 0 && num_rows_ > 0,
+    "[Internal ERROR] num_samples and num_rows must be greater than 0, but got num_samples: " +
+      std::to_string(num_samples_) + ", num_rows: " + std::to_string(num_rows_));
+  CHECK_FAIL_RETURN_UNEXPECTED(window_size_ > 0, "[Internal ERROR] GlobalShuffleSampler: window_size must be "
+                                                 "greater than 0, but got: " +
+                                                   std::to_string(window_size_));
+  samples_per_tensor_ = samples_per_tensor_ > num_samples_ ? num_samples_ : samples_per_tensor_;
+
+  num_buckets_ = (num_rows_ + window_size_ - 1) / window_size_;
+#if defined(_WIN32) || defined(_WIN64)
+  // without the index file all the ids are kept in a single window
+  num_buckets_ = 1;
+#endif
+  if (num_buckets_ > 1) {
+    RETURN_IF_NOT_OK(MapIndexFile());
+  }
+  RETURN_IF_NOT_OK(ShuffleIndex());
+
+  is_initialized = true;
+  return Status::OK();
+}
+
+Status GlobalShuffleSamplerRT::ResetSampler(const bool failover_reset) {
+  CHECK_FAIL_RETURN_UNEXPECTED(failover_reset || next_id_ == num_samples_,
+                               "[Internal ERROR] ResetSampler() called early or late.");
+  if (reshuffle_each_epoch_) {
+    seed_++;
+  }
+  RETURN_IF_NOT_OK(ShuffleIndex());
+
+  if (HasChildSampler()) {
+    RETURN_IF_NOT_OK(child_[0]->ResetSampler(failover_reset));
+  }
+  return Status::OK();
+}
+
+Status GlobalShuffleSamplerRT::MapIndexFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  const char *tmp_dir = std::getenv("TMPDIR");
+  std::string path = std::string(tmp_dir != nullptr ? tmp_dir : "/tmp") + "/mindspore_global_shuffle_XXXXXX";
+  int fd = mkstemp(&path[0]);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "GlobalShuffleSampler: failed to create the index file: " + path +
+                                          ", error: " + std::strerror(errno));
+  // the file is only reachable through the mapping from now on, so it is cleaned up even if the process dies
+  (void)unlink(path.c_str());
+  index_size_ = static_cast<size_t>(num_rows_) * sizeof(int64_t);
+  if (ftruncate(fd, static_cast<off_t>(index_size_)) != 0) {
+    int err = errno;
+    (void)close(fd);
+    index_size_ = 0;
+    RETURN_STATUS_UNEXPECTED("GlobalShuffleSampler: failed to allocate the index file of " + std::to_string(num_rows_) +
+                             " rows, error: " + std::strerror(err));
+  }
+  void *addr = mmap(nullptr, index_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    index_size_ = 0;
+    RETURN_STATUS_UNEXPECTED("GlobalShuffleSampler: failed to map the index file, error: " +
+                             std::string(std::strerror(err)));
+  }
+  index_ = static_cast<int64_t *>(addr);
+#endif
+  return Status::OK();
+}
+
+void GlobalShuffleSamplerRT::UnmapIndexFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (index_ != nullptr && munmap(index_, index_size_) != 0) {
+    MS_LOG(ERROR) << "[Internal ERROR] GlobalShuffleSampler: failed to unmap the index file, errno: " << errno;
+  }
+#endif
+  index_ = nullptr;
+  index_size_ = 0;
+}
+
+Status GlobalShuffleSamplerRT::ShuffleIndex() {
+  rnd_.seed(seed_);
+  next_id_ = 0;
+  next_bucket_ = 0;
+  window_.clear();
+  window_pos_ = 0;
+  if (num_buckets_ == 1) {
+    return Status::OK();
+  }
+  RETURN_UNEXPECTED_IF_NULL(index_);
+
+  // The bucket of every id is drawn twice from the same seed, first to size the buckets, then to place the ids,
+  // so that no per-row state other than the index file itself is needed.
+  const uint32_t scatter_seed = rnd_();
+  std::mt19937 scatter_rnd(scatter_seed);
+  std::uniform_int_distribution<int64_t> count_dist(0, num_buckets_ - 1);
+  std::vector<int64_t> fill(num_buckets_, 0);
+  for (int64_t i = 0; i < num_rows_; i++) {
+    fill[count_dist(scatter_rnd)]++;
+  }
+  bucket_offsets_.assign(num_buckets_ + 1, 0);
+  for (int64_t b = 0; b < num_buckets_; b++) {
+    bucket_offsets_[b + 1] = bucket_offsets_[b] + fill[b];
+    fill[b] = bucket_offsets_[b];
+  }
+
+  scatter_rnd.seed(scatter_seed);
+  std::uniform_int_distribution<int64_t> place_dist(0, num_buckets_ - 1);
+  for (int64_t i = 0; i < num_rows_; i++) {
+    index_[fill[place_dist(scatter_rnd)]++] = i;
+  }
+  return Status::OK();
+}
+
+Status GlobalShuffleSamplerRT::LoadWindow() {
+  window_pos_ = 0;
+  if (num_buckets_ == 1) {
+    CHECK_FAIL_RETURN_UNEXPECTED(next_bucket_ == 0, "[Internal ERROR] GlobalShuffleSampler: no ids left to sample.");
+    window_.resize(num_rows_);
+    for (int64_t i = 0; i < num_rows_; i++) {
+      window_[i] = i;
+    }
+    next_bucket_ = 1;
+  } else {
+    do {
+      CHECK_FAIL_RETURN_UNEXPECTED(next_bucket_ < num_buckets_,
+                                   "[Internal ERROR] GlobalShuffleSampler: no ids left to sample.");
+      window_.assign(index_ + bucket_offsets_[next_bucket_], index_ + bucket_offsets_[next_bucket_ + 1]);
+      next_bucket_++;
+    } while (window_.empty());
+  }
+  std::shuffle(window_.begin(), window_.end(), rnd_);
+  return Status::OK();
+}
+
+void GlobalShuffleSamplerRT::SamplerPrint(std::ostream &out, bool show_all) const {
+  out << "\nSampler: GlobalShuffleSampler";
+  if (show_all) {
+    // Call the super class for displaying any common detailed info
+    SamplerRT::SamplerPrint(out, show_all);
+    // Then add our own info if any
+    out << "\nWindow size: " << window_size_;
+  }
+}
+
+Status GlobalShuffleSamplerRT::to_json(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  nlohmann::json args;
+  RETURN_IF_NOT_OK(SamplerRT::to_json(&args));
+  args["sampler_name"] = "GlobalShuffleSampler";
+  args["reshuffle_each_epoch"] = reshuffle_each_epoch_;
+  args["window_size"] = window_size_;
+  *out_json = args;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_GLOBAL_SHUFFLE_SAMPLER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_GLOBAL_SHUFFLE_SAMPLER_H_
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Sampler which hands out a uniform random permutation of all the rows while keeping at most one window of
+///     row ids in memory.
+///
+/// Every row id is scattered into a uniformly drawn bucket of a memory mapped index file, and the buckets are read
+/// back one at a time and shuffled in memory, which yields a uniform permutation of the whole dataset. A bucket holds
+/// about window_size ids, so the memory does not grow with the dataset and the file is written and read mostly
+/// sequentially. The leaf op loads the rows in this order through its IOBlock workers.
+class GlobalShuffleSamplerRT : public SamplerRT {
+ public:
+  /// \brief Constructor
+  /// \param[in] num_samples Number of samples to draw, 0 for all the rows.
+  /// \param[in] seed Seed of the first epoch.
+  /// \param[in] reshuffle_each_epoch Whether every epoch gets a new permutation.
+  /// \param[in] window_size Number of row ids kept in memory, also the number of ids returned by one GetNextSample.
+  GlobalShuffleSamplerRT(int64_t num_samples, uint32_t seed, bool reshuffle_each_epoch, int64_t window_size);
+
+  /// \brief Destructor, releases the index file.
+  ~GlobalShuffleSamplerRT() override;
+
+  /// \brief Op calls this to get the next window of sample ids.
+  /// \param[out] out TensorRow of sample ids, or an eoe row at the end of the epoch.
+  /// \return Status The status code returned
+  Status GetNextSample(TensorRow *out) override;
+
+  /// \brief Meant to be called by base class or python.
+  /// \return Status The status code returned
+  Status InitSampler() override;
+
+  /// \brief Reset for next epoch.
+  /// \param[in] failover_reset A boolean to show whether we are resetting the pipeline
+  /// \return Status The status code returned
+  Status ResetSampler(const bool failover_reset = false) override;
+
+  void SamplerPrint(std::ostream &out, bool show_all) const override;
+
+  /// \brief Get the arguments of node
+  /// \param[out] out_json JSON string of all attributes
+  /// \return Status of the function
+  Status to_json(nlohmann::json *out_json) override;
+
+ private:
+  /// \brief Create the index file of num_rows_ ids and map it, it is removed from the file system at once.
+  /// \return Status The status code returned
+  Status MapIndexFile();
+
+  /// \brief Unmap the index file if it is mapped.
+  void UnmapIndexFile();
+
+  /// \brief Scatter all the row ids into the buckets of the current epoch and rewind to the first bucket.
+  /// \return Status The status code returned
+  Status ShuffleIndex();
+
+  /// \brief Read the next non-empty bucket into the window and shuffle it.
+  /// \return Status The status code returned
+  Status LoadWindow();
+
+  uint32_t seed_;
+  bool reshuffle_each_epoch_;
+  int64_t window_size_;
+  int64_t num_buckets_;
+  std::vector<int64_t> bucket_offsets_;  // num_buckets_ + 1 offsets into the index file
+  int64_t *index_;                       // mapped index file, nullptr when all the ids fit in one window
+  size_t index_size_;
+  std::vector<int64_t> window_;
+  size_t window_pos_;
+  int64_t next_bucket_;
+  int64_t next_id_;
+  std::mt19937 rnd_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_GLOBAL_SHUFFLE_SAMPLER_H_
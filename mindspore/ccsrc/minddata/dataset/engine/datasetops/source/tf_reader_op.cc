@@ -661,20 +661,15 @@ Status TFReaderOp::LoadExample(const dataengine::Example *tf_record_file, Tensor
 Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
                                const ColDescriptor &current_col, int32_t col) {
   const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
 
-  // This variable will point into the above staging variables.
-  // Also used for creating shape attributes.
+  // Used for creating shape attributes.
   int32_t num_elements = 0;
 
   // we build a tensor first a read directly into it if we need to cast
   std::shared_ptr<Tensor> ts;
 
-  // Depending on the type of data from the tf_record_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
+  // Depending on the type of data from the tf_record_file, the values are read straight into a tensor of the
+  // shape and type of the column.
   switch (column_list_type) {
     case dataengine::Feature::KindCase::kBytesList: {
       RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
@@ -682,15 +677,7 @@ Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature
       break;
     }
     case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.Type(), data_ptr, &ts));
+      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &ts));
       break;
     }
     case dataengine::Feature::KindCase::kInt64List: {
@@ -783,7 +770,7 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
 }
 
 Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
+                                 int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // KFloatList can only map to DE types:
   // DE_FLOAT32
   if (current_col.Type() != DataType::DE_FLOAT32) {
@@ -794,13 +781,12 @@ Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataeng
 
   const dataengine::FloatList &float_list = column_values_list.float_list();
 
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
+  // The values are contiguous in the float list, so they are copied into the tensor in one go
   *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
-  }
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
+  const auto *data_ptr = reinterpret_cast<const unsigned char *>(float_list.value().data());
+  RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.Type(), data_ptr, tensor));
 
   return Status::OK();
 }
@@ -300,10 +300,10 @@ class TFReaderOp : public NonMappableLeafOp {
   /// @param current_col - the column descriptor containing the expected shape and type of the data.
   /// @param column_values_list - the cell that contains the float list to read from.
   /// @Param numElements - number of values in the float list.
-  /// @param float_array - the array we read the values into.
+  /// @param tensor - the tensor we read the values into.
   /// @return Status - the error code returned.
   Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
+                       int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   /// Reads values from a bytes list and casts the value to type T, must be an integral
   /// type compatible with int64_t
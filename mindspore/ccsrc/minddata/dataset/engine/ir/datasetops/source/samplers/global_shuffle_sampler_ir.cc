@@ -0,0 +1,91 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/global_shuffle_sampler_ir.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/global_shuffle_sampler.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+// Constructor
+GlobalShuffleSamplerObj::GlobalShuffleSamplerObj(int64_t num_samples, uint32_t seed, bool reshuffle_each_epoch,
+                                                 int64_t window_size)
+    : num_samples_(num_samples), seed_(seed), reshuffle_each_epoch_(reshuffle_each_epoch), window_size_(window_size) {}
+
+// Destructor
+GlobalShuffleSamplerObj::~GlobalShuffleSamplerObj() = default;
+
+Status GlobalShuffleSamplerObj::ValidateParams() {
+  if (num_samples_ < 0) {
+    RETURN_STATUS_UNEXPECTED("GlobalShuffleSampler: num_samples must be greater than or equal to 0, but got: " +
+                             std::to_string(num_samples_));
+  }
+  if (window_size_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("GlobalShuffleSampler: window_size must be greater than 0, but got: " +
+                             std::to_string(window_size_));
+  }
+  return Status::OK();
+}
+
+Status GlobalShuffleSamplerObj::to_json(nlohmann::json *const out_json) {
+  nlohmann::json args;
+  RETURN_IF_NOT_OK(SamplerObj::to_json(&args));
+  args["sampler_name"] = "GlobalShuffleSampler";
+  args["seed"] = seed_;
+  args["reshuffle_each_epoch"] = reshuffle_each_epoch_;
+  args["window_size"] = window_size_;
+  args["num_samples"] = num_samples_;
+  *out_json = args;
+  return Status::OK();
+}
+
+#ifndef ENABLE_ANDROID
+Status GlobalShuffleSamplerObj::from_json(nlohmann::json json_obj, int64_t num_samples,
+                                          std::shared_ptr<SamplerObj> *sampler) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "seed", "GlobalShuffleSampler"));
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "reshuffle_each_epoch", "GlobalShuffleSampler"));
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "window_size", "GlobalShuffleSampler"));
+  uint32_t seed = json_obj["seed"];
+  bool reshuffle_each_epoch = json_obj["reshuffle_each_epoch"];
+  int64_t window_size = json_obj["window_size"];
+  *sampler = std::make_shared<GlobalShuffleSamplerObj>(num_samples, seed, reshuffle_each_epoch, window_size);
+  // Run common code in super class to add children samplers
+  RETURN_IF_NOT_OK(SamplerObj::from_json(json_obj, sampler));
+  return Status::OK();
+}
+#endif
+
+Status GlobalShuffleSamplerObj::SamplerBuild(std::shared_ptr<SamplerRT> *sampler) {
+  // runtime sampler object
+  *sampler =
+    std::make_shared<dataset::GlobalShuffleSamplerRT>(num_samples_, seed_, reshuffle_each_epoch_, window_size_);
+  Status s = BuildChildren(sampler);
+  sampler = s.IsOk() ? sampler : nullptr;
+  return s;
+}
+
+std::shared_ptr<SamplerObj> GlobalShuffleSamplerObj::SamplerCopy() {
+  auto sampler = std::make_shared<GlobalShuffleSamplerObj>(num_samples_, seed_, reshuffle_each_epoch_, window_size_);
+  for (const auto &child : children_) {
+    Status rc = sampler->AddChildSampler(child);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "[Internal ERROR] Error in copying the sampler. Message: " << rc;
+    }
+  }
+  return sampler;
+}
+}  // namespace dataset
+}  // namespace mindspore
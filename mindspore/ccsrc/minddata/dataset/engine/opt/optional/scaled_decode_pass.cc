@@ -0,0 +1,77 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/optional/scaled_decode_pass.h"
+
+#include <vector>
+
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status ScaledDecodePass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  constexpr size_t kResizeSizeHW = 2;
+
+  // The operations may be shared with other pipelines, so they are copied before they are changed.
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i] == nullptr) {
+      continue;
+    }
+    if (ops[i]->Name() == vision::kRandomCropDecodeResizeNormalizeOperation) {
+      auto *crop_ir = dynamic_cast<vision::RandomCropDecodeResizeNormalizeOperation *>(ops[i].get());
+      RETURN_UNEXPECTED_IF_NULL(crop_ir);
+      auto scaled_ir = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(*crop_ir);
+      scaled_ir->SetScaledDecode(true);
+      ops[i] = scaled_ir;
+      *modified = true;
+    } else if (ops[i]->Name() == vision::kRandomCropDecodeResizeOperation) {
+      auto *crop_ir = dynamic_cast<vision::RandomCropDecodeResizeOperation *>(ops[i].get());
+      RETURN_UNEXPECTED_IF_NULL(crop_ir);
+      auto scaled_ir = std::make_shared<vision::RandomCropDecodeResizeOperation>(*crop_ir);
+      scaled_ir->SetScaledDecode(true);
+      ops[i] = scaled_ir;
+      *modified = true;
+    } else if (ops[i]->Name() == vision::kDecodeOperation && i + 1 < ops.size() && ops[i + 1] != nullptr &&
+               ops[i + 1]->Name() == vision::kResizeOperation) {
+      auto *decode_ir = dynamic_cast<vision::DecodeOperation *>(ops[i].get());
+      auto *resize_ir = dynamic_cast<vision::ResizeOperation *>(ops[i + 1].get());
+      RETURN_UNEXPECTED_IF_NULL(decode_ir);
+      RETURN_UNEXPECTED_IF_NULL(resize_ir);
+      // a single size keeps the aspect ratio, which the rounding of the reduced resolution would change
+      if (decode_ir->DeviceTarget() != "CPU" || !decode_ir->IsRgb() || resize_ir->DeviceTarget() != "CPU" ||
+          resize_ir->Size().size() != kResizeSizeHW) {
+        continue;
+      }
+      auto scaled_ir = std::make_shared<vision::DecodeOperation>(*decode_ir);
+      scaled_ir->SetTargetSize(resize_ir->Size()[0], resize_ir->Size()[1]);
+      ops[i] = scaled_ir;
+      *modified = true;
+    }
+  }
+  RETURN_OK_IF_TRUE(!*modified);
+  node->setOperations(ops);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
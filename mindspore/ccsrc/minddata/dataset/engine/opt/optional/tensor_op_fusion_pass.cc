@@ -16,6 +16,8 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,11 +26,44 @@
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Fuses RandomCropDecodeResize followed by a CPU Normalize of HWC images, and HWC2CHW if it comes next, so the
+// decoded crop is resized, normalized and transposed in one pass.
+Status FuseNormalize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified) {
+  const std::vector<std::string> pattern = {vision::kRandomCropDecodeResizeOperation, vision::kNormalizeOperation};
+  auto itr = ops->begin();
+  while (true) {
+    itr = std::search(itr, ops->end(), pattern.begin(), pattern.end(),
+                      [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+    RETURN_OK_IF_TRUE(itr == ops->end());
+    auto *crop_ir = dynamic_cast<vision::RandomCropDecodeResizeOperation *>(itr->get());
+    auto *normalize_ir = dynamic_cast<vision::NormalizeOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(crop_ir);
+    RETURN_UNEXPECTED_IF_NULL(normalize_ir);
+    if (normalize_ir->DeviceTarget() != "CPU" || !normalize_ir->IsHwc()) {
+      ++itr;
+      continue;
+    }
+    auto last = itr + 2;
+    bool hwc_to_chw = last != ops->end() && *last != nullptr && (*last)->Name() == vision::kHwcToChwOperation;
+    if (hwc_to_chw) {
+      ++last;
+    }
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(*crop_ir, normalize_ir->Mean(),
+                                                                                normalize_ir->Std(), hwc_to_chw);
+    itr = ops->erase(itr + 1, last);
+    *modified = true;
+  }
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   RETURN_UNEXPECTED_IF_NULL(node);
@@ -54,16 +89,18 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    *modified = true;
+  }
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
+  RETURN_IF_NOT_OK(FuseNormalize(&ops, modified));
+  RETURN_OK_IF_TRUE(!*modified);
   node->setOperations(ops);
-  *modified = true;
   return Status::OK();
 }
 }  // namespace dataset
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/pre/global_shuffle_pass.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/rename_node.h"
+#include "minddata/dataset/engine/ir/datasetops/shuffle_node.h"
+#ifdef ENABLE_PYTHON
+#include "minddata/dataset/engine/ir/datasetops/source/generator_node.h"
+#endif
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
+#endif
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/global_shuffle_sampler_ir.h"
+
+namespace mindspore {
+namespace dataset {
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) {
+  // a shuffle below another one takes over the chain, the upper one is kept as it is
+  shuffle_ = node;
+  return Status::OK();
+}
+
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  if (node->IsCached()) {
+    shuffle_ = nullptr;
+  }
+  return Status::OK();
+}
+
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
+  return Status::OK();
+}
+
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<RenameNode> node, bool *const modified) {
+  return Status::OK();
+}
+
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<MappableSourceNode> node, bool *const modified) {
+  // a cached source is read through the cache, which is fed in the order of the sampler only once
+  if (shuffle_ != nullptr && !node->IsCached()) {
+    (void)shuffles_to_replace_.emplace_back(shuffle_, node);
+  }
+  shuffle_ = nullptr;
+  return Status::OK();
+}
+
+#ifdef ENABLE_PYTHON
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<GeneratorNode> node, bool *const modified) {
+  if (!node->IsMappableSource()) {
+    return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
+  }
+  return Visit(std::static_pointer_cast<MappableSourceNode>(node), modified);
+}
+#endif
+
+#ifndef ENABLE_ANDROID
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<MindDataNode> node, bool *const modified) {
+  return Visit(std::static_pointer_cast<DatasetNode>(node), modified);
+}
+#endif
+
+Status GlobalShufflePass::ShuffleNodes::Visit(std::shared_ptr<DatasetNode> node, bool *const modified) {
+  shuffle_ = nullptr;
+  return Status::OK();
+}
+
+// Walk the tree to move the shuffles over mappable sources into their samplers.
+Status GlobalShufflePass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  int64_t window_size = GlobalContext::config_manager()->global_shuffle_window();
+  if (window_size <= 0) {
+    return Status::OK();
+  }
+  MS_LOG(INFO) << "Pre pass: global shuffle pass started.";
+  std::unique_ptr<GlobalShufflePass::ShuffleNodes> shuffle_nodes = std::make_unique<GlobalShufflePass::ShuffleNodes>();
+  RETURN_IF_NOT_OK(shuffle_nodes->Run(root_ir, modified));
+
+  for (const auto &iter : shuffle_nodes->shuffles_to_replace()) {
+    auto shuffle = iter.first;
+    auto source = iter.second;
+    MS_LOG(INFO) << "Replacing the shuffle above " << source->Name() << " with a GlobalShuffleSampler("
+                 << window_size << ").";
+    auto new_sampler = std::make_shared<GlobalShuffleSamplerObj>(0, shuffle->ShuffleSeed(),
+                                                                 shuffle->ResetEveryEpoch(), window_size);
+    auto sampler = source->Sampler();
+    if (sampler != nullptr) {
+      RETURN_IF_NOT_OK(new_sampler->AddChildSampler(sampler));
+    }
+    source->SetSampler(new_sampler);
+    RETURN_IF_NOT_OK(shuffle->Drop());
+    *modified = true;
+  }
+
+  MS_LOG(INFO) << "Pre pass: global shuffle pass complete.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_GLOBAL_SHUFFLE_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_GLOBAL_SHUFFLE_PASS_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetNode;
+class MappableSourceNode;
+class MapNode;
+#ifndef ENABLE_ANDROID
+class MindDataNode;
+#endif
+class ProjectNode;
+class RenameNode;
+class ShuffleNode;
+
+/// \class GlobalShufflePass global_shuffle_pass.h
+/// \brief This is a tree pass that replaces a ShuffleNode over a mappable source by a GlobalShuffleSampler of that
+///     source, when a global shuffle window is configured. The rows are then loaded in shuffled order by the source
+///     instead of being buffered by a ShuffleOp. Only MapNode, ProjectNode and RenameNode may be between the two
+///     nodes, since they keep a one to one relation between input and output rows.
+class GlobalShufflePass : public IRTreePass {
+  /// \class ShuffleNodes
+  /// \brief This is a NodePass whose job is to find the ShuffleNodes which can be replaced, and their sources.
+  ///     It works in conjunction with the GlobalShufflePass.
+  class ShuffleNodes : public IRNodePass {
+   public:
+    /// \brief Constructor
+    ShuffleNodes() = default;
+
+    /// \brief Destructor
+    ~ShuffleNodes() override = default;
+
+    /// \brief Start a chain from a ShuffleNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) override;
+
+    /// \brief A MapNode does not break the chain unless it is cached
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+    /// \brief A ProjectNode does not break the chain
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ProjectNode> node, bool *const modified) override;
+
+    /// \brief A RenameNode does not break the chain
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<RenameNode> node, bool *const modified) override;
+
+    /// \brief Complete a chain at a MappableSourceNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MappableSourceNode> node, bool *const modified) override;
+
+#ifdef ENABLE_PYTHON
+    /// \brief Complete a chain at a GeneratorNode if it is mappable
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<GeneratorNode> node, bool *const modified) override;
+#endif
+
+#ifndef ENABLE_ANDROID
+    /// \brief A MindDataNode breaks the chain, since its samplers are built for the shard reader
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MindDataNode> node, bool *const modified) override;
+#endif
+
+    /// \brief Any other node breaks the chain
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<DatasetNode> node, bool *const modified) override;
+
+    /// \brief Getter
+    /// \return All the ShuffleNodes to be replaced, with the source that takes over the shuffle
+    const std::vector<std::pair<std::shared_ptr<ShuffleNode>, std::shared_ptr<MappableSourceNode>>> &
+    shuffles_to_replace() const {
+      return shuffles_to_replace_;
+    }
+
+   private:
+    std::vector<std::pair<std::shared_ptr<ShuffleNode>, std::shared_ptr<MappableSourceNode>>> shuffles_to_replace_;
+    std::shared_ptr<ShuffleNode> shuffle_;  // the ShuffleNode of the current chain, nullptr if there is none
+  };
+
+ public:
+  /// \brief Constructor
+  GlobalShufflePass() = default;
+
+  /// \brief Destructor
+  ~GlobalShufflePass() override = default;
+
+  /// \brief Runs a ShuffleNodes pass to find the shuffles over mappable sources, then moves them into the samplers.
+  /// \param[in, out] tree The tree to operate on.
+  /// \param[in, out] Indicate of the tree was modified.
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_GLOBAL_SHUFFLE_PASS_H_
@@ -17,6 +17,8 @@
 #include "minddata/dataset/engine/perf/auto_tune.h"
 
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -24,6 +26,7 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <limits>
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 #include "minddata/dataset/engine/serdes.h"
@@ -53,7 +56,9 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       phase_3_ID_(0),
       avg_batch_time(0.0),
       phase_3_prev_avg_(0.0),
-      save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()) {
+      save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()),
+      model_mode_(GlobalContext::config_manager()->enable_autotune_model()),
+      model_fits_(0) {
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
 }
@@ -61,7 +66,12 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
 Status AutoTune::Main() {
   TaskManager::FindMe()->Post();
   MS_LOG(INFO) << "Dataset AutoTune thread has started.";
-  if (step_gap_ != 0) {
+  if (model_mode_) {
+    // The model is fitted to short windows of steps so that it is applied within the first epoch.
+    mode_ = AutoTuneMode::kAutoTuneModeStep;
+    step_gap_ = MODEL_SAMPLE_STEPS;
+    AT_phase_ = AutoTunePhase::kAutoTunePhaseModel;
+  } else if (step_gap_ != 0) {
     mode_ = AutoTuneMode::kAutoTuneModeStep;
   } else {
     mode_ = AutoTuneMode::kAutoTuneModeEpoch;
@@ -75,7 +85,23 @@ Status AutoTune::Main() {
   }
   bool output_final_config = save_autoconfig_ && !nodes_offloaded;
   bool output_intermediate_config = save_intermediate_autoconfig_ && output_final_config;
-  RETURN_IF_NOT_OK(ATMainLoop(output_intermediate_config));
+#ifndef ENABLE_ANDROID
+  const std::string model_config_file =
+    autotune_json_filepath_ + "_" + profiling_manager_->GetRankID() + "_model.json";
+  if (model_mode_ && save_autoconfig_) {
+    bool applied = false;
+    Status rc = LoadModelConfig(model_config_file, &applied);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to apply the saved AutoTune model configuration, the model is fitted again. " << rc;
+    } else if (applied) {
+      MS_LOG(INFO) << "Dataset AutoTune applied the saved model configuration: " << model_config_file;
+      AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+    }
+  }
+#endif
+  if (AT_phase_ != AutoTunePhase::kAutoTuneEnd) {
+    RETURN_IF_NOT_OK(ATMainLoop(output_intermediate_config));
+  }
   RETURN_IF_NOT_OK(profiling_manager_->Stop());
   PostMainLogging();
 #ifndef ENABLE_ANDROID
@@ -83,6 +109,9 @@ Status AutoTune::Main() {
       (SaveAutotuneConfig(autotune_json_filepath_ + "_" + profiling_manager_->GetRankID() + ".json").IsError())) {
     MS_LOG(WARNING) << "Failed to write the final autotune configuration to disk";
   }
+  if (output_final_config && model_fits_ > 0 && SaveModelConfig(model_config_file).IsError()) {
+    MS_LOG(WARNING) << "Failed to write the AutoTune model configuration to disk";
+  }
 #endif
   return Status::OK();
 }
@@ -185,8 +214,82 @@ Status AutoTune::SetAutotuneConfigJson() {
   }
   return Status::OK();
 }
+
+Status AutoTune::SaveModelConfig(const std::string &file_name) {
+  nlohmann::json ops = nlohmann::json::array();
+  ExecutionTree const *tree = tree_adapter_->tree_.get();
+  for (auto itr = tree->begin(); itr != tree->end(); (void)itr++) {
+    if (!itr->inlined() && itr->Name() != "DataQueueOp") {
+      nlohmann::json op;
+      op["name"] = itr->NameWithID();
+      op["num_parallel_workers"] = itr->NumWorkers();
+      op["prefetch_size"] = itr->ConnectorCapacity();
+      ops.push_back(op);
+    }
+  }
+  nlohmann::json out_json;
+  out_json["remark"] = "The following file has been auto-generated by the Dataset AutoTune model.";
+  out_json["pipeline"] = GetPipelineSignature();
+  out_json["ops"] = ops;
+  RETURN_IF_NOT_OK(Serdes::SaveJSONToFile(out_json, file_name, true));
+  return Status::OK();
+}
+
+Status AutoTune::LoadModelConfig(const std::string &file_name, bool *applied) {
+  RETURN_UNEXPECTED_IF_NULL(applied);
+  *applied = false;
+  Path jsonpath(file_name);
+  if (!jsonpath.Exists()) {
+    return Status::OK();
+  }
+  nlohmann::json config;
+  std::ifstream json_in(file_name, std::ios::in);
+  CHECK_FAIL_RETURN_UNEXPECTED(json_in, "Invalid file, failed to open json file: " + file_name);
+  std::map<int32_t, std::pair<int32_t, int32_t>> targets;
+  try {
+    json_in >> config;
+    if (config.at("pipeline") != nlohmann::json(GetPipelineSignature())) {
+      MS_LOG(INFO) << "The AutoTune model configuration " << file_name << " is for another pipeline, it is ignored.";
+      return Status::OK();
+    }
+    std::map<std::string, int32_t> op_ids;
+    for (const auto &op : ops_) {
+      op_ids[op.second->NameWithID()] = op.first;
+    }
+    for (const auto &op : config.at("ops")) {
+      auto id = op_ids.find(op.at("name").get<std::string>());
+      CHECK_FAIL_RETURN_UNEXPECTED(id != op_ids.end(), "Unknown op in " + file_name);
+      targets[id->second] = {op.at("num_parallel_workers").get<int32_t>(), op.at("prefetch_size").get<int32_t>()};
+    }
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse json file: " + file_name + ", error message: " + e.what());
+  }
+  for (const auto &target : targets) {
+    auto &op = ops_[target.first];
+    int32_t workers = target.second.first;
+    if (op->NumWorkers() > 0 && workers != op->NumWorkers() && !SkipOpsCheck(target.first)) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(target.first, op->NumWorkers(), &workers));
+    }
+    if (target.second.second != op->ConnectorCapacity()) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(target.first, op->ConnectorCapacity(), target.second.second));
+    }
+  }
+  *applied = true;
+  return Status::OK();
+}
 #endif
 
+std::vector<std::string> AutoTune::GetPipelineSignature() const {
+  std::vector<std::string> names;
+  ExecutionTree const *tree = tree_adapter_->tree_.get();
+  for (auto itr = tree->begin(); itr != tree->end(); (void)itr++) {
+    if (!itr->inlined() && itr->Name() != "DataQueueOp") {
+      names.push_back(itr->NameWithID());
+    }
+  }
+  return names;
+}
+
 Status AutoTune::SummarizeTreeConfiguration(std::vector<std::string> *out) {
   constexpr int op_name_width = 20;
   constexpr int val_width = 2;
@@ -368,9 +471,9 @@ bool AutoTune::WarmupSkipCheck() {
       return false;
     }
   } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
-    int64_t skip_value = std::max(STEP_WARMUP, step_gap_);
+    int64_t skip_value = model_mode_ ? MODEL_WARMUP_STEPS : std::max(STEP_WARMUP, step_gap_);
     if (cur_step_running_ > skip_value) {
-      last_step_autotuned_ = std::min(STEP_WARMUP, step_gap_);
+      last_step_autotuned_ = model_mode_ ? MODEL_WARMUP_STEPS : std::min(STEP_WARMUP, step_gap_);
       skip_flag_ = false;
       return false;
     }
@@ -477,6 +580,8 @@ Status AutoTune::RunIteration() {
     RETURN_IF_NOT_OK(AnalyseTime());
   } else if (AT_phase_ == AutoTunePhase::kAutoTunePhaseMemory) {
     RETURN_IF_NOT_OK(AnalyseMemory());
+  } else if (AT_phase_ == AutoTunePhase::kAutoTunePhaseModel) {
+    RETURN_IF_NOT_OK(AnalyseModel());
   }
   return Status::OK();
 }
@@ -753,5 +858,174 @@ Status AutoTune::AnalyseMemory() {
   }
   return Status::OK();
 }
+
+Status AutoTune::GetMemoryBudget(double *process_mem, double *mem_budget) {
+  *process_mem = 0;
+  *mem_budget = 0;
+#ifndef ENABLE_ANDROID
+  std::vector<float> process_mems;
+  std::vector<float> available_mems;
+  RETURN_IF_NOT_OK(profiling_manager_->GetMainProcessMemoryInfoByStep(ProcessMemoryMetric::kPSS, last_step_autotuned_,
+                                                                      cur_step_running_ - 1, &process_mems));
+  RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByStep(
+    SystemMemoryMetric::kMemoryAvailable, last_step_autotuned_, cur_step_running_ - 1, &available_mems));
+  if (process_mems.empty() || available_mems.empty()) {
+    return Status::OK();
+  }
+  *process_mem = Mean(process_mems);
+  *mem_budget = Mean(available_mems) * MODEL_QUEUE_MEMORY_FRACTION;
+#endif
+  return Status::OK();
+}
+
+Status AutoTune::AnalyseModel() {
+  std::vector<int32_t> batch_times;
+  RETURN_IF_NOT_OK(profiling_manager_->GetBatchTimeByStep(last_step_autotuned_, cur_step_running_ - 1, &batch_times));
+  ModelSample sample;
+  sample.batch_time = Mean(batch_times);
+  if (sample.batch_time <= 0) {
+    MS_LOG(INFO) << "No batch time sampled in the last steps, AutoTune model is not fitted.";
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(IsDSaBottleneck(&sample.is_bottleneck));
+  sample.max_workers = max_workers_;
+  RETURN_IF_NOT_OK(GetMemoryBudget(&sample.process_mem, &sample.mem_budget));
+  std::map<int32_t, int32_t> ops_num_workers;
+  RETURN_IF_NOT_OK(GetOpsNumWorker(&ops_num_workers));
+  std::map<int32_t, double> out_ops_queue_util;
+  std::map<int32_t, double> in_ops_queue_util;
+  RETURN_IF_NOT_OK(GetOpsQueueUtil(&out_ops_queue_util, &in_ops_queue_util));
+  std::map<int32_t, double> ops_cpu_util;
+  RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  for (const auto &op : ops_) {
+    const int32_t op_id = op.first;
+    ModelOpSample &op_sample = sample.ops[op_id];
+    op_sample.num_workers = ops_num_workers[op_id];
+    op_sample.queue_capacity = op.second->ConnectorCapacity();
+    op_sample.cpu_util = ops_cpu_util[op_id];
+    op_sample.in_queue_util = in_ops_queue_util[op_id];
+    op_sample.out_queue_util = out_ops_queue_util[op_id];
+    op_sample.configurable = !op.second->inlined() && op.second->Name() != "DataQueueOp";
+    bool is_parallel = std::find(parallel_ops_ids_.begin(), parallel_ops_ids_.end(), op_id) != parallel_ops_ids_.end();
+    op_sample.tunable = is_parallel && !SkipOpsCheck(op_id);
+  }
+
+  ModelFit fit;
+  RETURN_IF_NOT_OK(FitModel(sample, &fit));
+  MS_LOG(INFO) << "AutoTune model: observed throughput " << 1000.0 / sample.batch_time
+               << " batches/s, predicted throughput " << fit.predicted << " batches/s, cpu cost " << fit.cpu_cost
+               << " s/batch.";
+  for (const auto &workers : fit.num_workers) {
+    int32_t num_workers = workers.second;
+    if (num_workers != ops_num_workers[workers.first]) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(workers.first, ops_num_workers[workers.first], &num_workers));
+    }
+    int32_t old_capacity = ops_[workers.first]->ConnectorCapacity();
+    if (fit.queue_capacity[workers.first] != old_capacity) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(workers.first, old_capacity, fit.queue_capacity[workers.first]));
+    }
+  }
+  if (++model_fits_ >= MODEL_NUM_FITS) {
+    AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+  }
+  return Status::OK();
+}
+
+Status AutoTune::FitModel(const ModelSample &sample, ModelFit *fit) const {
+  RETURN_UNEXPECTED_IF_NULL(fit);
+  CHECK_FAIL_RETURN_UNEXPECTED(sample.batch_time > 0, "The batch time of the AutoTune model must be positive.");
+  fit->num_workers.clear();
+  fit->queue_capacity.clear();
+  auto op_workers = [this](const ModelOpSample &op) { return std::max(op.num_workers, MIN_NUM_WORKERS); };
+
+  // Batches per second
+  const double throughput = 1000.0 / sample.batch_time;
+  // Cost of a batch in busy worker seconds for each op, and in cpu seconds for the whole pipeline
+  std::map<int32_t, double> worker_cost;
+  fit->cpu_cost = 0;
+  double rows_queued = 0;
+  for (const auto &op : sample.ops) {
+    const ModelOpSample &op_sample = op.second;
+    fit->cpu_cost += op_sample.cpu_util / TO_PERCENT / throughput;
+    if (!op_sample.configurable) {
+      continue;
+    }
+    rows_queued += op_sample.out_queue_util * op_sample.queue_capacity;
+    const int32_t num_workers = op_workers(op_sample);
+    // A worker which neither waits for input nor is blocked by a full output queue is busy, even when it waits for IO
+    // and does not show in the cpu utilization.
+    double busy = std::max(op_sample.cpu_util / TO_PERCENT / num_workers,
+                           op_sample.in_queue_util * (1 - op_sample.out_queue_util));
+    busy = std::min(std::max(busy, MODEL_MIN_BUSY), 1.0);
+    worker_cost[op.first] = busy * num_workers / throughput;
+  }
+
+  // Every op takes cpu in proportion to the throughput, which bounds the throughput the cpu threads can sustain.
+  // If the dataset pipeline is not the bottleneck, the current throughput is kept with as few workers as possible.
+  double target = throughput;
+  if (sample.is_bottleneck) {
+    target = throughput * MODEL_MAX_SPEEDUP;
+    if (fit->cpu_cost > 0) {
+      target = std::min(target, sample.max_workers / fit->cpu_cost);
+    }
+  }
+  double tunable_cost = 0;
+  for (const auto &cost : worker_cost) {
+    const ModelOpSample &op_sample = sample.ops.at(cost.first);
+    if (op_sample.tunable) {
+      tunable_cost += cost.second;
+    } else {
+      // The ops with a fixed number of workers bound the throughput too.
+      target = std::min(target, op_workers(op_sample) / cost.second);
+    }
+  }
+  const double max_total_workers = static_cast<double>(MODEL_MAX_WORKERS_PER_CPU) * sample.max_workers;
+  if (tunable_cost > 0) {
+    target = std::min(target, max_total_workers / (tunable_cost * MODEL_WORKER_HEADROOM));
+  }
+  target = std::max(target, 0.0);
+
+  fit->predicted = worker_cost.empty() ? throughput : std::numeric_limits<double>::max();
+  for (const auto &cost : worker_cost) {
+    const ModelOpSample &op_sample = sample.ops.at(cost.first);
+    int32_t num_workers = op_workers(op_sample);
+    if (op_sample.tunable) {
+      num_workers = static_cast<int32_t>(std::ceil(target * cost.second * MODEL_WORKER_HEADROOM));
+      num_workers = std::min(std::max(num_workers, MIN_NUM_WORKERS), sample.max_workers);
+      fit->num_workers[cost.first] = num_workers;
+    }
+    fit->predicted = std::min(fit->predicted, num_workers / cost.second);
+  }
+
+  // A queue holds enough rows for the workers on both of its sides, the consumer of an op has the next lower id.
+  double extra_rows = 0;
+  for (const auto &workers : fit->num_workers) {
+    int32_t consumer_workers = MIN_NUM_WORKERS;
+    auto consumer = fit->num_workers.find(workers.first - 1);
+    if (consumer != fit->num_workers.end()) {
+      consumer_workers = consumer->second;
+    } else if (sample.ops.find(workers.first - 1) != sample.ops.end()) {
+      consumer_workers = op_workers(sample.ops.at(workers.first - 1));
+    }
+    int32_t capacity = MODEL_QUEUE_ROWS_PER_WORKER * std::max(workers.second, consumer_workers);
+    capacity = std::min(std::max(capacity, MIN_QUEUE_SIZE), MAX_QUEUE_SIZE);
+    fit->queue_capacity[workers.first] = capacity;
+    extra_rows += std::max(capacity - sample.ops.at(workers.first).queue_capacity, 0);
+  }
+  // An upper bound, the process holds more than the rows in the queues.
+  const double row_mem = rows_queued >= 1 ? sample.process_mem / rows_queued : 0;
+  if (row_mem > 0 && extra_rows * row_mem > sample.mem_budget) {
+    // Grow the queues in proportion to fit the memory budget, but never below the workers of the op.
+    const double scale = sample.mem_budget / (extra_rows * row_mem);
+    for (auto &capacity : fit->queue_capacity) {
+      int32_t old_capacity = sample.ops.at(capacity.first).queue_capacity;
+      if (capacity.second > old_capacity) {
+        auto grown = static_cast<int32_t>((capacity.second - old_capacity) * scale);
+        capacity.second = std::max(old_capacity + grown, fit->num_workers[capacity.first]);
+      }
+    }
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -45,6 +45,53 @@ class AutoTune {
   /// \return Status object
   Status LaunchThread();
 
+  /// \brief Figures of an op sampled over the last steps
+  struct ModelOpSample {
+    int32_t num_workers = 0;
+    int32_t queue_capacity = 0;
+    /// CPU utilization of all the workers, in percent
+    double cpu_util = 0;
+    /// Average fill ratio of the input and the output queue
+    double in_queue_util = 0;
+    double out_queue_util = 0;
+    /// False for the inlined ops and the DataQueueOp, which have neither workers nor a queue to configure
+    bool configurable = true;
+    /// True if AutoTune may change the number of workers
+    bool tunable = false;
+  };
+
+  /// \brief Figures of the pipeline sampled over the last steps, the input of the AutoTune model
+  struct ModelSample {
+    /// Average batch time in ms
+    double batch_time = 0;
+    bool is_bottleneck = false;
+    /// Number of cpu threads, the most workers an op gets
+    int32_t max_workers = 1;
+    /// Memory (in MB) of the process, 0 if it is unknown
+    double process_mem = 0;
+    /// Memory (in MB) the queues may grow into
+    double mem_budget = 0;
+    /// The ops by id
+    std::map<int32_t, ModelOpSample> ops;
+  };
+
+  /// \brief Configuration fitted by the AutoTune model
+  struct ModelFit {
+    /// New number of workers and queue capacity of the tunable ops
+    std::map<int32_t, int32_t> num_workers;
+    std::map<int32_t, int32_t> queue_capacity;
+    /// Throughput in batches per second predicted for the new configuration
+    double predicted = 0;
+    /// CPU time of a batch in seconds
+    double cpu_cost = 0;
+  };
+
+  /// \brief Fit the throughput model to the sampled figures and size the workers and the queues of the tunable ops
+  /// \param sample Figures sampled over the last steps
+  /// \param[out] fit The fitted configuration
+  /// \return Status object
+  Status FitModel(const ModelSample &sample, ModelFit *fit) const;
+
  private:
   /// Main entry function for AT, triggers loop function.
   /// \return Status object
@@ -74,8 +121,24 @@ class AutoTune {
   /// Setter for autotune_config_json_
   /// \return Status code
   Status SetAutotuneConfigJson();
+
+  /// \brief Save the worker and queue configuration fitted by the model so that later runs of the same pipeline
+  /// can apply it at once
+  /// \param file_name Name of the file
+  /// \return Status object
+  Status SaveModelConfig(const std::string &file_name);
+
+  /// \brief Apply the configuration saved by SaveModelConfig if it was saved for the same pipeline
+  /// \param file_name Name of the file
+  /// \param[out] applied True if the configuration is applied
+  /// \return Status object
+  Status LoadModelConfig(const std::string &file_name, bool *applied);
 #endif
 
+  /// \brief Names of the ops AutoTune configures, in the order of the tree. It identifies the pipeline a saved
+  /// model configuration is for.
+  std::vector<std::string> GetPipelineSignature() const;
+
   /// Function to collect info from the tree
   /// \return Status code
   Status CollectOpsInfo();
@@ -146,7 +209,7 @@ class AutoTune {
   const float_t MAP_OP_WORKER_LOW_THRESHOLD = 35;
   // Running mode specifics
   enum AutoTuneMode { kAutoTuneModeEpoch, kAutoTuneModeStep };
-  enum AutoTunePhase { kAutoTunePhaseTime, kAutoTunePhaseMemory, kAutoTuneEnd };
+  enum AutoTunePhase { kAutoTunePhaseTime, kAutoTunePhaseMemory, kAutoTunePhaseModel, kAutoTuneEnd };
   enum AutoTuneMemPhase { kAutoTuneMemInit, kAutoTuneMemSet, kAutotTuneMemCompare };
   // Early stop specifics
   const int32_t EARLY_STOP_TRIAL_THRESHOLD_EPOCH = 4;
@@ -155,6 +218,22 @@ class AutoTune {
   const float MEMORY_COMPARISON_LOWER_BOUND_PERCENT = 0.02;
   const float QUEUE_REDUCTION_PERCENTAGE_EPOCH = 0.5;
   const float QUEUE_REDUCTION_PERCENTAGE_STEP = 0.8;
+  // Model specifics
+  const int64_t MODEL_WARMUP_STEPS = 5;
+  const int64_t MODEL_SAMPLE_STEPS = 20;
+  const int32_t MODEL_NUM_FITS = 2;
+  // Lower bound on the busy fraction of a worker, which keeps the cost of an idle op from being 0
+  const double MODEL_MIN_BUSY = 0.05;
+  // Extra workers over the cost predicted by the model, for the variance of the ops
+  const double MODEL_WORKER_HEADROOM = 1.2;
+  // A single fit extrapolates the linear model at most this far from the observed throughput
+  const double MODEL_MAX_SPEEDUP = 4.0;
+  // IO bound workers mostly wait, so the workers of all the ops may exceed the cpu threads up to this factor
+  const int32_t MODEL_MAX_WORKERS_PER_CPU = 2;
+  // Rows a queue holds for each worker on either side of it
+  const int32_t MODEL_QUEUE_ROWS_PER_WORKER = 2;
+  // Share of the available memory the queues may grow into
+  const double MODEL_QUEUE_MEMORY_FRACTION = 0.5;
 
   /// Get the out connector capacity of the operator
   /// \param[in] op_id operator id
@@ -192,6 +271,18 @@ class AutoTune {
   /// \return Status code
   Status AnalyseMemory();
 
+  /// AutoTune model algorithm. The cost of a batch in each op, in busy worker time and in cpu time, is estimated
+  /// from the samples of the last steps. The highest throughput the cpu threads can sustain gives the number of
+  /// workers of every op, and the queues are sized to the workers on both of their sides within the memory budget.
+  /// \return Status code
+  Status AnalyseModel();
+
+  /// Get the memory (in MB) of the process and the memory (in MB) the queues may grow into
+  /// \param[out] process_mem Memory of the process, 0 if it is unknown
+  /// \param[out] mem_budget Memory the queues may grow into
+  /// \return Status code
+  Status GetMemoryBudget(double *process_mem, double *mem_budget);
+
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
   /// \param old_workers Old number of workers for logging purposes
@@ -292,6 +383,11 @@ class AutoTune {
   /// True if should save AutoTune configuration
   bool save_autoconfig_;
 
+  /// True if the ops are tuned from the throughput model
+  bool model_mode_;
+  /// Number of times the model has been fitted and applied
+  int32_t model_fits_;
+
   /// Flag to enable saving of intermediate autotune config to disk
   bool save_intermediate_autoconfig_{false};
 
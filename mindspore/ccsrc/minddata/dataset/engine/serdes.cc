@@ -242,6 +242,8 @@ Status Serdes::ConstructSampler(nlohmann::json json_obj, std::shared_ptr<Sampler
   std::string sampler_name = json_obj["sampler_name"];
   if (sampler_name == "DistributedSampler") {
     RETURN_IF_NOT_OK(DistributedSamplerObj::from_json(json_obj, num_samples, sampler));
+  } else if (sampler_name == "GlobalShuffleSampler") {
+    RETURN_IF_NOT_OK(GlobalShuffleSamplerObj::from_json(json_obj, num_samples, sampler));
   } else if (sampler_name == "PKSampler") {
     RETURN_IF_NOT_OK(PKSamplerObj::from_json(json_obj, num_samples, sampler));
   } else if (sampler_name == "RandomSampler") {
@@ -322,6 +324,8 @@ Serdes::InitializeFuncPtr() {
   ops_ptr[vision::kRandomColorOperation] = &(vision::RandomColorOperation::from_json);
   ops_ptr[vision::kRandomColorAdjustOperation] = &(vision::RandomColorAdjustOperation::from_json);
   ops_ptr[vision::kRandomCropDecodeResizeOperation] = &(vision::RandomCropDecodeResizeOperation::from_json);
+  ops_ptr[vision::kRandomCropDecodeResizeNormalizeOperation] =
+    &(vision::RandomCropDecodeResizeNormalizeOperation::from_json);
   ops_ptr[vision::kRandomCropOperation] = &(vision::RandomCropOperation::from_json);
   ops_ptr[vision::kRandomCropWithBBoxOperation] = &(vision::RandomCropWithBBoxOperation::from_json);
   ops_ptr[vision::kRandomHorizontalFlipOperation] = &(vision::RandomHorizontalFlipOperation::from_json);
@@ -59,6 +59,7 @@
 #include "minddata/dataset/engine/ir/datasetops/source/voc_node.h"
 
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/distributed_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/global_shuffle_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/pk_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/prebuilt_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/random_sampler_ir.h"
@@ -102,6 +103,7 @@
 #include "minddata/dataset/kernels/ir/vision/random_color_adjust_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_color_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_with_bbox_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
@@ -19,6 +19,7 @@
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/scaled_decode_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_offload_pass.h"
@@ -34,6 +35,7 @@
 #include "minddata/dataset/engine/opt/pre/deep_copy_pass.h"
 #include "minddata/dataset/engine/opt/pre/epoch_ctrl_pass.h"
 #include "minddata/dataset/engine/opt/pre/getter_pass.h"
+#include "minddata/dataset/engine/opt/pre/global_shuffle_pass.h"
 #include "minddata/dataset/engine/opt/pre/input_validation_pass.h"
 #include "minddata/dataset/engine/opt/pre/insert_map_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_removal_pass.h"
@@ -69,6 +71,8 @@ Status TreeAdapter::PrePass(const std::shared_ptr<DatasetNode> &ir) {
       (void)actions.emplace_back(std::make_unique<SkipPushdownPass>());
     }
   }
+  // After the reset passes, since a skip pushed down into a sampler needs all the ids of its child sampler at once
+  (void)actions.emplace_back(std::make_unique<GlobalShufflePass>());
   (void)actions.emplace_back(std::make_unique<EpochCtrlPass>());
   if (usage_ == kDeGetter) {
     (void)actions.emplace_back(std::make_unique<GetterPass>());
@@ -101,6 +105,7 @@ Status TreeAdapter::Optimize(const std::shared_ptr<DatasetNode> &ir) {
   MS_LOG(INFO) << "Running optimization pass loops";
 #ifndef ENABLE_ANDROID
   (void)optimizations.emplace_back(std::make_unique<TensorOpFusionPass>());
+  (void)optimizations.emplace_back(std::make_unique<ScaledDecodePass>());
 #endif
   // Apply optimization pass actions
   for (auto &optimization : optimizations) {
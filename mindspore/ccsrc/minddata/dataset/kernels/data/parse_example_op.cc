@@ -739,12 +739,16 @@ Status ParseExampleOp::ParseSingleExample(const TensorRow &raw_bytes, TensorRow
   const auto filename = raw_bytes.getPath().empty() ? "" : raw_bytes.getPath()[0];
   const auto tensor_iterator = raw_bytes[0]->begin<std::string_view>();
 
-  const auto example_bytes = std::string(*tensor_iterator);
+  // The features are parsed in place, only the ones in the schema are decoded.
+  const StringPiece example_bytes = *tensor_iterator;
   RETURN_IF_NOT_OK(ConstructColumnMap(example_bytes));
 
-  parsed::Example parsed_example;
-  CHECK_FAIL_RETURN_UNEXPECTED(ParseExample(example_bytes, &parsed_example),
-                               "Failed to parse example bytes: " + example_bytes + " in tfrecord file: " + filename);
+  // The entries only view the example bytes, so the storage is reused by the rows parsed on this thread.
+  thread_local parsed::Example parsed_example;
+  parsed_example.clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    ParseExample(example_bytes, &parsed_example),
+    "Failed to parse example bytes: " + std::string(example_bytes) + " in tfrecord file: " + filename);
 
   parsed_row->reserve(data_schema_.NumColumns());
 
@@ -782,13 +786,12 @@ Status ParseExampleOp::ParseSingleExample(const TensorRow &raw_bytes, TensorRow
     const StringPiece &feature_name = name_and_feature.first;
     parsed::Feature &feature = name_and_feature.second;
 
-    if (column_name_id_map_.find(std::string(feature_name)) == column_name_id_map_.end()) {
+    const auto column_index = FindColumn(feature_name);
+    if (column_index < 0) {
       MS_LOG(INFO) << "Feature name: " << feature_name << " is not in schema, skip it.";
       continue;
     }
 
-    const auto column_index = column_name_id_map_[std::string(feature_name)];
-
     DataType example_dtype;
     RETURN_IF_NOT_OK(feature.ParseDataType(&example_dtype));
     if (example_dtype == DataType::DE_UNKNOWN) {
@@ -1026,7 +1029,7 @@ Status MergeDenseVarLenMiniBatches(const std::vector<std::vector<VarLenTensorBuf
 
 Status ParseExampleOp::ParallelParseExample(const TensorRow &raw_bytes, TensorRow *parsed_row) {
   Tensor::TensorIterator tensor_iterator = raw_bytes[0]->begin<std::string_view>();
-  RETURN_IF_NOT_OK(ConstructColumnMap(std::string(*tensor_iterator)));
+  RETURN_IF_NOT_OK(ConstructColumnMap(*tensor_iterator));
   parsed_row->reserve(data_schema_.NumColumns());
 
   auto batch_size = raw_bytes[0]->shape()[0];
@@ -1086,8 +1089,8 @@ Status ParseExampleOp::ParallelParseExample(const TensorRow &raw_bytes, TensorRo
     const auto end = first_example_of_minibatch(minibatch + 1);
     for (auto tensor_index = start; tensor_index < end; ++tensor_index) {
       status_of_minibatch[minibatch] =
-        ParseSerializedExample(static_cast<std::string>(*tensor_iterator.operator+(static_cast<dsize_t>(tensor_index))),
-                               parsed_row, &string_column_map, &varlen_dense_buffers[minibatch], tensor_index);
+        ParseSerializedExample(*tensor_iterator.operator+(static_cast<dsize_t>(tensor_index)), parsed_row,
+                               &string_column_map, &varlen_dense_buffers[minibatch], tensor_index);
       if (!status_of_minibatch[minibatch].IsOk()) {
         break;
       }
@@ -1318,13 +1321,15 @@ Status ParseSerializedVarLenColumn(const parsed::Feature &feature, VarLenTensorB
   return Status::OK();
 }
 
-Status ParseExampleOp::ParseSerializedExample(const std::string &example_bytes, TensorRow *parsed_row,
+Status ParseExampleOp::ParseSerializedExample(std::string_view example_bytes, TensorRow *parsed_row,
                                               std::unordered_map<int32_t, std::vector<std::string>> *string_column_map,
                                               std::vector<VarLenTensorBuffer> *varlen_tensor_vector,
                                               const size_t tensor_index) {
-  parsed::Example parsed_example;
+  // Each thread of the pool reuses the storage of its entries, which only view the example bytes.
+  thread_local parsed::Example parsed_example;
+  parsed_example.clear();
   CHECK_FAIL_RETURN_UNEXPECTED(ParseExample(example_bytes, &parsed_example),
-                               "Failed to parse example bytes: " + example_bytes);
+                               "Failed to parse example bytes: " + std::string(example_bytes));
 
   const size_t parsed_example_size = parsed_example.size();
   std::vector<bool> feature_already_seen(data_schema_.NumColumns(), false);
@@ -1335,7 +1340,8 @@ Status ParseExampleOp::ParseSerializedExample(const std::string &example_bytes,
     const StringPiece &feature_name = name_and_feature.first;
     parsed::Feature &feature = name_and_feature.second;
 
-    if (column_name_id_map_.find(std::string(feature_name)) == column_name_id_map_.end()) {
+    const auto column_index = FindColumn(feature_name);
+    if (column_index < 0) {
       MS_LOG(INFO) << "Feature name: " << feature_name << " is not in schema, skip it.";
       continue;
     }
@@ -1346,7 +1352,6 @@ Status ParseExampleOp::ParseSerializedExample(const std::string &example_bytes,
       continue;
     }
 
-    const auto column_index = column_name_id_map_[std::string(feature_name)];
     // If feature was already visited, skip.
     if (feature_already_seen[column_index]) {
       LogFeatureRepeated(feature_name);
@@ -1373,11 +1378,11 @@ Status ParseExampleOp::ParseSerializedExample(const std::string &example_bytes,
   return Status::OK();
 }
 
-Status ParseExampleOp::ConstructColumnMap(const std::string &example_bytes) {
+Status ParseExampleOp::ConstructColumnMap(std::string_view example_bytes) {
   if (column_name_id_map_.empty()) {
     if (data_schema_.Empty()) {
       dataengine::Example example;
-      if (!example.ParseFromString(example_bytes)) {
+      if (!example.ParseFromArray(example_bytes.data(), static_cast<int>(example_bytes.size()))) {
         RETURN_STATUS_UNEXPECTED("Failed to parse example bytes: " + std::string(example_bytes));
       }
 
@@ -1417,7 +1422,17 @@ Status ParseExampleOp::ConstructColumnMap(const std::string &example_bytes) {
     }
     RETURN_IF_NOT_OK(data_schema_.GetColumnNameMap(&column_name_id_map_));
     CHECK_FAIL_RETURN_UNEXPECTED(!column_name_id_map_.empty(), "Can not get column name map, it is empty.");
+    // The keys of an unordered map stay where they are, so they can be viewed.
+    column_name_view_map_.clear();
+    for (const auto &[column_name, column_index] : column_name_id_map_) {
+      column_name_view_map_[column_name] = column_index;
+    }
   }
   return Status::OK();
 }
+
+int32_t ParseExampleOp::FindColumn(std::string_view feature_name) const {
+  auto iter = column_name_view_map_.find(feature_name);
+  return iter == column_name_view_map_.end() ? -1 : iter->second;
+}
 }  // namespace mindspore::dataset
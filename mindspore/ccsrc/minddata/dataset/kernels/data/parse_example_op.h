@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -61,17 +62,22 @@ class ParseExampleOp : public TensorOp {
 
   Status ParallelParseExample(const TensorRow &raw_bytes, TensorRow *parsed_row);
 
-  Status ParseSerializedExample(const std::string &example_bytes, TensorRow *parsed_row,
+  Status ParseSerializedExample(std::string_view example_bytes, TensorRow *parsed_row,
                                 std::unordered_map<int32_t, std::vector<std::string>> *string_column_map,
                                 std::vector<VarLenTensorBuffer> *varlen_tensor_vector, size_t tensor_index);
 
-  Status ConstructColumnMap(const std::string &example_bytes);
+  Status ConstructColumnMap(std::string_view example_bytes);
+
+  /// \brief Find the column of a feature, the name is looked up without being copied.
+  /// \return The column index, or -1 if the feature is not in the schema.
+  int32_t FindColumn(std::string_view feature_name) const;
 
   DataSchema data_schema_;
   std::vector<std::string> column_list_;
   bool parallel_parse_;
   std::unique_ptr<Eigen::ThreadPool> pool_;
   std::unordered_map<std::string, int32_t> column_name_id_map_;
+  std::unordered_map<std::string_view, int32_t> column_name_view_map_;  // views of the keys of column_name_id_map_
 };
 }  // namespace dataset
 }  // namespace mindspore
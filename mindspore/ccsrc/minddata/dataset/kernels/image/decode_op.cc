@@ -43,6 +43,14 @@ Status DecodeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
                              std::to_string(input->Rank()));
   }
   if (is_rgb_format_) {  // RGB color mode
+#ifndef ENABLE_ANDROID
+    if (target_height_ > 0 && target_width_ > 0 && IsNonEmptyJPEG(input)) {
+      int height = 0;
+      int width = 0;
+      RETURN_IF_NOT_OK(GetJpegImageInfo(input, &width, &height));
+      return Decode(input, output, GetJpegScaleDenom(height, width, target_height_, target_width_));
+    }
+#endif
     return Decode(input, output);
   } else {  // BGR color mode
     RETURN_STATUS_UNEXPECTED(
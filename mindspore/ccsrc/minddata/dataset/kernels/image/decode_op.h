@@ -43,8 +43,17 @@ class DecodeOp : public TensorOp {
 
   std::string Name() const override { return kDecodeOp; }
 
+  /// \brief Set the size the decoded image is resized to next, JPEG images are then decoded at the smallest
+  ///     reduced resolution which is not smaller than it. 0 means the size is unknown.
+  void SetTargetSize(int32_t target_height, int32_t target_width) {
+    target_height_ = target_height;
+    target_width_ = target_width;
+  }
+
  private:
   bool is_rgb_format_ = true;
+  int32_t target_height_ = 0;
+  int32_t target_width_ = 0;
 };
 }  // namespace dataset
 }  // namespace mindspore
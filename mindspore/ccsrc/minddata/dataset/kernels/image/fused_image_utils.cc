@@ -0,0 +1,208 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_image_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(ENABLE_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr dsize_t kHWCRank = 3;
+constexpr dsize_t kHWRank = 2;
+constexpr int kNumCachedRows = 2;
+constexpr double kHalfPixel = 0.5;
+
+// The two source pixels an output pixel is interpolated from, along one axis.
+struct Sample {
+  int64_t index0;
+  int64_t index1;
+  float weight;  // weight of index1
+};
+
+// Follows the pixel centers of the linear interpolation of Resize, the borders are replicated.
+std::vector<Sample> ComputeSamples(int start, int crop_size, int target_size) {
+  std::vector<Sample> samples(target_size);
+  const double scale = static_cast<double>(crop_size) / target_size;
+  for (int i = 0; i < target_size; ++i) {
+    auto pos = static_cast<float>((i + kHalfPixel) * scale - kHalfPixel);
+    auto index = static_cast<int>(std::floor(pos));
+    float weight = pos - static_cast<float>(index);
+    if (index < 0) {
+      index = 0;
+      weight = 0;
+    }
+    if (index >= crop_size - 1) {
+      index = crop_size - 1;
+      weight = 0;
+    }
+    samples[i].index0 = start + index;
+    samples[i].index1 = start + std::min(index + 1, crop_size - 1);
+    samples[i].weight = weight;
+  }
+  return samples;
+}
+
+// Resizes one source row horizontally, the result is interleaved, or one plane per channel when planar.
+void ResizeRow(const uint8_t *src_row, const std::vector<Sample> &samples, int channels, bool planar, float *dst) {
+  const auto width = static_cast<int64_t>(samples.size());
+  for (int64_t i = 0; i < width; ++i) {
+    const uint8_t *pixel0 = src_row + samples[i].index0 * channels;
+    const uint8_t *pixel1 = src_row + samples[i].index1 * channels;
+    const float weight = samples[i].weight;
+    for (int c = 0; c < channels; ++c) {
+      float value = static_cast<float>(pixel0[c]) + static_cast<float>(pixel1[c] - pixel0[c]) * weight;
+      dst[planar ? c * width + i : i * channels + c] = value;
+    }
+  }
+}
+
+// dst = (row0 + (row1 - row0) * weight) * scale + shift
+void BlendNormalizeRow(const float *row0, const float *row1, float weight, const float *scale, const float *shift,
+                       float *dst, int64_t size) {
+  int64_t i = 0;
+#if defined(__AVX2__)
+  constexpr int64_t kStep = 8;
+  const __m256 v_weight = _mm256_set1_ps(weight);
+  for (; i + kStep <= size; i += kStep) {
+    __m256 v_row0 = _mm256_loadu_ps(row0 + i);
+    __m256 v_row1 = _mm256_loadu_ps(row1 + i);
+    __m256 v_value = _mm256_add_ps(v_row0, _mm256_mul_ps(_mm256_sub_ps(v_row1, v_row0), v_weight));
+    v_value = _mm256_add_ps(_mm256_mul_ps(v_value, _mm256_loadu_ps(scale + i)), _mm256_loadu_ps(shift + i));
+    _mm256_storeu_ps(dst + i, v_value);
+  }
+#elif defined(ENABLE_NEON)
+  constexpr int64_t kStep = 4;
+  const float32x4_t v_weight = vdupq_n_f32(weight);
+  for (; i + kStep <= size; i += kStep) {
+    float32x4_t v_row0 = vld1q_f32(row0 + i);
+    float32x4_t v_row1 = vld1q_f32(row1 + i);
+    float32x4_t v_value = vmlaq_f32(v_row0, vsubq_f32(v_row1, v_row0), v_weight);
+    v_value = vmlaq_f32(vld1q_f32(shift + i), v_value, vld1q_f32(scale + i));
+    vst1q_f32(dst + i, v_value);
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] = (row0[i] + (row1[i] - row0[i]) * weight) * scale[i] + shift[i];
+  }
+}
+}  // namespace
+
+Status CropResizeNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y,
+                           int crop_height, int crop_width, int target_height, int target_width,
+                           std::vector<float> mean, std::vector<float> std, bool to_chw) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input->Rank() == kHWRank || input->Rank() == kHWCRank,
+                               "CropResizeNormalize: image shape should be <H,W> or <H,W,C>, but got rank: " +
+                                 std::to_string(input->Rank()));
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type() == DataType::DE_UINT8,
+                               "CropResizeNormalize: image type should be uint8, but got: " + input->type().ToString());
+  const auto height = static_cast<int>(input->shape()[0]);
+  const auto width = static_cast<int>(input->shape()[1]);
+  const int channels = input->Rank() == kHWCRank ? static_cast<int>(input->shape()[kHWRank]) : 1;
+  CHECK_FAIL_RETURN_UNEXPECTED(channels > 0, "CropResizeNormalize: image should have at least one channel.");
+  CHECK_FAIL_RETURN_UNEXPECTED(x >= 0 && y >= 0 && crop_height > 0 && crop_width > 0 && x <= width - crop_width &&
+                                 y <= height - crop_height,
+                               "CropResizeNormalize: invalid crop box, got x: " + std::to_string(x) +
+                                 ", y: " + std::to_string(y) + ", crop_height: " + std::to_string(crop_height) +
+                                 ", crop_width: " + std::to_string(crop_width) + " for image of shape " +
+                                 input->shape().ToString());
+  CHECK_FAIL_RETURN_UNEXPECTED(target_height > 0 && target_width > 0,
+                               "CropResizeNormalize: target size should be positive, got target_height: " +
+                                 std::to_string(target_height) + ", target_width: " + std::to_string(target_width));
+  CHECK_FAIL_RETURN_UNEXPECTED(mean.size() == std.size(),
+                               "CropResizeNormalize: mean and std vectors are not of same size, got size of std: " +
+                                 std::to_string(std.size()) + ", and mean size: " + std::to_string(mean.size()));
+  // caller provided 1 mean/std value and there is more than one channel --> duplicate mean/std value
+  if (mean.size() == 1) {
+    mean.resize(channels, mean[0]);
+    std.resize(channels, std[0]);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(mean.size() == static_cast<size_t>(channels),
+                               "CropResizeNormalize: number of channels does not match the size of mean and std "
+                               "vectors, got channels: " +
+                                 std::to_string(channels) + ", size of mean: " + std::to_string(mean.size()));
+  for (auto value : std) {
+    CHECK_FAIL_RETURN_UNEXPECTED(value != 0, "CropResizeNormalize: std value should not be 0.");
+  }
+
+  TensorShape output_shape({target_height, target_width});
+  if (input->Rank() == kHWCRank) {
+    output_shape = to_chw ? TensorShape({channels, target_height, target_width})
+                          : TensorShape({target_height, target_width, channels});
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(output_shape, DataType(DataType::DE_FLOAT32), output));
+
+  // a row of the output of one image row, in the layout of the output
+  const int64_t row_size = static_cast<int64_t>(target_width) * channels;
+  std::vector<float> scale(row_size);
+  std::vector<float> shift(row_size);
+  for (int64_t i = 0; i < target_width; ++i) {
+    for (int c = 0; c < channels; ++c) {
+      int64_t index = to_chw ? c * target_width + i : i * channels + c;
+      scale[index] = 1.0f / std[c];
+      shift[index] = -mean[c] / std[c];
+    }
+  }
+
+  const std::vector<Sample> x_samples = ComputeSamples(x, crop_width, target_width);
+  const std::vector<Sample> y_samples = ComputeSamples(y, crop_height, target_height);
+  const uint8_t *src = &(*input->begin<uint8_t>());
+  const int64_t src_stride = static_cast<int64_t>(width) * channels;
+  float *dst = &(*(*output)->begin<float>());
+  const int64_t plane_size = static_cast<int64_t>(target_height) * target_width;
+
+  // consecutive output rows mostly share their source rows, so the last two resized rows are kept
+  std::vector<float> rows[kNumCachedRows] = {std::vector<float>(row_size), std::vector<float>(row_size)};
+  int64_t cached[kNumCachedRows] = {-1, -1};
+  for (int i = 0; i < target_height; ++i) {
+    const Sample &sample = y_samples[i];
+    int slot0 = cached[0] == sample.index0 ? 0 : (cached[1] == sample.index0 ? 1 : -1);
+    if (slot0 < 0) {
+      slot0 = cached[0] == sample.index1 ? 1 : 0;
+      ResizeRow(src + sample.index0 * src_stride, x_samples, channels, to_chw, rows[slot0].data());
+      cached[slot0] = sample.index0;
+    }
+    int slot1 = cached[0] == sample.index1 ? 0 : (cached[1] == sample.index1 ? 1 : -1);
+    if (slot1 < 0) {
+      slot1 = 1 - slot0;
+      ResizeRow(src + sample.index1 * src_stride, x_samples, channels, to_chw, rows[slot1].data());
+      cached[slot1] = sample.index1;
+    }
+    const float *row0 = rows[slot0].data();
+    const float *row1 = rows[slot1].data();
+    if (to_chw) {
+      for (int c = 0; c < channels; ++c) {
+        const int64_t offset = static_cast<int64_t>(c) * target_width;
+        BlendNormalizeRow(row0 + offset, row1 + offset, sample.weight, scale.data() + offset, shift.data() + offset,
+                          dst + c * plane_size + static_cast<int64_t>(i) * target_width, target_width);
+      }
+    } else {
+      BlendNormalizeRow(row0, row1, sample.weight, scale.data(), shift.data(), dst + i * row_size, row_size);
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_UTILS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_UTILS_H_
+
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Crops, bilinearly resizes and normalizes an image, and optionally swaps it to CHW, in a single pass.
+///     Each output row is blended from two horizontally resized source rows which are kept between rows, so the
+///     image is read once and the float output is written once, without intermediate tensors.
+///     The sampling follows the linear interpolation of Resize, but the resized values are not rounded to uint8
+///     before they are normalized.
+/// \param input: Tensor of shape <H,W,C> or <H,W> and type DE_UINT8.
+/// \param x: horizontal start point of the crop.
+/// \param y: vertical start point of the crop.
+/// \param crop_height: height of the cropped ROI.
+/// \param crop_width: width of the cropped ROI.
+/// \param target_height: height of the output image.
+/// \param target_width: width of the output image.
+/// \param mean: mean of each channel, or a single mean for all channels.
+/// \param std: std of each channel, or a single std for all channels.
+/// \param to_chw: whether the output is CHW instead of HWC.
+/// \param output: Tensor of shape <target_height,target_width,C>, <C,target_height,target_width> or
+///     <target_height,target_width> and type DE_FLOAT32.
+Status CropResizeNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y,
+                           int crop_height, int crop_width, int target_height, int target_width,
+                           std::vector<float> mean, std::vector<float> std, bool to_chw);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_UTILS_H_
@@ -327,6 +327,8 @@ const unsigned char kJpegMagic[] = "\xFF\xD8\xFF";
 constexpr dsize_t kJpegMagicLen = 3;
 const unsigned char kPngMagic[] = "\x89\x50\x4E\x47";
 constexpr dsize_t kPngMagicLen = 4;
+constexpr int kMaxJpegScaleDenom = 8;  // libjpeg decodes at 1/1, 1/2, 1/4 or 1/8 of the size in the DCT domain
+constexpr int kJpegScaleStep = 2;
 
 bool IsNonEmptyJPEG(const std::shared_ptr<Tensor> &input) {
   return input->SizeInBytes() > kJpegMagicLen && memcmp(input->GetBuffer(), kJpegMagic, kJpegMagicLen) == 0;
@@ -336,12 +338,12 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input) {
   return input->SizeInBytes() > kPngMagicLen && memcmp(input->GetBuffer(), kPngMagic, kPngMagicLen) == 0;
 }
 
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int scale_denom) {
   RETURN_IF_NOT_OK(CheckUnsupportedImage(input));
 
   Status ret;
   if (IsNonEmptyJPEG(input)) {
-    ret = JpegCropAndDecode(input, output);
+    ret = JpegCropAndDecode(input, output, 0, 0, 0, 0, scale_denom);
   } else {
     ret = DecodeCv(input, output);
   }
@@ -517,8 +519,21 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
     STATUS_ERROR(StatusCode::kMDUnexpectedError, "Error raised by libjpeg: " + std::string(jpeg_error_msg)));
 }
 
+int GetJpegScaleDenom(int height, int width, int target_height, int target_width) {
+  int scale_denom = kMaxJpegScaleDenom;
+  while (scale_denom > 1 && ((height + scale_denom - 1) / scale_denom < target_height ||
+                             (width + scale_denom - 1) / scale_denom < target_width)) {
+    scale_denom /= kJpegScaleStep;
+  }
+  return scale_denom;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  CHECK_FAIL_RETURN_UNEXPECTED(scale_denom == 1 || scale_denom == kJpegScaleStep ||
+                                 scale_denom == kJpegScaleStep * kJpegScaleStep || scale_denom == kMaxJpegScaleDenom,
+                               "JpegCropAndDecode: scale_denom should be 1, 2, 4 or 8, but got: " +
+                                 std::to_string(scale_denom));
   struct jpeg_decompress_struct cinfo {};
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -532,6 +547,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
     jpeg_calc_output_dimensions(&cinfo);
     RETURN_IF_NOT_OK(CheckJpegExit(&cinfo));
   } catch (std::runtime_error &e) {
@@ -546,12 +563,22 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
     crop_w = static_cast<int>(cinfo.output_width);
     crop_h = static_cast<int>(cinfo.output_height);
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError(
       "Crop: invalid crop size, corresponding crop value equal to 0 or too big, got crop width: " +
       std::to_string(crop_w) + ", crop height:" + std::to_string(crop_h) +
       ", and crop x coordinate:" + std::to_string(crop_x) + ", crop y coordinate:" + std::to_string(crop_y));
+  } else if (scale_denom > 1) {
+    // map the crop box onto the scaled image, the end is rounded up so no pixel of the box is lost
+    const int crop_x_end = std::min((crop_x + crop_w + scale_denom - 1) / scale_denom,
+                                    static_cast<int>(cinfo.output_width));
+    const int crop_y_end = std::min((crop_y + crop_h + scale_denom - 1) / scale_denom,
+                                    static_cast<int>(cinfo.output_height));
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = crop_x_end - crop_x;
+    crop_h = crop_y_end - crop_y;
   }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
@@ -159,7 +159,8 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 /// supported by opencv, if user need more image analysis capabilities, please compile opencv particularlly.
 /// \param input: CVTensor containing the not decoded image 1D bytes
 /// \param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+/// \param scale_denom: JPEG images are decoded at 1 / scale_denom of their size, see JpegCropAndDecode
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int scale_denom = 1);
 
 Status DecodeCv(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
@@ -169,8 +170,16 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decodes a JPEG image, or a crop of it, optionally at a reduced resolution in the DCT domain.
+/// \param x, y, w, h: the crop box on the full resolution image, the whole image if all of them are 0.
+/// \param scale_denom: the image is decoded at 1 / scale_denom of its size, one of 1, 2, 4 and 8.
+///     The crop box is scaled with it and rounded outwards.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
+
+/// \brief Returns the largest JPEG scale denominator which still decodes an image of height x width to at least
+///     target_height x target_width, so the decoded image only needs to be downscaled afterwards.
+int GetJpegScaleDenom(int height, int width, int target_height, int target_width);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+
+#include <utility>
+
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/fused_image_utils.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+RandomCropDecodeResizeNormalizeOp::RandomCropDecodeResizeNormalizeOp(const RandomCropDecodeResizeOp &rhs,
+                                                                     std::vector<float> mean, std::vector<float> std,
+                                                                     bool hwc_to_chw)
+    : RandomCropDecodeResizeOp(rhs), mean_(std::move(mean)), std_(std::move(std)), hwc_to_chw_(hwc_to_chw) {}
+
+Status RandomCropDecodeResizeNormalizeOp::Compute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  output->resize(input.size());
+  int x = 0;
+  int y = 0;
+  int crop_height = 0;
+  int crop_width = 0;
+  for (size_t i = 0; i < input.size(); i++) {
+    if (input[i] == nullptr) {
+      RETURN_STATUS_UNEXPECTED("RandomCropDecodeResizeNormalize: input image is empty since got nullptr.");
+    }
+    // the crop box is decoded alone from jpeg, otherwise it is cropped from the whole decoded image
+    std::shared_ptr<Tensor> decoded;
+    int box_x = 0;
+    int box_y = 0;
+    int box_height = 0;
+    int box_width = 0;
+    if (IsNonEmptyJPEG(input[i])) {
+      int h_in = 0;
+      int w_in = 0;
+      RETURN_IF_NOT_OK(GetJpegImageInfo(input[i], &w_in, &h_in));
+      if (i == 0) {
+        RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
+      }
+      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded, x, y, crop_width, crop_height,
+                                         GetScaleDenom(crop_height, crop_width)));
+      // the crop may have been decoded at a reduced resolution
+      box_height = static_cast<int>(decoded->shape()[0]);
+      box_width = static_cast<int>(decoded->shape()[1]);
+    } else {
+      DecodeOp op(true);
+      RETURN_IF_NOT_OK(op.Compute(input[i], &decoded));
+      std::vector<dsize_t> size;
+      RETURN_IF_NOT_OK(ImageSize(decoded, &size));
+      if (i == 0) {
+        RETURN_IF_NOT_OK(
+          GetCropBox(static_cast<int>(size[0]), static_cast<int>(size[1]), &x, &y, &crop_height, &crop_width));
+      }
+      box_x = x;
+      box_y = y;
+      box_height = crop_height;
+      box_width = crop_width;
+    }
+
+    if (interpolation_ == InterpolationMode::kLinear) {
+      RETURN_IF_NOT_OK(CropResizeNormalize(decoded, &(*output)[i], box_x, box_y, box_height, box_width,
+                                           target_height_, target_width_, mean_, std_, hwc_to_chw_));
+      continue;
+    }
+    // the other interpolations are not fused, the ops are run one after another
+    std::shared_ptr<Tensor> resized;
+    RETURN_IF_NOT_OK(CropAndResize(decoded, &resized, box_x, box_y, box_height, box_width, target_height_,
+                                   target_width_, interpolation_));
+    std::shared_ptr<Tensor> normalized;
+    RETURN_IF_NOT_OK(Normalize(resized, &normalized, mean_, std_, true));
+    if (hwc_to_chw_) {
+      RETURN_IF_NOT_OK(HwcToChw(normalized, &(*output)[i]));
+    } else {
+      (*output)[i] = std::move(normalized);
+    }
+  }
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputType(const std::vector<DataType> &inputs,
+                                                     std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  for (auto &type : outputs) {
+    type = DataType(DataType::DE_FLOAT32);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
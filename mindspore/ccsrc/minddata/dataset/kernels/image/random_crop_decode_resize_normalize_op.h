@@ -0,0 +1,56 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Fusion of RandomCropDecodeResize, Normalize and optionally HWC2CHW, the decoded crop is resized, normalized
+///     and transposed in one pass, see CropResizeNormalize.
+class RandomCropDecodeResizeNormalizeOp : public RandomCropDecodeResizeOp {
+ public:
+  RandomCropDecodeResizeNormalizeOp(const RandomCropDecodeResizeOp &rhs, std::vector<float> mean,
+                                    std::vector<float> std, bool hwc_to_chw);
+
+  ~RandomCropDecodeResizeNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << target_height_ << " " << target_width_ << " " << (hwc_to_chw_ ? "CHW" : "HWC");
+  }
+
+  Status Compute(const TensorRow &input, TensorRow *output) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kRandomCropDecodeResizeNormalizeOp; }
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool hwc_to_chw_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
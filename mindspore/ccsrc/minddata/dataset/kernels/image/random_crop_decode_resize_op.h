@@ -46,6 +46,17 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+  /// \brief Decode JPEG crops at the smallest reduced resolution which is not smaller than the target size.
+  void SetScaledDecode(bool scaled_decode) { scaled_decode_ = scaled_decode; }
+
+ protected:
+  /// \brief The JPEG scale denominator of a crop, 1 unless scaled decode is enabled.
+  int GetScaleDenom(int crop_height, int crop_width) const {
+    return scaled_decode_ ? GetJpegScaleDenom(crop_height, crop_width, target_height_, target_width_) : 1;
+  }
+
+  bool scaled_decode_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -44,7 +44,9 @@ Status DecodeOperation::ValidateParams() {
 
 std::shared_ptr<TensorOp> DecodeOperation::Build() {
   if (device_target_ == "CPU") {
-    return std::make_shared<DecodeOp>(rgb_);
+    auto tensor_op = std::make_shared<DecodeOp>(rgb_);
+    tensor_op->SetTargetSize(target_height_, target_width_);
+    return tensor_op;
 #if !defined(BUILD_LITE) && defined(ENABLE_D)
   } else if (device_target_ == "Ascend") {
     return std::make_shared<DvppDecodeOp>();
@@ -49,9 +49,22 @@ class DecodeOperation : public TensorOperation {
 
   MapTargetDevice Type() override;
 
+  /// \brief Getter functions
+  bool IsRgb() const { return rgb_; }
+  const std::string &DeviceTarget() const { return device_target_; }
+
+  /// \brief Set the size the image is resized to next, so JPEG images can be decoded at a reduced resolution.
+  ///     It is only a hint set by the optimizer, so it is not serialized.
+  void SetTargetSize(int32_t target_height, int32_t target_width) {
+    target_height_ = target_height;
+    target_width_ = target_width;
+  }
+
  private:
   bool rgb_;
   std::string device_target_;  // CPU, Ascend
+  int32_t target_height_ = 0;
+  int32_t target_width_ = 0;
 };
 }  // namespace vision
 }  // namespace dataset
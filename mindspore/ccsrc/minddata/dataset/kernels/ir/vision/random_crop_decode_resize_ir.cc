@@ -60,6 +60,7 @@ std::shared_ptr<TensorOp> RandomCropDecodeResizeOperation::Build() {
   auto tensor_op =
     std::make_shared<RandomCropDecodeResizeOp>(crop_height, crop_width, scale_lower_bound, scale_upper_bound,
                                                aspect_lower_bound, aspect_upper_bound, interpolation_, max_attempts_);
+  tensor_op->SetScaledDecode(scaled_decode_);
   return tensor_op;
 }
 
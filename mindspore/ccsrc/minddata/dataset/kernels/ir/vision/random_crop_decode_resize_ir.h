@@ -50,6 +50,13 @@ class RandomCropDecodeResizeOperation : public RandomResizedCropOperation {
   Status to_json(nlohmann::json *out_json) override;
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
+
+  /// \brief Decode JPEG crops at a reduced resolution which is not smaller than the target size.
+  ///     It is only set by the optimizer, so it is not serialized.
+  void SetScaledDecode(bool scaled_decode) { scaled_decode_ = scaled_decode; }
+
+ protected:
+  bool scaled_decode_ = false;
 };
 }  // namespace vision
 }  // namespace dataset
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_normalize_ir.h"
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#endif
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+#ifndef ENABLE_ANDROID
+// RandomCropDecodeResizeNormalizeOperation
+RandomCropDecodeResizeNormalizeOperation::RandomCropDecodeResizeNormalizeOperation(
+  const RandomCropDecodeResizeOperation &base, const std::vector<float> &mean, const std::vector<float> &std,
+  bool hwc_to_chw)
+    : RandomCropDecodeResizeOperation(base), mean_(mean), std_(std), hwc_to_chw_(hwc_to_chw) {}
+
+RandomCropDecodeResizeNormalizeOperation::~RandomCropDecodeResizeNormalizeOperation() = default;
+
+std::string RandomCropDecodeResizeNormalizeOperation::Name() const { return kRandomCropDecodeResizeNormalizeOperation; }
+
+std::shared_ptr<TensorOp> RandomCropDecodeResizeNormalizeOperation::Build() {
+  auto base_op = std::dynamic_pointer_cast<RandomCropDecodeResizeOp>(RandomCropDecodeResizeOperation::Build());
+  if (base_op == nullptr) {
+    MS_LOG(ERROR) << "RandomCropDecodeResizeNormalize: failed to build RandomCropDecodeResize.";
+    return nullptr;
+  }
+  auto tensor_op = std::make_shared<RandomCropDecodeResizeNormalizeOp>(*base_op, mean_, std_, hwc_to_chw_);
+  return tensor_op;
+}
+
+Status RandomCropDecodeResizeNormalizeOperation::to_json(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  nlohmann::json args;
+  RETURN_IF_NOT_OK(RandomCropDecodeResizeOperation::to_json(&args));
+  args["mean"] = mean_;
+  args["std"] = std_;
+  args["hwc_to_chw"] = hwc_to_chw_;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOperation::from_json(nlohmann::json op_params,
+                                                           std::shared_ptr<TensorOperation> *operation) {
+  RETURN_UNEXPECTED_IF_NULL(operation);
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "mean", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "std", kRandomCropDecodeResizeNormalizeOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "hwc_to_chw", kRandomCropDecodeResizeNormalizeOperation));
+  std::shared_ptr<TensorOperation> base;
+  RETURN_IF_NOT_OK(RandomCropDecodeResizeOperation::from_json(op_params, &base));
+  auto base_ir = std::dynamic_pointer_cast<RandomCropDecodeResizeOperation>(base);
+  RETURN_UNEXPECTED_IF_NULL(base_ir);
+  std::vector<float> mean = op_params["mean"];
+  std::vector<float> std = op_params["std"];
+  bool hwc_to_chw = op_params["hwc_to_chw"];
+  *operation = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(*base_ir, mean, std, hwc_to_chw);
+  return Status::OK();
+}
+#endif
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
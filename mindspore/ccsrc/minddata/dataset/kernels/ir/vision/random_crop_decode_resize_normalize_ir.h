@@ -0,0 +1,59 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_IR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_IR_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/api/status.h"
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/include/dataset/transforms.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
+#include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+constexpr char kRandomCropDecodeResizeNormalizeOperation[] = "RandomCropDecodeResizeNormalize";
+
+/// \brief Fusion of RandomCropDecodeResize, Normalize and optionally HWC2CHW, only created by TensorOpFusionPass.
+class RandomCropDecodeResizeNormalizeOperation : public RandomCropDecodeResizeOperation {
+ public:
+  RandomCropDecodeResizeNormalizeOperation(const RandomCropDecodeResizeOperation &base, const std::vector<float> &mean,
+                                           const std::vector<float> &std, bool hwc_to_chw);
+
+  ~RandomCropDecodeResizeNormalizeOperation() override;
+
+  std::shared_ptr<TensorOp> Build() override;
+
+  std::string Name() const override;
+
+  Status to_json(nlohmann::json *out_json) override;
+
+  static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool hwc_to_chw_;
+};
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_IR_H_
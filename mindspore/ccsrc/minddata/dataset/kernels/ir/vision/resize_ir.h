@@ -51,6 +51,10 @@ class ResizeOperation : public TensorOperation {
 
   MapTargetDevice Type() override;
 
+  /// \brief Getter functions
+  const std::vector<int32_t> &Size() const { return size_; }
+  const std::string &DeviceTarget() const { return device_target_; }
+
  private:
   std::vector<int32_t> size_;
   InterpolationMode interpolation_;
@@ -239,10 +239,12 @@ void BindShardIndexGenerator(const py::module *m) {
            THROW_IF_ERROR(s.Build());
            return SUCCESS;
          })
-    .def("write_to_db", [](ShardIndexGenerator &s) {
-      THROW_IF_ERROR(s.WriteToDatabase());
-      return SUCCESS;
-    });
+    .def("write_to_db",
+         [](ShardIndexGenerator &s) {
+           THROW_IF_ERROR(s.WriteToDatabase());
+           return SUCCESS;
+         })
+    .def("set_write_page_index", &ShardIndexGenerator::SetWritePageIndex);
 }
 
 void BindShardSegment(py::module *m) {
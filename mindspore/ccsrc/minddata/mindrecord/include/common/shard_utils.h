@@ -126,6 +126,12 @@ const int kMinFreeDiskSize = 10;  // 10M
 // dummy json
 const json kDummyId = R"({"id": 0})"_json;
 
+// suffix of the binary page index written next to the sqlite meta file
+const char kPageIndexSuffix[] = ".idx";
+
+// suffix of the sqlite meta file written next to the mindrecord file
+const char kMetaFileSuffix[] = ".db";
+
 // translate type in schema to type in sqlite3(NULL, INTEGER, REAL, TEXT, BLOB)
 const std::unordered_map<std::string, std::string> kDbJsonMap = {
   {"string", "TEXT"},     {"date", "DATE"},    {"date-time", "DATETIME"}, {"null", "NULL"},     {"integer", "INTEGER"},
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_BUFFER_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_BUFFER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Typed, contiguous storage of the raw (non-blob) fields of the rows of one shard.
+///
+/// Numeric columns keep one value of the schema type per row, string columns keep an offset table and a pool.
+/// Rows are decoded straight from the msgpack labels in the raw pages, or from the text values of the index,
+/// so no json object is built per row. Once filled the buffer is read-only and may be shared by all consumers.
+class MINDRECORD_API ShardColumnBuffer {
+ public:
+  /// \brief create an empty buffer
+  /// \param[in] columns names and types of the raw columns, blob columns are not supported
+  explicit ShardColumnBuffer(const std::vector<std::pair<std::string, ColumnDataType>> &columns);
+
+  ~ShardColumnBuffer() = default;
+
+  /// \brief reserve space for a number of rows
+  void Reserve(uint64_t num_rows);
+
+  /// \brief decode one row from a msgpack map of the raw fields, fields which are not in the buffer are skipped
+  /// \return Status, error if a column is missing or its value can not be kept in the column type without loss,
+  ///         the buffer is left in an undefined state then and should be dropped
+  Status AppendRaw(const uint8_t *data, uint64_t size);
+
+  /// \brief decode one row from the text values of the index, values[first + i] belongs to the i-th column
+  Status AppendText(const std::vector<std::string> &values, size_t first);
+
+  /// \brief number of rows in the buffer
+  uint64_t NumRows() const { return num_rows_; }
+
+  /// \brief position of a column, -1 if the column is not in the buffer
+  int GetColumnIndex(const std::string &column_name) const;
+
+  /// \brief get the value of a column of a row, the data is owned by the buffer
+  Status GetColumnValue(int column, uint64_t row, const unsigned char **data, uint64_t *n_bytes) const;
+
+ private:
+  struct Column {
+    std::string name;
+    ColumnDataType type;
+    uint64_t type_size;
+    std::vector<uint8_t> data;      // values of numeric columns, or the string pool
+    std::vector<uint64_t> offsets;  // num_rows + 1 offsets into the string pool, string columns only
+  };
+
+  /// \brief decode one msgpack value into a column
+  Status AppendValue(Column *column, const uint8_t **cursor, const uint8_t *end);
+
+  /// \brief append a number to a numeric column, integers are range checked against the column type
+  Status AppendInteger(Column *column, int64_t value, bool is_unsigned);
+  Status AppendReal(Column *column, double value);
+
+  /// \brief append a string to a string column
+  void AppendString(Column *column, const char *data, uint64_t size);
+
+  std::vector<Column> columns_;
+  std::unordered_map<std::string, int> column_ids_;
+  uint64_t num_rows_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_BUFFER_H_
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_page_index.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -60,6 +61,10 @@ class MINDRECORD_API ShardIndexGenerator {
 
   static Status Finalize(const std::vector<std::string> file_names);
 
+  /// \brief write a binary page index next to each meta file, enabled by default
+  /// \note the page index is not encrypted, disable it when the meta files are encrypted afterwards
+  void SetWritePageIndex(bool write_page_index) { write_page_index_ = write_page_index; }
+
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
 
@@ -106,6 +111,14 @@ class MINDRECORD_API ShardIndexGenerator {
   Status AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                                 std::vector<std::tuple<std::string, std::string, std::string>> &row_data);  // NOLINT
 
+  /// \brief collect the rows inserted to the meta file for the page index
+  Status AddPageIndexRows(const ROW_DATA &row_data, std::vector<ShardPageIndex::Record> *records,
+                          std::vector<std::vector<std::string>> *values);
+
+  /// \brief write the page index of one shard, a failure only disables the page index of this shard
+  void WritePageIndex(const std::string &shard_path, const std::vector<ShardPageIndex::Record> &records,
+                      const std::vector<std::vector<std::string>> &values);
+
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
@@ -117,6 +130,7 @@ class MINDRECORD_API ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  bool write_page_index_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
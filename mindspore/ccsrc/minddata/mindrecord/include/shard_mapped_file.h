@@ -0,0 +1,72 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A read-only memory mapping of a whole mindrecord shard file.
+/// The mapping is read-only and shared by all epochs, a consumer which needs to write copies the bytes first.
+/// Views handed out by the reader keep a shared_ptr to this object, the mapping lives until the last view is gone.
+class MINDRECORD_API ShardMappedFile {
+ public:
+  ShardMappedFile() = default;
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map the whole file into memory
+  /// \param[in] file_path the real path of the shard file
+  /// \param[out] mapped_file_ptr the mapped file
+  /// \return Status
+  static Status Map(const std::string &file_path, std::shared_ptr<ShardMappedFile> *mapped_file_ptr);
+
+  /// \brief check if memory mapped read is supported on this platform
+  static bool IsSupported();
+
+  /// \brief start address of the mapping
+  const uint8_t *Data() const { return data_; }
+
+  /// \brief size of the mapping in bytes
+  uint64_t Size() const { return size_; }
+
+ private:
+  uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+};
+
+/// \brief A non-owning view of the blob bytes of one row inside a mapped shard file
+struct ShardBlobView {
+  std::shared_ptr<ShardMappedFile> file;  // keeps the mapping alive while the view is in use
+  const uint8_t *data = nullptr;
+  uint64_t size = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A read-only binary copy of the INDEXES table of one shard, written next to the sqlite meta file.
+///
+/// File layout, all integers are native uint64:
+///   header  : magic "MRPGIDX2", num_rows, num_fields, num_pages, size and mtime of the shard file, size and mtime of
+///             the meta file, meta_size, pool_size
+///   meta    : shard name, meta file name and (field name, field type) pairs, each string prefixed by its length,
+///             padded to 8 bytes
+///   records : num_rows Record, sorted by row id
+///   pages   : num_pages PageEntry, sorted by blob page id, rows of one blob page are contiguous in records
+///   offsets : num_rows * num_fields + 1 offsets of the index field values in the pool
+///   pool    : index field values in the text form they were bound to sqlite
+/// The file is memory mapped when loading, so lookups neither open sqlite nor parse sql. The size and modification
+/// time of the shard and the meta file are checked with stat only, a changed file makes the reader use sqlite again.
+class MINDRECORD_API ShardPageIndex {
+ public:
+  /// \brief one row of the index, the same columns as the INDEXES table without the index fields
+  struct Record {
+    uint64_t row_id;
+    uint64_t row_group_id;
+    uint64_t page_id_raw;
+    uint64_t page_offset_raw;
+    uint64_t page_offset_raw_end;
+    uint64_t page_id_blob;
+    uint64_t page_offset_blob;
+    uint64_t page_offset_blob_end;
+  };
+
+  /// \brief type of an index field, follows the column type of the sqlite meta file
+  enum FieldType : uint64_t { kText = 0, kInteger = 1, kReal = 2 };
+
+  ShardPageIndex() = default;
+
+  ~ShardPageIndex() = default;
+
+  /// \brief write the page index of one shard after its meta file is closed, the name, size and modification time
+  ///     of the shard and the meta file are kept to verify the index later
+  /// \param[in] file_path path of the shard file, the index is written next to it
+  /// \param[in] fields index field names as in the sqlite meta file, and their sqlite column types
+  /// \param[in] records rows of the shard in any order
+  /// \param[in] values index field values of each row, in the order of fields
+  /// \return Status
+  static Status Write(const std::string &file_path, const std::vector<std::pair<std::string, std::string>> &fields,
+                      const std::vector<Record> &records, const std::vector<std::vector<std::string>> &values);
+
+  /// \brief map and verify the page index of one shard
+  /// \param[in] file_path path of the shard file, the index is looked up next to it
+  /// \param[out] index_ptr the page index
+  /// \return Status, error if the index does not exist, does not belong to the shard or the shard or its meta file
+  ///     changed after the index was written
+  static Status Load(const std::string &file_path, std::shared_ptr<ShardPageIndex> *index_ptr);
+
+  /// \brief path of the page index file of a shard
+  static std::string GetIndexPath(const std::string &file_path) { return file_path + kPageIndexSuffix; }
+
+  /// \brief number of rows in the shard
+  uint64_t NumRows() const { return num_rows_; }
+
+  /// \brief names of the index fields, as the column names of the sqlite meta file
+  const std::vector<std::string> &GetFieldNames() const { return field_names_; }
+
+  /// \brief position of an index field, -1 if the field is not in the index
+  int GetFieldIndex(const std::string &field_name) const;
+
+  /// \brief the row at position pos, rows are sorted by row id
+  const Record &GetRecord(uint64_t pos) const { return records_[pos]; }
+
+  /// \brief value of an index field of the row at position pos
+  Status GetFieldValue(uint64_t pos, int field, std::string *value) const;
+
+  /// \brief find the position of a row by its row id
+  /// \return false if the row id is not in the shard
+  bool FindRow(uint64_t row_id, uint64_t *pos) const;
+
+  /// \brief positions of the rows in a blob page whose field equals value, all rows of the page if field is -1
+  Status SelectRows(uint64_t page_id_blob, int field, const std::string &value, std::vector<uint64_t> *rows) const;
+
+  /// \brief blob pages containing a row whose field equals value, all blob pages if field is -1
+  Status SelectPages(int field, const std::string &value, std::vector<uint64_t> *pages) const;
+
+  /// \brief distinct values of an index field
+  Status GetDistinctValues(int field, std::set<std::string> *values) const;
+
+ private:
+  struct PageEntry {
+    uint64_t page_id_blob;
+    uint64_t begin_row;
+    uint64_t end_row;
+  };
+
+  /// \brief check if the field of the row at position pos equals value, with the comparison rules of sqlite
+  Status MatchValue(uint64_t pos, int field, const std::string &value, bool *match) const;
+
+  std::shared_ptr<ShardMappedFile> file_;  // mapping of the index file
+  uint64_t num_rows_ = 0;
+  uint64_t num_pages_ = 0;
+  uint64_t pool_size_ = 0;
+  std::vector<std::string> field_names_;
+  std::vector<FieldType> field_types_;
+  const Record *records_ = nullptr;
+  const PageEntry *pages_ = nullptr;
+  const uint64_t *value_offsets_ = nullptr;
+  const char *pool_ = nullptr;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_INDEX_H_
@@ -44,10 +44,13 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_column_buffer.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
+#include "minddata/mindrecord/include/shard_page_index.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
@@ -58,6 +61,7 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
+using TASK_CONTENT_VIEW = std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class MINDRECORD_API ShardReader {
@@ -184,6 +188,11 @@ class MINDRECORD_API ShardReader {
   Status GetNextById(const int64_t &task_id, const int32_t &consumer_id,
                      std::shared_ptr<TASK_CONTENT> *task_content_ptr);
 
+  /// \brief return a row by id, the blob is a view into the mapped shard file instead of a copy
+  /// \note only available when memory mapped read is enabled, see SetMmapRead
+  Status GetNextViewById(const int64_t &task_id, const int32_t &consumer_id,
+                         std::shared_ptr<TASK_CONTENT_VIEW> *task_content_ptr);
+
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -196,6 +205,27 @@ class MINDRECORD_API ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief read blob data through memory mapped shard files, must be set before Open
+  /// \note falls back to file stream read if the files can not be mapped
+  void SetMmapRead(bool mmap_read) { mmap_read_ = mmap_read; }
+
+  /// \brief check if blob data is read through memory mapped shard files
+  bool IsMmapRead() const { return mmap_read_ && !mapped_files_.empty(); }
+
+  /// \brief decode the raw fields of all rows into typed column buffers instead of json, must be set before Open
+  /// \note only takes effect in fast load mode without category, the json of the tasks is left empty then and the
+  ///       raw fields have to be fetched by GetRawColumnsById, falls back to json if a value can not be decoded
+  void SetColumnarRead(bool columnar_read) { columnar_read_ = columnar_read; }
+
+  /// \brief get the column buffer holding the raw fields of a task and the position of the task in it
+  /// \param[out] raw_columns the column buffer, nullptr if the raw fields of the task are in its json
+  /// \param[out] row position of the task in the column buffer
+  Status GetRawColumnsById(int64_t task_id, std::shared_ptr<ShardColumnBuffer> *raw_columns, uint64_t *row);
+
+  /// \brief look up pages, labels and categories in the binary page index, must be set before Open
+  /// \note shards without a valid page index always fall back to the sqlite meta file
+  void SetPageIndexRead(bool page_index_read) { page_index_read_ = page_index_read; }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
@@ -224,25 +254,33 @@ class MINDRECORD_API ShardReader {
   Status ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr, int shard_id,
                             const std::vector<std::string> &columns,
-                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                            const std::shared_ptr<ShardColumnBuffer> &raw_columns = nullptr);
 
   /// \brief convert json format to expected type
   Status ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                           const json &schema, json *value);
 
   /// \brief read all rows for specified columns
-  Status ReadAllRowGroup(const std::vector<std::string> &columns, std::shared_ptr<ROW_GROUPS> *row_group_ptr);
+  /// \param[in] raw_columns if not empty, the raw fields of each shard are decoded into its column buffer and the
+  ///            json of the rows is left empty
+  Status ReadAllRowGroup(const std::vector<std::string> &columns, std::shared_ptr<ROW_GROUPS> *row_group_ptr,
+                         const std::vector<std::shared_ptr<ShardColumnBuffer>> &raw_columns = {});
+
+  /// \brief create an empty column buffer of the selected raw fields for each shard
+  Status CreateRawColumns(std::vector<std::shared_ptr<ShardColumnBuffer>> *raw_columns);
 
   /// \brief read row meta by shard_id and sample_id
   Status ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                           const int32_t &consumer_id, const uint32_t &sample_id,
                                           std::shared_ptr<ROW_GROUPS> *row_group_ptr);
 
-  /// \brief read all rows in one shard
-  Status ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::string &sql,
+  /// \brief read all rows in one shard, or only the row of row_id if it is not negative
+  Status ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::string &sql, int64_t row_id,
                             const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                            std::shared_ptr<ShardColumnBuffer> raw_columns = nullptr);
 
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
@@ -266,6 +304,20 @@ class MINDRECORD_API ShardReader {
   /// \brief verify the validity of dataset
   Status VerifyDataset(sqlite3 **db, const string &file);
 
+  /// \brief drop the page indexes whose fields differ from the header and verify their meta files instead
+  Status VerifyPageIndexes();
+
+  /// \brief get the position of a column in the page index of a shard
+  Status GetPageIndexField(int shard_id, const std::string &column, int *field);
+
+  /// \brief select the rows of a blob page in the page index of a shard
+  Status SelectRowsFromPageIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                 std::vector<uint64_t> *rows);
+
+  /// \brief read the rows of a shard from its page index in the layout of the sqlite query of ReadAllRowsInShard
+  Status ReadRowsFromPageIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                               std::vector<std::vector<std::string>> *labels);
+
   /// \brief get column values
   Status GetLabels(int page_id, int shard_id, const std::vector<std::string> &columns,
                    const std::pair<std::string, std::string> &criteria, std::shared_ptr<std::vector<json>> *labels_ptr);
@@ -299,6 +351,13 @@ class MINDRECORD_API ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief map all shard files into memory
+  Status MapShardFiles();
+
+  /// \brief locate the blob of one task in the shard file and fetch its scalar fields
+  Status GetTaskBlobInfo(int64_t task_id, uint32_t consumer_id, TaskType *task_type, uint32_t *shard_id,
+                         uint64_t *file_offset, uint64_t *blob_size, json *var_fields);
+
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
@@ -307,6 +366,10 @@ class MINDRECORD_API ShardReader {
                                  const std::vector<std::vector<std::string>> &label_offsets,
                                  std::shared_ptr<std::vector<json>> *labels_ptr);
 
+  /// \brief get classes in one shard from its page index
+  Status GetClassesFromPageIndex(int shard_id, const std::string &field_name,
+                                 std::shared_ptr<std::set<std::string>> category_ptr);
+
   /// \brief get classes in one shard
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                          std::shared_ptr<std::set<std::string>> category_ptr);
@@ -326,9 +389,12 @@ class MINDRECORD_API ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardPageIndex>> page_indexes_;                    // binary page index list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // memory mapped shard files
+  std::vector<std::shared_ptr<ShardColumnBuffer>> raw_columns_;                  // raw fields of each shard
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -339,8 +405,11 @@ class MINDRECORD_API ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;     // if all columns are stored in index-table
+  bool interrupt_ = false;       // reader interrupted
+  bool mmap_read_ = false;       // read blob data through memory mapped files
+  bool page_index_read_ = true;  // look up the binary page index instead of the sqlite meta file
+  bool columnar_read_ = false;   // decode raw fields into column buffers instead of json
 
   int64_t num_padded_;  // number of padding samples
 
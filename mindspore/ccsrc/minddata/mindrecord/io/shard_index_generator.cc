@@ -15,6 +15,8 @@
  */
 #include "minddata/mindrecord/include/shard_index_generator.h"
 
+#include <cstdio>
+
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 
@@ -27,7 +29,8 @@ ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool appe
       header_size_(0),
       schema_count_(0),
       task_(0),
-      write_success_(true) {}
+      write_success_(true),
+      write_page_index_(true) {}
 
 Status ShardIndexGenerator::Build() {
   std::shared_ptr<json> header_ptr;
@@ -493,6 +496,72 @@ Status ShardIndexGenerator::GenerateIndexFields(const std::vector<json> &schema_
   return Status::OK();
 }
 
+Status ShardIndexGenerator::AddPageIndexRows(const ROW_DATA &row_data, std::vector<ShardPageIndex::Record> *records,
+                                             std::vector<std::vector<std::string>> *values) {
+  RETURN_UNEXPECTED_IF_NULL_MR(records);
+  RETURN_UNEXPECTED_IF_NULL_MR(values);
+  std::map<std::string, size_t> field_positions;
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    std::shared_ptr<std::string> fn_ptr;
+    RETURN_IF_NOT_OK_MR(GenerateFieldName(fields_[i], &fn_ptr));
+    field_positions[":" + *fn_ptr] = i;
+  }
+  const std::map<std::string, uint64_t ShardPageIndex::Record::*> record_members = {
+    {":ROW_ID", &ShardPageIndex::Record::row_id},
+    {":ROW_GROUP_ID", &ShardPageIndex::Record::row_group_id},
+    {":PAGE_ID_RAW", &ShardPageIndex::Record::page_id_raw},
+    {":PAGE_OFFSET_RAW", &ShardPageIndex::Record::page_offset_raw},
+    {":PAGE_OFFSET_RAW_END", &ShardPageIndex::Record::page_offset_raw_end},
+    {":PAGE_ID_BLOB", &ShardPageIndex::Record::page_id_blob},
+    {":PAGE_OFFSET_BLOB", &ShardPageIndex::Record::page_offset_blob},
+    {":PAGE_OFFSET_BLOB_END", &ShardPageIndex::Record::page_offset_blob_end}};
+  for (const auto &row : row_data) {
+    ShardPageIndex::Record record{};
+    std::vector<std::string> row_values(fields_.size());
+    for (const auto &field : row) {
+      const auto &place_holder = std::get<0>(field);
+      auto member = record_members.find(place_holder);
+      if (member != record_members.end()) {
+        record.*(member->second) = std::stoull(std::get<2>(field));
+        continue;
+      }
+      auto position = field_positions.find(place_holder);
+      if (position != field_positions.end()) {
+        row_values[position->second] = std::get<2>(field);
+      }
+    }
+    records->push_back(record);
+    values->push_back(std::move(row_values));
+  }
+  return Status::OK();
+}
+
+void ShardIndexGenerator::WritePageIndex(const std::string &shard_path,
+                                         const std::vector<ShardPageIndex::Record> &records,
+                                         const std::vector<std::vector<std::string>> &values) {
+  std::vector<std::pair<std::string, std::string>> index_fields;
+  for (const auto &field : fields_) {
+    std::shared_ptr<std::string> fn_ptr;
+    std::shared_ptr<Schema> schema_ptr;
+    Status st = GenerateFieldName(field, &fn_ptr);
+    if (st.IsOk()) {
+      st = shard_header_.GetSchemaByID(field.first, &schema_ptr);
+    }
+    if (st.IsError()) {
+      MS_LOG(WARNING) << "Failed to write page index of mindrecord file: " << shard_path << ", " << st.ToString();
+      return;
+    }
+    json json_schema = (schema_ptr->GetSchema())["schema"];
+    index_fields.emplace_back(*fn_ptr, ConvertJsonToSQL(TakeFieldType(field.second, json_schema)));
+  }
+  Status st = ShardPageIndex::Write(shard_path, index_fields, records, values);
+  if (st.IsError()) {
+    // the reader falls back to the meta file when the page index is missing
+    (void)std::remove(ShardPageIndex::GetIndexPath(shard_path).c_str());
+    MS_LOG(WARNING) << "Failed to write page index of mindrecord file: " << shard_path << ", " << st.ToString();
+  }
+}
+
 Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db, const std::vector<int> &raw_page_ids,
                                                const std::map<int, int> &blob_id_to_page_id) {
   // Add index data to database
@@ -511,6 +580,10 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  // an index left by a previous run does not match the new meta file
+  (void)std::remove(ShardPageIndex::GetIndexPath(realpath.value()).c_str());
+  std::vector<ShardPageIndex::Record> index_records;
+  std::vector<std::vector<std::string>> index_values;
   auto sql_code = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   if (sql_code != SQLITE_OK) {
     in.close();
@@ -524,6 +597,9 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
+    if (write_page_index_) {
+      RELEASE_AND_RETURN_IF_NOT_OK_MR(AddPageIndexRows(*row_data_ptr, &index_records, &index_values), db, in);
+    }
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
   }
   sql_code = sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
@@ -538,6 +614,10 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+
+  if (write_page_index_) {
+    WritePageIndex(realpath.value(), index_records, index_values);
+  }
   return Status::OK();
 }
 
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mindspore {
+namespace mindrecord {
+ShardMappedFile::~ShardMappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr && size_ > 0) {
+    if (munmap(data_, size_) != 0) {
+      MS_LOG(ERROR) << "[Internal ERROR] Failed to unmap mindrecord file, errno: " << errno;
+    }
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool ShardMappedFile::IsSupported() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  return true;
+#else
+  return false;
+#endif
+}
+
+Status ShardMappedFile::Map(const std::string &file_path, std::shared_ptr<ShardMappedFile> *mapped_file_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(mapped_file_ptr);
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open mindrecord file for mapping: " + file_path +
+                                             ", errno: " + std::to_string(errno));
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to get the size of mindrecord file: " + file_path);
+  }
+  auto file_size = static_cast<uint64_t>(file_stat.st_size);
+  if (file_size == 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, mindrecord file is empty: " + file_path);
+  }
+  void *addr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED, "[Internal ERROR] Failed to map mindrecord file: " + file_path +
+                                                        ", errno: " + std::to_string(errno));
+  // rows are fetched in sampler order, read-ahead of the whole file would only waste page cache
+  (void)madvise(addr, file_size, MADV_RANDOM);
+
+  auto mapped_file = std::make_shared<ShardMappedFile>();
+  mapped_file->data_ = static_cast<uint8_t *>(addr);
+  mapped_file->size_ = file_size;
+  *mapped_file_ptr = std::move(mapped_file);
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Memory mapped read of mindrecord file is not supported on Windows.");
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <thread>
 
+#include "./securec.h"
 #include "utils/file_utils.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "utils/ms_utils.h"
@@ -83,15 +84,29 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+    std::shared_ptr<ShardPageIndex> page_index;
+    if (page_index_read_) {
+      Status st = ShardPageIndex::Load(file, &page_index);
+      if (st.IsError()) {
+        MS_LOG(INFO) << "Use the meta file of mindrecord file: " << file << ", " << st.ToString();
+        page_index = nullptr;
+      }
+    }
+    // the page index is only loaded if the meta file is unchanged since the index was written, so the meta file
+    // is opened and verified only for the shards without a page index
     sqlite3 *db = nullptr;
-    RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    if (page_index == nullptr) {
+      RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    }
     database_paths_.push_back(db);
+    page_indexes_.push_back(page_index);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK_MR(sh.BuildDataset(file_paths_, load_dataset));
   shard_header_ = std::make_shared<ShardHeader>(sh);
   header_size_ = shard_header_->GetHeaderSize();
   page_size_ = shard_header_->GetPageSize();
+  RETURN_IF_NOT_OK_MR(VerifyPageIndexes());
   // version < 3.0
   if ((*first_meta_data_ptr)["version"] < kVersion) {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, false);
@@ -181,6 +196,94 @@ Status ShardReader::VerifyDataset(sqlite3 **db, const string &file) {
   return Status::OK();
 }
 
+Status ShardReader::VerifyPageIndexes() {
+  std::vector<std::string> field_names;
+  for (const auto &field : shard_header_->GetFields()) {
+    std::shared_ptr<std::string> fn_ptr;
+    RETURN_IF_NOT_OK_MR(ShardIndexGenerator::GenerateFieldName(field, &fn_ptr));
+    field_names.push_back(*fn_ptr);
+  }
+  for (size_t i = 0; i < page_indexes_.size(); ++i) {
+    if (page_indexes_[i] == nullptr || page_indexes_[i]->GetFieldNames() == field_names) {
+      continue;
+    }
+    MS_LOG(WARNING) << "The index fields in page index of mindrecord file: " << file_paths_[i]
+                    << " are different from its header, use the meta file instead.";
+    page_indexes_[i] = nullptr;
+    RETURN_IF_NOT_OK_MR(VerifyDataset(&database_paths_[i], file_paths_[i]));
+  }
+  return Status::OK();
+}
+
+Status ShardReader::GetPageIndexField(int shard_id, const std::string &column, int *field) {
+  RETURN_UNEXPECTED_IF_NULL_MR(field);
+  // called by the readers of all shards at the same time, so the column-schema map must not be changed here
+  auto iter = column_schema_id_.find(column);
+  uint64_t schema_id = iter == column_schema_id_.end() ? 0 : iter->second;
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(ShardIndexGenerator::GenerateFieldName(std::make_pair(schema_id, column), &fn_ptr));
+  *field = page_indexes_[shard_id]->GetFieldIndex(*fn_ptr);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(*field >= 0, "Invalid data, field: " + column +
+                                                 " can not found in index fields of mindrecord file: " +
+                                                 file_paths_[shard_id]);
+  return Status::OK();
+}
+
+Status ShardReader::SelectRowsFromPageIndex(int page_id, int shard_id,
+                                            const std::pair<std::string, std::string> &criteria,
+                                            std::vector<uint64_t> *rows) {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  int field = -1;
+  if (!criteria.first.empty()) {
+    RETURN_IF_NOT_OK_MR(GetPageIndexField(shard_id, criteria.first, &field));
+  }
+  return page_indexes_[shard_id]->SelectRows(page_id, field, criteria.second, rows);
+}
+
+Status ShardReader::ReadRowsFromPageIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                                          std::vector<std::vector<std::string>> *labels) {
+  RETURN_UNEXPECTED_IF_NULL_MR(labels);
+  const auto &page_index = page_indexes_[shard_id];
+  std::vector<int> fields;
+  if (all_in_index_) {
+    for (const auto &column : columns) {
+      int field = -1;
+      RETURN_IF_NOT_OK_MR(GetPageIndexField(shard_id, column, &field));
+      fields.push_back(field);
+    }
+  }
+  auto add_row = [&](uint64_t pos) -> Status {
+    const auto &record = page_index->GetRecord(pos);
+    std::vector<std::string> label{std::to_string(record.row_group_id), std::to_string(record.page_offset_blob),
+                                   std::to_string(record.page_offset_blob_end)};
+    if (all_in_index_) {
+      for (auto field : fields) {
+        std::string value;
+        RETURN_IF_NOT_OK_MR(page_index->GetFieldValue(pos, field, &value));
+        label.push_back(std::move(value));
+      }
+    } else {
+      label.push_back(std::to_string(record.page_id_raw));
+      label.push_back(std::to_string(record.page_offset_raw));
+      label.push_back(std::to_string(record.page_offset_raw_end));
+    }
+    labels->push_back(std::move(label));
+    return Status::OK();
+  };
+  if (row_id >= 0) {
+    uint64_t pos = 0;
+    if (page_index->FindRow(static_cast<uint64_t>(row_id), &pos)) {
+      RETURN_IF_NOT_OK_MR(add_row(pos));
+    }
+    return Status::OK();
+  }
+  labels->reserve(page_index->NumRows());
+  for (uint64_t pos = 0; pos < page_index->NumRows(); ++pos) {
+    RETURN_IF_NOT_OK_MR(add_row(pos));
+  }
+  return Status::OK();
+}
+
 Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   auto schema_ptr = GetShardHeader()->GetSchemas()[0];
   auto schema = schema_ptr->GetSchema()["schema"];
@@ -225,6 +328,41 @@ Status ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Succeed to open file, path: " << file;
   }
+  if (mmap_read_) {
+    auto rc = MapShardFiles();
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to map mindrecord files into memory, fall back to file stream read. "
+                      << rc.ToString();
+      mapped_files_.clear();
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardReader::MapShardFiles() {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(ShardMappedFile::IsSupported(),
+                                  "Memory mapped read of mindrecord files is not supported on this platform.");
+  mapped_files_.clear();
+  for (const auto &file : file_paths_) {
+    std::optional<std::string> dir = "";
+    std::optional<std::string> local_file_name = "";
+    FileUtils::SplitDirAndFileName(file, &dir, &local_file_name);
+    if (!dir.has_value()) {
+      dir = ".";
+    }
+
+    auto realpath = FileUtils::GetRealPath(dir.value().c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      realpath.has_value(), "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file);
+
+    std::optional<std::string> whole_path = "";
+    FileUtils::ConcatDirAndFileName(&realpath, &local_file_name, &whole_path);
+
+    std::shared_ptr<ShardMappedFile> mapped_file;
+    RETURN_IF_NOT_OK_MR(ShardMappedFile::Map(whole_path.value(), &mapped_file));
+    mapped_files_.push_back(std::move(mapped_file));
+    MS_LOG(INFO) << "Succeed to map file, path: " << file;
+  }
   return Status::OK();
 }
 
@@ -321,6 +459,8 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  // tensors which still view the mappings hold their own reference, so the files are unmapped when they are gone
+  mapped_files_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -404,8 +544,12 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
                                        std::shared_ptr<std::fstream> fs,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                                        int shard_id, const std::vector<std::string> &columns,
-                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                                       const std::shared_ptr<ShardColumnBuffer> &raw_columns) {
   auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  if (raw_columns != nullptr) {
+    raw_columns->Reserve(raw_columns->NumRows() + labels.size());
+  }
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     try {
       uint64_t group_id = std::stoull(labels[i][0]);
@@ -435,6 +579,11 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
           fs->close();
           RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
         }
+        if (raw_columns != nullptr) {
+          RETURN_IF_NOT_OK_MR(raw_columns->AppendRaw(label_raw.data(), label_raw.size()));
+          (*col_val_ptr)[shard_id].emplace_back(json());
+          continue;
+        }
         json label_json = json::from_msgpack(label_raw);
         json tmp;
         if (!columns.empty()) {
@@ -447,6 +596,10 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
           tmp = label_json;
         }
         (*col_val_ptr)[shard_id].emplace_back(tmp);
+      } else if (raw_columns != nullptr) {
+        constexpr size_t index = 3;
+        RETURN_IF_NOT_OK_MR(raw_columns->AppendText(labels[i], index));
+        (*col_val_ptr)[shard_id].emplace_back(json());
       } else {
         json construct_json;
         RETURN_IF_NOT_OK_MR(ConvertJsonValue(labels[i], columns, schema, &construct_json));
@@ -488,11 +641,17 @@ Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, cons
   return Status::OK();
 }
 Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::string &sql,
-                                       const std::vector<std::string> &columns,
+                                       int64_t row_id, const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
-                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
-  auto db = database_paths_[shard_id];
+                                       std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr,
+                                       std::shared_ptr<ShardColumnBuffer> raw_columns) {
   std::vector<std::vector<std::string>> labels;
+  if (page_indexes_[shard_id] != nullptr) {
+    RETURN_IF_NOT_OK_MR(ReadRowsFromPageIndex(shard_id, row_id, columns, &labels));
+    return ConvertLabelToJson(labels, file_streams_random_[consumer_id][shard_id], offset_ptr, shard_id, columns,
+                              col_val_ptr, raw_columns);
+  }
+  auto db = database_paths_[shard_id];
   char *errmsg = nullptr;
   int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
   if (rc != SQLITE_OK) {
@@ -508,7 +667,7 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id,
 
   sqlite3_free(errmsg);
   return ConvertLabelToJson(labels, file_streams_random_[consumer_id][shard_id], offset_ptr, shard_id, columns,
-                            col_val_ptr);
+                            col_val_ptr, raw_columns);
 }
 
 Status ShardReader::GetAllClasses(const std::string &category_field,
@@ -524,18 +683,44 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::shared_ptr<std::string> fn_ptr;
   RETURN_IF_NOT_OK_MR(
     ShardIndexGenerator::GenerateFieldName(std::make_pair(index_columns[category_field], category_field), &fn_ptr));
+  // shards with page index are cheap to scan, only the meta files are queried in threads
+  for (int x = 0; x < shard_count_; x++) {
+    if (page_indexes_[x] != nullptr) {
+      RETURN_IF_NOT_OK_MR(GetClassesFromPageIndex(x, *fn_ptr, category_ptr));
+    }
+  }
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    if (page_indexes_[x] == nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   return Status::OK();
 }
 
+Status ShardReader::GetClassesFromPageIndex(int shard_id, const std::string &field_name,
+                                            std::shared_ptr<std::set<std::string>> category_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(category_ptr);
+  int field = page_indexes_[shard_id]->GetFieldIndex(field_name);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(field >= 0, "Invalid data, field: " + field_name +
+                                                " can not found in index fields of mindrecord file: " +
+                                                file_paths_[shard_id]);
+  std::set<std::string> categories;
+  RETURN_IF_NOT_OK_MR(page_indexes_[shard_id]->GetDistinctValues(field, &categories));
+  MS_LOG(INFO) << "Succeed to get " << categories.size() << " records from shard " << std::to_string(shard_id)
+               << " index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  category_ptr->insert(categories.begin(), categories.end());
+  return Status::OK();
+}
+
 void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                                     std::shared_ptr<std::set<std::string>> category_ptr) {
   if (db == nullptr) {
@@ -561,8 +746,8 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
   sqlite3_free(errmsg);
 }
 
-Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
-                                    std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
+Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns, std::shared_ptr<ROW_GROUPS> *row_group_ptr,
+                                    const std::vector<std::shared_ptr<ShardColumnBuffer>> &raw_columns) {
   RETURN_UNEXPECTED_IF_NULL_MR(row_group_ptr);
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
@@ -586,8 +771,9 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   std::vector<std::future<Status>> async_results;
   auto status = Status::OK();
   for (int x = 0; x < shard_count_; x++) {
-    async_results.push_back(std::async(std::launch::async, &ShardReader::ReadAllRowsInShard, this, x, 0, sql, columns,
-                                       offset_ptr, col_val_ptr));
+    auto shard_raw_columns = raw_columns.empty() ? nullptr : raw_columns[x];
+    async_results.push_back(std::async(std::launch::async, &ShardReader::ReadAllRowsInShard, this, x, 0, sql, -1,
+                                       columns, offset_ptr, col_val_ptr, shard_raw_columns));
   }
 
   for (auto i = 0; i < async_results.size(); i++) {
@@ -603,6 +789,28 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   return Status::OK();
 }
 
+Status ShardReader::CreateRawColumns(std::vector<std::shared_ptr<ShardColumnBuffer>> *raw_columns) {
+  RETURN_UNEXPECTED_IF_NULL_MR(raw_columns);
+  auto columns = selected_columns_.empty() ? shard_column_->GetColumnName() : selected_columns_;
+  std::vector<std::pair<std::string, ColumnDataType>> raw_fields;
+  for (const auto &column : columns) {
+    ColumnDataType column_data_type = ColumnNoDataType;
+    uint64_t column_data_type_size = 1;
+    std::vector<int64_t> column_shape;
+    ColumnCategory category = ColumnNotFound;
+    RETURN_IF_NOT_OK_MR(
+      shard_column_->GetColumnTypeByName(column, &column_data_type, &column_data_type_size, &column_shape, &category));
+    if (category == ColumnInRaw) {
+      raw_fields.emplace_back(column, column_data_type);
+    }
+  }
+  raw_columns->clear();
+  for (int shard_id = 0; shard_id < shard_count_; ++shard_id) {
+    raw_columns->push_back(std::make_shared<ShardColumnBuffer>(raw_fields));
+  }
+  return Status::OK();
+}
+
 Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                                      const int32_t &consumer_id, const uint32_t &sample_id,
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
@@ -625,7 +833,8 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
 
   std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
 
-  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, consumer_id, sql, columns, offset_ptr, col_val_ptr));
+  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, consumer_id, sql, static_cast<int64_t>(sample_id), columns,
+                                         offset_ptr, col_val_ptr, nullptr));
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -684,6 +893,23 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (page_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    Status st = SelectRowsFromPageIndex(page_id, shard_id, criteria, &rows);
+    if (st.IsError()) {
+      MS_LOG(EXCEPTION) << st.ToString();
+    }
+    std::vector<std::vector<uint64_t>> res;
+    for (auto pos : rows) {
+      const auto &record = page_indexes_[shard_id]->GetRecord(pos);
+      res.emplace_back(std::vector<uint64_t>{record.page_offset_blob + kInt64Len, record.page_offset_blob_end});
+      if (res.back()[1] < res.back()[0]) {
+        MS_LOG(EXCEPTION) << "The sample's end offset: " << std::to_string(res.back()[1])
+                          << " should >= start offset: " << std::to_string(res.back()[0]) << ", check fail.";
+      }
+    }
+    return res;
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = :page_id_blob";
@@ -755,6 +981,13 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(pages_ptr);
+  if (page_indexes_[shard_id] != nullptr) {
+    int field = -1;
+    if (!criteria.first.empty()) {
+      RETURN_IF_NOT_OK_MR(GetPageIndexField(shard_id, criteria.first, &field));
+    }
+    return page_indexes_[shard_id]->SelectPages(field, criteria.second, pages_ptr->get());
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -934,7 +1167,15 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
     "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = :page_id_blob";
 
   auto label_offset_ptr = std::make_shared<std::vector<std::vector<std::string>>>();
-  if (!criteria.first.empty()) {
+  if (page_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    RETURN_IF_NOT_OK_MR(SelectRowsFromPageIndex(page_id, shard_id, criteria, &rows));
+    for (auto pos : rows) {
+      const auto &record = page_indexes_[shard_id]->GetRecord(pos);
+      label_offset_ptr->push_back({std::to_string(record.page_id_raw), std::to_string(record.page_offset_raw),
+                                   std::to_string(record.page_offset_raw_end)});
+    }
+  } else if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria;";
     RETURN_IF_NOT_OK_MR(QueryWithPageIdBlobAndCriteria(db, sql, page_id, criteria.second, label_offset_ptr));
   } else {
@@ -994,7 +1235,25 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
     }
     auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = :page_id_blob";
-    if (!criteria.first.empty()) {
+    if (page_indexes_[shard_id] != nullptr) {
+      std::vector<int> field_ids;
+      for (const auto &column : columns) {
+        int field = -1;
+        RETURN_IF_NOT_OK_MR(GetPageIndexField(shard_id, column, &field));
+        field_ids.push_back(field);
+      }
+      std::vector<uint64_t> rows;
+      RETURN_IF_NOT_OK_MR(SelectRowsFromPageIndex(page_id, shard_id, criteria, &rows));
+      for (auto pos : rows) {
+        std::vector<std::string> label;
+        for (auto field : field_ids) {
+          std::string value;
+          RETURN_IF_NOT_OK_MR(page_indexes_[shard_id]->GetFieldValue(pos, field, &value));
+          label.push_back(std::move(value));
+        }
+        labels->push_back(std::move(label));
+      }
+    } else if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria;";
       RETURN_IF_NOT_OK_MR(QueryWithPageIdBlobAndCriteria(db, sql, page_id, criteria.second, labels));
     } else {
@@ -1084,8 +1343,20 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
   auto category_ptr = std::make_shared<std::set<std::string>>();
+  for (int x = 0; x < shard_count; x++) {
+    if (static_cast<size_t>(x) < page_indexes_.size() && page_indexes_[x] != nullptr) {
+      Status st = GetClassesFromPageIndex(x, *fn_ptr, category_ptr);
+      if (st.IsError()) {
+        MS_LOG(ERROR) << st.ToString();
+        return -1;
+      }
+    }
+  }
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    if (static_cast<size_t>(x) < page_indexes_.size() && page_indexes_[x] != nullptr) {
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1103,7 +1374,9 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   }
 
   for (int x = 0; x < shard_count; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   sqlite3_close(db);
   return category_ptr->size();
@@ -1300,7 +1573,21 @@ Status ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, int,
                                      const std::vector<std::shared_ptr<ShardOperator>> &operators) {
   CheckIfColumnInIndex(selected_columns_);
   std::shared_ptr<ROW_GROUPS> row_group_ptr;
-  RETURN_IF_NOT_OK_MR(ReadAllRowGroup(selected_columns_, &row_group_ptr));
+  raw_columns_.clear();
+  if (columnar_read_) {
+    std::vector<std::shared_ptr<ShardColumnBuffer>> raw_columns;
+    RETURN_IF_NOT_OK_MR(CreateRawColumns(&raw_columns));
+    auto status = ReadAllRowGroup(selected_columns_, &row_group_ptr, raw_columns);
+    if (status.IsOk()) {
+      raw_columns_ = std::move(raw_columns);
+    } else {
+      MS_LOG(WARNING) << "Failed to decode the raw fields into column buffers, fall back to json. "
+                      << status.ToString();
+    }
+  }
+  if (raw_columns_.empty()) {
+    RETURN_IF_NOT_OK_MR(ReadAllRowGroup(selected_columns_, &row_group_ptr));
+  }
   auto &offsets = std::get<0>(*row_group_ptr);
   auto &local_columns = std::get<1>(*row_group_ptr);
   int sample_count = 0;
@@ -1321,9 +1608,12 @@ Status ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, int,
     init_tasks_thread[shard_id] = std::thread([this, &offsets, &local_columns, shard_id, current_offset]() {
       auto offset = current_offset;
       for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
+        std::vector<uint64_t> blob_offset{offsets[shard_id][i][2], offsets[shard_id][i][3]};
+        if (!raw_columns_.empty()) {
+          blob_offset.push_back(i);  // position of the row in the column buffer of the shard
+        }
         tasks_.InsertTask(offset, TaskType::kCommonTask, offsets[shard_id][i][0], offsets[shard_id][i][1],
-                          std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]},
-                          local_columns[shard_id][i]);
+                          blob_offset, local_columns[shard_id][i]);
         offset++;
       }
     });
@@ -1449,9 +1739,13 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+Status ShardReader::GetTaskBlobInfo(int64_t task_id, uint32_t consumer_id, TaskType *task_type, uint32_t *shard_id,
+                                    uint64_t *file_offset, uint64_t *blob_size, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_type);
+  RETURN_UNEXPECTED_IF_NULL_MR(shard_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(file_offset);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_size);
+  RETURN_UNEXPECTED_IF_NULL_MR(var_fields);
   if (load_mode_ == LoadMode::kFast || load_mode_ == LoadMode::kLazy) {
     // All tasks are done
     CHECK_FAIL_RETURN_UNEXPECTED_MR(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
@@ -1463,23 +1757,19 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
         " is out of bound: " + std::to_string(num_padded_ + shard_sample_count_[shard_sample_count_.size() - 1]));
   }
 
-  uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (load_mode_ == LoadMode::kLazy || load_mode_ == LoadMode::kSlow) {
     // get scalar variable fields by sample id
@@ -1488,40 +1778,95 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     // read the meta from index
     std::shared_ptr<ROW_GROUPS> row_group_ptr;
     RETURN_IF_NOT_OK_MR(
-      ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
+      ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];        // group_id
+    blob_start = offsets[*shard_id][0][2];      // blob start
+    blob_end = offsets[*shard_id][0][3];        // blob end
+    *var_fields = local_columns[*shard_id][0];  // scalar variable field
   } else {
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *var_fields = std::get<3>(task);            // scalar variable field
   }
 
-  // read the blob from data file
+  // locate the blob in data file
   std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
-  MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
+  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, *shard_id, &page_ptr));
+  MS_LOG(DEBUG) << "Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *blob_size = blob_end - blob_start;
+  return Status::OK();
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+Status ShardReader::GetRawColumnsById(int64_t task_id, std::shared_ptr<ShardColumnBuffer> *raw_columns,
+                                      uint64_t *row) {
+  RETURN_UNEXPECTED_IF_NULL_MR(raw_columns);
+  RETURN_UNEXPECTED_IF_NULL_MR(row);
+  *raw_columns = nullptr;
+  *row = 0;
+  if (raw_columns_.empty()) {
+    return Status::OK();
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    file_streams_random_[consumer_id][shard_id]->close();
-    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
+                                                             " is out of bound: " + std::to_string(tasks_.Size()));
+  ShardTask task = tasks_.GetTaskByID(task_id);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return Status::OK();
+  }
+  auto shard_id = std::get<0>(std::get<1>(task));
+  const auto &blob_offset = std::get<2>(task);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id >= 0 && shard_id < static_cast<int>(raw_columns_.size()) &&
+                                    blob_offset.size() > kInt2,
+                                  "[Internal ERROR] Task: " + std::to_string(task_id) + " has no raw field position.");
+  *raw_columns = raw_columns_[shard_id];
+  *row = blob_offset[kInt2];
+  return Status::OK();
+}
+
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetTaskBlobInfo(task_id, consumer_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return Status::OK();
+  }
+
+  // Pack image list
+  std::vector<uint8_t> images(blob_size);
+  if (IsMmapRead()) {
+    // copy straight from the mapping, saves the seek and read syscalls
+    const auto &mapped_file = mapped_files_[shard_id];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(file_offset + blob_size <= mapped_file->Size(),
+                                    "[Internal ERROR] Blob exceeds the size of file: " + file_paths_[shard_id]);
+    if (blob_size > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(
+        memcpy_s(images.data(), blob_size, mapped_file->Data() + file_offset, blob_size) == 0,
+        "[Internal ERROR] Failed to call securec func [memcpy_s]");
+    }
+  } else {
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+    }
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_size);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      file_streams_random_[consumer_id][shard_id]->close();
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+    }
   }
 
   // Deliver batch data to output map
@@ -1645,6 +1990,37 @@ Status ShardReader::GetNextById(const int64_t &task_id, const int32_t &consumer_
   return Status::OK();
 }
 
+Status ShardReader::GetNextViewById(const int64_t &task_id, const int32_t &consumer_id,
+                                    std::shared_ptr<TASK_CONTENT_VIEW> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  if (interrupt_) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(IsMmapRead(), "[Internal ERROR] Memory mapped read of mindrecord is not enabled.");
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetTaskBlobInfo(task_id, consumer_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT_VIEW>(TaskType::kPaddedTask, std::vector<std::tuple<ShardBlobView, json>>());
+    return Status::OK();
+  }
+
+  const auto &mapped_file = mapped_files_[shard_id];
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(file_offset + blob_size <= mapped_file->Size(),
+                                  "[Internal ERROR] Blob exceeds the size of file: " + file_paths_[shard_id]);
+  ShardBlobView view{mapped_file, mapped_file->Data() + file_offset, blob_size};
+
+  std::vector<std::tuple<ShardBlobView, json>> batch;
+  batch.emplace_back(std::move(view), std::move(var_fields));
+  *task_content_ptr = std::make_shared<TASK_CONTENT_VIEW>(TaskType::kCommonTask, std::move(batch));
+  return Status::OK();
+}
+
 Status ShardReader::UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                                    std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(blob_data_ptr);
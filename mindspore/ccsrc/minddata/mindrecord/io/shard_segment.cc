@@ -23,7 +23,11 @@
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { SetAllInIndex(false); }
+ShardSegment::ShardSegment() {
+  SetAllInIndex(false);
+  // category statistics of mindpage are aggregated by sql, so the segment keeps reading the meta files
+  SetPageIndexRead(false);
+}
 
 Status ShardSegment::GetCategoryFields(std::shared_ptr<vector<std::string>> *fields_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(fields_ptr);
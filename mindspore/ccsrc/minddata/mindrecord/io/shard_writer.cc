@@ -103,6 +103,8 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // the page index is optional, a stale one would be rejected by the reader anyway
+          (void)std::remove((whole_path.value() + kPageIndexSuffix).c_str());
         } else {
           RETURN_STATUS_UNEXPECTED_MR(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
@@ -0,0 +1,355 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_column_buffer.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// msgpack format bytes, only the ones json::to_msgpack emits for an object of scalars are decoded
+constexpr uint8_t kFixMapMask = 0xf0;
+constexpr uint8_t kFixMap = 0x80;
+constexpr uint8_t kFixStrMask = 0xe0;
+constexpr uint8_t kFixStr = 0xa0;
+constexpr uint8_t kNegativeFixInt = 0xe0;
+constexpr uint8_t kPositiveFixIntMax = 0x7f;
+constexpr uint8_t kNil = 0xc0;
+constexpr uint8_t kFalse = 0xc2;
+constexpr uint8_t kTrue = 0xc3;
+constexpr uint8_t kBin8 = 0xc4;
+constexpr uint8_t kBin16 = 0xc5;
+constexpr uint8_t kBin32 = 0xc6;
+constexpr uint8_t kFloat32 = 0xca;
+constexpr uint8_t kFloat64 = 0xcb;
+constexpr uint8_t kUint8 = 0xcc;
+constexpr uint8_t kUint16 = 0xcd;
+constexpr uint8_t kUint32 = 0xce;
+constexpr uint8_t kUint64 = 0xcf;
+constexpr uint8_t kInt8 = 0xd0;
+constexpr uint8_t kInt16 = 0xd1;
+constexpr uint8_t kInt32 = 0xd2;
+constexpr uint8_t kInt64 = 0xd3;
+constexpr uint8_t kStr8 = 0xd9;
+constexpr uint8_t kStr16 = 0xda;
+constexpr uint8_t kStr32 = 0xdb;
+constexpr uint8_t kMap16 = 0xde;
+constexpr uint8_t kMap32 = 0xdf;
+
+// read a big endian unsigned integer of n_bytes and advance the cursor
+Status ReadBigEndian(const uint8_t **cursor, const uint8_t *end, uint64_t n_bytes, uint64_t *value) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - *cursor) >= n_bytes,
+                                  "[Internal ERROR] Raw field data is truncated.");
+  uint64_t result = 0;
+  for (uint64_t i = 0; i < n_bytes; ++i) {
+    result = (result << kBitsOfByte) | (*cursor)[i];
+  }
+  *cursor += n_bytes;
+  *value = result;
+  return Status::OK();
+}
+
+// length of a string or binary whose format byte is given, the cursor is behind the format byte
+Status ReadLength(uint8_t format, const uint8_t **cursor, const uint8_t *end, uint64_t *length) {
+  if ((format & kFixStrMask) == kFixStr) {
+    *length = format & ~kFixStrMask;
+    return Status::OK();
+  }
+  switch (format) {
+    case kStr8:
+    case kBin8:
+      return ReadBigEndian(cursor, end, sizeof(uint8_t), length);
+    case kStr16:
+    case kBin16:
+      return ReadBigEndian(cursor, end, sizeof(uint16_t), length);
+    case kStr32:
+    case kBin32:
+      return ReadBigEndian(cursor, end, sizeof(uint32_t), length);
+    default:
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Raw field value is not a string, format: " +
+                                  std::to_string(format));
+  }
+}
+
+bool IsString(uint8_t format) {
+  return (format & kFixStrMask) == kFixStr || format == kStr8 || format == kStr16 || format == kStr32;
+}
+
+// skip a scalar value whose column is not in the buffer
+Status SkipValue(const uint8_t **cursor, const uint8_t *end) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(*cursor < end, "[Internal ERROR] Raw field data is truncated.");
+  uint8_t format = *(*cursor)++;
+  if (format <= kPositiveFixIntMax || format >= kNegativeFixInt || format == kNil || format == kFalse ||
+      format == kTrue) {
+    return Status::OK();
+  }
+  uint64_t n_bytes = 0;
+  switch (format) {
+    case kUint8:
+    case kInt8:
+      n_bytes = sizeof(uint8_t);
+      break;
+    case kUint16:
+    case kInt16:
+      n_bytes = sizeof(uint16_t);
+      break;
+    case kUint32:
+    case kInt32:
+    case kFloat32:
+      n_bytes = sizeof(uint32_t);
+      break;
+    case kUint64:
+    case kInt64:
+    case kFloat64:
+      n_bytes = sizeof(uint64_t);
+      break;
+    default:
+      RETURN_IF_NOT_OK_MR(ReadLength(format, cursor, end, &n_bytes));
+      break;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - *cursor) >= n_bytes,
+                                  "[Internal ERROR] Raw field data is truncated.");
+  *cursor += n_bytes;
+  return Status::OK();
+}
+}  // namespace
+
+ShardColumnBuffer::ShardColumnBuffer(const std::vector<std::pair<std::string, ColumnDataType>> &columns) {
+  for (const auto &column : columns) {
+    column_ids_[column.first] = static_cast<int>(columns_.size());
+    Column new_column{column.first, column.second, ColumnDataTypeSize[column.second], {}, {}};
+    if (column.second == ColumnString) {
+      new_column.offsets.push_back(0);
+    }
+    columns_.push_back(std::move(new_column));
+  }
+}
+
+void ShardColumnBuffer::Reserve(uint64_t num_rows) {
+  for (auto &column : columns_) {
+    if (column.type == ColumnString) {
+      column.offsets.reserve(num_rows + 1);
+    } else {
+      column.data.reserve(num_rows * column.type_size);
+    }
+  }
+}
+
+int ShardColumnBuffer::GetColumnIndex(const std::string &column_name) const {
+  auto it = column_ids_.find(column_name);
+  return it == column_ids_.end() ? -1 : it->second;
+}
+
+Status ShardColumnBuffer::AppendRaw(const uint8_t *data, uint64_t size) {
+  RETURN_UNEXPECTED_IF_NULL_MR(data);
+  const uint8_t *cursor = data;
+  const uint8_t *end = data + size;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor < end, "[Internal ERROR] Raw field data is empty.");
+  uint8_t format = *cursor++;
+  uint64_t num_fields = 0;
+  if ((format & kFixMapMask) == kFixMap) {
+    num_fields = format & ~kFixMapMask;
+  } else if (format == kMap16) {
+    RETURN_IF_NOT_OK_MR(ReadBigEndian(&cursor, end, sizeof(uint16_t), &num_fields));
+  } else if (format == kMap32) {
+    RETURN_IF_NOT_OK_MR(ReadBigEndian(&cursor, end, sizeof(uint32_t), &num_fields));
+  } else {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Raw field data is not a map, format: " + std::to_string(format));
+  }
+
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor < end, "[Internal ERROR] Raw field data is truncated.");
+    uint64_t key_size = 0;
+    RETURN_IF_NOT_OK_MR(ReadLength(*cursor++, &cursor, end, &key_size));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - cursor) >= key_size,
+                                    "[Internal ERROR] Raw field data is truncated.");
+    auto it = column_ids_.find(std::string(reinterpret_cast<const char *>(cursor), key_size));
+    cursor += key_size;
+    if (it == column_ids_.end()) {
+      RETURN_IF_NOT_OK_MR(SkipValue(&cursor, end));
+    } else {
+      RETURN_IF_NOT_OK_MR(AppendValue(&columns_[it->second], &cursor, end));
+    }
+  }
+
+  // every column must have got exactly one value
+  for (const auto &column : columns_) {
+    auto count = column.type == ColumnString ? column.offsets.size() - 1 : column.data.size() / column.type_size;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(count == num_rows_ + 1,
+                                    "[Internal ERROR] Raw field: " + column.name + " is missing or duplicated.");
+  }
+  ++num_rows_;
+  return Status::OK();
+}
+
+Status ShardColumnBuffer::AppendText(const std::vector<std::string> &values, size_t first) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(values.size() >= first + columns_.size(),
+                                  "[Internal ERROR] The number of index values is less than the number of columns.");
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    auto &column = columns_[i];
+    const auto &value = values[first + i];
+    char *value_end = nullptr;
+    errno = 0;
+    if (column.type == ColumnString) {
+      AppendString(&column, value.data(), value.size());
+    } else if (column.type == ColumnInt32 || column.type == ColumnInt64) {
+      int64_t number = std::strtoll(value.c_str(), &value_end, 10);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(errno == 0 && value_end != value.c_str() && *value_end == '\0',
+                                      "[Internal ERROR] Failed to convert index value: " + value + " to type int.");
+      RETURN_IF_NOT_OK_MR(AppendInteger(&column, number, false));
+    } else {
+      double number = std::strtod(value.c_str(), &value_end);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(value_end != value.c_str() && *value_end == '\0',
+                                      "[Internal ERROR] Failed to convert index value: " + value + " to type float.");
+      RETURN_IF_NOT_OK_MR(AppendReal(&column, number));
+    }
+  }
+  ++num_rows_;
+  return Status::OK();
+}
+
+Status ShardColumnBuffer::AppendValue(Column *column, const uint8_t **cursor, const uint8_t *end) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(*cursor < end, "[Internal ERROR] Raw field data is truncated.");
+  uint8_t format = *(*cursor)++;
+  if (column->type == ColumnString) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(IsString(format),
+                                    "[Internal ERROR] The value of raw field: " + column->name + " is not a string.");
+    uint64_t length = 0;
+    RETURN_IF_NOT_OK_MR(ReadLength(format, cursor, end, &length));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(static_cast<uint64_t>(end - *cursor) >= length,
+                                    "[Internal ERROR] Raw field data is truncated.");
+    AppendString(column, reinterpret_cast<const char *>(*cursor), length);
+    *cursor += length;
+    return Status::OK();
+  }
+
+  if (format <= kPositiveFixIntMax) {
+    return AppendInteger(column, format, true);
+  }
+  if (format >= kNegativeFixInt) {
+    return AppendInteger(column, static_cast<int8_t>(format), false);
+  }
+  uint64_t bits = 0;
+  switch (format) {
+    case kUint8:
+    case kUint16:
+    case kUint32:
+    case kUint64:
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, 1ULL << (format - kUint8), &bits));
+      return AppendInteger(column, static_cast<int64_t>(bits), true);
+    case kInt8:
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(int8_t), &bits));
+      return AppendInteger(column, static_cast<int8_t>(bits), false);
+    case kInt16:
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(int16_t), &bits));
+      return AppendInteger(column, static_cast<int16_t>(bits), false);
+    case kInt32:
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(int32_t), &bits));
+      return AppendInteger(column, static_cast<int32_t>(bits), false);
+    case kInt64:
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(int64_t), &bits));
+      return AppendInteger(column, static_cast<int64_t>(bits), false);
+    case kFloat32: {
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(float), &bits));
+      auto bits32 = static_cast<uint32_t>(bits);
+      float value = 0;
+      (void)memcpy(&value, &bits32, sizeof(float));
+      return AppendReal(column, value);
+    }
+    case kFloat64: {
+      RETURN_IF_NOT_OK_MR(ReadBigEndian(cursor, end, sizeof(double), &bits));
+      double value = 0;
+      (void)memcpy(&value, &bits, sizeof(double));
+      return AppendReal(column, value);
+    }
+    default:
+      RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] The value of raw field: " + column->name +
+                                  " is not a number, format: " + std::to_string(format));
+  }
+}
+
+Status ShardColumnBuffer::AppendInteger(Column *column, int64_t value, bool is_unsigned) {
+  switch (column->type) {
+    case ColumnInt32: {
+      constexpr int64_t kMax = std::numeric_limits<int32_t>::max();
+      constexpr int64_t kMin = std::numeric_limits<int32_t>::min();
+      bool in_range = is_unsigned ? static_cast<uint64_t>(value) <= static_cast<uint64_t>(kMax)
+                                  : value >= kMin && value <= kMax;
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(in_range, "[Internal ERROR] column value: " + std::to_string(value) +
+                                                  " is out of range of raw field: " + column->name);
+      auto number = static_cast<int32_t>(value);
+      auto bytes = reinterpret_cast<const uint8_t *>(&number);
+      column->data.insert(column->data.end(), bytes, bytes + sizeof(int32_t));
+      return Status::OK();
+    }
+    case ColumnInt64: {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(!is_unsigned || value >= 0, "[Internal ERROR] column value: " +
+                                                                    std::to_string(static_cast<uint64_t>(value)) +
+                                                                    " is out of range of raw field: " + column->name);
+      auto bytes = reinterpret_cast<const uint8_t *>(&value);
+      column->data.insert(column->data.end(), bytes, bytes + sizeof(int64_t));
+      return Status::OK();
+    }
+    default: {
+      double number = is_unsigned ? static_cast<double>(static_cast<uint64_t>(value)) : static_cast<double>(value);
+      return AppendReal(column, number);
+    }
+  }
+}
+
+Status ShardColumnBuffer::AppendReal(Column *column, double value) {
+  if (column->type == ColumnFloat32) {
+    auto number = static_cast<float>(value);
+    auto bytes = reinterpret_cast<const uint8_t *>(&number);
+    column->data.insert(column->data.end(), bytes, bytes + sizeof(float));
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(column->type == ColumnFloat64,
+                                  "[Internal ERROR] The value of raw field: " + column->name + " is not an integer.");
+  auto bytes = reinterpret_cast<const uint8_t *>(&value);
+  column->data.insert(column->data.end(), bytes, bytes + sizeof(double));
+  return Status::OK();
+}
+
+void ShardColumnBuffer::AppendString(Column *column, const char *data, uint64_t size) {
+  column->data.insert(column->data.end(), data, data + size);
+  column->offsets.push_back(column->data.size());
+}
+
+Status ShardColumnBuffer::GetColumnValue(int column, uint64_t row, const unsigned char **data,
+                                         uint64_t *n_bytes) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(data);
+  RETURN_UNEXPECTED_IF_NULL_MR(n_bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(column >= 0 && column < static_cast<int>(columns_.size()),
+                                  "[Internal ERROR] Column index: " + std::to_string(column) + " is out of bound.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(row < num_rows_, "[Internal ERROR] Row: " + std::to_string(row) +
+                                                     " is out of bound: " + std::to_string(num_rows_));
+  const auto &target = columns_[column];
+  if (target.type == ColumnString) {
+    *data = target.data.data() + target.offsets[row];
+    *n_bytes = target.offsets[row + 1] - target.offsets[row];
+  } else {
+    *data = target.data.data() + row * target.type_size;
+    *n_bytes = target.type_size;
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
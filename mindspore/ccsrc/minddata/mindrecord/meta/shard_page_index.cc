@@ -0,0 +1,378 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_page_index.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr uint64_t kPageIndexMagicLen = 8;
+const char kPageIndexMagic[kPageIndexMagicLen + 1] = "MRPGIDX2";
+constexpr uint64_t kNanoSecondsPerSecond = 1000000000;
+
+struct PageIndexHeader {
+  char magic[kPageIndexMagicLen];
+  uint64_t num_rows;
+  uint64_t num_fields;
+  uint64_t num_pages;
+  uint64_t shard_file_size;
+  uint64_t shard_file_mtime;
+  uint64_t meta_file_size;
+  uint64_t meta_file_mtime;
+  uint64_t meta_size;
+  uint64_t pool_size;
+};
+
+void AppendUint64(uint64_t value, std::string *buffer) {
+  (void)buffer->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendString(const std::string &str, std::string *buffer) {
+  AppendUint64(str.size(), buffer);
+  (void)buffer->append(str);
+}
+
+bool ReadUint64(const uint8_t *buffer, uint64_t size, uint64_t *pos, uint64_t *value) {
+  if (size < sizeof(uint64_t) || *pos > size - sizeof(uint64_t)) {
+    return false;
+  }
+  (void)memcpy(value, buffer + *pos, sizeof(uint64_t));
+  *pos += sizeof(uint64_t);
+  return true;
+}
+
+bool ReadString(const uint8_t *buffer, uint64_t size, uint64_t *pos, std::string *str) {
+  uint64_t len = 0;
+  if (!ReadUint64(buffer, size, pos, &len) || len > size - *pos) {
+    return false;
+  }
+  str->assign(reinterpret_cast<const char *>(buffer + *pos), len);
+  *pos += len;
+  return true;
+}
+
+ShardPageIndex::FieldType ToFieldType(const std::string &sql_type) {
+  if (sql_type == "INTEGER") {
+    return ShardPageIndex::kInteger;
+  }
+  if (sql_type == "REAL") {
+    return ShardPageIndex::kReal;
+  }
+  return ShardPageIndex::kText;
+}
+
+bool ToNumber(const std::string &str, long double *number) {
+  if (str.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  *number = std::strtold(str.c_str(), &end);
+  return end == str.c_str() + str.size();
+}
+
+/// \brief size and modification time in nanoseconds of a file, a rewritten file differs in at least one of them
+Status GetFileIdentity(const std::string &file_path, uint64_t *file_size, uint64_t *file_mtime) {
+  struct stat file_stat {};
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(stat(file_path.c_str(), &file_stat) == 0,
+                                  "Invalid file, failed to get the status of file: " + file_path);
+  *file_size = static_cast<uint64_t>(file_stat.st_size);
+#if defined(_WIN32) || defined(_WIN64)
+  *file_mtime = static_cast<uint64_t>(file_stat.st_mtime) * kNanoSecondsPerSecond;
+#elif defined(__APPLE__)
+  *file_mtime = static_cast<uint64_t>(file_stat.st_mtimespec.tv_sec) * kNanoSecondsPerSecond +
+                static_cast<uint64_t>(file_stat.st_mtimespec.tv_nsec);
+#else
+  *file_mtime = static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * kNanoSecondsPerSecond +
+                static_cast<uint64_t>(file_stat.st_mtim.tv_nsec);
+#endif
+  return Status::OK();
+}
+}  // namespace
+
+Status ShardPageIndex::Write(const std::string &file_path,
+                             const std::vector<std::pair<std::string, std::string>> &fields,
+                             const std::vector<Record> &records, const std::vector<std::vector<std::string>> &values) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(records.size() == values.size(),
+                                  "[Internal ERROR] The number of rows: " + std::to_string(records.size()) +
+                                    " and the number of index values: " + std::to_string(values.size()) +
+                                    " are not equal.");
+  std::vector<uint64_t> order(records.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&records](uint64_t a, uint64_t b) { return records[a].row_id < records[b].row_id; });
+
+  // a blob page is kept as a range of rows, so its rows have to be neighbours in row id order
+  std::vector<PageEntry> pages;
+  std::set<uint64_t> visited_pages;
+  for (uint64_t i = 0; i < order.size(); ++i) {
+    const auto &record = records[order[i]];
+    if (!pages.empty() && pages.back().page_id_blob == record.page_id_blob) {
+      pages.back().end_row = i + 1;
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(visited_pages.insert(record.page_id_blob).second,
+                                    "[Internal ERROR] The rows of blob page: " + std::to_string(record.page_id_blob) +
+                                      " are not contiguous, page index can not be built.");
+    pages.push_back({record.page_id_blob, i, i + 1});
+  }
+  std::sort(pages.begin(), pages.end(),
+            [](const PageEntry &a, const PageEntry &b) { return a.page_id_blob < b.page_id_blob; });
+
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(file_path, &fn_ptr));
+  PageIndexHeader header{};
+  RETURN_IF_NOT_OK_MR(GetFileIdentity(file_path, &header.shard_file_size, &header.shard_file_mtime));
+  RETURN_IF_NOT_OK_MR(GetFileIdentity(file_path + kMetaFileSuffix, &header.meta_file_size, &header.meta_file_mtime));
+
+  std::string meta;
+  AppendString(*fn_ptr, &meta);
+  AppendString(*fn_ptr + kMetaFileSuffix, &meta);
+  for (const auto &field : fields) {
+    AppendString(field.first, &meta);
+    AppendUint64(ToFieldType(field.second), &meta);
+  }
+  meta.resize((meta.size() + kInt64Len - 1) / kInt64Len * kInt64Len, '\0');
+
+  std::vector<uint64_t> value_offsets;
+  value_offsets.reserve(order.size() * fields.size() + 1);
+  uint64_t pool_size = 0;
+  for (auto row : order) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(values[row].size() == fields.size(),
+                                    "[Internal ERROR] The number of index values: " +
+                                      std::to_string(values[row].size()) + " of row: " +
+                                      std::to_string(records[row].row_id) + " is not equal to the number of fields.");
+    for (const auto &value : values[row]) {
+      value_offsets.push_back(pool_size);
+      pool_size += value.size();
+    }
+  }
+  value_offsets.push_back(pool_size);
+
+  (void)memcpy(header.magic, kPageIndexMagic, kPageIndexMagicLen);
+  header.num_rows = order.size();
+  header.num_fields = fields.size();
+  header.num_pages = pages.size();
+  header.meta_size = meta.size();
+  header.pool_size = pool_size;
+
+  auto index_path = GetIndexPath(file_path);
+  std::ofstream out(index_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(out.good(), "Invalid file, failed to open page index file: " + index_path +
+                                                ". Please check file path and permission.");
+  (void)out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void)out.write(meta.data(), static_cast<std::streamsize>(meta.size()));
+  for (auto row : order) {
+    (void)out.write(reinterpret_cast<const char *>(&records[row]), sizeof(Record));
+  }
+  (void)out.write(reinterpret_cast<const char *>(pages.data()),
+                  static_cast<std::streamsize>(pages.size() * sizeof(PageEntry)));
+  (void)out.write(reinterpret_cast<const char *>(value_offsets.data()),
+                  static_cast<std::streamsize>(value_offsets.size() * sizeof(uint64_t)));
+  for (auto row : order) {
+    for (const auto &value : values[row]) {
+      (void)out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+  }
+  bool write_success = out.good();
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(write_success, "[Internal ERROR] Failed to write page index file: " + index_path);
+  MS_LOG(INFO) << "Write " << order.size() << " rows of " << pages.size() << " pages to page index: " << index_path;
+  return Status::OK();
+}
+
+Status ShardPageIndex::Load(const std::string &file_path, std::shared_ptr<ShardPageIndex> *index_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(index_ptr);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(ShardMappedFile::IsSupported(),
+                                  "Page index of mindrecord file is not supported on this platform.");
+  auto index_path = GetIndexPath(file_path);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(std::ifstream(index_path).good(),
+                                  "Page index file: " + index_path + " does not exist.");
+  auto index = std::make_shared<ShardPageIndex>();
+  RETURN_IF_NOT_OK_MR(ShardMappedFile::Map(index_path, &index->file_));
+  const uint8_t *data = index->file_->Data();
+  uint64_t size = index->file_->Size();
+
+  // the mapping is page aligned, so the header and the sections after it are properly aligned
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(size >= sizeof(PageIndexHeader), "Invalid file, page index: " + index_path +
+                                                                      " is truncated.");
+  const auto *header = reinterpret_cast<const PageIndexHeader *>(data);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(memcmp(header->magic, kPageIndexMagic, kPageIndexMagicLen) == 0,
+                                  "Invalid file, page index: " + index_path + " has an unknown format.");
+  // every section is bounded by the file size first, so the sum below can not overflow
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    header->num_fields <= kMaxFieldCount && header->meta_size <= size && header->meta_size % kInt64Len == 0 &&
+      header->pool_size <= size && header->num_rows <= size / sizeof(Record) &&
+      header->num_pages <= size / sizeof(PageEntry),
+    "Invalid file, page index: " + index_path + " is corrupted.");
+  uint64_t num_values = header->num_rows * header->num_fields + 1;
+  uint64_t records_start = sizeof(PageIndexHeader) + header->meta_size;
+  uint64_t pages_start = records_start + header->num_rows * sizeof(Record);
+  uint64_t offsets_start = pages_start + header->num_pages * sizeof(PageEntry);
+  uint64_t pool_start = offsets_start + num_values * sizeof(uint64_t);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(pool_start + header->pool_size == size,
+                                  "Invalid file, page index: " + index_path + " is truncated.");
+
+  const uint8_t *meta = data + sizeof(PageIndexHeader);
+  uint64_t pos = 0;
+  std::string shard_name;
+  std::string meta_file_name;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(ReadString(meta, header->meta_size, &pos, &shard_name) &&
+                                    ReadString(meta, header->meta_size, &pos, &meta_file_name),
+                                  "Invalid file, page index: " + index_path + " is corrupted.");
+  for (uint64_t i = 0; i < header->num_fields; ++i) {
+    std::string field_name;
+    uint64_t field_type = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ReadString(meta, header->meta_size, &pos, &field_name) &&
+                                      ReadUint64(meta, header->meta_size, &pos, &field_type) && field_type <= kReal,
+                                    "Invalid file, page index: " + index_path + " is corrupted.");
+    index->field_names_.push_back(field_name);
+    index->field_types_.push_back(static_cast<FieldType>(field_type));
+  }
+
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(file_path, &fn_ptr));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_name == *fn_ptr && meta_file_name == *fn_ptr + kMetaFileSuffix,
+                                  "Invalid file, page index: " + index_path + " and mindrecord file: " + file_path +
+                                    " can not match.");
+  // the page index replaces the meta file, so it is only used while neither the shard nor the meta file changed
+  uint64_t file_size = 0;
+  uint64_t file_mtime = 0;
+  RETURN_IF_NOT_OK_MR(GetFileIdentity(file_path, &file_size, &file_mtime));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(file_size == header->shard_file_size && file_mtime == header->shard_file_mtime,
+                                  "Invalid file, mindrecord file: " + file_path +
+                                    " was changed after its page index: " + index_path + " was written.");
+  RETURN_IF_NOT_OK_MR(GetFileIdentity(file_path + kMetaFileSuffix, &file_size, &file_mtime));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(file_size == header->meta_file_size && file_mtime == header->meta_file_mtime,
+                                  "Invalid file, mindrecord meta file: " + file_path + kMetaFileSuffix +
+                                    " was changed after its page index: " + index_path + " was written.");
+
+  index->num_rows_ = header->num_rows;
+  index->num_pages_ = header->num_pages;
+  index->pool_size_ = header->pool_size;
+  index->records_ = reinterpret_cast<const Record *>(data + records_start);
+  index->pages_ = reinterpret_cast<const PageEntry *>(data + pages_start);
+  index->value_offsets_ = reinterpret_cast<const uint64_t *>(data + offsets_start);
+  index->pool_ = reinterpret_cast<const char *>(data + pool_start);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(index->value_offsets_[num_values - 1] == header->pool_size,
+                                  "Invalid file, page index: " + index_path + " is corrupted.");
+  *index_ptr = std::move(index);
+  return Status::OK();
+}
+
+int ShardPageIndex::GetFieldIndex(const std::string &field_name) const {
+  auto iter = std::find(field_names_.begin(), field_names_.end(), field_name);
+  return iter == field_names_.end() ? -1 : static_cast<int>(iter - field_names_.begin());
+}
+
+Status ShardPageIndex::GetFieldValue(uint64_t pos, int field, std::string *value) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(value);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(pos < num_rows_ && field >= 0 && static_cast<size_t>(field) < field_names_.size(),
+                                  "[Internal ERROR] Row: " + std::to_string(pos) + " or field: " +
+                                    std::to_string(field) + " is out of the range of page index.");
+  uint64_t idx = pos * field_names_.size() + static_cast<uint64_t>(field);
+  uint64_t begin = value_offsets_[idx];
+  uint64_t end = value_offsets_[idx + 1];
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(begin <= end && end <= pool_size_,
+                                  "Invalid file, page index is corrupted, value offset: " + std::to_string(end) +
+                                    " is out of bound: " + std::to_string(pool_size_));
+  value->assign(pool_ + begin, end - begin);
+  return Status::OK();
+}
+
+Status ShardPageIndex::MatchValue(uint64_t pos, int field, const std::string &value, bool *match) const {
+  std::string field_value;
+  RETURN_IF_NOT_OK_MR(GetFieldValue(pos, field, &field_value));
+  long double lhs = 0;
+  long double rhs = 0;
+  // sqlite converts a numeric-looking text operand to a number before comparing it with a numeric column
+  if (field_types_[field] != kText && ToNumber(field_value, &lhs) && ToNumber(value, &rhs)) {
+    *match = lhs == rhs;
+  } else {
+    *match = field_value == value;
+  }
+  return Status::OK();
+}
+
+bool ShardPageIndex::FindRow(uint64_t row_id, uint64_t *pos) const {
+  auto iter = std::lower_bound(records_, records_ + num_rows_, row_id,
+                               [](const Record &record, uint64_t id) { return record.row_id < id; });
+  if (iter == records_ + num_rows_ || iter->row_id != row_id) {
+    return false;
+  }
+  *pos = static_cast<uint64_t>(iter - records_);
+  return true;
+}
+
+Status ShardPageIndex::SelectRows(uint64_t page_id_blob, int field, const std::string &value,
+                                  std::vector<uint64_t> *rows) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  auto iter = std::lower_bound(pages_, pages_ + num_pages_, page_id_blob,
+                               [](const PageEntry &page, uint64_t id) { return page.page_id_blob < id; });
+  if (iter == pages_ + num_pages_ || iter->page_id_blob != page_id_blob) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(iter->begin_row <= iter->end_row && iter->end_row <= num_rows_,
+                                  "Invalid file, page index is corrupted, rows of blob page: " +
+                                    std::to_string(page_id_blob) + " are out of bound.");
+  for (uint64_t pos = iter->begin_row; pos < iter->end_row; ++pos) {
+    bool match = true;
+    if (field >= 0) {
+      RETURN_IF_NOT_OK_MR(MatchValue(pos, field, value, &match));
+    }
+    if (match) {
+      rows->push_back(pos);
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardPageIndex::SelectPages(int field, const std::string &value, std::vector<uint64_t> *pages) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(pages);
+  for (uint64_t i = 0; i < num_pages_; ++i) {
+    const auto &page = pages_[i];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(page.begin_row <= page.end_row && page.end_row <= num_rows_,
+                                    "Invalid file, page index is corrupted, rows of blob page: " +
+                                      std::to_string(page.page_id_blob) + " are out of bound.");
+    bool match = field < 0;
+    for (uint64_t pos = page.begin_row; pos < page.end_row && !match; ++pos) {
+      RETURN_IF_NOT_OK_MR(MatchValue(pos, field, value, &match));
+    }
+    if (match) {
+      pages->push_back(page.page_id_blob);
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardPageIndex::GetDistinctValues(int field, std::set<std::string> *values) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(values);
+  for (uint64_t pos = 0; pos < num_rows_; ++pos) {
+    std::string value;
+    RETURN_IF_NOT_OK_MR(GetFieldValue(pos, field, &value));
+    (void)values->insert(std::move(value));
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -100,9 +100,68 @@ void AnalysisSchedule::Stop() {
       MS_LOG(WARNING) << " Analysis schedule thread join exception:" << e.what();
     }
   }
+  StopWorkers();
   MS_LOG(DEBUG) << "Set analysis schedule to stop";
 }
 
+void AnalysisSchedule::RunAsync(std::function<void()> task) {
+  // DISABLE_INFER_WORKERS=1 runs each task on a new detached thread, the baseline of the graph compile benchmark.
+  static const bool disable_infer_workers = (common::GetCompileConfig("DISABLE_INFER_WORKERS") == "1");
+  if (disable_infer_workers) {
+    std::thread(std::move(task)).detach();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(worker_lock_);
+  worker_tasks_.push_back(std::move(task));
+  if (idle_workers_ >= worker_tasks_.size()) {
+    worker_cv_.notify_one();
+    return;
+  }
+  (void)workers_.emplace_back([this] { WorkerLoop(); });
+  MS_LOG(DEBUG) << "Add infer worker, the worker count: " << workers_.size();
+}
+
+void AnalysisSchedule::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(worker_lock_);
+      ++idle_workers_;
+      worker_cv_.wait(lock, [this] { return stop_workers_ || !worker_tasks_.empty(); });
+      --idle_workers_;
+      if (worker_tasks_.empty()) {
+        return;
+      }
+      task = std::move(worker_tasks_.front());
+      worker_tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+void AnalysisSchedule::StopWorkers() {
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock(worker_lock_);
+    stop_workers_ = true;
+    workers.swap(workers_);
+  }
+  worker_cv_.notify_all();
+  for (auto &worker : workers) {
+    if (!worker.joinable()) {
+      continue;
+    }
+    try {
+      worker.join();
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << " Analysis infer worker join exception:" << e.what();
+    }
+  }
+  // The schedule may be started again, eg. after fork.
+  std::lock_guard<std::mutex> lock(worker_lock_);
+  stop_workers_ = false;
+}
+
 void AnalysisSchedule::Wait() {
   EnterWaiting();
   if (infer_thread_count_.load() > 0) {
@@ -60,6 +60,9 @@ class AnalysisSchedule {
   void Add2Schedule(const AsyncInferTaskPtr &async_infer_task_ptr);
   void WaitForRun() const;
   void YieldTask(AsyncInferTask *asyncTask);
+  // Run the task on an idle infer worker, or on a new worker if all of them are busy, since the running tasks may
+  // wait for each other. The workers are kept for the later tasks until Stop.
+  void RunAsync(std::function<void()> task);
 
   void EnterWaiting() {
     {
@@ -103,6 +106,8 @@ class AnalysisSchedule {
  private:
   void Schedule();
   void SetNextReady();
+  void WorkerLoop();
+  void StopWorkers();
   AnalysisSchedule() { Start(); }
   std::atomic<int> infer_thread_count_{0};
   bool run_{true};
@@ -114,6 +119,12 @@ class AnalysisSchedule {
   std::set<std::string> activate_threads_;
   static thread_local std::string thread_id_;
   std::shared_ptr<std::thread> dispatcher_;
+  std::mutex worker_lock_;
+  std::condition_variable worker_cv_;
+  std::list<std::function<void()>> worker_tasks_;
+  std::vector<std::thread> workers_;
+  size_t idle_workers_{0};
+  bool stop_workers_{false};
 };
 
 template <typename KeyType, typename ValueType, typename CacheType>
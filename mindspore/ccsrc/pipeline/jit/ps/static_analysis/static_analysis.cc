@@ -24,6 +24,7 @@
 #include <unordered_set>
 #include <utility>
 #include <atomic>
+#include <functional>
 #include "mindspore/core/ops/structure_ops.h"
 #include "mindspore/core/ops/sequence_ops.h"
 #include "mindspore/core/ops/framework_ops.h"
@@ -1464,10 +1465,10 @@ EvalResultPtr AnalysisEngine::ExecuteMultipleEvaluatorsMultiThread(const std::ve
     AsyncInferTaskPtr async_task = AsyncInferTask::MakeShared(control_run_order, thread_id);
     AnalysisSchedule::GetInstance().IncreaseThreadCount();
     MS_LOG(DEBUG) << GetInferThread() << "async : " << evaluator->ToString();
-    auto thread = std::thread(ExecEvaluator, evaluator, shared_from_this(), args_conf_list, out_conf, thread_id,
-                              async_result_branch, async_result_main, async_task, trace::GetCurrentGraphEvalStack(),
-                              trace::GetCNodeDebugStack());
-    thread.detach();
+    AnalysisSchedule::GetInstance().RunAsync(std::bind(ExecEvaluator, evaluator, shared_from_this(), args_conf_list,
+                                                       out_conf, thread_id, async_result_branch, async_result_main,
+                                                       async_task, trace::GetCurrentGraphEvalStack(),
+                                                       trace::GetCNodeDebugStack()));
 
     // Push to list of running loop
     MS_LOG(DEBUG) << "Add to schedule: " << async_task.get();
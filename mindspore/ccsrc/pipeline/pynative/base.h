@@ -124,6 +124,8 @@ struct FrontendOpRunInfo {
   bool requires_grad = false;
   bool output_get_by_infer_value = false;
   bool should_be_cache = false;
+  // The signature hash of the output abstract cache.
+  size_t abs_cache_signature = 0;
   bool is_jit_input = false;
   bool is_view_op = false;
   int mix_type{0};
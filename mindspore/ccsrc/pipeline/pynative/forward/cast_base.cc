@@ -19,6 +19,8 @@
 #include <algorithm>
 #include "ops/array_ops.h"
 #include "frontend/operator/composite/do_signature.h"
+#include "include/common/utils/convert_utils.h"
+#include "utils/hashing.h"
 
 namespace mindspore {
 namespace pynative {
@@ -139,6 +141,12 @@ PrimitivePtr CastBaseOperation::GetPrimByTypeId(const TypeId &type_id) const {
 #endif
 }
 
+void CastBaseOperation::ClearRes() {
+  implicit_cast_map_.clear();
+  type_prim_cache_.clear();
+  cast_signature_cache_.clear();
+}
+
 const std::string &CastBaseOperation::TypeIdToMsTypeStr(const TypeId &type_id) const {
   const auto &type_name = type_name_map().find(type_id);
   if (type_name == type_name_map().cend()) {
@@ -163,6 +171,34 @@ bool CastBaseOperation::GetSignatureType(const std::vector<Signature> &signature
   return has_sig_dtype;
 }
 
+void CastBaseOperation::ResetTypeInfo(size_t input_size) const {
+  args_type_id_.assign(input_size, kTypeUnknown);
+  args_has_tensor_.assign(input_size, false);
+}
+
+SignatureDstTypePtr CastBaseOperation::GetSignatureDstType(const PrimitivePtr &prim,
+                                                           const std::vector<SignatureEnumDType> &dtypes) const {
+  MS_EXCEPTION_IF_NULL(prim);
+  auto signature = prim->Hash();
+  for (size_t i = 0; i < args_type_id_.size(); ++i) {
+    signature = hash_combine(signature, (static_cast<size_t>(args_type_id_[i]) << 1) | (args_has_tensor_[i] ? 1 : 0));
+  }
+  auto iter = cast_signature_cache_.find(signature);
+  if (iter != cast_signature_cache_.end()) {
+    for (const auto &info : iter->second) {
+      if (info.prim_name == prim->name() && info.args_type_id == args_type_id_ &&
+          info.args_has_tensor == args_has_tensor_) {
+        return info.dst_type;
+      }
+    }
+  }
+  // The unsupported conversion throws here and is not cached.
+  auto dst_type = std::make_shared<SignatureDstType>(GetSignatureTypeMap(dtypes, args_type_id_, args_has_tensor_));
+  (void)cast_signature_cache_[signature].emplace_back(
+    CastSignatureInfo{prim->name(), args_type_id_, args_has_tensor_, dst_type});
+  return dst_type;
+}
+
 tensor::TensorPtr CastBaseOperation::TensorToDstDtypeValue(const ValuePtr &src_value, const TypeId &dst_type_id) const {
   MS_EXCEPTION_IF_NULL(src_value);
   auto src_tensor = src_value->cast<tensor::TensorPtr>();
@@ -32,6 +32,7 @@ class CastBaseOperation {
     implicit_cast_map_.reserve(kDefaultContainerSize);
   }
   ~CastBaseOperation() = default;
+  void ClearRes();
 
  protected:
   PrimitivePtr GetPrimByTypeId(const TypeId &type_id) const;
@@ -40,9 +41,18 @@ class CastBaseOperation {
   // Modify tensor data type, when op input source dtype is not tensor without dispatch cast op.
   tensor::TensorPtr TensorToDstDtypeValue(const ValuePtr &src_value, const TypeId &dst_type_id) const;
   ValuePtr ScalarToDstDtypeValue(const ValuePtr &src_value, const std::pair<TypeId, bool> &dst_type) const;
+  // Reset the type info buffers of the inputs, the buffers are reused by every op.
+  void ResetTypeInfo(size_t input_size) const;
+  // Get the destination types of implicit cast by the type info buffers, which is cached by the signature hash.
+  // It is held by the caller, as the implicit cast of the inputs may run a cast op which updates the cache.
+  SignatureDstTypePtr GetSignatureDstType(const PrimitivePtr &prim,
+                                          const std::vector<SignatureEnumDType> &dtypes) const;
 
   mutable mindspore::HashMap<TypeId, PrimitivePtr> type_prim_cache_;
   mutable ImplicitCastCache implicit_cast_map_;
+  mutable CastSignatureCache cast_signature_cache_;
+  mutable std::vector<TypeId> args_type_id_;
+  mutable std::vector<bool> args_has_tensor_;
 };
 }  // namespace pynative
 }  // namespace mindspore
@@ -33,11 +33,6 @@ void CastOperation::DoCast(const FrontendOpRunInfoPtr &op_run_info) {
   SetImplicitCast(op_run_info);
 }
 
-void CastOperation::ClearRes() {
-  implicit_cast_map_.clear();
-  type_prim_cache_.clear();
-}
-
 bool CastOperation::IsValueTypeInvalid(const ValuePtr &v) const {
   MS_EXCEPTION_IF_NULL(v);
   return !v->isa<tensor::Tensor>() && !v->isa<tensor::CSRTensor>() && !v->isa<IntegerImm>() && !v->isa<FloatImm>() &&
@@ -282,32 +277,23 @@ void CastOperation::SetTensorMixPrecisionCast(const FrontendOpRunInfoPtr &op_run
   }
 }
 
-namespace {
-std::pair<std::vector<TypeId>, std::vector<bool>> GetTypeInfo(const FrontendOpRunInfoPtr &op_run_info) {
+void CastOperation::GetTypeInfo(const FrontendOpRunInfoPtr &op_run_info) const {
   MS_EXCEPTION_IF_NULL(op_run_info);
-  std::vector<TypeId> args_type_id;
-  std::vector<bool> args_has_tensor;
-  args_type_id.resize(op_run_info->input_size);
-  args_has_tensor.resize(op_run_info->input_size, false);
-
+  ResetTypeInfo(op_run_info->input_size);
   const auto &input_value = op_run_info->op_grad_info->input_value;
   for (size_t i = 0; i < op_run_info->input_size; ++i) {
     if (input_value[i]->isa<tensor::Tensor>()) {
-      args_type_id[i] = input_value[i]->cast<tensor::TensorPtr>()->data_type();
+      args_type_id_[i] = input_value[i]->cast<tensor::TensorPtr>()->data_type();
       if (op_run_info->source_type[i] == ops::OP_DTYPE::DT_BEGIN) {
-        args_has_tensor[i] = true;
+        args_has_tensor_[i] = true;
       }
     } else if (input_value[i]->isa<Scalar>()) {
       const auto type = input_value[i]->cast<ScalarPtr>()->type();
       MS_EXCEPTION_IF_NULL(type);
-      args_type_id[i] = type->type_id();
-    } else {
-      args_type_id[i] = kTypeUnknown;
+      args_type_id_[i] = type->type_id();
     }
   }
-  return {args_type_id, args_has_tensor};
 }
-}  // namespace
 
 void CastOperation::SetImplicitCast(const FrontendOpRunInfoPtr &op_run_info) {
   MS_EXCEPTION_IF_NULL(op_run_info);
@@ -336,9 +322,9 @@ void CastOperation::SetImplicitCast(const FrontendOpRunInfoPtr &op_run_info) {
                                << "signature size " << sig_size;
     }
 
-    auto [args_type_id, args_has_tensor] = GetTypeInfo(op_run_info);
-    auto dst_type = GetSignatureTypeMap(dtypes, args_type_id, args_has_tensor);
-    DoSignatureCast(op_run_info, dst_type, dtypes);
+    GetTypeInfo(op_run_info);
+    auto dst_type = GetSignatureDstType(prim, dtypes);
+    DoSignatureCast(op_run_info, *dst_type, dtypes);
     PrimSignature sig_value{has_dtype_sig, dtypes};
     implicit_cast_map_[prim->name()] = sig_value;
   } else {
@@ -347,9 +333,9 @@ void CastOperation::SetImplicitCast(const FrontendOpRunInfoPtr &op_run_info) {
       return;
     }
     MS_LOG(DEBUG) << "Do signature for " << op_run_info->base_op_run_info.op_name << " with cache";
-    auto [args_type_id, args_has_tensor] = GetTypeInfo(op_run_info);
-    auto dst_type = GetSignatureTypeMap(it->second.dtypes, args_type_id, args_has_tensor);
-    DoSignatureCast(op_run_info, dst_type, it->second.dtypes);
+    GetTypeInfo(op_run_info);
+    auto dst_type = GetSignatureDstType(prim, it->second.dtypes);
+    DoSignatureCast(op_run_info, *dst_type, it->second.dtypes);
   }
 }
 }  // namespace pynative
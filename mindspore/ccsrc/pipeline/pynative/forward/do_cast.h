@@ -31,7 +31,6 @@ class CastOperation : public CastBaseOperation {
   CastOperation() = default;
   ~CastOperation() = default;
   void DoCast(const FrontendOpRunInfoPtr &op_run_info);
-  void ClearRes();
   ValuePtr DoNormalCast(const FrontendOpRunInfoPtr &cast_run_info, const ValuePtr &v, const TypeId &type_id) const;
 
  private:
@@ -47,6 +46,7 @@ class CastOperation : public CastBaseOperation {
   void DoSignatureCast(const FrontendOpRunInfoPtr &op_run_info,
                        const std::map<SignatureEnumDType, std::pair<TypeId, bool>> &dst_type,
                        const std::vector<SignatureEnumDType> &dtypes) const;
+  void GetTypeInfo(const FrontendOpRunInfoPtr &op_run_info) const;
   void SetImplicitCast(const FrontendOpRunInfoPtr &op_run_info);
 };
 using CastOperationPtr = std::shared_ptr<CastOperation>;
@@ -22,6 +22,7 @@
 #include "ops/nn_op_name.h"
 #include "ops/framework_op_name.h"
 #include "ops/ops_frontend_func_impl.h"
+#include "utils/hashing.h"
 
 namespace mindspore {
 namespace pynative {
@@ -286,17 +287,20 @@ bool InferOperation::GetOutputAbstractByCache(const FrontendOpRunInfoPtr &op_run
   const auto &prim = op_run_info->op_grad_info->op_prim;
   MS_EXCEPTION_IF_NULL(prim);
 
-  AbsCacheKey key{prim->name(), prim->Hash(), prim->attrs()};
-  auto prim_iter = prim_abs_list_.find(key);
-  if (prim_iter != prim_abs_list_.end()) {
-    MS_LOG(DEBUG) << "Output abstract cache matched prim " << prim->name();
-    const auto &input_abs_map = prim_iter->second;
-    auto abs_iter = input_abs_map.find(op_run_info->op_grad_info->input_abs);
-    if (abs_iter != input_abs_map.end()) {
-      MS_EXCEPTION_IF_NULL(abs_iter->second.abs);
-      MS_LOG(DEBUG) << "From output abstract cache get output abs " << abs_iter->second.abs->ToString();
-      op_run_info->base_op_run_info.abstract = abs_iter->second.abs;
-      prim->set_evaluate_added_attrs(abs_iter->second.attrs);
+  const auto &input_abs = op_run_info->op_grad_info->input_abs;
+  op_run_info->abs_cache_signature = hash_combine(prim->Hash(), abstract::AbstractBasePtrListHash(input_abs));
+  auto iter = prim_abs_list_.find(op_run_info->abs_cache_signature);
+  if (iter != prim_abs_list_.end()) {
+    const auto &prim_attrs = prim->attrs();
+    for (const auto &info : iter->second) {
+      if (info.prim_name != prim->name() || !common::IsAttrsEqual(info.prim_attrs, prim_attrs) ||
+          !abstract::AbstractBasePtrListDeepEqual(info.input_abs, input_abs)) {
+        continue;
+      }
+      MS_EXCEPTION_IF_NULL(info.abs);
+      MS_LOG(DEBUG) << "From output abstract cache get output abs " << info.abs->ToString();
+      op_run_info->base_op_run_info.abstract = info.abs;
+      prim->set_evaluate_added_attrs(info.attrs);
       op_run_info->should_be_cache = false;
       return true;
     }
@@ -309,10 +313,13 @@ void InferOperation::SaveOutputAbstractToCache(const FrontendOpRunInfoPtr &op_ru
   MS_EXCEPTION_IF_NULL(op_run_info);
   const auto &prim = op_run_info->op_grad_info->op_prim;
   MS_EXCEPTION_IF_NULL(prim);
-  AbsCacheKey key{prim->name(), prim->Hash(), prim->attrs()};
-  auto &out = prim_abs_list_[key];
-  out[op_run_info->op_grad_info->input_abs].abs = op_run_info->base_op_run_info.abstract;
-  out[op_run_info->op_grad_info->input_abs].attrs = prim->evaluate_added_attrs();
+  PrimAbsInfo info;
+  info.prim_name = prim->name();
+  info.prim_attrs = prim->attrs();
+  info.input_abs = op_run_info->op_grad_info->input_abs;
+  info.abs = op_run_info->base_op_run_info.abstract;
+  info.attrs = prim->evaluate_added_attrs();
+  (void)prim_abs_list_[op_run_info->abs_cache_signature].emplace_back(std::move(info));
 }
 
 void InferOperation::SetNodeAbsCacheByValue(const FrontendOpRunInfoPtr &op_run_info) {
@@ -61,43 +61,36 @@ class PyBoostCastOperation : public CastBaseOperation {
   }
 
   template <typename Item>
-  void GetTypeIdInfo(const FrontendOpRunInfoPtr &op_run_info, std::vector<TypeId> *args_type_id,
-                     std::vector<bool> *args_has_tensor, size_t i, const Item &v) {
+  void GetTypeIdInfo(const FrontendOpRunInfoPtr &op_run_info, size_t i, const Item &v) {
     MS_EXCEPTION_IF_NULL(v);
     if (v->template isa<tensor::Tensor>()) {
-      (*args_type_id)[i] = v->template cast<tensor::TensorPtr>()->data_type();
+      args_type_id_[i] = v->template cast<tensor::TensorPtr>()->data_type();
       // Indicate have do type cast
       if (op_run_info->source_type[i] == ops::OP_DTYPE::DT_BEGIN) {
-        (*args_has_tensor)[i] = true;
+        args_has_tensor_[i] = true;
       }
     } else if (v->template isa<Scalar>()) {
       const auto type = v->template cast<ScalarPtr>()->type();
       MS_EXCEPTION_IF_NULL(type);
-      (*args_type_id)[i] = type->type_id();
+      args_type_id_[i] = type->type_id();
     } else {
       MS_LOG(DEBUG) << "Get value " << v->ToString();
     }
   }
 
   template <typename Item>
-  void GetTypeIdInfo(const FrontendOpRunInfoPtr &op_run_info, std::vector<TypeId> *args_type_id,
-                     std::vector<bool> *args_has_tensor, size_t i, const std::optional<Item> &t) {
+  void GetTypeIdInfo(const FrontendOpRunInfoPtr &op_run_info, size_t i, const std::optional<Item> &t) {
     if (!t.has_value()) {
       return;
     }
   }
 
+  // Fill the type info buffers of the inputs.
   template <typename TupleInput, size_t... Index>
-  std::pair<std::vector<TypeId>, std::vector<bool>> GetTypeInfo(const FrontendOpRunInfoPtr &op_run_info,
-                                                                const TupleInput &tuple_input,
-                                                                std::index_sequence<Index...>) {
-    std::vector<TypeId> args_type_id;
-    std::vector<bool> args_has_tensor;
-    args_type_id.resize(op_run_info->input_size, kTypeUnknown);
-    args_has_tensor.resize(op_run_info->input_size, false);
-
-    (GetTypeIdInfo(op_run_info, &args_type_id, &args_has_tensor, Index, std::get<Index>(tuple_input)), ...);
-    return {args_type_id, args_has_tensor};
+  void GetTypeInfo(const FrontendOpRunInfoPtr &op_run_info, const TupleInput &tuple_input,
+                   std::index_sequence<Index...>) {
+    ResetTypeInfo(op_run_info->input_size);
+    (GetTypeIdInfo(op_run_info, Index, std::get<Index>(tuple_input)), ...);
   }
 
   // Implicit transform
@@ -123,10 +116,9 @@ class PyBoostCastOperation : public CastBaseOperation {
       PrimSignature sig_value{has_dtype_sig, dtypes};
       implicit_cast_map_[op_run_info->base_op_run_info.op_name] = sig_value;
 
-      auto [args_type_id, args_has_tensor] =
-        GetTypeInfo(op_run_info, input_args, std::make_index_sequence<sizeof...(InputArgs)>{});
-      auto dst_type = GetSignatureTypeMap(dtypes, args_type_id, args_has_tensor);
-      return SetImplicitCast(op_run_info, dst_type, dtypes, input_args,
+      GetTypeInfo(op_run_info, input_args, std::make_index_sequence<sizeof...(InputArgs)>{});
+      auto dst_type = GetSignatureDstType(op_run_info->op_grad_info->op_prim, dtypes);
+      return SetImplicitCast(op_run_info, *dst_type, dtypes, input_args,
                              std::make_index_sequence<sizeof...(InputArgs)>{});
     } else {
       if (!it->second.has_dtype_sig) {
@@ -134,10 +126,9 @@ class PyBoostCastOperation : public CastBaseOperation {
         return input_args;
       }
       MS_LOG(DEBUG) << "Do signature for " << op_run_info->base_op_run_info.op_name << " with cache";
-      auto [args_type_id, args_has_tensor] =
-        GetTypeInfo(op_run_info, input_args, std::make_index_sequence<sizeof...(InputArgs)>{});
-      auto dst_type = GetSignatureTypeMap(it->second.dtypes, args_type_id, args_has_tensor);
-      return SetImplicitCast(op_run_info, dst_type, it->second.dtypes, input_args,
+      GetTypeInfo(op_run_info, input_args, std::make_index_sequence<sizeof...(InputArgs)>{});
+      auto dst_type = GetSignatureDstType(op_run_info->op_grad_info->op_prim, it->second.dtypes);
+      return SetImplicitCast(op_run_info, *dst_type, it->second.dtypes, input_args,
                              std::make_index_sequence<sizeof...(InputArgs)>{});
     }
   }
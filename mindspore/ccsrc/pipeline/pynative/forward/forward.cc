@@ -24,6 +24,7 @@
 #include "ops/nn_op_name.h"
 #include "ops/array_ops.h"
 #include "ops/framework_ops.h"
+#include "ops/op_utils.h"
 #include "pipeline/pynative/pynative_utils.h"
 #include "pybind_api/gil_scoped_long_running.h"
 #include "include/common/utils/python_fallback_running.h"
@@ -368,14 +369,18 @@ void ForwardExecutor::Init() {
   MS_LOG(DEBUG) << "Init ForwardExecutor";
   compile::SetMindRTEnable();
   python_adapter::set_python_env_flag(true);
-  runtime::OpExecutor::GetInstance().RegisterForwardCallback(
-    []() { runtime::Pipeline::Get().frontend_stage()->Wait(); });
+  runtime::OpExecutor::GetInstance().RegisterForwardCallback([this]() {
+    runtime::Pipeline::Get().frontend_stage()->Wait();
+    // The tensors to wait may be the outputs of the captured ops.
+    FlushCapturedSegment();
+  });
 }
 
 void ForwardExecutor::RefreshForwardCallback() {
 #if defined(_WIN32) || defined(_WIN64)
   runtime::OpExecutor::GetInstance().RegisterForwardCallback([this]() {
     runtime::Pipeline::Get().frontend_stage()->Wait();
+    FlushCapturedSegment();
     grad()->WaitBpropTask();
   });
 #endif
@@ -397,7 +402,7 @@ bool ForwardExecutor::EnablePipeline(const std::string &op_name) const {
 }
 
 void ForwardExecutor::DispatchFrontendTask(const FrontendOpRunInfoPtr &op_run_info) {
-  auto forward_task = std::make_shared<FrontendTask>(
+  auto forward_task = runtime::MakePooledTask<FrontendTask>(
     [this](const FrontendOpRunInfoPtr &op_run_info) { RunOpFrontend(op_run_info); }, op_run_info);
   runtime::Pipeline::Get().frontend_stage()->Push(forward_task);
 }
@@ -540,6 +545,8 @@ ValuePtr ForwardExecutor::RunSliceOpFrontend(const std::vector<ValuePtr> &input_
   }
 
   MS_LOG(DEBUG) << "Start, slice_op_infos size:" << slice_op_infos.size();
+  // The slice ops are views of the input, which may be the output of the captured ops.
+  FlushCapturedSegment();
   auto intermediate_tensor = input_values;
   auto last_tensor = input_values[0];
 
@@ -599,6 +606,11 @@ void ForwardExecutor::RunOpFrontend(const FrontendOpRunInfoPtr &op_run_info) {
   // 1.Set cast for inputs
   SetCastForInputs(op_run_info);
 
+  if (op_run_info->is_view_op) {
+    // The view op uses the device address of the input, which may be the output of the captured ops.
+    FlushCapturedSegment();
+  }
+
 #ifndef ENABLE_TEST
   if (op_run_info->is_view_op &&
       ProcessViewOp(op_run_info, strides_calc_info.first.value(), strides_calc_info.second)) {
@@ -615,7 +627,10 @@ void ForwardExecutor::RunOpFrontend(const FrontendOpRunInfoPtr &op_run_info) {
     op_run_info->is_view_op = false;
   }
 
-  // Infer output abstract
+  // Infer output abstract, the value depended inputs are read in infer.
+  if (SegmentCapture::Enable() && !ops::GetInputDependValueList(op_run_info->op_grad_info->op_prim).empty()) {
+    FlushCapturedSegment();
+  }
   InferOutputAbstract(op_run_info);
 
   if (!op_run_info->base_op_run_info.has_dynamic_output) {
@@ -632,9 +647,43 @@ void ForwardExecutor::RunOpFrontend(const FrontendOpRunInfoPtr &op_run_info) {
 
   PrepareOpInputs(op_run_info);
 
+  if (CaptureOp(op_run_info)) {
+    return;
+  }
   RunOpBackendSync(op_run_info);
 }
 
+bool ForwardExecutor::CaptureOp(const FrontendOpRunInfoPtr &op_run_info) {
+  if (!SegmentCapture::Enable()) {
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(segment_capture_);
+  if (!EnablePipeline(op_run_info->base_op_run_info.op_name) || !segment_capture_->IsCapturable(op_run_info)) {
+    // The inputs of the op may be the outputs of the captured ops.
+    segment_capture_->Flush();
+    return false;
+  }
+  // The outputs are created with the device address promises, which are set when the segment runs.
+  PrepareOpOutputs(op_run_info);
+  segment_capture_->Capture(op_run_info);
+  return true;
+}
+
+void ForwardExecutor::RunCapturedOp(const FrontendOpRunInfoPtr &op_run_info) {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  const auto &backend_op_run_info = CreateBackendOpRunInfo(op_run_info);
+  GilReleaseWithCheck gil_release;
+  (void)RunOpBackendInner(op_run_info, backend_op_run_info);
+}
+
+void ForwardExecutor::FlushCapturedSegment() {
+  if (!SegmentCapture::Enable()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(segment_capture_);
+  segment_capture_->Flush();
+}
+
 void ForwardExecutor::RunOpBackendSync(const FrontendOpRunInfoPtr &op_run_info) {
   const auto &backend_op_run_info = CreateBackendOpRunInfo(op_run_info);
   RunOpBackend(op_run_info, backend_op_run_info);
@@ -1143,6 +1192,8 @@ void ForwardExecutor::ClearRes() {
   init_ = false;
   is_jit_compiling_ = false;
   cast_operation()->ClearRes();
+  pyboost_cast_operation()->ClearRes();
+  segment_capture_->Clear();
   ClearNodeAbsMap();
   infer_operation()->ClearPrimAbsList();
   infer_operation()->ClearConstFlagPrimCache();
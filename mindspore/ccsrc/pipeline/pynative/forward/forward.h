@@ -26,6 +26,7 @@
 #include "pipeline/pynative/forward/do_cast.h"
 #include "pipeline/pynative/forward/do_pyboost_cast.h"
 #include "pipeline/pynative/forward/do_infer.h"
+#include "pipeline/pynative/forward/segment_capture.h"
 #include "backend/graph_compiler/backend.h"
 #include "ir/cell.h"
 #include "runtime/pipeline/async_hqueue.h"
@@ -45,7 +46,9 @@ class ForwardExecutor {
   ForwardExecutor()
       : cast_operation_(std::make_shared<CastOperation>()),
         pyboost_cast_operation_(std::make_shared<PyBoostCastOperation>()),
-        infer_operation_(std::make_shared<InferOperation>()) {}
+        infer_operation_(std::make_shared<InferOperation>()),
+        segment_capture_(std::make_shared<SegmentCapture>(
+          [this](const FrontendOpRunInfoPtr &op_run_info) { RunCapturedOp(op_run_info); })) {}
   ~ForwardExecutor() = default;
 
   void Init();
@@ -81,6 +84,8 @@ class ForwardExecutor {
   void PushForwardCell(const CellPtr &cell) { forward_cell_stack_.push(cell); }
   void PopForwardCell() { forward_cell_stack_.pop(); }
   void ExecuteLazyTask() const;
+  // Run the ops deferred by the segment capture.
+  void FlushCapturedSegment();
   void Sync();
   void PrintPyObjInfo(const py::object &obj, const std::string &str, bool is_cell) const;
   void ProcessBeforeNewGraph(const py::object &obj, const py::args &args);
@@ -124,6 +129,9 @@ class ForwardExecutor {
                                   const BackendOpRunInfoPtr &backend_op_run_info);
   void RunOpBackend(const FrontendOpRunInfoPtr &op_run_info, const BackendOpRunInfoPtr &backend_op_run_info);
   void RunOpBackendSync(const FrontendOpRunInfoPtr &op_run_info);
+  // Defer the op to the captured segment if it can be captured, otherwise flush the segment.
+  bool CaptureOp(const FrontendOpRunInfoPtr &op_run_info);
+  void RunCapturedOp(const FrontendOpRunInfoPtr &op_run_info);
 
   VectorRef RunOpBackendInner(const FrontendOpRunInfoPtr &op_run_info, const BackendOpRunInfoPtr &backend_op_run_info);
   // Infer output abstract
@@ -166,6 +174,7 @@ class ForwardExecutor {
   CastOperationPtr cast_operation_;
   PyBoostCastOperationPtr pyboost_cast_operation_;
   InferOperationPtr infer_operation_;
+  SegmentCapturePtr segment_capture_;
   MindrtBackendMap mindrt_backends_;
   mindspore::HashMap<std::string, PrimitivePtr> slice_prim_cache_;
 };
@@ -22,6 +22,7 @@
 #include <vector>
 #include <memory>
 #include "runtime/pipeline/task/task.h"
+#include "runtime/pipeline/task/task_pool.h"
 #include "pipeline/pynative/base.h"
 #include "backend/common/session/session_basic.h"
 
@@ -0,0 +1,355 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/pynative/forward/segment_capture.h"
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include "ops/sequence_ops.h"
+#include "utils/flags.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
+#include "ir/manager.h"
+#include "include/common/utils/tensor_future.h"
+#include "include/backend/anf_runtime_algorithm.h"
+#include "pybind_api/gil_scoped_long_running.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+bool IsStaticTensorAbstract(const AbstractBasePtr &abs) {
+  return abs != nullptr && abs->isa<abstract::AbstractTensor>() && !abs->BuildShape()->IsDynamic();
+}
+
+// The outputs of the captured op are the static shape tensors, or a flat tuple of them.
+bool IsCapturableOutput(const AbstractBasePtr &abs) {
+  if (IsStaticTensorAbstract(abs)) {
+    return true;
+  }
+  if (abs == nullptr || !abs->isa<abstract::AbstractTuple>()) {
+    return false;
+  }
+  const auto &elements = abs->cast<abstract::AbstractTuplePtr>()->elements();
+  return !elements.empty() && std::all_of(elements.begin(), elements.end(), IsStaticTensorAbstract);
+}
+
+void FlattenOutputs(const BaseRef &output, std::vector<tensor::TensorPtr> *tensors) {
+  if (utils::isa<VectorRef>(output)) {
+    const auto &elements = utils::cast<VectorRef>(output);
+    for (const auto &element : elements) {
+      FlattenOutputs(element, tensors);
+    }
+  } else if (utils::isa<tensor::TensorPtr>(output)) {
+    (void)tensors->emplace_back(utils::cast<tensor::TensorPtr>(output));
+  } else {
+    MS_LOG(EXCEPTION) << "The output of the captured segment should be tensor, but got " << output.ToString();
+  }
+}
+}  // namespace
+
+bool SegmentCapture::Enable() {
+  static const bool enable = common::GetEnv("MS_DEV_PYNATIVE_SEGMENT_CAPTURE") == "1";
+  return enable;
+}
+
+bool SegmentCapture::IsCapturable(const FrontendOpRunInfoPtr &op_run_info) const {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  const auto &base_op_run_info = op_run_info->base_op_run_info;
+  if (op_run_info->requires_grad || op_run_info->is_view_op || op_run_info->output_get_by_infer_value ||
+      base_op_run_info.has_dynamic_output || base_op_run_info.use_dynamic_shape_process ||
+      !base_op_run_info.dyn_input_sizes.empty() || !IsCapturableOutput(base_op_run_info.abstract)) {
+    return false;
+  }
+  const auto &prim = op_run_info->op_grad_info->op_prim;
+  if (prim == nullptr || GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_MEM) ||
+      GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_IO) || GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_HIDDEN) ||
+      AnfAlgo::NeedEraseCache(prim)) {
+    return false;
+  }
+  const auto &input_values = base_op_run_info.expanded_input_values;
+  return std::none_of(input_values.begin(), input_values.end(), [](const ValuePtr &value) {
+    return value == nullptr || value->isa<tensor::MapTensor>() || value->isa<ValueSequence>();
+  });
+}
+
+void SegmentCapture::Capture(const FrontendOpRunInfoPtr &op_run_info) {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  const auto &base_op_run_info = op_run_info->base_op_run_info;
+  bool need_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    need_flush = pending_ != nullptr && (pending_->device_target != base_op_run_info.device_target ||
+                                         pending_->ops.size() >= kMaxCapturedSegmentSize);
+  }
+  if (need_flush) {
+    Flush();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_ == nullptr) {
+    pending_ = std::make_shared<CapturedSegment>();
+    pending_->device_target = base_op_run_info.device_target;
+    pending_->key = base_op_run_info.device_target;
+  }
+  auto &segment = *pending_;
+  const auto op_index = segment.ops.size();
+  std::ostringstream key;
+  key << ';' << base_op_run_info.op_name << op_run_info->op_grad_info->op_prim->GetAttrsText();
+  std::vector<CapturedInput> inputs;
+  const auto &input_values = base_op_run_info.expanded_input_values;
+  for (size_t i = 0; i < input_values.size(); ++i) {
+    if (!input_values[i]->isa<tensor::Tensor>()) {
+      key << ",c" << input_values[i]->ToString();
+      inputs.push_back({CapturedInput::kConstant, i, 0});
+      continue;
+    }
+    const auto &tensor = input_values[i]->cast<tensor::TensorPtr>();
+    // The copies of an output tensor share its address future.
+    const auto &future = tensor->address_future();
+    auto output_iter = future == nullptr ? segment.op_outputs.end() : segment.op_outputs.find(future.get());
+    if (output_iter != segment.op_outputs.end()) {
+      key << ",o" << output_iter->second.first << '_' << output_iter->second.second;
+      inputs.push_back({CapturedInput::kOpOutput, output_iter->second.first, output_iter->second.second});
+      continue;
+    }
+    auto arg_iter = segment.arg_index.find(tensor.get());
+    size_t arg_index = segment.args.size();
+    if (arg_iter == segment.arg_index.end()) {
+      segment.arg_index[tensor.get()] = arg_index;
+      (void)segment.args.emplace_back(tensor);
+    } else {
+      arg_index = arg_iter->second;
+    }
+    key << ",a" << arg_index << '_' << static_cast<int>(tensor->data_type()) << ShapeVectorToStr(tensor->shape());
+    inputs.push_back({CapturedInput::kArgument, arg_index, 0});
+  }
+  const auto &output_tensors = base_op_run_info.output_tensors;
+  for (size_t i = 0; i < output_tensors.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(output_tensors[i]->address_future());
+    segment.op_outputs[output_tensors[i]->address_future().get()] = std::make_pair(op_index, i);
+  }
+  segment.key += key.str();
+  (void)segment.ops.emplace_back(op_run_info);
+  (void)segment.op_inputs.emplace_back(std::move(inputs));
+}
+
+bool SegmentCapture::HasPending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_ != nullptr;
+}
+
+std::string SegmentCapture::PendingKey() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_ == nullptr ? std::string() : pending_->key;
+}
+
+void SegmentCapture::Flush() {
+  CapturedSegmentPtr segment;
+  CompiledSegmentPtr compiled;
+  {
+    // Take the pending segment out first, the backend calls back to flush again before running the segment.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_ == nullptr) {
+      return;
+    }
+    segment = std::move(pending_);
+    pending_ = nullptr;
+    if (segment->ops.size() >= kMinCapturedSegmentSize) {
+      auto iter = compiled_segments_.find(segment->key);
+      if (iter != compiled_segments_.end()) {
+        compiled = iter->second;
+      } else if (compiled_segments_.size() < kMaxCompiledSegmentNum) {
+        compiled = std::make_shared<CompiledSegment>();
+        compiled_segments_[segment->key] = compiled;
+      }
+    }
+    if (compiled != nullptr) {
+      ++compiled->flush_count;
+    }
+  }
+  MS_LOG(DEBUG) << "Flush the captured segment of " << segment->ops.size() << " ops";
+
+  // The promises are moved to the backend op run info when the ops run one by one.
+  std::vector<DeviceAddressPromisePtr> promises;
+  for (const auto &op_run_info : segment->ops) {
+    (void)promises.insert(promises.end(), op_run_info->device_sync_promises.begin(),
+                          op_run_info->device_sync_promises.end());
+  }
+  try {
+    if (compiled != nullptr && !compiled->compile_failed && compiled->flush_count >= kSegmentCompileThreshold) {
+      if (compiled->run_graph_func == nullptr && !CompileSegment(segment, compiled)) {
+        compiled->compile_failed = true;
+      }
+      if (!compiled->compile_failed) {
+        RunByGraph(segment, compiled);
+        return;
+      }
+    }
+    RunByOp(segment);
+  } catch (...) {
+    // Wake up the readers of the outputs which have not been set.
+    auto exception = std::current_exception();
+    for (const auto &promise : promises) {
+      MS_EXCEPTION_IF_NULL(promise);
+      promise->SetValue(std::make_shared<DeviceAddressFutureData>(nullptr, exception));
+    }
+    throw;
+  }
+}
+
+void SegmentCapture::RunByOp(const CapturedSegmentPtr &segment) const {
+  MS_EXCEPTION_IF_NULL(segment);
+  for (const auto &op_run_info : segment->ops) {
+    run_op_func_(op_run_info);
+  }
+}
+
+FuncGraphPtr SegmentCapture::BuildGraph(const CapturedSegmentPtr &segment) const {
+  MS_EXCEPTION_IF_NULL(segment);
+  auto func_graph = std::make_shared<FuncGraph>();
+  AnfNodePtrList parameters;
+  for (const auto &arg : segment->args) {
+    auto parameter = func_graph->add_parameter();
+    parameter->set_abstract(arg->ToAbstract()->Broaden());
+    (void)parameters.emplace_back(parameter);
+  }
+  std::vector<AnfNodePtrList> op_outputs(segment->ops.size());
+  AnfNodePtrList graph_outputs{NewValueNode(prim::kPrimMakeTuple)};
+  AbstractBasePtrList graph_output_abs;
+  for (size_t i = 0; i < segment->ops.size(); ++i) {
+    const auto &op_run_info = segment->ops[i];
+    AnfNodePtrList inputs{NewValueNode(std::make_shared<Primitive>(*op_run_info->op_grad_info->op_prim))};
+    for (const auto &input : segment->op_inputs[i]) {
+      if (input.kind == CapturedInput::kOpOutput) {
+        (void)inputs.emplace_back(op_outputs[input.index][input.output_index]);
+      } else if (input.kind == CapturedInput::kArgument) {
+        (void)inputs.emplace_back(parameters[input.index]);
+      } else {
+        const auto &value = op_run_info->base_op_run_info.expanded_input_values[input.index];
+        auto value_node = NewValueNode(value);
+        value_node->set_abstract(value->ToAbstract());
+        (void)inputs.emplace_back(value_node);
+      }
+    }
+    auto cnode = func_graph->NewCNode(inputs);
+    const auto &abs = op_run_info->base_op_run_info.abstract;
+    cnode->set_abstract(abs);
+    if (abs->isa<abstract::AbstractTuple>()) {
+      const auto &elements = abs->cast<abstract::AbstractTuplePtr>()->elements();
+      for (size_t j = 0; j < elements.size(); ++j) {
+        auto index = MakeValue(SizeToLong(j));
+        auto index_node = NewValueNode(index);
+        index_node->set_abstract(index->ToAbstract());
+        auto get_item = func_graph->NewCNode({NewValueNode(prim::kPrimTupleGetItem), cnode, index_node});
+        get_item->set_abstract(elements[j]);
+        (void)op_outputs[i].emplace_back(get_item);
+      }
+    } else {
+      (void)op_outputs[i].emplace_back(cnode);
+    }
+    for (const auto &output : op_outputs[i]) {
+      (void)graph_outputs.emplace_back(output);
+      (void)graph_output_abs.emplace_back(output->abstract());
+    }
+  }
+  auto output = func_graph->NewCNode(graph_outputs);
+  output->set_abstract(std::make_shared<abstract::AbstractTuple>(graph_output_abs));
+  func_graph->set_output(output);
+  return func_graph;
+}
+
+SegmentCapture::RunGraphFunc SegmentCapture::CompileByBackend(const FuncGraphPtr &func_graph,
+                                                             const std::string &device_target) {
+  auto manager = Manage(func_graph, true);
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  auto device_id = ms_context->get_param<uint32_t>(MS_CTX_DEVICE_ID);
+  // The backend keeps the root graph it compiles, so each segment has its own one.
+  auto backend = std::make_shared<compile::MindRTBackend>("ms", device_target, device_id);
+  auto actor_info = backend->CompileGraphs(func_graph);
+  MS_LOG(INFO) << "Compile the captured segment to " << actor_info;
+  return [manager, backend, actor_info](const VectorRef &args, VectorRef *outputs) {
+    backend->RunGraph(actor_info, args, outputs);
+  };
+}
+
+bool SegmentCapture::CompileSegment(const CapturedSegmentPtr &segment, const CompiledSegmentPtr &compiled) const {
+  MS_EXCEPTION_IF_NULL(segment);
+  MS_EXCEPTION_IF_NULL(compiled);
+  auto func_graph = BuildGraph(segment);
+  try {
+    compiled->run_graph_func = compile_graph_func_(func_graph, segment->device_target);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Compile the captured segment of " << segment->ops.size()
+                    << " ops failed, it will run op by op. Error: " << e.what();
+    compiled->run_graph_func = nullptr;
+    return false;
+  }
+  if (compiled->run_graph_func == nullptr) {
+    MS_LOG(WARNING) << "Compile the captured segment of " << segment->ops.size()
+                    << " ops failed, it will run op by op.";
+    return false;
+  }
+  MS_LOG(INFO) << "Compile the captured segment of " << segment->ops.size() << " ops";
+  return true;
+}
+
+void SegmentCapture::RunByGraph(const CapturedSegmentPtr &segment, const CompiledSegmentPtr &compiled) const {
+  MS_EXCEPTION_IF_NULL(segment);
+  MS_EXCEPTION_IF_NULL(compiled);
+  MS_EXCEPTION_IF_NULL(compiled->run_graph_func);
+  VectorRef args;
+  for (const auto &arg : segment->args) {
+    (void)args.emplace_back(arg);
+  }
+  VectorRef outputs;
+  {
+    GilReleaseWithCheck gil_release;
+    compiled->run_graph_func(args, &outputs);
+  }
+  std::vector<tensor::TensorPtr> output_tensors;
+  FlattenOutputs(outputs, &output_tensors);
+
+  // The graph outputs are the outputs of the ops in order, check the count before any promise is set, so that a
+  // mismatch sets the error on all of them instead of the wrong addresses on some.
+  size_t promise_num = 0;
+  for (const auto &op_run_info : segment->ops) {
+    promise_num += op_run_info->device_sync_promises.size();
+  }
+  if (promise_num != output_tensors.size()) {
+    MS_LOG(EXCEPTION) << "The captured segment has " << output_tensors.size() << " outputs, but the ops have "
+                      << promise_num;
+  }
+  size_t output_index = 0;
+  for (const auto &op_run_info : segment->ops) {
+    for (const auto &promise : op_run_info->device_sync_promises) {
+      MS_EXCEPTION_IF_NULL(promise);
+      const auto &output_tensor = output_tensors[output_index++];
+      MS_EXCEPTION_IF_NULL(output_tensor);
+      promise->SetValue(std::make_shared<DeviceAddressFutureData>(output_tensor->device_address(), nullptr));
+    }
+    op_run_info->device_sync_promises.clear();
+  }
+}
+
+void SegmentCapture::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_ = nullptr;
+  compiled_segments_.clear();
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_PYNATIVE_FORWARD_SEGMENT_CAPTURE_H_
+#define MINDSPORE_CCSRC_PIPELINE_PYNATIVE_FORWARD_SEGMENT_CAPTURE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pipeline/pynative/base.h"
+#include "backend/graph_compiler/backend.h"
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace pynative {
+// The op count of a segment to compile, the single op has been cached by the op compiler.
+constexpr size_t kMinCapturedSegmentSize = 2;
+constexpr size_t kMaxCapturedSegmentSize = 128;
+// A segment is compiled when it is flushed for the second time, and at most this many segments are compiled.
+constexpr size_t kSegmentCompileThreshold = 2;
+constexpr size_t kMaxCompiledSegmentNum = 64;
+
+/*
+ * The SegmentCapture defers the runs of the eager ops without grad. The outputs of a deferred op are created with
+ * device address promises as in the async pipeline, and the op is appended to the pending segment, which is keyed by
+ * the op sequence, the prim attrs, the shape and dtype of the external inputs and the links between the ops. When the
+ * segment is flushed, eg. by a op that can not be captured or a sync of the tensors, it runs op by op at the first
+ * time, and then it is compiled once into a kernel graph by the MindRT backend and replayed by one graph launch.
+ */
+class SegmentCapture {
+ public:
+  using RunOpFunc = std::function<void(const FrontendOpRunInfoPtr &op_run_info)>;
+  // The compiled graph of a segment, it runs with the args and returns the outputs of all the ops in order.
+  using RunGraphFunc = std::function<void(const VectorRef &args, VectorRef *outputs)>;
+  // Compile the graph of a segment for the device target, it throws if the graph can not be compiled.
+  using CompileGraphFunc =
+    std::function<RunGraphFunc(const FuncGraphPtr &func_graph, const std::string &device_target)>;
+  explicit SegmentCapture(RunOpFunc run_op_func, CompileGraphFunc compile_graph_func = CompileByBackend)
+      : run_op_func_(std::move(run_op_func)), compile_graph_func_(std::move(compile_graph_func)) {}
+  ~SegmentCapture() = default;
+
+  // Enabled by the env MS_DEV_PYNATIVE_SEGMENT_CAPTURE=1.
+  static bool Enable();
+  // Compile the graph by a MindRT backend of its own.
+  static RunGraphFunc CompileByBackend(const FuncGraphPtr &func_graph, const std::string &device_target);
+
+  // Whether the inferred op with prepared inputs can be deferred. The ops which require grad are never captured, as
+  // the grad of each op is recorded when it runs, so only the ops of the inference and of the no grad parts of the
+  // training are replayed by graph.
+  bool IsCapturable(const FrontendOpRunInfoPtr &op_run_info) const;
+  // Append the op whose outputs have been created with device address promises to the pending segment.
+  void Capture(const FrontendOpRunInfoPtr &op_run_info);
+  // Run the pending segment, it is reentrant as the backend waits the pipeline before running.
+  void Flush();
+  bool HasPending() const;
+  std::string PendingKey() const;
+  void Clear();
+
+ private:
+  struct CapturedInput {
+    // The op output the input links to, or the index of the graph argument, or a constant.
+    enum Kind { kOpOutput, kArgument, kConstant } kind;
+    size_t index;
+    size_t output_index;
+  };
+  struct CapturedSegment {
+    std::string device_target;
+    std::string key;
+    std::vector<FrontendOpRunInfoPtr> ops;
+    std::vector<std::vector<CapturedInput>> op_inputs;
+    std::vector<tensor::TensorPtr> args;
+    mindspore::HashMap<const tensor::Tensor *, size_t> arg_index;
+    // The op and output index of the address future of each output tensor.
+    mindspore::HashMap<const tensor::FutureBase<DeviceSync> *, std::pair<size_t, size_t>> op_outputs;
+  };
+  using CapturedSegmentPtr = std::shared_ptr<CapturedSegment>;
+  struct CompiledSegment {
+    size_t flush_count{0};
+    bool compile_failed{false};
+    RunGraphFunc run_graph_func;
+  };
+  using CompiledSegmentPtr = std::shared_ptr<CompiledSegment>;
+
+  void RunByOp(const CapturedSegmentPtr &segment) const;
+  bool CompileSegment(const CapturedSegmentPtr &segment, const CompiledSegmentPtr &compiled) const;
+  void RunByGraph(const CapturedSegmentPtr &segment, const CompiledSegmentPtr &compiled) const;
+  FuncGraphPtr BuildGraph(const CapturedSegmentPtr &segment) const;
+
+  RunOpFunc run_op_func_;
+  CompileGraphFunc compile_graph_func_;
+  mutable std::mutex mutex_;
+  CapturedSegmentPtr pending_;
+  mindspore::HashMap<std::string, CompiledSegmentPtr> compiled_segments_;
+};
+using SegmentCapturePtr = std::shared_ptr<SegmentCapture>;
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_PYNATIVE_FORWARD_SEGMENT_CAPTURE_H_
@@ -13,7 +13,7 @@ py::object ${func_name}_Base(const PrimitivePtr &prim, const py::list &args) {
     op_run_info->stub_output = node.second;
     op_run_info->source_type = converter.source_type();
     DispatchOp(
-      std::make_shared<FrontendTask>(
+      runtime::MakePooledTask<FrontendTask>(
         [${op_args}](const FrontendOpRunInfoPtr &op_run_info) {
           MS_LOG(DEBUG) << "Run frontend task ${func_name} start";
           // stub tensor to tensor.
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 #include <memory>
+#include <map>
 #include <unordered_map>
 #include "pybind11/pytypes.h"
 #include "utils/hash_map.h"
@@ -29,33 +30,17 @@
 namespace mindspore {
 namespace pynative {
 // The following structures used to get output abstract of op from cache
-struct AbsCacheKey {
-  std::string prim_name_;
-  size_t prim_hash_value_;
-  mindspore::HashMap<std::string, ValuePtr> prim_attrs_;
-};
-
-struct AbsCacheKeyHasher {
-  size_t operator()(const AbsCacheKey &key) const { return key.prim_hash_value_; }
-};
-
-struct AbsCacheKeyEqual {
-  bool operator()(const AbsCacheKey &lk, const AbsCacheKey &rk) const {
-    if (lk.prim_name_ != rk.prim_name_) {
-      return false;
-    }
-    return common::IsAttrsEqual(lk.prim_attrs_, rk.prim_attrs_);
-  }
-};
-
+// Key is the signature hash of the prim and the input abstracts, which is computed once for an op without copying
+// the prim attrs. The entries of a signature are verified by the prim name, the prim attrs and the input abstracts.
 struct PrimAbsInfo {
+  std::string prim_name;
+  mindspore::HashMap<std::string, ValuePtr> prim_attrs;
+  abstract::AbstractBasePtrList input_abs;
   abstract::AbstractBasePtr abs;
   bool is_dynamic_shape = false;
   mindspore::HashMap<std::string, ValuePtr> attrs;
 };
-using AbstractListMap = std::unordered_map<abstract::AbstractBasePtrList, PrimAbsInfo,
-                                           abstract::AbstractBasePtrListHasher, abstract::AbstractBasePtrListEqual>;
-using PrimAbsCache = std::unordered_map<AbsCacheKey, AbstractListMap, AbsCacheKeyHasher, AbsCacheKeyEqual>;
+using PrimAbsCache = mindspore::HashMap<size_t, std::vector<PrimAbsInfo>>;
 
 // Used to get input abstract of op from cache
 // Key is id of input obj, value is the abstract of input obj
@@ -68,6 +53,19 @@ struct PrimSignature {
   std::vector<SignatureEnumDType> dtypes;
 };
 using ImplicitCastCache = mindspore::HashMap<std::string, PrimSignature>;
+
+// Used to cache the destination types of implicit cast according to the input types
+// Key is the signature hash of the primitive and the input types, the entries of a signature are verified by the
+// primitive name and the input types.
+using SignatureDstType = std::map<SignatureEnumDType, std::pair<TypeId, bool>>;
+using SignatureDstTypePtr = std::shared_ptr<SignatureDstType>;
+struct CastSignatureInfo {
+  std::string prim_name;
+  std::vector<TypeId> args_type_id;
+  std::vector<bool> args_has_tensor;
+  SignatureDstTypePtr dst_type;
+};
+using CastSignatureCache = mindspore::HashMap<size_t, std::vector<CastSignatureInfo>>;
 }  // namespace pynative
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_ABS_CACHE_H
@@ -2338,6 +2338,11 @@ void DispatchOp(const std::shared_ptr<runtime::AsyncTask> &task) {
     runtime::OpExecutor::GetInstance().WaitAll();
     task->Run();
   } else {
+    if (SegmentCapture::Enable()) {
+      // The pyboost op reads its inputs directly, which may be the outputs of the captured ops.
+      runtime::Pipeline::Get().frontend_stage()->Push(std::make_shared<PassthroughFrontendTask>(
+        []() { PyNativeAlgo::Common::GetPyNativeExecutor()->forward_executor()->FlushCapturedSegment(); }));
+    }
     runtime::Pipeline::Get().frontend_stage()->Push(task);
   }
 }
@@ -13,7 +13,7 @@ PyBoostUtils::PrepareOpOutputs(device_context_, op->stream_id(), outputs_);
 
 // Async
 PyBoostUtils::DispatchRun(
-std::make_shared<runtime::PyBoostDeviceTask>(
+runtime::MakePooledTask<runtime::PyBoostDeviceTask>(
   [op, ${real_call_args}]() {
       MS_LOG(DEBUG) << "Run device task " << op_name() << " end";
       runtime::ProfilerRecorder profiler(runtime::ProfilerModule::kPynative, runtime::ProfilerEvent::kPyBoostDeviceTask,
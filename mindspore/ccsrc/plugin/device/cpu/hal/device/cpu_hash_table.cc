@@ -17,7 +17,9 @@
 
 #include <string>
 #include <algorithm>
+#include <atomic>
 
+#include "include/common/thread_pool.h"
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 #include "utils/ms_context.h"
@@ -26,6 +28,14 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+// Keep the load factor including the erased slots under 3/4, so the probing always ends at an empty slot.
+constexpr size_t kLoadFactorNumerator = 3;
+constexpr size_t kLoadFactorDenominator = 4;
+// The slab element number stops doubling after this many slabs in a shard.
+constexpr size_t kMaxSlabDoublingNum = 20;
+}  // namespace
+
 template <typename Key, typename Value>
 CPUHashTable<Key, Value>::CPUHashTable(size_t value_dim, const std::string &initializer)
     : value_dim_(value_dim), value_size_(0), initializer_(initializer), default_value_(0) {
@@ -46,6 +56,9 @@ CPUHashTable<Key, Value>::~CPUHashTable() {
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Initialize() {
   value_size_ = value_dim_ * sizeof(Value);
+  if (shards_ == nullptr) {
+    shards_ = std::make_unique<Shard[]>(kHashTableShardNum);
+  }
   return true;
 }
 
@@ -55,198 +68,386 @@ bool CPUHashTable<Key, Value>::Finalize() {
 }
 
 template <typename Key, typename Value>
-bool CPUHashTable<Key, Value>::Find(const Key *keys, size_t key_num, bool insert_default_value, Value *outputs,
-                                    void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
+uint64_t CPUHashTable<Key, Value>::Hash(const Key &key) {
+  // The finalizer of splitmix64, the integer keys are usually continuous ids which should be scattered to all shards
+  // and slots.
+  auto hash = static_cast<uint64_t>(key);
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
 
-  MS_EXCEPTION_IF_NULL(outputs);
-  // Find and copy values to output buffer if the keys exist.
+template <typename Key, typename Value>
+typename CPUHashTable<Key, Value>::ShardedKeys CPUHashTable<Key, Value>::GroupKeysByShard(const Key *keys,
+                                                                                         size_t key_num) const {
+  ShardedKeys sharded_keys;
+  sharded_keys.shard_offsets.resize(kHashTableShardNum + 1, 0);
+  std::vector<uint8_t> key_shards(key_num);
+  for (size_t i = 0; i < key_num; ++i) {
+    key_shards[i] = static_cast<uint8_t>(ShardIndex(Hash(keys[i])));
+    ++sharded_keys.shard_offsets[key_shards[i] + 1];
+  }
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    sharded_keys.shard_offsets[i + 1] += sharded_keys.shard_offsets[i];
+  }
+  // Keep the order of the keys in the same shard, so the duplicated keys in a batch are handled in order.
+  std::vector<size_t> cursors(sharded_keys.shard_offsets.begin(), sharded_keys.shard_offsets.end() - 1);
+  sharded_keys.key_indices.resize(key_num);
   for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-    size_t offset = i * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    if (values_.find(key) != values_.end()) {
-      // Copy the value of the key from the hash table to the outputs.
-      auto value = values_[key].first;
-      MS_EXCEPTION_IF_NULL(value);
-      auto ret = memcpy_s(outputs + offset, dst_size, value, src_size);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return false;
+    sharded_keys.key_indices[cursors[key_shards[i]]++] = i;
+  }
+  return sharded_keys;
+}
+
+template <typename Key, typename Value>
+bool CPUHashTable<Key, Value>::ParallelRunOnShards(size_t total_work,
+                                                   const std::function<bool(size_t, size_t)> &func) const {
+  size_t thread_num = std::min(common::ThreadPool::GetInstance().GetSyncRunThreadNum(), kHashTableShardNum);
+  if (total_work < kHashTableParallelKeyNum || thread_num <= 1) {
+    return func(0, kHashTableShardNum);
+  }
+
+  std::atomic<bool> success{true};
+  std::vector<common::Task> tasks;
+  size_t shard_num_per_task = (kHashTableShardNum + thread_num - 1) / thread_num;
+  for (size_t begin = 0; begin < kHashTableShardNum; begin += shard_num_per_task) {
+    size_t end = std::min(begin + shard_num_per_task, kHashTableShardNum);
+    (void)tasks.emplace_back([&func, &success, begin, end]() {
+      if (!func(begin, end)) {
+        success = false;
+        return common::FAIL;
       }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  return success;
+}
+
+template <typename Key, typename Value>
+typename CPUHashTable<Key, Value>::Slot *CPUHashTable<Key, Value>::FindSlot(Shard *shard, const Key &key,
+                                                                           uint64_t hash) const {
+  if (shard->slots.empty()) {
+    return nullptr;
+  }
+  size_t mask = shard->slots.size() - 1;
+  for (size_t index = static_cast<size_t>(hash) & mask;; index = (index + 1) & mask) {
+    auto &slot = shard->slots[index];
+    if (slot.state == SlotState::kEmpty) {
+      return nullptr;
+    }
+    if (slot.state == SlotState::kOccupied && slot.key == key) {
+      return &slot;
+    }
+  }
+}
+
+template <typename Key, typename Value>
+typename CPUHashTable<Key, Value>::Slot *CPUHashTable<Key, Value>::FindOrInsertSlot(Shard *shard, const Key &key,
+                                                                                   uint64_t hash, bool *inserted) {
+  *inserted = false;
+  auto slot = FindSlot(shard, key, hash);
+  if (slot != nullptr) {
+    return slot;
+  }
+
+  if ((shard->size + shard->erased_num + 1) * kLoadFactorDenominator > shard->slots.size() * kLoadFactorNumerator) {
+    size_t slot_num = std::max(shard->slots.size(), kHashTableMinSlotNum);
+    while ((shard->size + 1) * kLoadFactorDenominator * 2 > slot_num * kLoadFactorNumerator) {
+      slot_num <<= 1;
+    }
+    Rehash(shard, slot_num);
+  }
+
+  auto value = NewValue(shard);
+  if (value == nullptr) {
+    return nullptr;
+  }
+  size_t mask = shard->slots.size() - 1;
+  size_t index = static_cast<size_t>(hash) & mask;
+  while (shard->slots[index].state == SlotState::kOccupied) {
+    index = (index + 1) & mask;
+  }
+  auto &new_slot = shard->slots[index];
+  if (new_slot.state == SlotState::kErased) {
+    --shard->erased_num;
+  }
+  new_slot.key = key;
+  new_slot.state = SlotState::kOccupied;
+  new_slot.status = Status::kModified;
+  new_slot.value = value;
+  ++shard->size;
+  *inserted = true;
+  return &new_slot;
+}
+
+template <typename Key, typename Value>
+void CPUHashTable<Key, Value>::Rehash(Shard *shard, size_t slot_num) const {
+  std::vector<Slot> old_slots(slot_num);
+  old_slots.swap(shard->slots);
+  size_t mask = slot_num - 1;
+  for (const auto &slot : old_slots) {
+    if (slot.state != SlotState::kOccupied) {
       continue;
     }
+    size_t index = static_cast<size_t>(Hash(slot.key)) & mask;
+    while (shard->slots[index].state == SlotState::kOccupied) {
+      index = (index + 1) & mask;
+    }
+    shard->slots[index] = slot;
+  }
+  shard->erased_num = 0;
+}
+
+template <typename Key, typename Value>
+Value *CPUHashTable<Key, Value>::NewValue(Shard *shard) const {
+  if (!shard->free_values.empty()) {
+    auto value = shard->free_values.back();
+    shard->free_values.pop_back();
+    return value;
+  }
 
-    if (!insert_default_value) {
-      MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
-      return false;
+  if (shard->slab_remain_num == 0) {
+    size_t max_element_num = std::max(kHashTableMaxSlabSize / value_size_, static_cast<size_t>(1));
+    size_t element_num = std::min(kHashTableInitSlabElementNum << std::min(shard->slabs.size(), kMaxSlabDoublingNum),
+                                  max_element_num);
+    auto slab = AllocateMemory(element_num * value_size_);
+    if (slab == nullptr) {
+      return nullptr;
     }
+    (void)shard->slabs.emplace_back(slab);
+    shard->slab_cursor = static_cast<Value *>(slab);
+    shard->slab_remain_num = element_num;
+  }
+  auto value = shard->slab_cursor;
+  shard->slab_cursor += value_dim_;
+  --shard->slab_remain_num;
+  return value;
+}
 
-    // Insert key-value pair into values_ by default_value or initializer
-    if (!initializer_.empty()) {
-      // allocate memory for value
-      auto value_addr = static_cast<Value *>(AllocateMemory(value_size_));
-      MS_EXCEPTION_IF_NULL(value_addr);
-      (void)values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified));
-      if (initializer_ == kNormalDistribution) {
-        // initialize normal distribution parameter
-        const double mean = 0.0;
-        const double sigma = 0.01;
-        std::random_device rd;
-        const std::uint64_t seed = rd();
-        size_t skip = 0;
-        random::GenerateRandoms<Value, Generator, NormalDistribution>(seed, skip, value_addr, value_dim_, mean, sigma);
-      } else if (initializer_ == kOnesDistribution) {
-        default_value_ = 1;
-        for (size_t k = 0; k < value_dim_; ++k) {
-          value_addr[k] = default_value_;
+template <typename Key, typename Value>
+bool CPUHashTable<Key, Value>::InitializeValue(Value *value) const {
+  if (initializer_.empty()) {
+    std::fill_n(value, value_dim_, default_value_);
+    return true;
+  }
+
+  if (initializer_ == kNormalDistribution) {
+    // initialize normal distribution parameter
+    const double mean = 0.0;
+    const double sigma = 0.01;
+    std::random_device rd;
+    const std::uint64_t seed = rd();
+    size_t skip = 0;
+    random::GenerateRandoms<Value, Generator, NormalDistribution>(seed, skip, value, value_dim_, mean, sigma);
+  } else if (initializer_ == kOnesDistribution) {
+    std::fill_n(value, value_dim_, static_cast<Value>(1));
+  } else if (initializer_ == kZerosDistribution) {
+    std::fill_n(value, value_dim_, static_cast<Value>(0));
+  } else {
+    MS_LOG(ERROR) << "Unsupported initializer: " << initializer_;
+    return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value>
+bool CPUHashTable<Key, Value>::Find(const Key *keys, size_t key_num, bool insert_default_value, Value *outputs,
+                                    void *) {
+  MS_ERROR_IF_NULL(keys);
+  MS_EXCEPTION_IF_NULL(outputs);
+  const auto &sharded_keys = GroupKeysByShard(keys, key_num);
+  std::atomic<bool> inserted_any{false};
+  auto find_in_shards = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t key_begin = sharded_keys.shard_offsets[i];
+      size_t key_end = sharded_keys.shard_offsets[i + 1];
+      if (key_begin == key_end) {
+        continue;
+      }
+      auto &shard = shards_[i];
+      // The missing keys are inserted only if `insert_default_value` is true, so the shared lock is enough otherwise.
+      std::unique_lock<std::shared_mutex> unique_lock(shard.mutex, std::defer_lock);
+      std::shared_lock<std::shared_mutex> shared_lock(shard.mutex, std::defer_lock);
+      insert_default_value ? unique_lock.lock() : shared_lock.lock();
+      for (size_t j = key_begin; j < key_end; ++j) {
+        size_t key_index = sharded_keys.key_indices[j];
+        const auto &key = keys[key_index];
+        uint64_t hash = Hash(key);
+        Slot *slot = nullptr;
+        if (insert_default_value) {
+          bool inserted = false;
+          slot = FindOrInsertSlot(&shard, key, hash, &inserted);
+          if (slot == nullptr) {
+            MS_LOG(ERROR) << "Allocate memory for the value of key: " << key << " failed.";
+            return false;
+          }
+          if (inserted) {
+            inserted_any = true;
+            if (!InitializeValue(slot->value)) {
+              return false;
+            }
+          }
+        } else {
+          slot = FindSlot(&shard, key, hash);
+          if (slot == nullptr) {
+            MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
+            return false;
+          }
         }
-      } else if (initializer_ == kZerosDistribution) {
-        default_value_ = 0;
-        for (size_t k = 0; k < value_dim_; ++k) {
-          value_addr[k] = default_value_;
+
+        // Copy the value of the key from the hash table to the outputs.
+        auto ret = memcpy_s(outputs + key_index * value_dim_, value_size_, slot->value, value_size_);
+        if (ret != EOK) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          return false;
         }
-      } else {
-        MS_LOG(ERROR) << "Unsupported initializer: " << initializer_;
-        return false;
-      }
-      auto ret = memcpy_s(outputs + offset, dst_size, value_addr, src_size);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return false;
-      }
-    } else {
-      // if there's no key in values_
-      auto value_addr = static_cast<Value *>(AllocateMemory(value_size_));
-      MS_EXCEPTION_IF_NULL(value_addr);
-      (void)values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified));
-      for (size_t k = 0; k < value_dim_; ++k) {
-        value_addr[k] = default_value_;
-      }
-      auto ret = memcpy_s(outputs + offset, dst_size, value_addr, src_size);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return false;
       }
     }
+    return true;
+  };
+  bool ret = ParallelRunOnShards(key_num, find_in_shards);
+  if (inserted_any) {
+    is_dirty_ = true;
   }
-  return true;
+  return ret;
 }
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
   MS_ERROR_IF_NULL(keys);
   MS_ERROR_IF_NULL(values);
-
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-
-    auto iter = values_.find(key);
-    // The the key does not exist, a new value buffer should be allocated firstly.
-    if (iter == values_.end()) {
-      auto value_addr = AllocateMemory(value_size_);
-      MS_EXCEPTION_IF_NULL(value_addr);
-      iter = values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified)).first;
-    }
-
-    // Do the insertion copy.
-    size_t offset = i * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(iter->second.first, dst_size, values + offset, src_size);
-    if (ret != EOK) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
-    }
-    iter->second.second = Status::kModified;
-  }
-  is_dirty_ = true;
-  return true;
+  std::vector<Status> statuses(key_num, Status::kModified);
+  return Insert(keys, key_num, values, statuses.data(), nullptr);
 }
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, Status *statuses, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
   MS_ERROR_IF_NULL(keys);
   MS_ERROR_IF_NULL(values);
   MS_ERROR_IF_NULL(statuses);
 
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-
-    auto iter = values_.find(key);
-    // The the key does not exist, a new value buffer should be allocated firstly.
-    if (iter == values_.end()) {
-      auto value_addr = AllocateMemory(value_size_);
-      MS_EXCEPTION_IF_NULL(value_addr);
-      iter = values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), statuses[i])).first;
-    }
+  const auto &sharded_keys = GroupKeysByShard(keys, key_num);
+  auto insert_into_shards = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t key_begin = sharded_keys.shard_offsets[i];
+      size_t key_end = sharded_keys.shard_offsets[i + 1];
+      if (key_begin == key_end) {
+        continue;
+      }
+      auto &shard = shards_[i];
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      for (size_t j = key_begin; j < key_end; ++j) {
+        size_t key_index = sharded_keys.key_indices[j];
+        const auto &key = keys[key_index];
+        // The the key does not exist, a new value buffer is taken from the slabs of the shard.
+        bool inserted = false;
+        auto slot = FindOrInsertSlot(&shard, key, Hash(key), &inserted);
+        if (slot == nullptr) {
+          MS_LOG(ERROR) << "Allocate memory for the value of key: " << key << " failed.";
+          return false;
+        }
 
-    auto ret = memcpy_s(iter->second.first, value_size_, values + (i * value_dim_), value_size_);
-    if (ret != EOK) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
+        // Do the insertion copy.
+        auto ret = memcpy_s(slot->value, value_size_, values + key_index * value_dim_, value_size_);
+        if (ret != EOK) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          return false;
+        }
+        slot->status = statuses[key_index];
+      }
     }
-    iter->second.second = statuses[i];
-  }
+    return true;
+  };
   is_dirty_ = true;
-  return true;
+  return ParallelRunOnShards(key_num, insert_into_shards);
 }
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Erase(const Key *keys, size_t key_num, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-
+  MS_ERROR_IF_NULL(keys);
   // Erase all the keys in the hash table.
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-    auto iter = values_.find(key);
-    if (iter != values_.end()) {
-      auto value = iter->second.first;
-      (void)values_.erase(key);
-
-      // Return the memory of value to the pool.
-      MS_EXCEPTION_IF_NULL(value);
-      FreeMemory(value);
-    } else {
-      MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
-      return false;
+  const auto &sharded_keys = GroupKeysByShard(keys, key_num);
+  auto erase_from_shards = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t key_begin = sharded_keys.shard_offsets[i];
+      size_t key_end = sharded_keys.shard_offsets[i + 1];
+      if (key_begin == key_end) {
+        continue;
+      }
+      auto &shard = shards_[i];
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      for (size_t j = key_begin; j < key_end; ++j) {
+        const auto &key = keys[sharded_keys.key_indices[j]];
+        auto slot = FindSlot(&shard, key, Hash(key));
+        if (slot == nullptr) {
+          MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
+          return false;
+        }
+        // Return the value buffer to the shard, it is reused by the next inserted key.
+        (void)shard.free_values.emplace_back(slot->value);
+        slot->value = nullptr;
+        slot->state = SlotState::kErased;
+        --shard.size;
+        ++shard.erased_num;
+      }
     }
-  }
-  return true;
+    return true;
+  };
+  return ParallelRunOnShards(key_num, erase_from_shards);
 }
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Reserve(size_t new_capacity, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  values_.reserve(new_capacity);
+  // The keys are spread evenly to the shards, reserve a quarter more for the skew.
+  constexpr size_t kSkewRatio = 4;
+  size_t shard_capacity = new_capacity / kHashTableShardNum;
+  shard_capacity += shard_capacity / kSkewRatio + 1;
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    auto &shard = shards_[i];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    size_t slot_num = std::max(shard.slots.size(), kHashTableMinSlotNum);
+    while (std::max(shard_capacity, shard.size) * kLoadFactorDenominator > slot_num * kLoadFactorNumerator) {
+      slot_num <<= 1;
+    }
+    if (slot_num != shard.slots.size()) {
+      Rehash(&shard, slot_num);
+    }
+  }
   return true;
 }
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::GetKeysAndValues(Key *keys, Value *values, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  size_t index = 0;
-  for (auto iter = values_.begin(); iter != values_.end(); iter++) {
-    auto key = iter->first;
-    auto value = iter->second.first;
-    // Copy the key.
-    keys[index] = key;
-
-    // Copy the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values + offset, dst_size, value, src_size);
-    if (ret != EOK) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
-    }
-    ++index;
+  MS_ERROR_IF_NULL(keys);
+  MS_ERROR_IF_NULL(values);
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  std::vector<size_t> shard_offsets(kHashTableShardNum + 1, 0);
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    (void)locks.emplace_back(shards_[i].mutex);
+    shard_offsets[i + 1] = shard_offsets[i] + shards_[i].size;
   }
-  return true;
+
+  auto get_from_shards = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t index = shard_offsets[i];
+      for (const auto &slot : shards_[i].slots) {
+        if (slot.state != SlotState::kOccupied) {
+          continue;
+        }
+        // Copy the key and the value.
+        keys[index] = slot.key;
+        auto ret = memcpy_s(values + index * value_dim_, value_size_, slot.value, value_size_);
+        if (ret != EOK) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          return false;
+        }
+        ++index;
+      }
+    }
+    return true;
+  };
+  return ParallelRunOnShards(shard_offsets.back(), get_from_shards);
 }
 
 template <typename Key, typename Value>
@@ -273,112 +474,98 @@ bool CPUHashTable<Key, Value>::Import(const DataLenPair &input_data) {
     return true;
   }
 
+  // 2. The imported elements are inserted into the shards in parallel.
   Key *device_keys = static_cast<Key *>(host_keys);
   Value *device_values = static_cast<Value *>(host_values);
-  Status *statuses = new Status[keys_len];
-  (void)std::fill_n(statuses, keys_len, Status::kUnchanged);
-  if (!Insert(device_keys, keys_len / sizeof(Key), device_values, statuses, nullptr)) {
+  size_t key_num = keys_len / sizeof(Key);
+  std::vector<Status> statuses(key_num, Status::kUnchanged);
+  if (!Insert(device_keys, key_num, device_values, statuses.data(), nullptr)) {
     MS_LOG(ERROR) << "Insert keys and values failed.";
-    delete[] statuses;
     return false;
   }
 
   input_data_list.clear();  // Clear the list of input tensors
-  delete[] statuses;
-
   return true;
 }
 
 template <typename Key, typename Value>
-HashTableExportData CPUHashTable<Key, Value>::ExportSliceFully(size_t begin, size_t end) {
+HashTableExportData CPUHashTable<Key, Value>::ExportSliceImpl(size_t begin, size_t end, bool incremental) {
   if (end < begin) {
     MS_LOG(EXCEPTION) << "Invalid export position parameter, begin: " << begin << ", end: " << end;
   }
 
-  const size_t size = end - begin;
-  auto keys = std::make_shared<std::vector<char>>(size * sizeof(Key));
-  auto keys_data = reinterpret_cast<Key *>(keys->data());
-  auto values = std::make_shared<std::vector<char>>(size * value_size_);
-  auto values_data = reinterpret_cast<Value *>(values->data());
-  auto statuses = std::make_shared<std::vector<char>>(size * sizeof(HashTableElementStatus));
-  auto statuses_data = reinterpret_cast<Status *>(statuses->data());
-
-  size_t index = 0;
-  auto begin_iter = values_.begin();
-  std::advance(begin_iter, begin);
-  auto end_iter = values_.begin();
-  std::advance(end_iter, end);
-  for (auto iter = begin_iter; iter != end_iter; ++iter) {
-    auto key = iter->first;
-    auto value = iter->second.first;
-    auto status = iter->second.second;
-
-    // Export the key.
-    keys_data[index] = key;
-    // Export the status.
-    statuses_data[index] = status;
-
-    // Export the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values_data + offset, dst_size, value, src_size);
-    if (ret != EOK) {
-      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
-    }
-    ++index;
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  std::vector<size_t> shard_offsets(kHashTableShardNum + 1, 0);
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    (void)locks.emplace_back(shards_[i].mutex);
+    shard_offsets[i + 1] = shard_offsets[i] + shards_[i].size;
   }
-  return {keys, values, statuses};
-}
 
-template <typename Key, typename Value>
-HashTableExportData CPUHashTable<Key, Value>::ExportSliceIncrementally(size_t begin, size_t end) {
-  if (end < begin) {
-    MS_LOG(EXCEPTION) << "Invalid export position parameter, begin: " << begin << ", end: " << end;
+  // Visit the elements of the shard whose positions are in the interval [begin, end).
+  auto visit_shard = [&](size_t shard_index, const std::function<void(const Slot &)> &visitor) {
+    size_t position = shard_offsets[shard_index];
+    if (position >= end || shard_offsets[shard_index + 1] <= begin) {
+      return;
+    }
+    for (const auto &slot : shards_[shard_index].slots) {
+      if (slot.state != SlotState::kOccupied) {
+        continue;
+      }
+      if (position >= end) {
+        break;
+      }
+      if (position++ >= begin) {
+        visitor(slot);
+      }
+    }
+  };
+  auto need_export = [incremental](const Slot &slot) { return !incremental || slot.status != Status::kUnchanged; };
+
+  // 1. Count export number of the elements in every shard.
+  std::vector<size_t> export_offsets(kHashTableShardNum + 1, 0);
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    size_t export_num = 0;
+    if (incremental) {
+      visit_shard(i, [&export_num, &need_export](const Slot &slot) { export_num += need_export(slot) ? 1 : 0; });
+    } else {
+      size_t lower = std::max(begin, shard_offsets[i]);
+      size_t upper = std::min(end, shard_offsets[i + 1]);
+      export_num = upper > lower ? upper - lower : 0;
+    }
+    export_offsets[i + 1] = export_offsets[i] + export_num;
   }
 
-  auto begin_iter = values_.begin();
-  std::advance(begin_iter, begin);
-  auto end_iter = values_.begin();
-  std::advance(end_iter, end);
-
-  // 1. Count export number of all modified elememts.
-  size_t update_elements_size = LongToSize(
-    std::count_if(begin_iter, end_iter, [](typename std::unordered_map<Key, ValueStatusPair>::const_reference item) {
-      return item.second.second != Status::kUnchanged;
-    }));
-
-  auto keys = std::make_shared<std::vector<char>>(update_elements_size * sizeof(Key));
+  const size_t size = export_offsets.back();
+  auto keys = std::make_shared<std::vector<char>>(size * sizeof(Key));
   auto keys_data = reinterpret_cast<Key *>(keys->data());
-  auto values = std::make_shared<std::vector<char>>(update_elements_size * value_size_);
+  auto values = std::make_shared<std::vector<char>>(size * value_size_);
   auto values_data = reinterpret_cast<Value *>(values->data());
-  auto statuses = std::make_shared<std::vector<char>>(update_elements_size * sizeof(HashTableElementStatus));
+  auto statuses = std::make_shared<std::vector<char>>(size * sizeof(HashTableElementStatus));
   auto statuses_data = reinterpret_cast<Status *>(statuses->data());
 
-  // 2. Export all modified elememts.
-  size_t index = 0;
-  for (auto iter = begin_iter; iter != end_iter; ++iter) {
-    auto key = iter->first;
-    auto value = iter->second.first;
-    auto status = iter->second.second;
-    if (status == Status::kUnchanged) {
-      continue;
-    }
-
-    // Export the key.
-    keys_data[index] = key;
-    // Export the status.
-    statuses_data[index] = status;
-
-    // Export the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values_data + offset, dst_size, value, src_size);
-    if (ret != EOK) {
-      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  // 2. Export the elements of the shards in parallel.
+  auto export_shards = [&](size_t shard_begin, size_t shard_end) {
+    bool success = true;
+    for (size_t i = shard_begin; i < shard_end; ++i) {
+      size_t index = export_offsets[i];
+      visit_shard(i, [&](const Slot &slot) {
+        if (!need_export(slot)) {
+          return;
+        }
+        keys_data[index] = slot.key;
+        statuses_data[index] = slot.status;
+        auto ret = memcpy_s(values_data + index * value_dim_, value_size_, slot.value, value_size_);
+        if (ret != EOK) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          success = false;
+        }
+        ++index;
+      });
     }
-    ++index;
+    return success;
+  };
+  if (!ParallelRunOnShards(end - begin, export_shards)) {
+    MS_LOG(EXCEPTION) << "Export the hash table failed.";
   }
   return {keys, values, statuses};
 }
@@ -394,11 +581,7 @@ HashTableExportData CPUHashTable<Key, Value>::Export(bool incremental) {
 
   size_t begin = 0;
   size_t end = size();
-
-  if (incremental) {
-    return ExportSliceIncrementally(begin, end);
-  }
-  return ExportSliceFully(begin, end);
+  return ExportSliceImpl(begin, end, incremental);
 }
 
 template <typename Key, typename Value>
@@ -422,12 +605,7 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSlice(bool incremental, bool
     end_ = std::min(begin_ + slice_size, size());
   }
 
-  HashTableExportData ret;
-  if (incremental) {
-    ret = ExportSliceIncrementally(begin_, end_);
-  } else {
-    ret = ExportSliceFully(begin_, end_);
-  }
+  HashTableExportData ret = ExportSliceImpl(begin_, end_, incremental);
 
   *last_slice = (end_ == size());
   if (*last_slice) {
@@ -442,14 +620,17 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSlice(bool incremental, bool
 
 template <typename Key, typename Value>
 size_t CPUHashTable<Key, Value>::capacity() const {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  return values_.size();
+  return size();
 }
 
 template <typename Key, typename Value>
 size_t CPUHashTable<Key, Value>::size() const {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  return values_.size();
+  size_t total_size = 0;
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+    total_size += shards_[i].size;
+  }
+  return total_size;
 }
 
 template <typename Key, typename Value>
@@ -457,17 +638,27 @@ bool CPUHashTable<Key, Value>::is_dirty() const {
   return is_dirty_;
 }
 
+template <typename Key, typename Value>
+void CPUHashTable<Key, Value>::ClearShard(Shard *shard) const {
+  // Return all the memory of values in the shard to the memory pool.
+  for (auto slab : shard->slabs) {
+    FreeMemory(slab);
+  }
+  shard->slabs.clear();
+  shard->free_values.clear();
+  shard->slab_cursor = nullptr;
+  shard->slab_remain_num = 0;
+  shard->slots.clear();
+  shard->size = 0;
+  shard->erased_num = 0;
+}
+
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Clear() {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  // Return all the memory of values in hash table to the memory pool.
-  for (auto iter = values_.begin(); iter != values_.end(); iter++) {
-    auto value = iter->second.first;
-    if (value != nullptr) {
-      FreeMemory(value);
-    }
+  for (size_t i = 0; i < kHashTableShardNum; ++i) {
+    std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+    ClearShard(&shards_[i]);
   }
-  (void)values_.clear();
   return true;
 }
 
@@ -16,12 +16,15 @@
 #ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_HASH_TABLE_H_
 #define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_HASH_TABLE_H_
 
+#include <mutex>
 #include <shared_mutex>
-#include <unordered_map>
+#include <memory>
 #include <random>
 #include <vector>
 #include <string>
 #include <utility>
+#include <functional>
+#include <atomic>
 
 #include "runtime/device/hash_table.h"
 #include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
@@ -34,6 +37,18 @@ constexpr static size_t kImportTensorNum = 3;
 constexpr static char kNormalDistribution[] = "normal";
 constexpr static char kZerosDistribution[] = "zeros";
 constexpr static char kOnesDistribution[] = "ones";
+// The hash table is split into shards by the high bits of the hash of the keys, every shard is an open addressing
+// table with its own lock, so the keys of a batch in different shards are handled in parallel.
+constexpr static size_t kHashTableShardBits = 6;
+constexpr static size_t kHashTableShardNum = static_cast<size_t>(1) << kHashTableShardBits;
+// The minimum slot number of a shard, always power of two.
+constexpr static size_t kHashTableMinSlotNum = 16;
+// The values are stored in slabs allocated from the memory pool, the element number of the slabs in a shard doubles
+// from the initial one until the slab size reaches the max one.
+constexpr static size_t kHashTableInitSlabElementNum = 16;
+constexpr static size_t kHashTableMaxSlabSize = static_cast<size_t>(4) << 20;
+// The batches with less keys are handled in the calling thread.
+constexpr static size_t kHashTableParallelKeyNum = 4096;
 
 using DataType = float;
 using Generator = random::Philox;
@@ -44,7 +59,6 @@ template <typename Key, typename Value>
 class CPUHashTable : public HashTable<Key, Value> {
  public:
   using Status = HashTableElementStatus;
-  using ValueStatusPair = std::pair<Value *, Status>;
 
   CPUHashTable(size_t value_dim, const std::string &initializer);
   CPUHashTable(size_t value_dim, const Value &default_value);
@@ -85,12 +99,60 @@ class CPUHashTable : public HashTable<Key, Value> {
   bool Clear() override;
 
  private:
-  // Export all keys, values and status of the hash table in the iterator interval [begin, end).
-  HashTableExportData ExportSliceFully(size_t begin, size_t end);
-
-  // Export the keys, values and status in the iterator interval [begin, end) which are modified or erased since last
-  // import or export.
-  HashTableExportData ExportSliceIncrementally(size_t begin, size_t end);
+  enum class SlotState : uint8_t { kEmpty = 0, kOccupied, kErased };
+
+  // The slot of the open addressing table, the value is stored in the slabs of the shard.
+  struct Slot {
+    Key key;
+    SlotState state{SlotState::kEmpty};
+    Status status{Status::kUnchanged};
+    Value *value{nullptr};
+  };
+
+  struct Shard {
+    // This mutex is to guarantee the thread-safe of the shard.
+    mutable std::shared_mutex mutex;
+    // The slot number is always power of two, the slots are probed linearly.
+    std::vector<Slot> slots;
+    size_t size{0};
+    size_t erased_num{0};
+    // The slabs hold the values of the shard contiguously, the value buffers of the erased keys are reused first.
+    std::vector<void *> slabs;
+    std::vector<Value *> free_values;
+    Value *slab_cursor{nullptr};
+    size_t slab_remain_num{0};
+  };
+
+  // The keys of a batch grouped by shard, the indices of the keys in shard `i` are
+  // `key_indices[shard_offsets[i], shard_offsets[i + 1])`.
+  struct ShardedKeys {
+    std::vector<size_t> key_indices;
+    std::vector<size_t> shard_offsets;
+  };
+
+  static uint64_t Hash(const Key &key);
+  static size_t ShardIndex(uint64_t hash) { return static_cast<size_t>(hash >> (64 - kHashTableShardBits)); }
+  ShardedKeys GroupKeysByShard(const Key *keys, size_t key_num) const;
+  // Run the function on the shards in parallel, the function handles the shards in the interval [begin, end) and
+  // returns whether it succeeded.
+  bool ParallelRunOnShards(size_t total_work, const std::function<bool(size_t, size_t)> &func) const;
+
+  // Return the slot of the key, nullptr if the key does not exist. The caller holds the lock of the shard.
+  Slot *FindSlot(Shard *shard, const Key &key, uint64_t hash) const;
+  // Return the slot of the key, the key and its value buffer are inserted if the key does not exist, `inserted` tells
+  // whether a new key is inserted. The caller holds the unique lock of the shard.
+  Slot *FindOrInsertSlot(Shard *shard, const Key &key, uint64_t hash, bool *inserted);
+  // Rehash the shard to the given slot number, the values are not moved.
+  void Rehash(Shard *shard, size_t slot_num) const;
+  // Take a value buffer from the slabs of the shard, nullptr if failed to allocate a new slab.
+  Value *NewValue(Shard *shard) const;
+  // Fill the value buffer of a missing key by the default value or the initializer.
+  bool InitializeValue(Value *value) const;
+  void ClearShard(Shard *shard) const;
+
+  // Export the elements in the position interval [begin, end) of the hash table, only the elements which are modified
+  // or erased since last import or export are exported if `incremental` is true.
+  HashTableExportData ExportSliceImpl(size_t begin, size_t end, bool incremental);
 
   // Allocate host memory from dynamic memory pool.
   void *AllocateMemory(size_t size) const;
@@ -98,12 +160,8 @@ class CPUHashTable : public HashTable<Key, Value> {
   // Free host memory to dynamic memory pool.
   void FreeMemory(void *ptr) const;
 
-  // The key-value style elements stored in this hash table.
-  std::unordered_map<Key, ValueStatusPair> values_;
-
-  // This mutex is to guarantee the thread-safe of the `values_` above.
-  // The perforcemence of this thread-safe mechanism is poor, so a more efficient way could be used later.
-  mutable std::shared_mutex mutex_;
+  // The key-value style elements stored in this hash table, the elements are ordered by shard and slot when exported.
+  std::unique_ptr<Shard[]> shards_;
 
   // The value dimension and byte size for each key.
   size_t value_dim_;
@@ -114,9 +172,9 @@ class CPUHashTable : public HashTable<Key, Value> {
   Value default_value_;
   // The flag records whether the elements of the hash table have changed since the last export, true means that there
   // has been a change.
-  bool is_dirty_{true};
+  std::atomic<bool> is_dirty_{true};
 
-  // Record the position of slice export, the elements in the iterator interval [begin_, end_) of hash table will be
+  // Record the position of slice export, the elements in the position interval [begin_, end_) of hash table will be
   // exported.
   size_t begin_{0};
   size_t end_{0};
@@ -16,15 +16,31 @@
 
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
+#include <algorithm>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 constexpr size_t kWaitTimeout = 30;
+// The data not larger than this size is reduced by the halving doubling algorithm whose latency is lower.
+constexpr size_t kHalvingDoublingMaxSize = 256 << 10;
+// The byte size of the segments which the chunks of the ring algorithm are sent in.
+constexpr size_t kRingSegmentSize = 1 << 20;
+constexpr size_t kHalvingFactor = 2;
+
+// Add the input data into the output by the SIMD kernel.
+void ReduceSum(const float *input, float *output, size_t data_num) {
+  if (data_num == 0) {
+    return;
+  }
+  (void)ElementAdd(output, input, output, SizeToInt(data_num));
+}
 }  // namespace
 
 bool AllReduceLauncher::Initialize() {
@@ -70,6 +86,10 @@ bool AllReduceLauncher::Execute(const void *input_data, void *const output_data,
     MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
     return ReduceBroadcastAllReduce(input_data, output_data, data_size);
   }
+  if (data_size <= kHalvingDoublingMaxSize) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes HalvingDoublingAllReduce algorithm on the rank " << rank_id_;
+    return HalvingDoublingAllReduce(input_data, output_data, data_size);
+  }
   // If the data number is not less than the node number, the RingAllReduce algorithm is used.
   MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
   return RingAllReduce(input_data, output_data, data_size);
@@ -101,44 +121,44 @@ bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output
   auto *output_buff = reinterpret_cast<float *>(output_data);
   uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
   uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
+  const size_t segment_num = kRingSegmentSize / sizeof(float);
   MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
                 << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
                 << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", rec_from_rank:" << rec_from_rank;
+                << ", rec_from_rank:" << rec_from_rank << ", segment_num:" << segment_num;
+  if (rank_size_ == 1) {
+    return true;
+  }
+
+  // The data of the socket is copied when sending, so the sent segments are waited for at the end.
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  std::vector<uint64_t> send_req_ids;
+  auto send_segment = [&](size_t offset, size_t num) {
+    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, output_buff + offset,
+                                                      num * sizeof(float));
+    send_req_ids.push_back(send_req_id);
+  };
 
   // Ring ReduceScatter.
+  // Each received segment is reduced and forwarded to the next rank at once, so the reduction and the transfer of the
+  // segments overlap. The chunk reduced in the last step is complete and starts the AllGather.
   MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
-  MS_EXCEPTION_IF_NULL(abs_node_);
+  for (size_t ofs = 0; ofs < chunk_sizes[rank_id_]; ofs += segment_num) {
+    send_segment(chunk_offset[rank_id_] + ofs, std::min(segment_num, chunk_sizes[rank_id_] - ofs));
+  }
   for (size_t i = 0; i < rank_size_ - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    // Step 2: Async receive data to next rank and wait until it's done.
     size_t rec_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
-
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait receiving [" << rec_req_id.first << "," << rec_req_id.second
-                    << "] failed.";
-      return false;
-    }
-    // Step 3: Reduce the data, so we can overlap the time cost of send.
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
-    }
-    // Step 4: Wait until send is done.
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
-      return false;
+    MS_LOG(DEBUG) << "Ring ReduceScatter rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+    for (size_t ofs = 0; ofs < chunk_sizes[rec_chunk_index]; ofs += segment_num) {
+      size_t num = std::min(segment_num, chunk_sizes[rec_chunk_index] - ofs);
+      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+      if (!Receive(rec_from_rank, num, &rec_ptr)) {
+        MS_LOG(ERROR) << "Ring ReduceScatter failed in iteration " << i;
+        return false;
+      }
+      ReduceSum(reinterpret_cast<const float *>(rec_ptr->data()), output_buff + chunk_offset[rec_chunk_index] + ofs,
+                num);
+      send_segment(chunk_offset[rec_chunk_index] + ofs, num);
     }
   }
   MS_LOG(DEBUG) << "End Ring ReduceScatter.";
@@ -146,34 +166,156 @@ bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output
   // Ring AllGather.
   MS_LOG(DEBUG) << "Start Ring AllGather.";
   for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
     size_t rec_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+    MS_LOG(DEBUG) << "Ring AllGather rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+    for (size_t ofs = 0; ofs < chunk_sizes[rec_chunk_index]; ofs += segment_num) {
+      size_t num = std::min(segment_num, chunk_sizes[rec_chunk_index] - ofs);
+      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+      if (!Receive(rec_from_rank, num, &rec_ptr)) {
+        MS_LOG(ERROR) << "Ring AllGather failed in iteration " << i;
+        return false;
+      }
+      float *rec_segment = output_buff + chunk_offset[rec_chunk_index] + ofs;
+      memcpy_ret = memcpy_s(rec_segment, num * sizeof(float), rec_ptr->data(), rec_ptr->size());
+      if (memcpy_ret != EOK) {
+        MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+        return false;
+      }
+      // The next rank has got the chunk received in the last iteration.
+      if (i + 1 < rank_size_ - 1) {
+        send_segment(chunk_offset[rec_chunk_index] + ofs, num);
+      }
+    }
+  }
+  MS_LOG(DEBUG) << "End Ring AllGather.";
 
+  for (const auto &send_req_id : send_req_ids) {
+    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AllReduceLauncher::HalvingDoublingAllReduce(const void *input_data, void *const output_data,
+                                                 size_t data_size) const {
+  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "HalvingDoublingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  MS_EXCEPTION_IF_CHECK_FAIL((rank_size_ != 0), "The rank size is zero.");
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  size_t data_num = data_size / sizeof(float);
+  auto *output_buff = reinterpret_cast<float *>(output_data);
+  // The ranks beyond the largest power of two fold their data into the lower ranks first, and get the result from them
+  // at last.
+  size_t pof2 = 1;
+  while (pof2 * kHalvingFactor <= rank_size_) {
+    pof2 *= kHalvingFactor;
+  }
+  size_t rem = rank_size_ - pof2;
+  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
+                << ", power of two:" << pof2;
+  if (rank_id_ >= pof2) {
+    return SendRecv(SizeToUint(rank_id_ - pof2), output_buff, data_num, output_buff, data_num, false);
+  }
+  if (rank_id_ < rem) {
     std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring AllGather wait receiving " << rec_req_id << " failed.";
+    if (!Receive(SizeToUint(rank_id_ + pof2), data_num, &rec_ptr)) {
       return false;
     }
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    memcpy_ret = memcpy_s(rec_chunk, chunk_sizes[rec_chunk_index] * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+    ReduceSum(reinterpret_cast<const float *>(rec_ptr->data()), output_buff, data_num);
+  }
+
+  // Recursive halving ReduceScatter, each step keeps a half of the range and reduces the half of the peer into it.
+  // The data number is not less than the power of two, so no half is empty.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t lo = 0;
+  size_t hi = data_num;
+  for (size_t mask = pof2 >> 1; mask > 0; mask >>= 1) {
+    uint32_t peer_rank = SizeToUint(rank_id_ ^ mask);
+    size_t mid = lo + (hi - lo) / kHalvingFactor;
+    ranges.emplace_back(lo, hi);
+    bool keep_upper = (rank_id_ & mask) != 0;
+    size_t send_lo = keep_upper ? lo : mid;
+    size_t send_hi = keep_upper ? mid : hi;
+    lo = keep_upper ? mid : lo;
+    hi = keep_upper ? hi : mid;
+    if (!SendRecv(peer_rank, output_buff + send_lo, send_hi - send_lo, output_buff + lo, hi - lo, true)) {
+      MS_LOG(ERROR) << "Recursive halving ReduceScatter with rank " << peer_rank << " failed.";
+      return false;
+    }
+  }
+
+  // Recursive doubling AllGather, which replays the steps of the ReduceScatter in the reverse order.
+  for (size_t mask = 1; mask < pof2; mask <<= 1) {
+    uint32_t peer_rank = SizeToUint(rank_id_ ^ mask);
+    auto range = ranges.back();
+    ranges.pop_back();
+    bool keep_upper = (rank_id_ & mask) != 0;
+    size_t rec_lo = keep_upper ? range.first : hi;
+    size_t rec_hi = keep_upper ? lo : range.second;
+    if (!SendRecv(peer_rank, output_buff + lo, hi - lo, output_buff + rec_lo, rec_hi - rec_lo, false)) {
+      MS_LOG(ERROR) << "Recursive doubling AllGather with rank " << peer_rank << " failed.";
       return false;
     }
+    lo = range.first;
+    hi = range.second;
+  }
+
+  if (rank_id_ < rem) {
+    auto send_req_id =
+      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, SizeToUint(rank_id_ + pof2), output_buff, data_size);
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+      MS_LOG(ERROR) << "HalvingDoublingAllReduce wait sending " << send_req_id << " failed.";
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
+  return true;
+}
+
+bool AllReduceLauncher::SendRecv(uint32_t peer_rank, const float *send_data, size_t send_num, float *output,
+                                 size_t recv_num, bool reduce) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  auto send_req_id =
+    abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, peer_rank, send_data, send_num * sizeof(float));
+  std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+  if (!Receive(peer_rank, recv_num, &rec_ptr)) {
+    return false;
+  }
+  if (reduce) {
+    ReduceSum(reinterpret_cast<const float *>(rec_ptr->data()), output, recv_num);
+  } else {
+    int memcpy_ret = memcpy_s(output, recv_num * sizeof(float), rec_ptr->data(), rec_ptr->size());
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "SendRecv memcpy_s received data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
+  }
+  if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+    MS_LOG(ERROR) << "SendRecv wait sending " << send_req_id << " to rank " << peer_rank << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool AllReduceLauncher::Receive(uint32_t rank, size_t data_num,
+                                std::shared_ptr<std::vector<unsigned char>> *rec_ptr) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  MS_EXCEPTION_IF_NULL(rec_ptr);
+  auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rank, rec_ptr);
+  if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
+    MS_LOG(ERROR) << "AllReduce wait receiving " << rec_req_id << " failed.";
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(*rec_ptr);
+  if ((*rec_ptr)->size() != data_num * sizeof(float)) {
+    MS_LOG(ERROR) << "AllReduce received " << (*rec_ptr)->size() << " bytes from rank " << rank << ", but "
+                  << data_num * sizeof(float) << " bytes are expected.";
+    return false;
+  }
   return true;
 }
 
@@ -201,10 +343,7 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
         return false;
       }
       MS_EXCEPTION_IF_NULL(rec_ptr);
-      const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-      for (size_t j = 0; j < data_num; j++) {
-        output_buff[j] += tmp_data[j];
-      }
+      ReduceSum(reinterpret_cast<const float *>(rec_ptr->data()), output_buff, data_num);
     }
   } else {
     MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "include/backend/distributed/cluster/cluster_context.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
 
@@ -45,8 +46,19 @@ class AllReduceLauncher {
   std::string node_role_{distributed::kEnvRoleOfWorker};
   std::shared_ptr<ps::core::CollectiveNode> abs_node_{nullptr};
 
+  // The ring algorithm whose chunks are sent in segments, so that the reduction of a segment overlaps the transfer of
+  // the following ones, it is used for the large data.
   bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // The recursive halving reduce scatter followed by the recursive doubling all gather, which takes 2*log(n) steps
+  // instead of 2*(n-1) ones of the ring and is used for the small data.
+  bool HalvingDoublingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
   bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+
+  // Send the data to the peer rank and receive the data of the peer, which is added to or copied into the output.
+  bool SendRecv(uint32_t peer_rank, const float *send_data, size_t send_num, float *output, size_t recv_num,
+                bool reduce) const;
+  // Receive the data of the given number from the rank.
+  bool Receive(uint32_t rank, size_t data_num, std::shared_ptr<std::vector<unsigned char>> *rec_ptr) const;
 };
 }  // namespace cpu
 }  // namespace device
@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/cpu_device_context.h"
+#include <algorithm>
 #include <map>
 #include <string>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
@@ -28,6 +29,7 @@
 #endif
 #include "plugin/factory/ms_factory.h"
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "plugin/device/cpu/kernel/utils/parallel_tuning_cache.h"
 #include "kernel/kernel_build_info.h"
 #include "kernel/framework_utils.h"
 #include "plugin/device/cpu/hal/device/kernel_select_cpu.h"
@@ -56,6 +58,8 @@
 #include "backend/common/graph_kernel/value_graph_binder.h"
 #include "include/backend/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
+#include "include/common/utils/convert_utils.h"
+#include "backend/common/session/kernel_select_cache.h"
 #include "plugin/device/cpu/hal/profiler/cpu_profiling.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
@@ -128,6 +132,7 @@ void CPUDeviceContext::Initialize() {
 
 void CPUDeviceContext::Destroy() {
   MS_EXCEPTION_IF_NULL(device_res_manager_);
+  (void)kernel::ParallelTuningCache::GetInstance().Save();
   device_res_manager_->Destroy();
   initialized_ = false;
 }
@@ -372,6 +377,25 @@ void SetKernelInfoBeforeCreateKernel(const std::vector<CNodePtr> &nodes) {
     }
   }
 }
+
+// The selection of the control ops, the custom ops and the kernels registered at selection is not cached, as it has
+// side effects besides the kernel build info.
+bool CanCacheKernelSelection(const std::vector<CNodePtr> &nodes) {
+  return std::all_of(nodes.begin(), nodes.end(), [](const CNodePtr &node) {
+    return !common::AnfAlgo::IsBpropCutOpExecInBackend(node) && !IsPrimitiveCNode(node, prim::kPrimCustom) &&
+           !kernel::IsDynamicParamKernel(common::AnfAlgo::GetCNodeName(node)) && !IsAKGSparseOP(node);
+  });
+}
+
+// The kernel attrs registered for the op of the kernel, the kernel selection picks one of them.
+std::string CpuKernelFingerprint(const CNodePtr &kernel) {
+  auto kernel_attrs = kernel::NativeCpuKernelMod::GetCpuSupportedList(common::AnfAlgo::GetCNodeName(kernel));
+  std::string fingerprint;
+  for (const auto &kernel_attr : kernel_attrs) {
+    fingerprint += kernel::FetchPrintInfoByKernelAttr(kernel_attr) + ";";
+  }
+  return fingerprint;
+}
 }  // namespace
 
 void CPUKernelExecutor::SetOperatorInfo(const KernelGraphPtr &graph) const {
@@ -385,6 +409,16 @@ void CPUKernelExecutor::SetOperatorInfo(const KernelGraphPtr &graph) const {
     graph->set_manager(mng);
   }
   auto &node_list = graph->execution_order();
+  auto &kernel_select_cache = session::KernelSelectCache::GetInstance();
+  std::string cache_key;
+  if (session::KernelSelectCache::Enable() && CanCacheKernelSelection(node_list)) {
+    cache_key = session::KernelSelectCache::GraphKey(graph, kCPUDevice, CpuKernelFingerprint);
+    if (kernel_select_cache.LoadKernelBuildInfo(cache_key, node_list)) {
+      MS_LOG(INFO) << "Skip the kernel selection of graph " << graph->graph_id() << " by the kernel select cache.";
+      (void)profiler::CollectHostInfo(kModelNameCPU, kEventOptimizeGraph, kStageSetKernelInfo, 1, 0, 1);
+      return;
+    }
+  }
   for (auto &node : node_list) {
     if (!common::AnfAlgo::IsBpropCutOpExecInBackend(node)) {
       auto [msg, etype] = SetKernelInfoWithMsg(node);
@@ -410,6 +444,8 @@ void CPUKernelExecutor::SetOperatorInfo(const KernelGraphPtr &graph) const {
   if (do_expand) {
     (void)graphkernel::BindValueToGraph().Run(graph);
     graph->SetExecOrderByDefault();
+  } else if (!cache_key.empty()) {
+    kernel_select_cache.SaveKernelBuildInfo(cache_key, node_list);
   }
   (void)profiler::CollectHostInfo(kModelNameCPU, kEventOptimizeGraph, kStageSetKernelInfo, 1, 0, 1);
 }
@@ -455,6 +491,8 @@ void CPUKernelExecutor::CreateKernel(const std::vector<CNodePtr> &nodes) const {
     if (!ret) {
       MS_LOG(EXCEPTION) << trace::DumpSourceLines(node);
     }
+    cpu_kernel->parallel_search_info_.tuning_signature =
+      kernel::GetParallelTuningSignature(kernel_name, input_kernel_tensors, output_kernel_tensors);
     if (kernel::CheckResizeCondition(node)) {
       if (cpu_kernel->Resize(input_kernel_tensors, output_kernel_tensors) == kernel::KRET_RESIZE_FAILED) {
         MS_LOG(INTERNAL_EXCEPTION) << "#dmsg#Kernel build failed:#dmsg#CPU kernel op [" << node->fullname_with_scope()
@@ -23,6 +23,9 @@ namespace device {
 namespace cpu {
 namespace {
 const char kMemAvailable[] = "MemAvailable";
+// PyNative and dynamic shape graphs make a great many small allocations, which the thread cache serves without the
+// lock of the pool.
+const char kMemThreadCacheEnv[] = "MS_DEV_CPU_MEM_THREAD_CACHE";
 }
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
@@ -47,6 +50,8 @@ bool CPUMemoryPool::FreeDeviceMem(const DeviceMemPtr &addr) {
 }
 
 size_t CPUMemoryPool::free_mem_size() { return mindspore::GetSystemMemorySize(kMemAvailable); }
+
+const bool CPUMemoryPool::IsEnableThreadCache() const { return common::GetEnv(kMemThreadCacheEnv) == "1"; }
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -39,6 +39,9 @@ class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
   size_t free_mem_size() override;
   std::string GetMemoryPoolType() const override { return "CPU"; }
 
+ protected:
+  const bool IsEnableThreadCache() const override;
+
  private:
   CPUMemoryPool() = default;
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
@@ -20,6 +20,7 @@
 #include "utils/ms_utils.h"
 #include "utils/ms_context.h"
 #include "mindspore/core/utils/file_utils.h"
+#include "plugin/device/cpu/kernel/utils/parallel_tuning_cache.h"
 
 namespace mindspore {
 namespace profiler {
@@ -58,6 +59,14 @@ void CpuDataSaver::WriteFile(const std::string out_path_dir) {
   WriteOpDetail(out_path_dir);
   WriteOpType(out_path_dir);
   WriteOpTimestamp(out_path_dir);
+  WriteParallelTuning(out_path_dir);
+}
+
+void CpuDataSaver::WriteParallelTuning(const std::string &out_path_dir) const {
+  std::string file_path = out_path_dir + "/" + op_side_ + "_parallel_tuning_" + device_id_ + ".csv";
+  if (kernel::ParallelTuningCache::GetInstance().Dump(file_path)) {
+    MS_LOG(INFO) << "Write parallel tuning infos into file: " << file_path;
+  }
 }
 OpTimestampInfo &CpuDataSaver::GetOpTimeStampInfo() { return op_timestamps_map_; }
 
@@ -43,6 +43,9 @@ class BACKEND_EXPORT CpuDataSaver : public DataSaver {
   void WriteFile(const std::string out_path);
 
  private:
+  // Write the parallel grain of the cpu kernels found by the auto search.
+  void WriteParallelTuning(const std::string &out_path_dir) const;
+
   static std::shared_ptr<CpuDataSaver> cpu_data_saver_inst_;
 };
 }  // namespace cpu
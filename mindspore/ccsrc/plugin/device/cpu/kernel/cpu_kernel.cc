@@ -26,9 +26,33 @@
 #include "utils/profile.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "kernel/common_utils.h"
+#include "plugin/device/cpu/kernel/utils/parallel_tuning_cache.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Take the best parallelism of the signature from the tuning cache instead of searching it, the search restarts when
+// the count falls into another bucket.
+void LookupParallelTuningCache(size_t count, size_t avg_count, ParallelSearchInfo *parallel_search_info) {
+  size_t count_bucket = ParallelTuningCache::CountBucket(count);
+  if (count_bucket != parallel_search_info->tuning_count_bucket) {
+    parallel_search_info->tuning_count_bucket = count_bucket;
+    parallel_search_info->search_count = 0;
+    parallel_search_info->min_cost_time = DBL_MAX;
+    parallel_search_info->best_pow = 0;
+  } else if (parallel_search_info->search_count >= avg_count * parallel_search_info->max_pow) {
+    return;
+  }
+  size_t best_pow = 0;
+  if (ParallelTuningCache::GetInstance().Find(parallel_search_info->tuning_signature, count_bucket,
+                                              parallel_search_info->kernel_thread_num, &best_pow)) {
+    parallel_search_info->best_pow = best_pow;
+    parallel_search_info->best_block_size = static_cast<float>(count) / std::pow(2.0f, best_pow);
+    parallel_search_info->search_count = avg_count * parallel_search_info->max_pow;
+  }
+}
+}  // namespace
+
 std::vector<KernelAttr> NativeCpuKernelMod::GetAllSupportedList(const std::string &kernel_name) {
   auto iter = support_map_.find(kernel_name);
   if (iter == support_map_.end()) {
@@ -265,9 +289,13 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
       max_pow_current++;
     }
     parallel_search_info->max_pow = max_pow_current + 1;
+    parallel_search_info->kernel_thread_num = kernel_thread_num;
     parallel_search_info->kernel_thread_num_set = true;
   }
   const size_t AVG_COUNT = 5;
+  if (!parallel_search_info->tuning_signature.empty()) {
+    LookupParallelTuningCache(count, AVG_COUNT, parallel_search_info);
+  }
   size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
   if (current_pow < parallel_search_info->max_pow) {
     if (parallel_search_info->search_count % AVG_COUNT == 0) {
@@ -288,12 +316,33 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
       } else if (current_pow - parallel_search_info->best_pow >= 2) {
         parallel_search_info->search_count = AVG_COUNT * parallel_search_info->max_pow;
       }
+      if (parallel_search_info->search_count >= AVG_COUNT * parallel_search_info->max_pow &&
+          !parallel_search_info->tuning_signature.empty()) {
+        ParallelTuningCache::GetInstance().Update(
+          parallel_search_info->tuning_signature, parallel_search_info->tuning_count_bucket,
+          parallel_search_info->kernel_thread_num, parallel_search_info->best_pow, parallel_search_info->min_cost_time);
+      }
     }
   } else {
     ParallelLaunch(task, count, parallel_search_info->best_block_size, content, pool);
   }
 }
 
+std::string GetParallelTuningSignature(const std::string &kernel_name, const std::vector<KernelTensor *> &inputs,
+                                       const std::vector<KernelTensor *> &outputs) {
+  std::string signature = kernel_name + "(";
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(inputs[i]);
+    signature += (i == 0 ? "" : " ") + TypeIdToString(inputs[i]->dtype_id(), true);
+  }
+  signature += ")->(";
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(outputs[i]);
+    signature += (i == 0 ? "" : " ") + TypeIdToString(outputs[i]->dtype_id(), true);
+  }
+  return signature + ")";
+}
+
 ShapeVector CPUKernelUtils::FlatShapeByAxis(const ShapeVector &shape, int axis) {
   if (axis < 0) {
     axis = axis + SizeToInt(shape.size());
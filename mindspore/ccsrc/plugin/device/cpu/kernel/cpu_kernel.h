@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 
 #include <functional>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -137,6 +138,12 @@ struct ParallelSearchInfo {
   size_t search_count{0};
   bool kernel_thread_num_set{false};
   size_t max_pow{6};
+  size_t kernel_thread_num{0};
+  // The kernel name and data types, the kernel instances with the same signature share the search results through the
+  // parallel tuning cache. The cache is not used if it is empty.
+  std::string tuning_signature;
+  // The count bucket which the search results belong to.
+  size_t tuning_count_bucket{std::numeric_limits<size_t>::max()};
 };
 
 class BACKEND_EXPORT NativeCpuKernelMod : public CpuKernelMod {
@@ -317,12 +324,16 @@ class TransposeIterator {
   size_t pos_{0};
 };
 
-ActorThreadPool *GetActorMgrInnerThreadPool();
+BACKEND_EXPORT ActorThreadPool *GetActorMgrInnerThreadPool();
 void ParallelLaunch(const CTask &task, size_t count, float block_size = 128.0, Content content = nullptr,
                     ThreadPool *pool = nullptr);
 void ParallelLaunch(const std::vector<common::Task> &tasks, Content content = nullptr, ThreadPool *pool = nullptr);
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
                               ParallelSearchInfo *parallel_search_info, ThreadPool *pool = nullptr);
+// The signature of the kernel in the parallel tuning cache.
+BACKEND_EXPORT std::string GetParallelTuningSignature(const std::string &kernel_name,
+                                                      const std::vector<KernelTensor *> &inputs,
+                                                      const std::vector<KernelTensor *> &outputs);
 
 // Deal with pytorch style axis iteration, to iterate every value on specific axis
 class AxisIterator {
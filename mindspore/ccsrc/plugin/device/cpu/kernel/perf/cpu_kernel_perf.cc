@@ -0,0 +1,30 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "plugin/device/cpu/kernel/perf/cpu_kernel_perf_run.h"
+
+namespace ms = mindspore;
+
+int main(int argc, char **argv) {
+  ms::kernel::CpuKernelPerfRun perf_run;
+  if (perf_run.ProcessArgs(argc, argv) != 0) {
+    return -1;
+  }
+  // The report goes to stdout if no output file is given, so print the settings to stderr.
+  std::cerr << perf_run << std::endl;
+  return perf_run.Run();
+}
@@ -0,0 +1,767 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/perf/cpu_kernel_perf_run.h"
+#include <getopt.h>
+#include <securec.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "abstract/abstract_value.h"
+#include "abstract/ops/primitive_infer_map.h"
+#include "base/bfloat16.h"
+#include "base/float16.h"
+#include "include/common/utils/utils.h"
+#include "ir/primitive.h"
+#include "ir/value.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "utils/convert_utils_base.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr int32_t kCaseOpt = 1000;  // there is no short option for case
+constexpr size_t kPerfBufferAlign = 64;
+constexpr size_t kActorQueueSize = 81920;
+constexpr double kPercentile90 = 0.9;
+constexpr double kGiga = 1e9;
+constexpr double kMicroSecondsPerSecond = 1e6;
+constexpr uint32_t kPerfSeed = 0;
+
+constexpr char kCaseOp[] = "op";
+constexpr char kCaseInputs[] = "inputs";
+constexpr char kCaseOutputs[] = "outputs";
+constexpr char kCaseAttrs[] = "attrs";
+constexpr char kCaseFlops[] = "flops";
+constexpr char kCaseFlopsPerOutput[] = "flops_per_output";
+constexpr char kSpecDtype[] = "dtype";
+constexpr char kSpecShape[] = "shape";
+constexpr char kSpecValue[] = "value";
+constexpr char kSpecRange[] = "range";
+
+using PerfBuffer = std::shared_ptr<void>;
+
+PerfBuffer AllocPerfBuffer(size_t size) {
+  void *ptr = nullptr;
+  // Keep the buffers aligned as the memory pool does, the vectorized kernels are sensitive to it.
+  if (posix_memalign(&ptr, kPerfBufferAlign, std::max(size, kPerfBufferAlign)) != 0) {
+    return nullptr;
+  }
+  return PerfBuffer(ptr, free);
+}
+
+size_t ElementNum(const ShapeVector &shape) {
+  size_t num = 1;
+  for (auto dim : shape) {
+    num *= LongToSize(dim);
+  }
+  return num;
+}
+
+template <typename T>
+void FillUniform(double low, double high, size_t num, void *data) {
+  std::mt19937 gen(kPerfSeed);
+  auto ptr = static_cast<T *>(data);
+  if constexpr (std::is_integral<T>::value) {
+    std::uniform_int_distribution<int64_t> dis(static_cast<int64_t>(std::ceil(low)),
+                                               static_cast<int64_t>(std::floor(high)));
+    for (size_t i = 0; i < num; ++i) {
+      ptr[i] = static_cast<T>(dis(gen));
+    }
+  } else {
+    std::uniform_real_distribution<double> dis(low, high);
+    for (size_t i = 0; i < num; ++i) {
+      ptr[i] = static_cast<T>(dis(gen));
+    }
+  }
+}
+
+void FillRandom(const PerfTensorSpec &spec, size_t size, void *data) {
+  auto num = ElementNum(spec.shape);
+  switch (spec.dtype) {
+    case kNumberTypeFloat16:
+      FillUniform<float16>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeBFloat16:
+      FillUniform<bfloat16>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeFloat32:
+      FillUniform<float>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeFloat64:
+      FillUniform<double>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeInt8:
+      FillUniform<int8_t>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeInt16:
+      FillUniform<int16_t>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeInt32:
+      FillUniform<int32_t>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeInt64:
+      FillUniform<int64_t>(spec.low, spec.high, num, data);
+      break;
+    case kNumberTypeUInt8:
+      FillUniform<uint8_t>(std::max(spec.low, 0.0), spec.high, num, data);
+      break;
+    case kNumberTypeUInt16:
+      FillUniform<uint16_t>(std::max(spec.low, 0.0), spec.high, num, data);
+      break;
+    case kNumberTypeUInt32:
+      FillUniform<uint32_t>(std::max(spec.low, 0.0), spec.high, num, data);
+      break;
+    case kNumberTypeUInt64:
+      FillUniform<uint64_t>(std::max(spec.low, 0.0), spec.high, num, data);
+      break;
+    case kNumberTypeBool:
+      FillUniform<bool>(0, 1, num, data);
+      break;
+    default:
+      (void)memset_s(data, size, 0, size);
+      break;
+  }
+}
+
+// Convert the value of a scalar or tuple input, and its data which the kernels read from the device pointer.
+ValuePtr MakeInputValue(const PerfTensorSpec &spec, std::vector<uint8_t> *bytes) {
+  auto append = [bytes](const auto &item) {
+    auto ptr = reinterpret_cast<const uint8_t *>(&item);
+    (void)bytes->insert(bytes->end(), ptr, ptr + sizeof(item));
+  };
+  const auto &value = spec.value;
+  if (value.is_boolean()) {
+    append(value.get<bool>());
+    return MakeValue(value.get<bool>());
+  }
+  if (value.is_number_integer()) {
+    append(value.get<int64_t>());
+    return MakeValue(value.get<int64_t>());
+  }
+  if (value.is_number_float()) {
+    append(value.get<float>());
+    return MakeValue(value.get<float>());
+  }
+  if (!value.is_array()) {
+    return nullptr;
+  }
+  if (std::all_of(value.begin(), value.end(), [](const nlohmann::json &item) { return item.is_number_integer(); })) {
+    auto items = value.get<std::vector<int64_t>>();
+    std::for_each(items.begin(), items.end(), append);
+    return MakeValue(items);
+  }
+  if (std::all_of(value.begin(), value.end(), [](const nlohmann::json &item) { return item.is_number(); })) {
+    auto items = value.get<std::vector<float>>();
+    std::for_each(items.begin(), items.end(), append);
+    return MakeValue(items);
+  }
+  return nullptr;
+}
+
+ValuePtr MakeAttrValue(const nlohmann::json &attr) {
+  if (attr.is_boolean()) {
+    return MakeValue(attr.get<bool>());
+  }
+  if (attr.is_number_integer()) {
+    return MakeValue(attr.get<int64_t>());
+  }
+  if (attr.is_number_float()) {
+    return MakeValue(attr.get<float>());
+  }
+  if (attr.is_string()) {
+    return MakeValue(attr.get<std::string>());
+  }
+  if (attr.is_array() &&
+      std::all_of(attr.begin(), attr.end(), [](const nlohmann::json &item) { return item.is_number_integer(); })) {
+    return MakeValue(attr.get<std::vector<int64_t>>());
+  }
+  if (attr.is_array() &&
+      std::all_of(attr.begin(), attr.end(), [](const nlohmann::json &item) { return item.is_number(); })) {
+    return MakeValue(attr.get<std::vector<float>>());
+  }
+  return nullptr;
+}
+
+nlohmann::json SpecToJson(const PerfTensorSpec &spec) {
+  nlohmann::json spec_json;
+  spec_json[kSpecDtype] = TypeIdToString(spec.dtype, true);
+  if (spec.value.is_null()) {
+    spec_json[kSpecShape] = spec.shape;
+  } else {
+    spec_json[kSpecValue] = spec.value;
+  }
+  return spec_json;
+}
+
+// Infer the outputs of the case by the registered infer of the primitive.
+bool InferOutputs(const PrimitivePtr &primitive, const std::vector<PerfTensorSpec> &inputs,
+                  const std::vector<ValuePtr> &input_values, std::vector<PerfTensorSpec> *outputs, std::string *error) {
+  AbstractBasePtrList input_abs;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (input_values[i] != nullptr) {
+      (void)input_abs.emplace_back(input_values[i]->ToAbstract());
+    } else {
+      (void)input_abs.emplace_back(
+        std::make_shared<abstract::AbstractTensor>(TypeIdToType(inputs[i].dtype), inputs[i].shape));
+    }
+  }
+  auto output_abs = abstract::TryInferAbstract(primitive, input_abs);
+  if (!output_abs.has_value() || output_abs.value() == nullptr) {
+    *error = "The outputs of " + primitive->name() + " can not be inferred, please give them in the case.";
+    return false;
+  }
+  AbstractBasePtrList elements{output_abs.value()};
+  if (output_abs.value()->isa<abstract::AbstractSequence>()) {
+    elements = output_abs.value()->cast<abstract::AbstractSequencePtr>()->elements();
+  }
+  for (const auto &element : elements) {
+    MS_EXCEPTION_IF_NULL(element);
+    PerfTensorSpec output;
+    output.shape = element->GetShape()->GetShapeVector();
+    auto type = element->GetType();
+    MS_EXCEPTION_IF_NULL(type);
+    auto tensor_type = type->cast<TensorTypePtr>();
+    output.dtype = (tensor_type != nullptr && tensor_type->element() != nullptr) ? tensor_type->element()->type_id()
+                                                                                  : type->type_id();
+    if (std::any_of(output.shape.begin(), output.shape.end(), [](int64_t dim) { return dim < 0; })) {
+      *error = "The output shape of " + primitive->name() + " is dynamic, please give the outputs in the case.";
+      return false;
+    }
+    outputs->push_back(output);
+  }
+  return true;
+}
+
+// The floating point operations of a launch, negative if unknown.
+double CaseFlops(const PerfCase &perf_case, const std::vector<PerfTensorSpec> &outputs) {
+  if (perf_case.flops >= 0) {
+    return perf_case.flops;
+  }
+  size_t output_num = 0;
+  for (const auto &output : outputs) {
+    output_num += ElementNum(output.shape);
+  }
+  if (perf_case.flops_per_output >= 0) {
+    return perf_case.flops_per_output * output_num;
+  }
+  // A multiply and an add for each element of the reduced dim.
+  const auto &op_name = perf_case.op_name;
+  if ((op_name == "MatMul" || op_name == "BatchMatMul") && !perf_case.inputs.empty() &&
+      perf_case.inputs[0].shape.size() >= kDim2) {
+    const auto &shape = perf_case.inputs[0].shape;
+    bool transpose_a = perf_case.attrs.is_object() && perf_case.attrs.value("transpose_a", false);
+    auto reduce_dim = transpose_a ? shape[shape.size() - kDim2] : shape.back();
+    return kDim2 * static_cast<double>(reduce_dim) * output_num;
+  }
+  return -1.0;
+}
+
+nlohmann::json LatencyToJson(std::vector<double> latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  nlohmann::json latency_json;
+  auto num = latencies.size();
+  latency_json["min"] = latencies.front();
+  latency_json["median"] = latencies[num / kDim2];
+  latency_json["mean"] = std::accumulate(latencies.begin(), latencies.end(), 0.0) / num;
+  latency_json["p90"] = latencies[std::min(num - 1, static_cast<size_t>(std::ceil(num * kPercentile90)) - 1)];
+  return latency_json;
+}
+}  // namespace
+
+// The measurement of a case at a kernel thread num.
+struct PerfMeasurement {
+  std::vector<PerfTensorSpec> outputs;
+  // The latency of each launch in microseconds.
+  std::vector<double> latencies;
+  // The bytes of the inputs and outputs of a launch.
+  size_t bytes{0};
+};
+
+void CpuKernelPerfRun::PrintHelp() const {
+  std::cout << "Options:\n"
+               "    -h,--help:           Show this usage message\n"
+               "    -c,--config:         The json file of the cases, which is a list of the case objects\n"
+               "       --case:           A case object in json, eg. '{\"op\":\"ReLU\",\"inputs\":[{\"dtype\":"
+               "\"float32\",\"shape\":[64,1024]}]}'\n"
+               "                         The keys of a case are op, inputs, outputs (inferred if not given), attrs,\n"
+               "                         flops or flops_per_output. The keys of an input are dtype, shape and range\n"
+               "                         of a tensor, or value of a scalar or tuple input, eg. {\"value\":[-1]}\n"
+               "    -t,--threads:        The kernel thread nums separated by comma. Default = the powers of 2 up "
+               "to the cores\n"
+               "    -w,--warmup:         Set the launch times before measuring. Default = "
+            << kDftPerfWarmup
+            << "\n"
+               "    -i,--iterations:     Set the measured launch times. Default = "
+            << kDftPerfIterations
+            << "\n"
+               "    -o,--output:         The json file of the report. Default = stdout\n";
+}
+
+bool CpuKernelPerfRun::ParseThreadNums(const std::string &thread_nums) {
+  thread_nums_.clear();
+  std::stringstream ss(thread_nums);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    auto thread_num = std::stoi(item);
+    if (thread_num <= 0) {
+      std::cerr << "Invalid thread num " << item << std::endl;
+      return false;
+    }
+    thread_nums_.push_back(IntToSize(thread_num));
+  }
+  return !thread_nums_.empty();
+}
+
+bool CpuKernelPerfRun::ParseTensorSpec(const nlohmann::json &spec_json, PerfTensorSpec *spec) const {
+  if (spec_json.contains(kSpecValue)) {
+    spec->value = spec_json.at(kSpecValue);
+  } else {
+    spec->shape = spec_json.at(kSpecShape).get<ShapeVector>();
+    if (std::any_of(spec->shape.begin(), spec->shape.end(), [](int64_t dim) { return dim < 0; })) {
+      std::cerr << "The shape " << spec_json.at(kSpecShape) << " is not static." << std::endl;
+      return false;
+    }
+  }
+  if (spec_json.contains(kSpecDtype)) {
+    auto type = StringToType(spec_json.at(kSpecDtype).get<std::string>());
+    if (type == nullptr || type->type_id() == kTypeUnknown) {
+      std::cerr << "Unknown dtype " << spec_json.at(kSpecDtype) << std::endl;
+      return false;
+    }
+    spec->dtype = type->type_id();
+  } else if (spec->value.is_null()) {
+    std::cerr << "The dtype of the tensor " << spec_json << " is missing." << std::endl;
+    return false;
+  }
+  if (spec_json.contains(kSpecRange)) {
+    const auto &range = spec_json.at(kSpecRange);
+    if (!range.is_array() || range.size() != kDim2 || range[0].get<double>() > range[1].get<double>()) {
+      std::cerr << "The range " << range << " should be [low, high]." << std::endl;
+      return false;
+    }
+    spec->low = range[0].get<double>();
+    spec->high = range[1].get<double>();
+  }
+  return true;
+}
+
+bool CpuKernelPerfRun::ParseCase(const nlohmann::json &case_json, PerfCase *perf_case) const {
+  perf_case->op_name = case_json.at(kCaseOp).get<std::string>();
+  for (const auto &spec_json : case_json.at(kCaseInputs)) {
+    PerfTensorSpec spec;
+    if (!ParseTensorSpec(spec_json, &spec)) {
+      return false;
+    }
+    perf_case->inputs.push_back(spec);
+  }
+  if (case_json.contains(kCaseOutputs)) {
+    for (const auto &spec_json : case_json.at(kCaseOutputs)) {
+      PerfTensorSpec spec;
+      if (!ParseTensorSpec(spec_json, &spec) || !spec.value.is_null()) {
+        std::cerr << "The output " << spec_json << " of " << perf_case->op_name << " should be a tensor." << std::endl;
+        return false;
+      }
+      perf_case->outputs.push_back(spec);
+    }
+  }
+  perf_case->attrs = case_json.value(kCaseAttrs, nlohmann::json::object());
+  perf_case->flops = case_json.value(kCaseFlops, -1.0);
+  perf_case->flops_per_output = case_json.value(kCaseFlopsPerOutput, -1.0);
+  return true;
+}
+
+bool CpuKernelPerfRun::AddCases(const nlohmann::json &cases_json) {
+  try {
+    if (!cases_json.is_array()) {
+      return AddCases(nlohmann::json::array({cases_json}));
+    }
+    for (const auto &case_json : cases_json) {
+      PerfCase perf_case;
+      if (!ParseCase(case_json, &perf_case)) {
+        return false;
+      }
+      cases_.push_back(perf_case);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Parse the cases failed: " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int32_t CpuKernelPerfRun::ProcessArgsHelper(int32_t opt) {
+  int32_t rc = 0;
+  try {
+    switch (opt) {
+      case 'c': {
+        std::ifstream ifs(optarg);
+        if (!ifs.is_open()) {
+          std::cerr << "Open the config file " << optarg << " failed." << std::endl;
+          rc = -1;
+          break;
+        }
+        nlohmann::json cases_json;
+        ifs >> cases_json;
+        rc = AddCases(cases_json) ? 0 : -1;
+        break;
+      }
+
+      case kCaseOpt: {
+        rc = AddCases(nlohmann::json::parse(optarg)) ? 0 : -1;
+        break;
+      }
+
+      case 't': {
+        rc = ParseThreadNums(optarg) ? 0 : -1;
+        break;
+      }
+
+      case 'w': {
+        warmup_ = std::stoi(optarg);
+        break;
+      }
+
+      case 'i': {
+        iterations_ = std::stoi(optarg);
+        break;
+      }
+
+      case 'o': {
+        output_file_ = optarg;
+        break;
+      }
+
+      case 'h':  // -h or --help
+        PrintHelp();
+        rc = -1;
+        break;
+
+      case ':':
+        std::cerr << "Missing argument for option " << char(optopt) << std::endl;
+        rc = -1;
+        break;
+
+      case '?':  // Unrecognized option
+      default:
+        std::cerr << "Unknown option " << char(optopt) << std::endl;
+        PrintHelp();
+        rc = -1;
+        break;
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    PrintHelp();
+    rc = -1;
+  }
+  return rc;
+}
+
+int32_t CpuKernelPerfRun::ProcessArgs(int argc, char **argv) {
+  const char *const short_opts = ":hc:t:w:i:o:";
+  const option long_opts[] = {{"help", no_argument, nullptr, 'h'},
+                              {"config", required_argument, nullptr, 'c'},
+                              {"case", required_argument, nullptr, kCaseOpt},
+                              {"threads", required_argument, nullptr, 't'},
+                              {"warmup", required_argument, nullptr, 'w'},
+                              {"iterations", required_argument, nullptr, 'i'},
+                              {"output", required_argument, nullptr, 'o'},
+                              {nullptr, no_argument, nullptr, 0}};
+  while (true) {
+    int32_t opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+    if (opt == -1) {
+      break;
+    }
+    auto rc = ProcessArgsHelper(opt);
+    if (rc != 0) {
+      return rc;
+    }
+  }
+  if (optind < argc) {
+    std::cerr << "Unknown arguments: " << argv[optind] << std::endl;
+    PrintHelp();
+    return -1;
+  }
+  if (cases_.empty()) {
+    std::cerr << "Missing the cases, please give --config or --case." << std::endl;
+    PrintHelp();
+    return -1;
+  }
+  if (warmup_ < 0 || iterations_ <= 0) {
+    std::cerr << "Invalid warmup " << warmup_ << " or iterations " << iterations_ << std::endl;
+    return -1;
+  }
+  if (thread_nums_.empty()) {
+    size_t core_num = std::max(std::thread::hardware_concurrency(), 1U);
+    for (size_t thread_num = 1; thread_num < core_num; thread_num <<= 1) {
+      thread_nums_.push_back(thread_num);
+    }
+    thread_nums_.push_back(core_num);
+  }
+  return 0;
+}
+
+std::ostream &operator<<(std::ostream &out, const CpuKernelPerfRun &perf_run) {
+  out << "Number of cases: " << perf_run.cases_.size() << "\nKernel thread nums:";
+  for (auto thread_num : perf_run.thread_nums_) {
+    out << " " << thread_num;
+  }
+  out << "\nWarmup: " << perf_run.warmup_ << "\nIterations: " << perf_run.iterations_;
+  return out;
+}
+
+bool CpuKernelPerfRun::Measure(const PerfCase &perf_case, size_t thread_num, PerfMeasurement *measurement,
+                               std::string *error) const {
+  auto kernel_mod = Factory<NativeCpuKernelMod>::Instance().Create(perf_case.op_name);
+  if (kernel_mod == nullptr) {
+    *error = "The cpu kernel " + perf_case.op_name + " is not registered.";
+    return false;
+  }
+  auto primitive = std::make_shared<Primitive>(perf_case.op_name);
+  for (const auto &attr : perf_case.attrs.items()) {
+    auto value = MakeAttrValue(attr.value());
+    if (value == nullptr) {
+      *error = "The attr " + attr.key() + " of " + perf_case.op_name + " is not supported.";
+      return false;
+    }
+    (void)primitive->AddAttr(attr.key(), value);
+  }
+
+  // The buffers are released after the kernel tensors which refer to them.
+  std::vector<PerfBuffer> buffers;
+  std::vector<KernelTensorPtr> inputs;
+  std::vector<ValuePtr> input_values;
+  size_t bytes = 0;
+  for (const auto &spec : perf_case.inputs) {
+    if (spec.value.is_null()) {
+      auto size = ElementNum(spec.shape) * UnitSizeInBytes(spec.dtype);
+      auto buffer = AllocPerfBuffer(size);
+      MS_EXCEPTION_IF_NULL(buffer);
+      FillRandom(spec, size, buffer.get());
+      (void)inputs.emplace_back(std::make_shared<KernelTensor>(
+        std::make_shared<abstract::TensorShape>(spec.shape), std::make_shared<TensorType>(TypeIdToType(spec.dtype)),
+        kValueAny, buffer.get(), size, kOpFormat_DEFAULT, spec.dtype, spec.shape, kCPUDevice, 0));
+      (void)input_values.emplace_back(nullptr);
+      (void)buffers.emplace_back(buffer);
+      bytes += size;
+      continue;
+    }
+    std::vector<uint8_t> value_bytes;
+    auto value = MakeInputValue(spec, &value_bytes);
+    if (value == nullptr) {
+      *error = "The value input " + spec.value.dump() + " of " + perf_case.op_name + " is not supported.";
+      return false;
+    }
+    auto buffer = AllocPerfBuffer(value_bytes.size());
+    MS_EXCEPTION_IF_NULL(buffer);
+    if (!value_bytes.empty() &&
+        memcpy_s(buffer.get(), value_bytes.size(), value_bytes.data(), value_bytes.size()) != EOK) {
+      *error = "Copy the value input of " + perf_case.op_name + " failed.";
+      return false;
+    }
+    auto abs = value->ToAbstract();
+    auto dtype = spec.dtype;
+    ShapeVector host_shape;
+    if (value->isa<ValueSequence>()) {
+      auto elements = value->cast<ValueSequencePtr>()->value();
+      dtype = elements.empty() ? kNumberTypeInt64 : elements[0]->type()->type_id();
+      host_shape.push_back(SizeToLong(elements.size()));
+    } else if (dtype == kTypeUnknown) {
+      dtype = value->type()->type_id();
+    }
+    (void)inputs.emplace_back(std::make_shared<KernelTensor>(abs->GetShape(), abs->GetType(), value, buffer.get(),
+                                                             value_bytes.size(), kOpFormat_DEFAULT, dtype,
+                                                             host_shape, kCPUDevice, 0));
+    (void)input_values.emplace_back(value);
+    (void)buffers.emplace_back(buffer);
+  }
+
+  auto &outputs_spec = measurement->outputs;
+  outputs_spec = perf_case.outputs;
+  if (outputs_spec.empty() && !InferOutputs(primitive, perf_case.inputs, input_values, &outputs_spec, error)) {
+    return false;
+  }
+  std::vector<KernelTensorPtr> outputs;
+  for (const auto &spec : outputs_spec) {
+    (void)outputs.emplace_back(std::make_shared<KernelTensor>(
+      std::make_shared<abstract::TensorShape>(spec.shape), std::make_shared<TensorType>(TypeIdToType(spec.dtype)),
+      kValueAny, nullptr, 0, kOpFormat_DEFAULT, spec.dtype, spec.shape, kCPUDevice, 0));
+  }
+  std::vector<KernelTensor *> input_ptrs;
+  std::vector<KernelTensor *> output_ptrs;
+  (void)std::transform(inputs.begin(), inputs.end(), std::back_inserter(input_ptrs),
+                       [](const KernelTensorPtr &tensor) { return tensor.get(); });
+  (void)std::transform(outputs.begin(), outputs.end(), std::back_inserter(output_ptrs),
+                       [](const KernelTensorPtr &tensor) { return tensor.get(); });
+
+  // The kernel thread num includes the actor thread, as GetKernelThreadNum counts in ParallelLaunch.
+  auto thread_pool = GetActorMgrInnerThreadPool();
+  thread_pool->SetKernelThreadNum(thread_num - thread_pool->GetActorThreadNum());
+  kernel_mod->SetThreadPool(thread_pool);
+  if (!kernel_mod->Init(primitive, input_ptrs, output_ptrs)) {
+    *error = "Init the cpu kernel " + perf_case.op_name + " failed.";
+    return false;
+  }
+  kernel_mod->parallel_search_info_.tuning_signature =
+    GetParallelTuningSignature(perf_case.op_name, input_ptrs, output_ptrs);
+  if (kernel_mod->Resize(input_ptrs, output_ptrs) != KRET_OK) {
+    *error = "Resize the cpu kernel " + perf_case.op_name + " failed.";
+    return false;
+  }
+
+  const auto &output_sizes = kernel_mod->GetOutputSizeList();
+  for (size_t i = 0; i < outputs.size() && i < output_sizes.size(); ++i) {
+    auto buffer = AllocPerfBuffer(output_sizes[i]);
+    MS_EXCEPTION_IF_NULL(buffer);
+    outputs[i]->set_device_ptr(buffer.get());
+    outputs[i]->set_size(output_sizes[i]);
+    (void)buffers.emplace_back(buffer);
+    bytes += output_sizes[i];
+  }
+  std::vector<KernelTensorPtr> workspaces;
+  std::vector<KernelTensor *> workspace_ptrs;
+  for (auto size : kernel_mod->GetWorkspaceSizeList()) {
+    auto buffer = AllocPerfBuffer(size);
+    MS_EXCEPTION_IF_NULL(buffer);
+    auto workspace = std::make_shared<KernelTensor>(buffer.get(), size, Format::DEFAULT_FORMAT, kTypeUnknown,
+                                                    ShapeVector(), kCPUDevice, 0);
+    (void)buffers.emplace_back(buffer);
+    (void)workspace_ptrs.emplace_back(workspace.get());
+    (void)workspaces.emplace_back(workspace);
+  }
+
+  // The warmup also covers the parallel grain search of the kernels which launch by ParallelLaunchAutoSearch.
+  for (int32_t i = 0; i < warmup_; ++i) {
+    if (!kernel_mod->Launch(input_ptrs, workspace_ptrs, output_ptrs, nullptr)) {
+      *error = "Launch the cpu kernel " + perf_case.op_name + " failed.";
+      return false;
+    }
+  }
+  measurement->latencies.clear();
+  for (int32_t i = 0; i < iterations_; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    if (!kernel_mod->Launch(input_ptrs, workspace_ptrs, output_ptrs, nullptr)) {
+      *error = "Launch the cpu kernel " + perf_case.op_name + " failed.";
+      return false;
+    }
+    auto end = std::chrono::steady_clock::now();
+    measurement->latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  measurement->bytes = bytes;
+  return true;
+}
+
+nlohmann::json CpuKernelPerfRun::RunCase(const PerfCase &perf_case) const {
+  nlohmann::json case_json;
+  case_json[kCaseOp] = perf_case.op_name;
+  case_json[kCaseInputs] = nlohmann::json::array();
+  for (const auto &spec : perf_case.inputs) {
+    case_json[kCaseInputs].push_back(SpecToJson(spec));
+  }
+  if (!perf_case.attrs.empty()) {
+    case_json[kCaseAttrs] = perf_case.attrs;
+  }
+
+  nlohmann::json results = nlohmann::json::array();
+  double base_latency = 0;
+  for (auto thread_num : thread_nums_) {
+    PerfMeasurement measurement;
+    std::string error;
+    bool ret = false;
+    try {
+      ret = Measure(perf_case, thread_num, &measurement, &error);
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+    if (!ret) {
+      case_json["error"] = error;
+      break;
+    }
+    if (!case_json.contains(kCaseOutputs)) {
+      case_json[kCaseOutputs] = nlohmann::json::array();
+      for (const auto &spec : measurement.outputs) {
+        case_json[kCaseOutputs].push_back(SpecToJson(spec));
+      }
+    }
+
+    nlohmann::json result;
+    result["threads"] = thread_num;
+    result["latency_us"] = LatencyToJson(measurement.latencies);
+    double median = result["latency_us"]["median"].get<double>();
+    double seconds = std::max(median, std::numeric_limits<double>::min()) / kMicroSecondsPerSecond;
+    auto flops = CaseFlops(perf_case, measurement.outputs);
+    result["gflops"] = flops >= 0 ? nlohmann::json(flops / seconds / kGiga) : nlohmann::json(nullptr);
+    result["gbps"] = measurement.bytes / seconds / kGiga;
+    // The scaling is relative to the first thread num, which is 1 by default.
+    if (results.empty()) {
+      base_latency = median;
+    }
+    double speedup = base_latency / std::max(median, std::numeric_limits<double>::min());
+    result["speedup"] = speedup;
+    result["efficiency"] = speedup * thread_nums_.front() / thread_num;
+    results.push_back(result);
+  }
+  case_json["results"] = results;
+  return case_json;
+}
+
+int32_t CpuKernelPerfRun::Run() {
+  // The actor thread pool reserves the most kernel threads, each measurement lowers the kernel thread num in use.
+  auto max_thread_num = *std::max_element(thread_nums_.begin(), thread_nums_.end());
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_manager);
+  if (actor_manager->Initialize(true, 1, max_thread_num + 1, kActorQueueSize) != MINDRT_OK) {
+    std::cerr << "Initialize the actor thread pool failed." << std::endl;
+    return -1;
+  }
+
+  nlohmann::json report;
+  report["hardware_concurrency"] = std::thread::hardware_concurrency();
+  report["warmup"] = warmup_;
+  report["iterations"] = iterations_;
+  report["cases"] = nlohmann::json::array();
+  int32_t rc = 0;
+  for (const auto &perf_case : cases_) {
+    auto case_json = RunCase(perf_case);
+    if (case_json.contains("error")) {
+      std::cerr << "Run the case of " << perf_case.op_name << " failed: " << case_json["error"] << std::endl;
+      rc = -1;
+    }
+    report["cases"].push_back(case_json);
+  }
+
+  if (output_file_.empty()) {
+    std::cout << report.dump(1) << std::endl;
+    return rc;
+  }
+  std::ofstream ofs(output_file_);
+  if (!ofs.is_open()) {
+    std::cerr << "Open the output file " << output_file_ << " failed." << std::endl;
+    return -1;
+  }
+  ofs << report.dump(1) << std::endl;
+  return rc;
+}
+}  // namespace kernel
+}  // namespace mindspore
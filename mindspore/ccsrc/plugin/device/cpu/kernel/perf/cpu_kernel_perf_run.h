@@ -0,0 +1,91 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PERF_CPU_KERNEL_PERF_RUN_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PERF_CPU_KERNEL_PERF_RUN_H_
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "ir/dtype/type_id.h"
+#include "mindapi/base/shape_vector.h"
+
+namespace mindspore {
+namespace kernel {
+constexpr int32_t kDftPerfWarmup = 10;
+constexpr int32_t kDftPerfIterations = 100;
+
+// An input or output of a benchmark case. The tensors are filled with random data in the range, the scalar and tuple
+// inputs, eg. the axis of the ops in the new primitive style, carry their value.
+struct PerfTensorSpec {
+  TypeId dtype{kTypeUnknown};
+  ShapeVector shape;
+  nlohmann::json value;
+  double low{-1.0};
+  double high{1.0};
+};
+
+// One kernel at the given inputs, the outputs are inferred from the primitive if they are not given.
+struct PerfCase {
+  std::string op_name;
+  std::vector<PerfTensorSpec> inputs;
+  std::vector<PerfTensorSpec> outputs;
+  nlohmann::json attrs;
+  // The floating point operations of a launch, or of an output element, negative if unknown.
+  double flops{-1.0};
+  double flops_per_output{-1.0};
+};
+
+struct PerfMeasurement;
+
+/*
+ * The CpuKernelPerfRun creates the cpu kernels registered in the kernel factory without a graph, launches them with
+ * synthetic inputs at each kernel thread num, and reports the latency, GFLOP/s, GB/s and thread scaling in json.
+ */
+class CpuKernelPerfRun {
+ public:
+  CpuKernelPerfRun() = default;
+  ~CpuKernelPerfRun() = default;
+
+  void PrintHelp() const;
+  int32_t ProcessArgs(int argc, char **argv);
+  int32_t Run();
+
+  friend std::ostream &operator<<(std::ostream &out, const CpuKernelPerfRun &perf_run);
+
+ private:
+  int32_t ProcessArgsHelper(int32_t opt);
+  bool ParseThreadNums(const std::string &thread_nums);
+  bool AddCases(const nlohmann::json &cases_json);
+  bool ParseCase(const nlohmann::json &case_json, PerfCase *perf_case) const;
+  bool ParseTensorSpec(const nlohmann::json &spec_json, PerfTensorSpec *spec) const;
+
+  nlohmann::json RunCase(const PerfCase &perf_case) const;
+  // Launch a new kernel instance of the case with thread_num kernel threads and record the latency of each launch.
+  bool Measure(const PerfCase &perf_case, size_t thread_num, PerfMeasurement *measurement, std::string *error) const;
+
+  std::vector<PerfCase> cases_;
+  std::vector<size_t> thread_nums_;
+  int32_t warmup_{kDftPerfWarmup};
+  int32_t iterations_{kDftPerfIterations};
+  std::string output_file_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PERF_CPU_KERNEL_PERF_RUN_H_
@@ -15,7 +15,7 @@ if (kernel_attr_pair.first || op_name() == "Cast") {
 
   // Async
   PyBoostUtils::DispatchRun(
-  std::make_shared<runtime::PyBoostDeviceTask>([this, op, ${call_args_with_tensor}]() {
+  runtime::MakePooledTask<runtime::PyBoostDeviceTask>([this, op, ${call_args_with_tensor}]() {
     auto device_context = op->device_context();
     const auto &outputs = op->outputs();
 
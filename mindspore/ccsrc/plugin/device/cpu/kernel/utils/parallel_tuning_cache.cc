@@ -0,0 +1,191 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/utils/parallel_tuning_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include "nlohmann/json.hpp"
+#include "include/common/debug/common.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr char kTuningEntries[] = "entries";
+constexpr char kTuningSignature[] = "signature";
+constexpr char kTuningCountBucket[] = "count_bucket";
+constexpr char kTuningThreadNum[] = "thread_num";
+constexpr char kTuningBestPow[] = "best_pow";
+constexpr char kTuningCostTime[] = "cost_time";
+}  // namespace
+
+ParallelTuningCache &ParallelTuningCache::GetInstance() {
+  static ParallelTuningCache instance;
+  return instance;
+}
+
+ParallelTuningCache::ParallelTuningCache() : cache_file_(common::GetEnv(kEnvParallelTuningCache)) { Load(); }
+
+size_t ParallelTuningCache::CountBucket(size_t count) {
+  size_t bucket = 0;
+  while (count > 1) {
+    count >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::string ParallelTuningCache::MakeKey(const std::string &signature, size_t count_bucket, size_t thread_num) {
+  return signature + "|" + std::to_string(count_bucket) + "|" + std::to_string(thread_num);
+}
+
+bool ParallelTuningCache::Find(const std::string &signature, size_t count_bucket, size_t thread_num,
+                               size_t *best_pow) {
+  MS_EXCEPTION_IF_NULL(best_pow);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(MakeKey(signature, count_bucket, thread_num));
+  if (iter == entries_.end()) {
+    return false;
+  }
+  *best_pow = iter->second.best_pow;
+  ++iter->second.reuse_count;
+  return true;
+}
+
+void ParallelTuningCache::Update(const std::string &signature, size_t count_bucket, size_t thread_num,
+                                 size_t best_pow, double cost_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &entry = entries_[MakeKey(signature, count_bucket, thread_num)];
+  // Another instance may finish the search of the same key meanwhile, keep the faster one.
+  if (entry.signature.empty() || cost_time < entry.cost_time) {
+    entry.signature = signature;
+    entry.count_bucket = count_bucket;
+    entry.thread_num = thread_num;
+    entry.best_pow = best_pow;
+    entry.cost_time = cost_time;
+    updated_ = true;
+  }
+}
+
+void ParallelTuningCache::Load() {
+  if (cache_file_.empty()) {
+    return;
+  }
+  std::ifstream ifs(cache_file_);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "The parallel tuning cache file " << cache_file_ << " does not exist, it will be created.";
+    return;
+  }
+  try {
+    nlohmann::json cache_json;
+    ifs >> cache_json;
+    for (const auto &item : cache_json.at(kTuningEntries)) {
+      ParallelTuningEntry entry;
+      entry.signature = item.at(kTuningSignature).get<std::string>();
+      entry.count_bucket = item.at(kTuningCountBucket).get<size_t>();
+      entry.thread_num = item.at(kTuningThreadNum).get<size_t>();
+      entry.best_pow = item.at(kTuningBestPow).get<size_t>();
+      entry.cost_time = item.at(kTuningCostTime).get<double>();
+      entries_[MakeKey(entry.signature, entry.count_bucket, entry.thread_num)] = entry;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the parallel tuning cache file " << cache_file_ << " failed, ignore it: " << e.what();
+    entries_.clear();
+    return;
+  }
+  MS_LOG(INFO) << "Load " << entries_.size() << " entries from the parallel tuning cache file " << cache_file_;
+}
+
+bool ParallelTuningCache::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cache_file_.empty() || !updated_) {
+    return true;
+  }
+  auto real_path = Common::CreatePrefixPath(cache_file_, true);
+  if (!real_path.has_value()) {
+    MS_LOG(WARNING) << "Get the real path of the parallel tuning cache file " << cache_file_ << " failed.";
+    return false;
+  }
+
+  nlohmann::json cache_json;
+  cache_json[kTuningEntries] = nlohmann::json::array();
+  for (const auto &item : entries_) {
+    const auto &entry = item.second;
+    nlohmann::json entry_json;
+    entry_json[kTuningSignature] = entry.signature;
+    entry_json[kTuningCountBucket] = entry.count_bucket;
+    entry_json[kTuningThreadNum] = entry.thread_num;
+    entry_json[kTuningBestPow] = entry.best_pow;
+    entry_json[kTuningCostTime] = entry.cost_time;
+    cache_json[kTuningEntries].push_back(entry_json);
+  }
+
+  // Write a temporary file and rename it, the jobs sharing the cache file never read a partial one.
+  std::string tmp_file = real_path.value() + ".tmp" + Common::GetRandomStr();
+  std::ofstream ofs(tmp_file);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open the parallel tuning cache file " << tmp_file << " failed.";
+    return false;
+  }
+  ofs << cache_json.dump(1);
+  ofs.close();
+  ChangeFileMode(tmp_file, S_IRUSR | S_IWUSR);
+  if (std::rename(tmp_file.c_str(), real_path.value().c_str()) != 0) {
+    MS_LOG(WARNING) << "Save the parallel tuning cache file " << real_path.value() << " failed, errno: " << errno;
+    (void)std::remove(tmp_file.c_str());
+    return false;
+  }
+  updated_ = false;
+  MS_LOG(INFO) << "Save " << entries_.size() << " entries to the parallel tuning cache file " << real_path.value();
+  return true;
+}
+
+bool ParallelTuningCache::Dump(const std::string &file_path) {
+  auto entries = GetEntries();
+  if (entries.empty()) {
+    return true;
+  }
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return false;
+  }
+  ofs << "signature,count_bucket,thread_num,best_thread_num,cost_time(s),reuse_count" << std::endl;
+  for (const auto &entry : entries) {
+    ofs << entry.signature << "," << entry.count_bucket << "," << entry.thread_num << ","
+        << std::min(static_cast<size_t>(1) << entry.best_pow, entry.thread_num) << "," << entry.cost_time << ","
+        << entry.reuse_count << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path, S_IRUSR | S_IWUSR);
+  return true;
+}
+
+std::vector<ParallelTuningEntry> ParallelTuningCache::GetEntries() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<ParallelTuningEntry> entries;
+  entries.reserve(entries_.size());
+  for (const auto &item : entries_) {
+    entries.push_back(item.second);
+  }
+  return entries;
+}
+}  // namespace kernel
+}  // namespace mindspore
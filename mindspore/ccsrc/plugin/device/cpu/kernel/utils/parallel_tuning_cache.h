@@ -0,0 +1,83 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_PARALLEL_TUNING_CACHE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_PARALLEL_TUNING_CACHE_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace kernel {
+// The json file which the tuning results are loaded from at startup and saved to at exit, no persistence if not set.
+constexpr char kEnvParallelTuningCache[] = "MS_CPU_PARALLEL_TUNING_CACHE";
+
+// The best parallelism found by ParallelLaunchAutoSearch for a kernel signature.
+struct ParallelTuningEntry {
+  // The kernel name and the data types of the inputs and outputs.
+  std::string signature;
+  // The floor of log2 of the parallel count, the counts in a bucket share the best parallelism.
+  size_t count_bucket{0};
+  size_t thread_num{0};
+  // The count is split into 2^best_pow blocks.
+  size_t best_pow{0};
+  // The average cost time in seconds of the best parallelism when it is searched.
+  double cost_time{0};
+  // The number of the kernel instances which take the entry instead of searching.
+  size_t reuse_count{0};
+};
+
+// The process wide cache of the parallel grain tuning results, keyed by (signature, count bucket, thread num), so the
+// kernel instances with the same signature search once, and the repeated jobs start with the tuned parallelism.
+class BACKEND_EXPORT ParallelTuningCache {
+ public:
+  static ParallelTuningCache &GetInstance();
+
+  static size_t CountBucket(size_t count);
+
+  // Find the best pow of the key, return false if it has not been searched.
+  bool Find(const std::string &signature, size_t count_bucket, size_t thread_num, size_t *best_pow);
+  // Record the result of a finished search.
+  void Update(const std::string &signature, size_t count_bucket, size_t thread_num, size_t best_pow, double cost_time);
+
+  // Save the cache to the file in the env kEnvParallelTuningCache if it has been updated.
+  bool Save();
+  // Write the entries in csv format for the profiler.
+  bool Dump(const std::string &file_path);
+
+  std::vector<ParallelTuningEntry> GetEntries();
+
+ private:
+  ParallelTuningCache();
+  ~ParallelTuningCache() = default;
+  ParallelTuningCache(const ParallelTuningCache &) = delete;
+  ParallelTuningCache &operator=(const ParallelTuningCache &) = delete;
+
+  static std::string MakeKey(const std::string &signature, size_t count_bucket, size_t thread_num);
+  void Load();
+
+  std::mutex mutex_;
+  std::map<std::string, ParallelTuningEntry> entries_;
+  std::string cache_file_;
+  bool updated_{false};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_UTILS_PARALLEL_TUNING_CACHE_H_
@@ -12,7 +12,7 @@ PyBoostUtils::PrepareOpOutputs(device_context_, op->stream_id(), outputs_);
 
 // Async
 PyBoostUtils::DispatchRun(
-std::make_shared<runtime::PyBoostDeviceTask>([this, op, ${call_args_with_tensor}]() {
+runtime::MakePooledTask<runtime::PyBoostDeviceTask>([this, op, ${call_args_with_tensor}]() {
   auto device_context = op->device_context();
   const auto &outputs = op->outputs();
 
@@ -88,6 +88,7 @@ using distributed::recovery::RecoveryContext;
 namespace {
 constexpr char kNumaEnableEnv[] = "MS_ENABLE_NUMA";
 constexpr char kNumaEnableEnv2[] = "DATASET_ENABLE_NUMA";
+constexpr char kActorWorkStealingEnv[] = "MS_DEV_ACTOR_WORK_STEALING";
 
 // For the transform state synchronization.
 constexpr char kTransformFinishPrefix[] = "TRANSFORM_FINISH_";
@@ -452,8 +453,11 @@ void GraphScheduler::Initialize() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   size_t actor_queue_size = 81920;
-  auto ret =
-    actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size, numa_cpus_);
+  // Graphs of many small kernel actors contend on the shared actor queue, the work stealing mode spreads them.
+  auto queue_mode = common::GetEnv(kActorWorkStealingEnv) == "1" ? ActorQueueMode::kWorkStealing
+                                                                 : ActorQueueMode::kSharedQueue;
+  auto ret = actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size,
+                                       numa_cpus_, queue_mode);
   if (ret != MINDRT_OK) {
     MS_LOG(INTERNAL_EXCEPTION) << "#dmsg#Runtime error info:#dmsg#Actor manager init failed.";
   }
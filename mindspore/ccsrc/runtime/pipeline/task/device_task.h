@@ -23,6 +23,7 @@
 #include <future>
 
 #include "runtime/pipeline/task/task.h"
+#include "runtime/pipeline/task/task_pool.h"
 #include "backend/common/session/session_basic.h"
 #include "runtime/pynative/op_compiler.h"
 
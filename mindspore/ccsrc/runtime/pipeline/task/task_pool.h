@@ -0,0 +1,152 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PIPELINE_TASK_TASK_POOL_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PIPELINE_TASK_TASK_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include "mindrt/include/async/spinlock.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+// Twice the capacity of the async queue, so that the tasks in flight of a full queue are all recycled.
+constexpr size_t kMaxPooledTaskNum = 2048;
+
+/*
+ * A free list of the fixed size blocks. The tasks are created by the python thread and destroyed by the worker
+ * thread, so the list is guarded by a spin lock, which is held for a few instructions only.
+ */
+class TaskBlockPool {
+ public:
+  explicit TaskBlockPool(size_t block_size) : block_size_(std::max(block_size, sizeof(FreeBlock))) {}
+  ~TaskBlockPool() {
+    while (free_list_ != nullptr) {
+      auto next = free_list_->next;
+      ::operator delete(free_list_);
+      free_list_ = next;
+    }
+  }
+
+  void *Allocate() {
+    {
+      std::lock_guard<SpinLock> lock(lock_);
+      if (free_list_ != nullptr) {
+        auto block = free_list_;
+        free_list_ = block->next;
+        --free_num_;
+        return block;
+      }
+    }
+    return ::operator new(block_size_);
+  }
+
+  void Free(void *ptr) {
+    {
+      std::lock_guard<SpinLock> lock(lock_);
+      if (free_num_ < kMaxPooledTaskNum) {
+        auto block = static_cast<FreeBlock *>(ptr);
+        block->next = free_list_;
+        free_list_ = block;
+        ++free_num_;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+  size_t free_num() const {
+    std::lock_guard<SpinLock> lock(lock_);
+    return free_num_;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  size_t block_size_;
+  FreeBlock *free_list_{nullptr};
+  size_t free_num_{0};
+  mutable SpinLock lock_;
+};
+
+// The allocator of std::allocate_shared, the task and its control block are one block recycled by the pool of the
+// rebound type, so the steady state of the dispatch does not call the heap allocator for the task.
+template <typename T>
+class PooledTaskAllocator {
+ public:
+  using value_type = T;
+  static_assert(alignof(T) <= alignof(std::max_align_t), "The over aligned task can not be pooled.");
+
+  PooledTaskAllocator() = default;
+  template <typename U>
+  explicit PooledTaskAllocator(const PooledTaskAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T *>(Pool().Allocate());
+  }
+
+  void deallocate(T *ptr, size_t n) {
+    if (n != 1) {
+      ::operator delete(ptr);
+      return;
+    }
+    Pool().Free(ptr);
+  }
+
+  // The pool is never destroyed, as the worker threads may release the tasks during the exit.
+  static TaskBlockPool &Pool() {
+    static auto *pool = new TaskBlockPool(sizeof(T));
+    return *pool;
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PooledTaskAllocator<T> &, const PooledTaskAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PooledTaskAllocator<T> &, const PooledTaskAllocator<U> &) {
+  return false;
+}
+
+// MS_DEV_DISABLE_TASK_POOL=1 creates the tasks on the heap, the baseline of the dispatch benchmark.
+inline bool IsTaskPoolDisabled() {
+  static const bool disabled = common::GetEnv("MS_DEV_DISABLE_TASK_POOL") == "1";
+  return disabled;
+}
+
+// Create the task, or the context shared by the tasks, which is created for every op.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooledTask(Args &&... args) {
+  if (IsTaskPoolDisabled()) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(PooledTaskAllocator<T>(), std::forward<Args>(args)...);
+}
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PIPELINE_TASK_TASK_POOL_H_
@@ -523,6 +523,8 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool
   }
   for (auto &fg : dropped) {
     MS_EXCEPTION_IF_NULL(fg);
+    // The analyses keep the results of each graph, drop them with the graph so that it can be freed.
+    InvalidateFuncGraph(fg);
     all_nodes_.difference_update(fg->parameters());
     EraseOneGraph(fg);
     if (fg->manager().get() == this) {
@@ -812,7 +814,7 @@ void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfN
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateFuncGraph(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -829,7 +831,7 @@ void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfN
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
@@ -842,7 +844,7 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        InvalidateFuncGraph(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -851,11 +853,35 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
 
+void FuncGraphManager::InvalidateFuncGraph(const FuncGraphPtr &fg) {
+  MS_EXCEPTION_IF_NULL(fg);
+  // The total analyses of a graph only depend on the graphs it uses directly or indirectly, so only the users of fg
+  // are affected, the results of the other graphs are kept for the following queries.
+  FuncGraphSet users;
+  users.add(fg);
+  std::vector<FuncGraphPtr> todo = {fg};
+  while (!todo.empty()) {
+    auto cur = todo.back();
+    todo.pop_back();
+    for (const auto &item : cur->func_graph_cnodes_index()) {
+      MS_EXCEPTION_IF_NULL(item.first);
+      const auto &user_node = item.first->first;
+      auto user = user_node == nullptr ? nullptr : user_node->func_graph();
+      if (user == nullptr || users.contains(user)) {
+        continue;
+      }
+      users.add(user);
+      todo.push_back(user);
+    }
+  }
+  signals_->InvalidateFuncGraphs(users);
+}
+
 void FuncGraphManager::MoveAllNodes(const FuncGraphPtr &source, const FuncGraphPtr &target) {
   target->CopyNodes(source);
   target->CopyValueNodes(source);
@@ -980,6 +1006,7 @@ void FuncGraphTransaction::Commit() { manager_->CommitChanges(std::move(changes_
 DepComputer::DepComputer(const FuncGraphManager *const manager) : manager_(manager), validate_(false) {
   MS_EXCEPTION_IF_NULL(manager_);
   manager_->signals()->InvalidateComputer.connect(this, &DepComputer::OnInvalidateComputer);
+  manager_->signals()->InvalidateFuncGraphs.connect(this, &DepComputer::OnInvalidateFuncGraphs);
 }
 
 void DepComputer::Recompute() {
@@ -76,6 +76,8 @@ MS_CORE_API FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &fun
 
 struct Signals {
   Signal<void()> InvalidateComputer;
+  // Invalidate the analyses of the func graphs only, emitted with an edited func graph and all of its users.
+  Signal<void(const FuncGraphSet &)> InvalidateFuncGraphs;
 };
 
 using CNodeIndexPair = std::pair<AnfNodePtr, int>;
@@ -115,6 +117,16 @@ class DepComputer {
 
   void OnInvalidateComputer() { Reset(); }
 
+  void OnInvalidateFuncGraphs(const FuncGraphSet &func_graphs) {
+    if (!ExtraInvalidate(func_graphs)) {
+      Reset();
+      return;
+    }
+    for (const auto &fg : func_graphs) {
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -126,6 +138,9 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass whose result of a graph only depends on the graphs it uses can drop the results of the func graphs only,
+  // return false to reset all;
+  virtual bool ExtraInvalidate(const FuncGraphSet &) { return false; }
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -153,6 +168,13 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
 
+  bool ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    for (const auto &fg : func_graphs) {
+      (void)func_graph_parents_total_analysis_.erase(fg);
+    }
+    return true;
+  }
+
   void RealRecompute(FuncGraphPtr fg) override;
 
  private:
@@ -248,6 +270,13 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
 
+  bool ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    for (const auto &fg : func_graphs) {
+      (void)func_graph_used_total_analysis_.erase(fg);
+    }
+    return true;
+  }
+
   void RealRecompute(FuncGraphPtr fg) override;
 };
 
@@ -275,6 +304,15 @@ class RecursiveComputer final : public DepComputer {
     recursive_map_.clear();
   }
 
+  // The graphs in a recursion use each other, so they are all invalidated together.
+  bool ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    for (const auto &fg : func_graphs) {
+      (void)recursive_analysis_.erase(fg);
+      (void)recursive_map_.erase(fg);
+    }
+    return true;
+  }
+
   void RealRecompute(FuncGraphPtr fg) override;
 };
 
@@ -292,6 +330,13 @@ class FuncGraphMetaFgPrimTotalComputer final : public DepComputer {
  protected:
   void ExtraReset() override { meta_fg_prim_total_analysis_.clear(); }
 
+  bool ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    for (const auto &fg : func_graphs) {
+      (void)meta_fg_prim_total_analysis_.erase(fg);
+    }
+    return true;
+  }
+
   void RealRecompute(FuncGraphPtr fg) override;
 
   bool SeekMetaFgPrim(const FuncGraphPtr &fg, SeenNum seen_num);
@@ -373,6 +418,9 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   FuncGraphSet MaybeDropNodes(std::vector<AnfNodePtr> &&nodes);
   void OnEdgeAdded(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void OnEdgeRemoved(const AnfNodePtr &node, int index, const AnfNodePtr &input);
+  // Invalidate the analyses of fg and the func graphs using it directly or indirectly, after the free variables or
+  // the used func graphs of fg changed.
+  void InvalidateFuncGraph(const FuncGraphPtr &fg);
   void MoveAllNodes(const FuncGraphPtr &source, const FuncGraphPtr &target);
 
   std::deque<FuncGraphPtr> todo_;
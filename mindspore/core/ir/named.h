@@ -51,7 +51,10 @@ class MS_CORE_API Named : public Value {
   ///
   /// \param[in] name The name set for the object.
   /// \no return.
-  void set_name(const std::string &name) { name_ = name; }
+  void set_name(const std::string &name) {
+    name_ = name;
+    hash_id_ = std::hash<std::string>{}(name_);
+  }
   /// \brief Check whether two Named objects are the same.
   ///
   /// \param[in] other The other Named to be compared with.
@@ -73,8 +76,8 @@ class MS_CORE_API Named : public Value {
   /// \brief Get hash id for named.
   ///
   /// \return The restored hash id of Named.
-  std::size_t Hash() const { return std::hash<std::string>{}(name_); }
-  std::size_t hash() const override { return std::hash<std::string>{}(name_); }
+  std::size_t Hash() const { return hash_id_; }
+  std::size_t hash() const override { return hash_id_; }
   /// \brief Overloads operator << for Named.
   ///
   /// \param os The output stream.
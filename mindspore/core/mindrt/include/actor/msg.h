@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -24,6 +25,17 @@
 
 namespace mindspore {
 class ActorBase;
+class MessageBase;
+
+// The link of a message in the intrusive queue of a mailbox. A copied message is not in any queue, so the link is not
+// copied.
+struct MailBoxLink {
+  MailBoxLink() = default;
+  MailBoxLink(const MailBoxLink &) {}
+  MailBoxLink &operator=(const MailBoxLink &) { return *this; }
+  std::atomic<MessageBase *> next{nullptr};
+};
+
 class MessageBase {
  public:
   enum class Type : char {
@@ -88,6 +100,9 @@ class MessageBase {
 
   // The id of remote function to call.
   uint32_t func_id_;
+
+  // Used by LockFreeMailBox, so that enqueueing a message needs no allocation.
+  MailBoxLink link_;
 };
 }  // namespace mindspore
 
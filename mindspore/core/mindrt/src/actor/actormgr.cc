@@ -22,8 +22,18 @@
 
 #include "actor/actormgr.h"
 #include "actor/iomgr.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
+namespace {
+// The shared thread actors, e.g. the kernel actors and the data prepare actor, use the LockFreeMailBox.
+// MS_DEV_DISABLE_LOCKFREE_MAILBOX=1 falls back to the NonblockingMailBox.
+bool EnableLockFreeMailBox() {
+  static const bool enable = (common::GetEnv("MS_DEV_DISABLE_LOCKFREE_MAILBOX") != "1");
+  return enable;
+}
+}  // namespace
+
 ActorMgr ActorMgr::actorMgr;
 std::map<std::string, std::shared_ptr<IOMgr>> ActorMgr::ioMgrs;
 
@@ -51,10 +61,11 @@ ActorMgr::~ActorMgr() {
 }
 
 int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t max_thread_num, size_t actor_queue_size,
-                         const std::vector<int> &core_list) {
+                         const std::vector<int> &core_list, ActorQueueMode queue_mode) {
   MS_LOG(DEBUG) << "ActorMgr Initialize, use_inner_pool : " << use_inner_pool
                 << ", actor_thread_num : " << actor_thread_num << ", max_thread_num : " << max_thread_num
-                << ", actor_queue_size : " << actor_queue_size << ", core_list size : " << core_list.size();
+                << ", actor_queue_size : " << actor_queue_size << ", core_list size : " << core_list.size()
+                << ", work stealing : " << (queue_mode == ActorQueueMode::kWorkStealing);
   std::unique_lock lock(actorsMutex);
   if (initialized_) {
     MS_LOG(DEBUG) << "Actor Manager has been initialized before";
@@ -65,7 +76,7 @@ int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t ma
   if (use_inner_pool) {
     ActorThreadPool::set_actor_queue_size(actor_queue_size);
     if (max_thread_num <= actor_thread_num) {
-      inner_pool_ = ActorThreadPool::CreateThreadPool(actor_thread_num);
+      inner_pool_ = ActorThreadPool::CreateThreadPool(actor_thread_num, queue_mode);
       if (inner_pool_ == nullptr) {
         MS_LOG(ERROR) << "ActorMgr CreateThreadPool failed";
         return MINDRT_ERROR;
@@ -77,7 +88,8 @@ int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t ma
         bind_list.push_back(core_list[core_list.size() - 1 - i]);
       }
       auto bind_mode = !bind_list.empty() ? BindMode::Power_Higher : BindMode::Power_NoBind;
-      inner_pool_ = ActorThreadPool::CreateThreadPool(actor_thread_num, max_thread_num, bind_list, bind_mode);
+      inner_pool_ =
+        ActorThreadPool::CreateThreadPool(actor_thread_num, max_thread_num, bind_list, bind_mode, queue_mode);
       if (inner_pool_ == nullptr) {
         MS_LOG(ERROR) << "ActorMgr CreateThreadPool failed";
         return MINDRT_ERROR;
@@ -252,7 +264,12 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::make_unique<NonblockingMailBox>();
+    std::unique_ptr<MailBox> mailbox;
+    if (EnableLockFreeMailBox()) {
+      mailbox = std::make_unique<LockFreeMailBox>();
+    } else {
+      mailbox = std::make_unique<NonblockingMailBox>();
+    }
     auto hook = std::make_unique<std::function<void()>>([actor]() {
       auto actor_mgr = actor->get_actor_mgr();
       if (actor_mgr != nullptr) {
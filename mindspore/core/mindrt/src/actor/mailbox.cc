@@ -70,6 +70,77 @@ std::list<std::unique_ptr<MessageBase>> *NonblockingMailBox::GetMsgs() {
   return ret;
 }
 
+LockFreeMailBox::~LockFreeMailBox() {
+  while (auto msg = Pop()) {
+    delete msg;
+  }
+}
+
+void LockFreeMailBox::Push(MessageBase *msg) {
+  msg->link_.next.store(nullptr, std::memory_order_relaxed);
+  MessageBase *prev = head_.exchange(msg, std::memory_order_acq_rel);
+  prev->link_.next.store(msg, std::memory_order_release);
+}
+
+MessageBase *LockFreeMailBox::Pop() {
+  MessageBase *tail = tail_;
+  MessageBase *next = tail->link_.next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->link_.next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // tail is the last message, put the stub behind it so that it can be taken
+  Push(&stub_);
+  next = tail->link_.next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+int LockFreeMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  Push(msg.release());
+  if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0 && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> LockFreeMailBox::GetMsg() {
+  MessageBase *msg = Pop();
+  if (msg == nullptr) {
+    // give back all the messages of this drain at once, the actor is released if nothing came in meanwhile
+    int64_t taken = taken_;
+    taken_ = 0;
+    if (pending_.fetch_sub(taken, std::memory_order_acq_rel) == taken) {
+      return nullptr;
+    }
+    // a producer has counted its message but may not have linked it yet, schedule the actor again instead of
+    // waiting for the producer, as the producer does not notify when the count is not raised from 0
+    msg = Pop();
+    if (msg == nullptr) {
+      if (notifyHook) {
+        (*notifyHook.get())();
+      }
+      return nullptr;
+    }
+  }
+  ++taken_;
+  return std::unique_ptr<MessageBase>(msg);
+}
+
 int HQueMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
   bool empty = mailbox.Empty();
   MessageBase *msgPtr = msg.release();
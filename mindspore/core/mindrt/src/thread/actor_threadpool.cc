@@ -24,6 +24,26 @@
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
 
+namespace {
+// in work stealing mode an actor thread looks at the shared queue before its own deque once in this many pops, so the
+// actors pushed by other threads are not starved by the ones it keeps waking up itself
+constexpr size_t kSharedQueuePollInterval = 61;
+
+// the work stealing pool and the index of the actor thread running on this thread, if any
+thread_local const ActorThreadPool *current_pool = nullptr;
+thread_local size_t current_index = 0;
+thread_local size_t pop_count = 0;
+thread_local uint32_t steal_seed = 0;
+
+uint32_t NextStealSeed() {
+  // xorshift32, it only needs to spread the victims of the actor threads
+  steal_seed ^= steal_seed << 13;
+  steal_seed ^= steal_seed >> 17;
+  steal_seed ^= steal_seed << 5;
+  return steal_seed;
+}
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::make_unique<std::thread>(&ActorWorker::RunWithSpin, this); }
 
 void ActorWorker::RunWithSpin() {
@@ -39,6 +59,12 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  if (pool != nullptr && pool->queue_mode() == ActorQueueMode::kWorkStealing) {
+    current_pool = pool;
+    current_index = worker_id_;
+    steal_seed = static_cast<uint32_t>(worker_id_) + 1;
+  }
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -84,14 +110,7 @@ ActorThreadPool::~ActorThreadPool() {
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueuesEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -109,7 +128,66 @@ ActorThreadPool::~ActorThreadPool() {
 #endif
 }
 
+bool ActorThreadPool::ActorQueuesEmpty() {
+  for (auto &deque : actor_deques_) {
+    if (!deque->Empty()) {
+      return false;
+    }
+  }
+#ifdef USE_HQUEUE
+  return actor_queue_.Empty();
+#else
+  std::lock_guard<std::mutex> _l(actor_mutex_);
+  return actor_queue_.empty();
+#endif
+}
+
+ActorBase *ActorThreadPool::PopActorWithStealing(size_t index) {
+  auto &own_deque = actor_deques_[index];
+  ActorBase *actor = nullptr;
+  bool poll_shared_first = (++pop_count % kSharedQueuePollInterval) == 0;
+  if (!poll_shared_first) {
+    actor = own_deque->Pop();
+  }
+#ifdef USE_HQUEUE
+  if (actor == nullptr) {
+    actor = actor_queue_.Dequeue();
+  }
+#else
+  if (actor == nullptr) {
+    std::lock_guard<std::mutex> _l(actor_mutex_);
+    if (!actor_queue_.empty()) {
+      actor = actor_queue_.front();
+      actor_queue_.pop();
+    }
+  }
+#endif
+  if (actor == nullptr && poll_shared_first) {
+    actor = own_deque->Pop();
+  }
+  if (actor != nullptr) {
+    return actor;
+  }
+  // start from a random victim so that the idle actor threads do not all hit the same deque
+  size_t deque_num = actor_deques_.size();
+  size_t start = NextStealSeed() % deque_num;
+  for (size_t i = 0; i < deque_num; ++i) {
+    size_t victim = (start + i) % deque_num;
+    if (victim == index) {
+      continue;
+    }
+    actor = actor_deques_[victim]->Steal();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 ActorBase *ActorThreadPool::PopActorFromQueue() {
+  if (current_pool == this && current_index < actor_deques_.size()) {
+    return PopActorWithStealing(current_index);
+  }
 #ifdef USE_HQUEUE
   return actor_queue_.Dequeue();
 #else
@@ -127,7 +205,10 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  // an actor woken by an actor thread stays on that thread, its inputs are likely still in the cache
+  if (current_pool == this && current_index < actor_deques_.size() && actor_deques_[current_index]->Push(actor)) {
+    THREAD_DEBUG("actor[%s] push to deque[%zu] success", actor->GetAID().Name().c_str(), current_index);
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -135,8 +216,8 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
     std::lock_guard<std::mutex> _l(actor_mutex_);
     actor_queue_.push(actor);
 #endif
+    THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   }
-  THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
@@ -177,6 +258,13 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
   if (TaskQueuesInit(total_thread_num) != THREAD_OK) {
     return THREAD_ERROR;
   }
+  if (queue_mode_ == ActorQueueMode::kWorkStealing) {
+    // the deques must exist before the actor threads start
+    for (size_t i = 0; i < actor_thread_num_; ++i) {
+      auto deque = std::make_unique<WorkStealingDeque<ActorBase>>(kActorDequeSize);
+      actor_deques_.push_back(std::move(deque));
+    }
+  }
 
   if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
@@ -189,12 +277,14 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
 }
 
 ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t actor_thread_num, size_t all_thread_num,
-                                                   const std::vector<int> &core_list, BindMode bind_mode) {
+                                                   const std::vector<int> &core_list, BindMode bind_mode,
+                                                   ActorQueueMode queue_mode) {
   std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
   ActorThreadPool *pool = new (std::nothrow) ActorThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->queue_mode_ = queue_mode;
   int ret = pool->InitAffinityInfo();
   if (ret != THREAD_OK) {
     delete pool;
@@ -214,11 +304,12 @@ ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t actor_thread_num, size
   return pool;
 }
 
-ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t thread_num) {
+ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t thread_num, ActorQueueMode queue_mode) {
   ActorThreadPool *pool = new (std::nothrow) ActorThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->queue_mode_ = queue_mode;
   int ret = pool->CreateThreads(thread_num, thread_num, {});
   if (ret != THREAD_OK) {
     delete pool;
@@ -18,6 +18,7 @@
 #define MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 
 #include <queue>
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <atomic>
@@ -26,10 +27,23 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/work_stealing_deque.h"
 #ifndef USE_HQUEUE
 #define USE_HQUEUE
 #endif
 namespace mindspore {
+// the size of the deque of every actor thread in work stealing mode, the actors beyond it go to the shared queue
+constexpr size_t kActorDequeSize = 1024;
+
+// how the runnable actors are handed to the actor threads
+enum class ActorQueueMode {
+  // all the actors go through one queue shared by the actor threads
+  kSharedQueue,
+  // every actor thread has its own deque, an actor woken by an actor thread goes to the deque of that thread, and the
+  // idle actor threads steal from the deques of the others
+  kWorkStealing
+};
+
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
@@ -67,15 +81,18 @@ class ActorWorker : public Worker {
 class MS_CORE_API ActorThreadPool : public ThreadPool {
  public:
   // create ThreadPool that contains actor thread and kernel thread
-  static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num, BindMode bind_mode) {
+  static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num, BindMode bind_mode,
+                                           ActorQueueMode queue_mode = ActorQueueMode::kSharedQueue) {
     std::vector<int> core_list;
-    return ActorThreadPool::CreateThreadPool(actor_thread_num, all_thread_num, core_list, bind_mode);
+    return ActorThreadPool::CreateThreadPool(actor_thread_num, all_thread_num, core_list, bind_mode, queue_mode);
   }
 
   static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num,
-                                           const std::vector<int> &core_list, BindMode bind_mode);
+                                           const std::vector<int> &core_list, BindMode bind_mode,
+                                           ActorQueueMode queue_mode = ActorQueueMode::kSharedQueue);
   // create ThreadPool that contains only actor thread
-  static ActorThreadPool *CreateThreadPool(size_t thread_num);
+  static ActorThreadPool *CreateThreadPool(size_t thread_num,
+                                           ActorQueueMode queue_mode = ActorQueueMode::kSharedQueue);
   ~ActorThreadPool() override;
 
   static void set_actor_queue_size(size_t actor_queue_size) { actor_queue_size_ = actor_queue_size; }
@@ -84,6 +101,8 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
 
+  ActorQueueMode queue_mode() const { return queue_mode_; }
+
  protected:
   ActorThreadPool() = default;
 
@@ -97,6 +116,13 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  // pop in work stealing mode: the own deque first, then the shared queue, then the deques of the other actor threads
+  ActorBase *PopActorWithStealing(size_t index);
+  bool ActorQueuesEmpty();
+
+  ActorQueueMode queue_mode_{ActorQueueMode::kSharedQueue};
+  // one deque per actor thread in work stealing mode
+  std::vector<std::unique_ptr<WorkStealingDeque<ActorBase>>> actor_deques_;
 
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+// implement a bounded lock-free work stealing deque, the owner pushes and pops at the bottom, and the other threads
+// steal from the top.
+// refer to https://fzn.fr/readings/ppopp13.pdf
+template <typename T>
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+  // the capacity is rounded up to a power of two
+  explicit WorkStealingDeque(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = static_cast<int64_t>(size) - 1;
+    buffer_ = std::vector<std::atomic<T *>>(size);
+  }
+  ~WorkStealingDeque() = default;
+
+  // only called by the owner, return false if the deque is full
+  bool Push(T *value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+      return false;
+    }
+    buffer_[bottom & mask_].store(value, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // only called by the owner, take the latest pushed value
+  T *Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *value = buffer_[bottom & mask_].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // the last value, race against the thieves for it
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        value = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  // called by any thread, take the oldest pushed value
+  T *Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    T *value = buffer_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return value;
+  }
+
+  bool Empty() const { return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire); }
+
+ private:
+  // the owner and the thieves update different ends, keep them on different cache lines
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  int64_t mask_{0};
+  std::vector<std::atomic<T *>> buffer_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_DEQUE_H_
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 // #include <sys/time.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
 #include "actor/actor.h"
 #include "actor/op_actor.h"
 #include "async/uuid_base.h"
@@ -158,4 +162,73 @@ TEST_F(LiteMindRtTest, ActorThreadPoolTest) {
   }
 }
 
+// every relay forwards a message to the next actor of the ring until its hops run out, so most actors are woken by
+// actor threads, like kernel actors which trigger their successors
+class RelayActor : public ActorBase {
+ public:
+  RelayActor(const std::string &nm, ActorThreadPool *pool, std::atomic_int *pending)
+      : ActorBase(nm, pool), pending_(pending) {}
+  void set_next(const AID &next) { next_ = next; }
+  void Relay(int hops) {
+    if (hops == 0) {
+      (*pending_)--;
+      return;
+    }
+    Async(next_, &RelayActor::Relay, hops - 1);
+  }
+
+ private:
+  AID next_;
+  std::atomic_int *pending_;
+};
+
+double RunRelayBenchmark(ActorQueueMode queue_mode, const std::string &prefix) {
+  constexpr size_t kThreadNum = 8;
+  constexpr size_t kActorNum = 512;
+  constexpr int kHops = 2000;
+  auto pool = ActorThreadPool::CreateThreadPool(kThreadNum, queue_mode);
+  if (pool == nullptr) {
+    return 0;
+  }
+  std::atomic_int pending{kActorNum};
+  std::vector<std::shared_ptr<RelayActor>> relays;
+  std::vector<AID> actors;
+  for (size_t i = 0; i < kActorNum; i++) {
+    auto relay = std::make_shared<RelayActor>(prefix + std::to_string(i), pool, &pending);
+    relays.emplace_back(relay);
+    actors.emplace_back(Spawn(relay));
+  }
+  for (size_t i = 0; i < kActorNum; i++) {
+    relays[i]->set_next(actors[(i + 1) % kActorNum]);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto &aid : actors) {
+    Async(aid, &RelayActor::Relay, kHops);
+  }
+  while (pending > 0) {
+    std::this_thread::yield();
+  }
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+
+  for (auto &aid : actors) {
+    Terminate(aid);
+    Await(aid);
+  }
+  delete pool;
+  return kActorNum * kHops / cost.count();
+}
+
+// compare the dispatch throughput of the shared actor queue and of the work stealing deques
+TEST_F(LiteMindRtTest, ActorThreadPoolDispatchBenchmark) {
+  Initialize("", "", "", "");
+  double shared_queue = RunRelayBenchmark(ActorQueueMode::kSharedQueue, "shared_relay_");
+  double work_stealing = RunRelayBenchmark(ActorQueueMode::kWorkStealing, "stealing_relay_");
+  std::cout << "actor dispatch throughput, shared queue: " << shared_queue
+            << " msg/s, work stealing: " << work_stealing << " msg/s" << std::endl;
+  ASSERT_GT(shared_queue, 0);
+  ASSERT_GT(work_stealing, 0);
+  Finalize();
+}
+
 }  // namespace mindspore
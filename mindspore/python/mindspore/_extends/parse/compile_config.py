@@ -95,6 +95,16 @@ Value Range:
 """
 SINGLE_EVAL = ''
 
+"""
+Name: DISABLE_INFER_WORKERS
+Function: Whether to run each control flow branch of the multithreading type inference on a new thread, instead of
+          the reused infer workers.
+Value Range:
+    1: A new thread for each branch.
+    Default: Reuse the infer workers.
+"""
+DISABLE_INFER_WORKERS = ''
+
 """
 Name: ENABLE_DDE
 Function: Whether to eliminate elements in tuple/list that are not used by other nodes.
@@ -214,6 +224,7 @@ __all__ = [
     "NOT_WAIT_BRANCH_EVAL",
     "RECURSIVE_EVAL",
     "SINGLE_EVAL",
+    "DISABLE_INFER_WORKERS",
     "ENABLE_DDE",
     "DDE_ONLY_MARK",
     "BOOST_PARSE",
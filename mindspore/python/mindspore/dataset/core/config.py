@@ -44,12 +44,15 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_enable_autotune_model', 'get_enable_autotune_model',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
            'set_fast_recovery', 'get_fast_recovery',
            'set_debug_mode', 'get_debug_mode',
            'set_error_samples_mode', 'get_error_samples_mode', 'ErrorSamplesMode',
-           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
+           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval',
+           'set_enable_mindrecord_mmap', 'get_enable_mindrecord_mmap',
+           'set_global_shuffle_window', 'get_global_shuffle_window']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -624,6 +627,52 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_enable_autotune_model(enable):
+    """
+    Set whether AutoTune tunes the data pipeline from a throughput model of its operations.
+
+    By default, AutoTune changes the parallelism or the buffer queue size of one operation at a time according to
+    the utilization of its queues, which can take several epochs to settle. When the model is enabled, AutoTune
+    instead estimates the cost of each operation from the profiling samples of the first steps, and sets the
+    parallelism and the buffer queue size of all the operations at once, within the number of CPU threads and the
+    available memory. The configuration is fitted twice within the first epoch and then kept. Takes effect only
+    when AutoTune is enabled.
+
+    If a path is given to `mindspore.dataset.config.set_enable_autotune` , the fitted configuration is also saved
+    to `filepath_prefix + "_" + RANK_ID + "_model.json"` , and later runs of the same data pipeline apply it at
+    once instead of fitting the model again.
+
+    Args:
+        enable (bool): Whether to tune from the throughput model.
+
+    Raises:
+        TypeError: If `enable` is not of type bool.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_autotune(True)
+        >>> ds.config.set_enable_autotune_model(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_autotune_model(enable)
+
+
+def get_enable_autotune_model():
+    """
+    Get whether AutoTune tunes the data pipeline from a throughput model of its operations.
+    It is disabled by default.
+
+    Returns:
+        bool, whether AutoTune uses the throughput model.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> flag = ds.config.get_enable_autotune_model()
+    """
+    return _config.get_enable_autotune_model()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -897,6 +946,89 @@ def get_fast_recovery():
     return _config.get_fast_recovery()
 
 
+def set_enable_mindrecord_mmap(enable):
+    """
+    Set whether MindDataset reads the blob data of MindRecord files through memory mapped files.
+    When enabled, each shard file is mapped once and numeric blob columns are passed to the pipeline
+    without being copied. A column is copied when it is written for the first time, e.g. by an in-place
+    operation, so the samples of later epochs are not changed. If the files can not be mapped, MindDataset
+    falls back to reading them normally.
+    It is set to False by default.
+
+    Args:
+        enable (bool): Whether to read MindRecord files through memory mapped files.
+
+    Raises:
+        TypeError: If `enable` is not a boolean data type.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_enable_mindrecord_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean dtype.")
+    _config.set_enable_mindrecord_mmap(enable)
+
+
+def get_enable_mindrecord_mmap():
+    """
+    Get whether MindDataset reads MindRecord files through memory mapped files.
+    It is set to False by default.
+
+    Returns:
+        bool, whether MindRecord files are read through memory mapped files.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> enable_mmap = ds.config.get_enable_mindrecord_mmap()
+    """
+    return _config.get_enable_mindrecord_mmap()
+
+
+def set_global_shuffle_window(window):
+    """
+    Set the window of the global shuffle of mappable datasets.
+
+    When the window is greater than 0, a shuffle operation directly above a mappable source dataset (only
+    map, project and rename operations may be in between) is replaced by a global shuffle of the row indices
+    of that source. The indices are spilled to a memory mapped temporary file and at most `window` of them are
+    kept in memory, and the rows are then loaded in the shuffled order, so no rows are buffered for the shuffle.
+    The temporary file is created in the directory given by the TMPDIR environment variable, or in /tmp.
+    It is set to 0 by default, which keeps the buffered shuffle.
+
+    Args:
+        window (int): The number of row indices kept in memory, 0 to disable the global shuffle.
+
+    Raises:
+        TypeError: If `window` is not of type int.
+        ValueError: If `window` is a negative number.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_global_shuffle_window(1000000)
+    """
+    if not isinstance(window, int) or isinstance(window, bool):
+        raise TypeError("window isn't of type int.")
+    if window < 0 or window > INT32_MAX:
+        raise ValueError("window is not within the required range [0, INT32_MAX(2147483647)].")
+    _config.set_global_shuffle_window(window)
+
+
+def get_global_shuffle_window():
+    """
+    Get the window of the global shuffle of mappable datasets.
+    It is set to 0 by default, which means the global shuffle is disabled.
+
+    Returns:
+        int, the number of row indices kept in memory by the global shuffle.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> window = ds.config.get_global_shuffle_window()
+    """
+    return _config.get_global_shuffle_window()
+
+
 def set_debug_mode(debug_mode_flag: bool, debug_hook_list: list = None):
     """
     Set the debug_mode flag of the dataset pipeline. When enabled, the dataset pipeline is run synchronously and
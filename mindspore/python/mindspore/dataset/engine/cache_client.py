@@ -109,6 +109,9 @@ class DatasetCache:
             >>> num_mem_cached = stat.num_mem_cached
             >>> # Number of rows spilled to disk
             >>> num_disk_cached = stat.num_disk_cached
+            >>> # Number of rows fetched from memory and from disk
+            >>> num_mem_hit = stat.num_mem_hit
+            >>> num_disk_hit = stat.num_disk_hit
         """
         return self.cache_client.GetStat()
 
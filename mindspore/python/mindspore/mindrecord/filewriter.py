@@ -471,6 +471,9 @@ class FileWriter:
             if os.path.exists(index_file):
                 os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
                 index_files.append(index_file)
+            page_index_file = item + ".idx"
+            if os.path.exists(page_index_file):
+                os.chmod(page_index_file, stat.S_IRUSR | stat.S_IWUSR)
 
         for item in self._paths:
             if os.path.exists(item):
@@ -18,6 +18,7 @@ This module is to  write data into mindrecord.
 import mindspore._c_mindrecord as ms
 from mindspore import log as logger
 from .common.exceptions import MRMIndexGeneratorError, MRMGenerateIndexError
+from .config import _get_enc_key, _get_hash_mode
 
 __all__ = ['ShardIndexGenerator']
 
@@ -26,7 +27,8 @@ class ShardIndexGenerator:
     """
     Wrapper class which is represent ShardIndexGenerator class in c++ module.
 
-    The class would generate db files for accelerating reading.
+    The class would generate db files for accelerating reading. Unless encryption or hash check is enabled,
+    a binary page index is generated next to each db file as well.
 
     Args:
         path (str): Absolute path of MindRecord File.
@@ -40,6 +42,8 @@ class ShardIndexGenerator:
         if not self._generator:
             logger.critical("Failed to create index generator.")
             raise MRMIndexGeneratorError
+        # the page index is neither encrypted nor hashed, so the reader falls back to the db file then
+        self._generator.set_write_page_index(_get_enc_key() is None and _get_hash_mode() is None)
 
     def build(self):
         """
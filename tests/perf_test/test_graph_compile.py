@@ -0,0 +1,114 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Graph compile benchmark, reports the compile time of a deep network whose layers all contain control flow."""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+
+import numpy as np
+
+from mindspore import Tensor, context, nn, ops
+from mindspore._extends.parse import compile_config
+
+HIDDEN_SIZE = 16
+# The compile with the infer workers may be this much slower than the baseline before the test fails, for the noise
+# of the machine.
+MIN_SPEEDUP = 0.9
+
+
+class Layer(nn.Cell):
+    """A dense layer followed by an if on a tensor, the two branches are inferred by the multithreading inference."""
+
+    def __init__(self):
+        super(Layer, self).__init__()
+        self.dense = nn.Dense(HIDDEN_SIZE, HIDDEN_SIZE)
+        self.relu = ops.ReLU()
+        self.tanh = ops.Tanh()
+        self.reduce_sum = ops.ReduceSum()
+
+    def construct(self, x):
+        y = self.dense(x)
+        if self.reduce_sum(y) > 0:
+            y = self.relu(y)
+        else:
+            y = self.tanh(y)
+        return y + x
+
+
+class DeepNet(nn.Cell):
+    def __init__(self, num_layers):
+        super(DeepNet, self).__init__()
+        self.layers = nn.CellList([Layer() for _ in range(num_layers)])
+
+    def construct(self, x):
+        for layer in self.layers:
+            x = layer(x)
+        return x
+
+
+def run_benchmark(num_layers=200, device_target="CPU"):
+    """Returns the seconds of compiling a DeepNet of num_layers, the graph is not run."""
+    context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
+    net = DeepNet(num_layers)
+    x = Tensor(np.ones((2, HIDDEN_SIZE)).astype(np.float32))
+    start = time.perf_counter()
+    net.compile(x)
+    return time.perf_counter() - start
+
+
+def run_in_subprocess(num_layers, config):
+    """Runs the benchmark in a new process, the compile config is read once by the process."""
+    output = subprocess.check_output([sys.executable, os.path.abspath(__file__), "--num_layers", str(num_layers),
+                                      "--config", config, "--json"])
+    return json.loads(output.decode().strip().splitlines()[-1])["compile_time"]
+
+
+def test_graph_compile():
+    """
+    Feature: Multithreading type inference.
+    Description: Compile a deep network whose layers all contain an if on a tensor, with the branches inferred on the
+        reused infer workers, on a new thread for each branch as the baseline, and by the single thread inference.
+    Expectation: The compile with the infer workers is not slower than the baseline.
+    """
+    num_layers = 50
+    workers = run_in_subprocess(num_layers, "")
+    baseline = run_in_subprocess(num_layers, "DISABLE_INFER_WORKERS")
+    single = run_in_subprocess(num_layers, "SINGLE_EVAL")
+    speedup = baseline / workers
+    print(f"compile {num_layers} layers: {workers:.2f}s, {baseline:.2f}s with a new thread for each branch, "
+          f"{single:.2f}s with the single thread inference, speedup {speedup:.2f}")
+    assert speedup > MIN_SPEEDUP
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Graph compile benchmark")
+    parser.add_argument("--num_layers", type=int, default=200)
+    parser.add_argument("--device_target", type=str, default="CPU")
+    parser.add_argument("--config", type=str, default="", choices=["", "DISABLE_INFER_WORKERS", "SINGLE_EVAL"],
+                        help="the compile config to set to 1")
+    parser.add_argument("--json", action="store_true", help="print the result as a json line")
+    args = parser.parse_args()
+    if args.config:
+        setattr(compile_config, args.config, "1")
+    compile_time = run_benchmark(args.num_layers, args.device_target)
+    if args.json:
+        print(json.dumps({"compile_time": compile_time}))
+    else:
+        print(f"compile {args.num_layers} layers: {compile_time:.2f}s")
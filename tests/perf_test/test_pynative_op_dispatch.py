@@ -0,0 +1,123 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""PyNative op dispatch benchmark, reports the ops per second of the eager ops on tiny tensors."""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+
+import numpy as np
+
+import mindspore as ms
+from mindspore import Tensor, context, ops
+
+WARMUP_STEPS = 100
+# The pooled dispatch may be this much slower than the baseline before the test fails, for the noise of the machine.
+MIN_SPEEDUP = 0.9
+
+
+def run_add(x, y):
+    return ops.add(x, y)
+
+
+def run_mul_add(x, y):
+    return ops.add(ops.mul(x, y), x)
+
+
+def run_implicit_cast(x, y):
+    # The float32 and int32 inputs go through the implicit cast of the signature.
+    return ops.add(x, y.astype(ms.int32))
+
+
+def run_reduce(x, y):
+    return ops.ReduceSum(keep_dims=True)(ops.mul(x, y), 1)
+
+
+CASES = {
+    "add": (run_add, 1),
+    "mul_add": (run_mul_add, 2),
+    "implicit_cast": (run_implicit_cast, 2),
+    "reduce": (run_reduce, 2),
+}
+
+
+def measure(func, op_num, steps, shape):
+    """Returns the ops per second of running func for steps, the outputs are synced at the end."""
+    x = Tensor(np.ones(shape).astype(np.float32))
+    y = Tensor(np.ones(shape).astype(np.float32))
+    out = None
+    for _ in range(WARMUP_STEPS):
+        out = func(x, y)
+    out.asnumpy()
+    start = time.perf_counter()
+    for _ in range(steps):
+        out = func(x, y)
+    out.asnumpy()
+    cost = time.perf_counter() - start
+    return steps * op_num / cost
+
+
+def run_benchmark(steps=2000, shape=(2, 2), device_target="CPU", cases=None):
+    context.set_context(mode=context.PYNATIVE_MODE, device_target=device_target)
+    result = {}
+    for name in cases or CASES:
+        func, op_num = CASES[name]
+        result[name] = measure(func, op_num, steps, shape)
+    return result
+
+
+def run_in_subprocess(steps, disable_task_pool):
+    """Runs the benchmark in a new process, the task pool switch is read once by the process."""
+    env = dict(os.environ)
+    env["MS_DEV_DISABLE_TASK_POOL"] = "1" if disable_task_pool else "0"
+    output = subprocess.check_output([sys.executable, os.path.abspath(__file__), "--steps", str(steps), "--json"],
+                                     env=env)
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+def test_pynative_op_dispatch():
+    """
+    Feature: PyNative op dispatch.
+    Description: Run the eager ops on tiny tensors, where the time is spent on the dispatch instead of the kernels,
+        with the pooled tasks and with the tasks allocated on the heap as the baseline.
+    Expectation: The dispatch with the pooled tasks is not slower than the baseline.
+    """
+    pooled = run_in_subprocess(2000, False)
+    baseline = run_in_subprocess(2000, True)
+    for name in CASES:
+        speedup = pooled[name] / baseline[name]
+        print(f"{name}: {pooled[name]:.1f} ops/s, {baseline[name]:.1f} ops/s without the task pool, "
+              f"speedup {speedup:.2f}")
+        assert speedup > MIN_SPEEDUP
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="PyNative op dispatch benchmark")
+    parser.add_argument("--steps", type=int, default=20000)
+    parser.add_argument("--shape", type=int, nargs="+", default=[2, 2])
+    parser.add_argument("--device_target", type=str, default="CPU")
+    parser.add_argument("--case", type=str, nargs="*", choices=list(CASES), default=None)
+    parser.add_argument("--json", action="store_true", help="print the result as a json line")
+    args = parser.parse_args()
+    benchmark_result = run_benchmark(args.steps, tuple(args.shape), args.device_target, args.case)
+    if args.json:
+        print(json.dumps(benchmark_result))
+    else:
+        for case_name, value in benchmark_result.items():
+            print(f"{case_name}: {value:.1f} ops/s")
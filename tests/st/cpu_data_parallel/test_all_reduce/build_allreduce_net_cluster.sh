@@ -14,7 +14,7 @@
 # limitations under the License.
 # ============================================================================
 
-export MS_WORKER_NUM=8
+export MS_WORKER_NUM=${3:-8}
 export MS_SCHED_HOST=127.0.0.1
 export MS_SCHED_PORT=$2
 export GLOG_v=1
@@ -25,10 +25,10 @@ python3 $1 >scheduler.log 2>&1 &
 sched_pid=${!}
 echo "scheduler start success!"
 
-# Launch 8 workers.
+# Launch the workers, 8 by default.
 export MS_ROLE=MS_WORKER
 process_pid=()
-for((i=0;i<8;i++));
+for((i=0;i<${MS_WORKER_NUM};i++));
 do
     python3 $1 >worker_$i.log 2>&1 &
     echo "worker ${i} start success with pid ${!}"
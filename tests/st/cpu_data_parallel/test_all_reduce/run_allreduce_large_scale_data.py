@@ -0,0 +1,56 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""define and run AllReduce network with data of different scales"""
+
+import numpy as np
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore import nn
+from mindspore.ops import operations as P
+from mindspore.communication.management import init, get_group_size, get_rank
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+context.set_ps_context(enable_ssl=False)
+init()
+context.set_auto_parallel_context(parallel_mode="data_parallel", gradients_mean=True, device_num=get_group_size())
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.all_reduce = P.AllReduce()
+
+    def construct(self, x, y, z):
+        return self.all_reduce(x), self.all_reduce(y), self.all_reduce(z)
+
+
+def run_all_reduce():
+    """
+    Run all reduce with the data reduced by halving doubling, by the ring in one segment and by the ring in several
+    segments of each chunk.
+    """
+    all_reduce = Net()
+    shapes = ((100, 10), (1000, 100), (3000, 1000))
+    inputs = [(np.arange(np.prod(shape)) % 7 + get_rank()).reshape(shape).astype(np.float32) for shape in shapes]
+    rank_sum = sum(range(get_group_size()))
+    output = all_reduce(*[Tensor(x) for x in inputs])
+    for x, out in zip(inputs, output):
+        expect = (x - get_rank()) * get_group_size() + rank_sum
+        assert np.array_equal(out.asnumpy(), expect)
+
+
+run_all_reduce()
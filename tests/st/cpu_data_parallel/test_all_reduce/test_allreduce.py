@@ -54,3 +54,18 @@ def test_allreduce_small_scale_data():
         return
     return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_small_scale_data.py 8081")
     assert return_code == 0
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_allreduce_large_scale_data():
+    """
+    Feature: CPU data parallel.
+    Description: Test allreduce data of different scales on a number of CPU nodes which is not a power of two.
+    Expectation: Each node obtains all node reduced result whichever algorithm is chosen for the data size.
+    """
+    if sys.platform != 'linux':
+        return
+    return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_large_scale_data.py 8125 6")
+    assert return_code == 0
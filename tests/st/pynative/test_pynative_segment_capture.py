@@ -0,0 +1,72 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test the replay of the captured op segments in PyNative mode """
+import os
+import numpy as np
+import pytest
+
+# The switch is read once, before the first op runs.
+os.environ['MS_DEV_PYNATIVE_SEGMENT_CAPTURE'] = '1'
+
+import mindspore as ms  # pylint: disable=wrong-import-position
+from mindspore import Tensor, ops  # pylint: disable=wrong-import-position
+from mindspore.ops import operations as P  # pylint: disable=wrong-import-position
+
+# More flushes of the same segment than it takes to compile it.
+FLUSH_NUM = 5
+
+
+# pylint: disable=unused-argument
+def setup_module(module):
+    ms.set_context(mode=ms.PYNATIVE_MODE, device_target="CPU")
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_replay_add_mul():
+    """
+    Feature: PyNative segment capture.
+    Description: Run the same Add and Mul segment with new inputs, each run is flushed by reading the output.
+    Expectation: The outputs of the runs op by op and of the replayed graph equal the numpy results.
+    """
+    for i in range(FLUSH_NUM):
+        x = np.arange(6).reshape(2, 3).astype(np.float32) + i
+        y = np.full((2, 3), i + 1, np.float32)
+        add = ops.add(Tensor(x), Tensor(y))
+        out = ops.mul(add, Tensor(x))
+        assert np.allclose(out.asnumpy(), (x + y) * x)
+        assert np.allclose(add.asnumpy(), x + y)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_replay_tuple_output():
+    """
+    Feature: PyNative segment capture.
+    Description: Run the same segment of TopK, whose output is a tuple, and of an Add of the TopK values.
+    Expectation: Each element of the tuple and the Add output get the right values after the replay.
+    """
+    top_k = P.TopK(sorted=True)
+    for i in range(FLUSH_NUM):
+        x = np.array([[1, 4, 2], [6, 3, 5]]).astype(np.float32) + i
+        values, indices = top_k(Tensor(x), 2)
+        out = ops.add(values, Tensor(np.ones((2, 2), np.float32)))
+        expect_indices = np.argsort(-x, axis=1)[:, :2]
+        expect_values = np.take_along_axis(x, expect_indices, axis=1)
+        assert np.allclose(out.asnumpy(), expect_values + 1)
+        assert np.allclose(values.asnumpy(), expect_values)
+        assert (indices.asnumpy() == expect_indices).all()
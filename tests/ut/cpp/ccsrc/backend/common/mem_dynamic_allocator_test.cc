@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include <random>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "common/common_test.h"
 #include "include/backend/mem_reuse/mem_dynamic_allocator.h"
@@ -64,6 +66,11 @@ class DummyPool : public DynamicMemPoolBestFit {
   std::unordered_set<DeviceMemPtr> allocated_mems_;
 };
 
+class ThreadCachePool : public DummyPool {
+ public:
+  const bool IsEnableThreadCache() const override { return true; }
+};
+
 class TestMemDynamicAllocator : public UT::Common {
  public:
   TestMemDynamicAllocator() = default;
@@ -239,5 +246,86 @@ TEST_F(TestMemDynamicAllocator, test_malloc_with_multi_stream_id) {
   EXPECT_EQ(persitent_mem_pool->mem_bufs_[std::make_pair(stream1, DynamicMemBufStatus::kMemBufIdle)].size(),
             expected_size_two);
 }
+
+/// Feature: test small memory malloc through the thread cache of mem dynamic allocator.
+/// Description: test the thread cache reuses the freed memory and keeps the others in the pool.
+/// Expectation: the freed memory is allocated again from the thread cache without overlapping.
+TEST_F(TestMemDynamicAllocator, test_thread_cache) {
+  ThreadCachePool mem_pool;
+  constexpr size_t kSmallSize = 1000;
+  constexpr size_t kAllocCount = 100;
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kAllocCount; ++i) {
+    addrs.push_back(mem_pool.AllocTensorMem(kSmallSize));
+  }
+  std::unordered_set<DeviceMemPtr> unique_addrs(addrs.begin(), addrs.end());
+  EXPECT_EQ(unique_addrs.size(), kAllocCount);
+  for (auto addr : addrs) {
+    mem_pool.FreeTensorMem(addr);
+  }
+  auto stats = mem_pool.ThreadCacheStatistics();
+  EXPECT_EQ(stats.free_count_, kAllocCount);
+  EXPECT_GT(stats.span_mem_size_, expected_size_zero);
+  // The freed memory is served again from the free list of the thread.
+  auto addr = mem_pool.AllocTensorMem(kSmallSize);
+  EXPECT_EQ(unique_addrs.count(addr), expected_size_one);
+  EXPECT_GT(mem_pool.ThreadCacheStatistics().hit_count_, stats.hit_count_);
+  mem_pool.FreeTensorMem(addr);
+
+  // The large, persistent and other stream memory bypasses the thread cache.
+  auto large_addr = mem_pool.AllocTensorMem(kThreadCacheMaxSize + 1);
+  auto persistent_addr = mem_pool.AllocTensorMem(kSmallSize, true);
+  auto stream_addr = mem_pool.AllocTensorMem(kSmallSize, false, false, 1);
+  EXPECT_EQ(mem_pool.ThreadCacheStatistics().free_count_, kAllocCount + 1);
+  mem_pool.FreeTensorMem(large_addr);
+  mem_pool.FreeTensorMem(persistent_addr);
+  mem_pool.FreeTensorMem(stream_addr);
+  EXPECT_EQ(mem_pool.ThreadCacheStatistics().free_count_, kAllocCount + 1);
+}
+
+/// Feature: test small memory malloc through the thread cache of mem dynamic allocator from multi threads.
+/// Description: every thread allocates and frees, part of the memory is freed by another thread.
+/// Expectation: no memory is handed out twice, and the memory of the exited threads goes back to the central lists.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_multi_thread) {
+  ThreadCachePool mem_pool;
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kAllocCount = 1000;
+  std::vector<std::vector<DeviceMemPtr>> thread_addrs(kThreadNum);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&mem_pool, &thread_addrs, t]() {
+      std::mt19937 rng(t);
+      for (size_t i = 0; i < kAllocCount; ++i) {
+        auto size = rng() % kThreadCacheMaxSize + 1;
+        thread_addrs[t].push_back(mem_pool.AllocTensorMem(size));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::unordered_set<DeviceMemPtr> unique_addrs;
+  for (const auto &addrs : thread_addrs) {
+    unique_addrs.insert(addrs.begin(), addrs.end());
+  }
+  EXPECT_EQ(unique_addrs.size(), kThreadNum * kAllocCount);
+
+  // Free the memory of every thread from the next one.
+  threads.clear();
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&mem_pool, &thread_addrs, t]() {
+      for (auto addr : thread_addrs[(t + 1) % kThreadNum]) {
+        mem_pool.FreeTensorMem(addr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stats = mem_pool.ThreadCacheStatistics();
+  EXPECT_EQ(stats.free_count_, kThreadNum * kAllocCount);
+  EXPECT_GT(stats.cached_mem_size_, expected_size_zero);
+  EXPECT_LE(stats.cached_mem_size_, stats.span_mem_size_);
+}
 }  // namespace device
 }  // namespace mindspore
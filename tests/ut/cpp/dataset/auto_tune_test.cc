@@ -0,0 +1,154 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/datasets.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr int32_t kConsumerOp = 0;
+constexpr int32_t kMapOp = 1;
+constexpr int32_t kLeafOp = 2;
+
+AutoTune::ModelOpSample MakeOp(int32_t num_workers, double cpu_util, double in_queue_util, double out_queue_util,
+                               bool tunable) {
+  AutoTune::ModelOpSample op;
+  op.num_workers = num_workers;
+  op.queue_capacity = 8;
+  op.cpu_util = cpu_util;
+  op.in_queue_util = in_queue_util;
+  op.out_queue_util = out_queue_util;
+  op.tunable = tunable;
+  return op;
+}
+
+/// \brief 10 batches per second on 8 cpu threads, through a leaf op with a fixed worker, a map op and its consumer.
+AutoTune::ModelSample MakeSample(bool is_bottleneck) {
+  AutoTune::ModelSample sample;
+  sample.batch_time = 100;
+  sample.is_bottleneck = is_bottleneck;
+  sample.max_workers = 8;
+  // The consumer mostly waits for the map op.
+  sample.ops[kConsumerOp] = MakeOp(1, 10, 0.9, 0.1, true);
+  // Both workers of the map op are busy all the time.
+  sample.ops[kMapOp] = MakeOp(2, 200, 1, 0, true);
+  // The leaf op is blocked by the full queue of the map op.
+  sample.ops[kLeafOp] = MakeOp(1, 5, 1, 1, false);
+  return sample;
+}
+}  // namespace
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ public:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    // The model is fitted to synthetic samples, the pipeline and the profiler are never read.
+    std::string folder_path = datasets_root_path_ + "/testMnistData/";
+    std::shared_ptr<Dataset> ds = Mnist(folder_path, "all", std::make_shared<SequentialSampler>(0, 4));
+    ASSERT_NE(ds, nullptr);
+    ds = ds->Batch(2);
+    ASSERT_NE(ds, nullptr);
+    tree_adapter_ = std::make_shared<TreeAdapter>();
+    ASSERT_OK(tree_adapter_->Compile(ds->IRNode(), 1));
+    auto_tune_ = std::make_unique<AutoTune>(tree_adapter_.get(), nullptr);
+  }
+
+ protected:
+  std::shared_ptr<TreeAdapter> tree_adapter_;
+  std::unique_ptr<AutoTune> auto_tune_;
+};
+
+/// Feature: AutoTune model
+/// Description: Fit the model to a pipeline which is the bottleneck and whose map op is busy all the time
+/// Expectation: The map op gets the most workers the cpu threads allow, the consumer gets enough workers for the
+///     throughput of the map op, and the leaf op with a fixed worker is not changed
+TEST_F(MindDataTestAutoTune, TestFitBottleneck) {
+  AutoTune::ModelFit fit;
+  ASSERT_OK(auto_tune_->FitModel(MakeSample(true), &fit));
+  // 215% cpu at 10 batches per second bounds the pipeline to 8 / 0.215 batches per second.
+  EXPECT_NEAR(fit.cpu_cost, 0.215, 1e-9);
+  ASSERT_EQ(fit.num_workers.size(), 2U);
+  EXPECT_EQ(fit.num_workers[kConsumerOp], 4);
+  EXPECT_EQ(fit.num_workers[kMapOp], 8);
+  EXPECT_EQ(fit.num_workers.count(kLeafOp), 0U);
+  // 8 map workers each taking 0.2 s of a batch.
+  EXPECT_DOUBLE_EQ(fit.predicted, 40);
+  // Two rows for each worker on either side of a queue.
+  EXPECT_EQ(fit.queue_capacity[kConsumerOp], 8);
+  EXPECT_EQ(fit.queue_capacity[kMapOp], 16);
+}
+
+/// Feature: AutoTune model
+/// Description: Fit the model to a pipeline which is not the bottleneck and whose map op is half idle
+/// Expectation: The current throughput is kept with fewer workers and smaller queues
+TEST_F(MindDataTestAutoTune, TestFitNotBottleneck) {
+  auto sample = MakeSample(false);
+  sample.ops[kMapOp] = MakeOp(4, 200, 0.5, 0, true);
+  AutoTune::ModelFit fit;
+  ASSERT_OK(auto_tune_->FitModel(sample, &fit));
+  EXPECT_EQ(fit.num_workers[kConsumerOp], 1);
+  EXPECT_EQ(fit.num_workers[kMapOp], 3);
+  EXPECT_GE(fit.predicted, 10);
+  EXPECT_EQ(fit.queue_capacity[kConsumerOp], 2);
+  EXPECT_EQ(fit.queue_capacity[kMapOp], 6);
+}
+
+/// Feature: AutoTune model
+/// Description: Fit the model to a bottleneck pipeline whose leaf op with a fixed worker is busy all the time
+/// Expectation: The tunable ops only get the workers for the throughput of the leaf op
+TEST_F(MindDataTestAutoTune, TestFitFixedOpBound) {
+  auto sample = MakeSample(true);
+  sample.ops[kLeafOp] = MakeOp(1, 100, 1, 0, false);
+  AutoTune::ModelFit fit;
+  ASSERT_OK(auto_tune_->FitModel(sample, &fit));
+  EXPECT_EQ(fit.num_workers[kConsumerOp], 1);
+  EXPECT_EQ(fit.num_workers[kMapOp], 3);
+  EXPECT_DOUBLE_EQ(fit.predicted, 10);
+}
+
+/// Feature: AutoTune model
+/// Description: Fit the model when the rows the queues would grow by need more memory than the budget
+/// Expectation: The growth of the queues is scaled down to the budget, but a queue keeps a row for each worker
+TEST_F(MindDataTestAutoTune, TestFitMemoryBudget) {
+  auto sample = MakeSample(true);
+  // 8.8 rows are queued on average, so a row takes 100 MB. The 8 more rows of the map queue need 800 MB.
+  sample.process_mem = 880;
+  sample.mem_budget = 400;
+  AutoTune::ModelFit fit;
+  ASSERT_OK(auto_tune_->FitModel(sample, &fit));
+  EXPECT_EQ(fit.num_workers[kMapOp], 8);
+  EXPECT_EQ(fit.queue_capacity[kConsumerOp], 8);
+  EXPECT_EQ(fit.queue_capacity[kMapOp], 12);
+
+  sample.mem_budget = 0;
+  ASSERT_OK(auto_tune_->FitModel(sample, &fit));
+  EXPECT_EQ(fit.queue_capacity[kMapOp], 8);
+}
+
+/// Feature: AutoTune model
+/// Description: Fit the model without a sampled batch time
+/// Expectation: The fit fails
+TEST_F(MindDataTestAutoTune, TestFitWithoutBatchTime) {
+  auto sample = MakeSample(true);
+  sample.batch_time = 0;
+  AutoTune::ModelFit fit;
+  EXPECT_ERROR(auto_tune_->FitModel(sample, &fit));
+}
@@ -0,0 +1,251 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/cache_server.h"
+#include "minddata/dataset/engine/cache/storage_manager.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/services.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr size_t kBufferSize = 64 * 1024;
+// The container the first buffer of a StorageManager with one container goes to.
+constexpr char kFirstContainer[] = "IMG00000.LB";
+
+/// \brief A row which deflates well, made of a few repeated values.
+std::vector<uint8_t> MakeCompressible(uint8_t seed) {
+  std::vector<uint8_t> buf(kBufferSize);
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<uint8_t>(seed + (i / 256) % 4);
+  }
+  return buf;
+}
+
+std::vector<uint8_t> MakeIncompressible(uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> buf(kBufferSize);
+  std::generate(buf.begin(), buf.end(), [&gen, &dist]() { return static_cast<uint8_t>(dist(gen)); });
+  return buf;
+}
+
+Status ReadBack(const StorageManager &sm, StorageManager::key_type key, std::vector<uint8_t> *out) {
+  out->assign(kBufferSize, 0);
+  WritableSlice dest(out->data(), out->size());
+  size_t bytes_read = 0;
+  RETURN_IF_NOT_OK(sm.Read(key, &dest, &bytes_read));
+  CHECK_FAIL_RETURN_UNEXPECTED(bytes_read == kBufferSize, "Unexpected length " + std::to_string(bytes_read));
+  return Status::OK();
+}
+
+Status ReadBack(CachePool *cp, CachePool::key_type key, std::vector<uint8_t> *out) {
+  out->assign(kBufferSize, 0);
+  WritableSlice dest(out->data(), out->size());
+  return cp->Read(key, &dest);
+}
+
+/// \brief Offset of the zlib stream of the only buffer written to a container. Z_BEST_SPEED writes the header 78 01.
+int64_t FindZlibStream(const std::string &container) {
+  std::ifstream in(container, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  auto pos = content.find(std::string("\x78\x01", 2));
+  return pos == std::string::npos ? -1 : static_cast<int64_t>(pos);
+}
+}  // namespace
+
+class MindDataTestCachePool : public UT::DatasetOpTesting {
+ public:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    GlobalInit();
+    spill_dir_ = Path("/tmp") / ("cache_pool_test_" + Services::GetUniqueID());
+    ASSERT_OK(spill_dir_.CreateDirectories());
+  }
+
+  void TearDown() override {
+    auto it = Path::DirIterator::OpenDirectory(&spill_dir_);
+    while (it != nullptr && it->HasNext()) {
+      (void)it->Next().Remove();
+    }
+    (void)spill_dir_.Remove();
+  }
+
+ protected:
+  Path spill_dir_{""};
+};
+
+/// Feature: StorageManager
+/// Description: Write a row which deflates well and a row of random bytes, then read them back
+/// Expectation: Both rows come back unchanged, only the first one is kept compressed on disk
+TEST_F(MindDataTestCachePool, TestCompressionRoundTrip) {
+  StorageManager sm(spill_dir_, 1);
+  ASSERT_OK(sm.ServiceStart());
+  auto compressible = MakeCompressible(1);
+  auto incompressible = MakeIncompressible(1);
+  StorageManager::key_type compressible_key;
+  StorageManager::key_type incompressible_key;
+  ASSERT_OK(sm.Write(&compressible_key, {ReadableSlice(compressible.data(), compressible.size())}));
+  int64_t stored_sz = 0;
+  int64_t sz = 0;
+  sm.GetSpillSize(&stored_sz, &sz);
+  EXPECT_EQ(sz, static_cast<int64_t>(kBufferSize));
+  EXPECT_LE(stored_sz, static_cast<int64_t>(kBufferSize * StorageManager::kMinCompressionRatio));
+
+  // A row given in several slices is compressed as one.
+  const size_t half = kBufferSize / 2;
+  ASSERT_OK(sm.Write(&incompressible_key, {ReadableSlice(incompressible.data(), half),
+                                           ReadableSlice(incompressible.data() + half, kBufferSize - half)}));
+  int64_t total_stored_sz = 0;
+  sm.GetSpillSize(&total_stored_sz, &sz);
+  EXPECT_EQ(sz, static_cast<int64_t>(2 * kBufferSize));
+  EXPECT_EQ(total_stored_sz - stored_sz, static_cast<int64_t>(kBufferSize));
+
+  std::vector<uint8_t> out;
+  ASSERT_OK(ReadBack(sm, compressible_key, &out));
+  EXPECT_EQ(out, compressible);
+  ASSERT_OK(ReadBack(sm, incompressible_key, &out));
+  EXPECT_EQ(out, incompressible);
+  ASSERT_OK(sm.ServiceStop());
+}
+
+/// Feature: StorageManager
+/// Description: Read a compressed row whose bytes on disk are overwritten with garbage
+/// Expectation: The read fails instead of returning the garbage
+TEST_F(MindDataTestCachePool, TestCorruptedCompressedRow) {
+  StorageManager sm(spill_dir_, 1);
+  ASSERT_OK(sm.ServiceStart());
+  auto row = MakeCompressible(2);
+  StorageManager::key_type key;
+  ASSERT_OK(sm.Write(&key, {ReadableSlice(row.data(), row.size())}));
+  int64_t stored_sz = 0;
+  int64_t sz = 0;
+  sm.GetSpillSize(&stored_sz, &sz);
+  ASSERT_LT(stored_sz, sz);
+
+  auto container = (spill_dir_ / kFirstContainer).ToString();
+  auto offset = FindZlibStream(container);
+  ASSERT_GE(offset, 0);
+  {
+    // Keep the zlib header, the deflate blocks after it become invalid.
+    std::fstream fs(container, std::ios::binary | std::ios::in | std::ios::out);
+    fs.seekp(offset + 2);
+    std::string garbage(static_cast<size_t>(stored_sz) - 2, '\xff');
+    fs.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+  }
+  std::vector<uint8_t> out;
+  EXPECT_ERROR(ReadBack(sm, key, &out));
+  ASSERT_OK(sm.ServiceStop());
+}
+
+/// Feature: StorageManager
+/// Description: Read a compressed row after its container is truncated in the middle of the row
+/// Expectation: The read fails instead of returning a partial row
+TEST_F(MindDataTestCachePool, TestTruncatedCompressedRow) {
+  StorageManager sm(spill_dir_, 1);
+  ASSERT_OK(sm.ServiceStart());
+  auto row = MakeCompressible(3);
+  StorageManager::key_type key;
+  ASSERT_OK(sm.Write(&key, {ReadableSlice(row.data(), row.size())}));
+  int64_t stored_sz = 0;
+  int64_t sz = 0;
+  sm.GetSpillSize(&stored_sz, &sz);
+  ASSERT_LT(stored_sz, sz);
+
+  auto container = (spill_dir_ / kFirstContainer).ToString();
+  auto offset = FindZlibStream(container);
+  ASSERT_GE(offset, 0);
+  ASSERT_EQ(truncate(container.c_str(), offset + stored_sz / 2), 0);
+  std::vector<uint8_t> out;
+  EXPECT_ERROR(ReadBack(sm, key, &out));
+  ASSERT_OK(sm.ServiceStop());
+}
+
+/// Feature: CachePool
+/// Description: Cache four rows with room in memory for two of them, then keep fetching one of the spilled rows
+/// Expectation: The row fetched often moves to memory in place of a row never fetched, a row fetched once stays on
+///     disk, and every row reads back unchanged
+TEST_F(MindDataTestCachePool, TestPromoteAndDemoteByFrequency) {
+  constexpr int32_t kNumRows = 4;
+  constexpr int32_t kMaxFetches = 100;
+  // Small enough for the memory pool to take a single arena of a few megabytes.
+  constexpr float kMemoryCapRatio = 0.001;
+  constexpr CachePool::key_type kHotKey = 3;
+  constexpr CachePool::key_type kWarmKey = 2;
+  auto hw = std::make_shared<CacheServerHW>();
+  ASSERT_OK(hw->GetNumaNodeInfo());
+  // The cache pool sizes its storage after the number of workers of the server.
+  ASSERT_OK(CacheServer::CreateInstance(spill_dir_.ToString(), 1, 0, 0, kMemoryCapRatio, 1, hw));
+  auto mp = std::make_shared<NumaMemoryPool>(hw, kMemoryCapRatio);
+  CachePool cp(mp, spill_dir_.ToString());
+  ASSERT_OK(cp.ServiceStart());
+  cp.SetMemoryCap(2 * kBufferSize);
+
+  std::vector<std::vector<uint8_t>> rows;
+  for (int32_t i = 0; i < kNumRows; ++i) {
+    rows.push_back(MakeCompressible(static_cast<uint8_t>(i)));
+    ASSERT_OK(cp.Insert(i, {ReadableSlice(rows.back().data(), kBufferSize)}));
+  }
+  auto stat = cp.GetStat();
+  ASSERT_EQ(stat.num_mem_cached, 2);
+  ASSERT_EQ(stat.num_disk_cached, 2);
+
+  // A fetch counts the access and the row on disk is then read, like the server does.
+  auto fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  auto fetch = [&cp, &fbb](CachePool::key_type key, std::vector<uint8_t> *out) -> Status {
+    flatbuffers::Offset<DataLocatorMsg> offset;
+    RETURN_IF_NOT_OK(cp.GetDataLocator(key, fbb, &offset));
+    return ReadBack(&cp, key, out);
+  };
+  std::vector<uint8_t> out;
+  ASSERT_OK(fetch(kWarmKey, &out));
+  EXPECT_EQ(out, rows[kWarmKey]);
+  // The memory of a row moved to disk is taken by the hot row on its next read.
+  bool promoted = false;
+  for (int32_t i = 0; i < kMaxFetches && !promoted; ++i) {
+    auto mem_hit = cp.GetStat().num_mem_hit;
+    ASSERT_OK(fetch(kHotKey, &out));
+    EXPECT_EQ(out, rows[kHotKey]);
+    promoted = cp.GetStat().num_mem_hit > mem_hit;
+  }
+  ASSERT_TRUE(promoted);
+  stat = cp.GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 2);
+  EXPECT_EQ(stat.num_disk_cached, 2);
+
+  auto disk_hit = stat.num_disk_hit;
+  ASSERT_OK(fetch(kWarmKey, &out));
+  EXPECT_EQ(out, rows[kWarmKey]);
+  EXPECT_EQ(cp.GetStat().num_disk_hit, disk_hit + 1);
+  // The demoted row reads back from disk.
+  for (int32_t i = 0; i < kNumRows; ++i) {
+    ASSERT_OK(ReadBack(&cp, i, &out));
+    EXPECT_EQ(out, rows[i]);
+  }
+  ASSERT_OK(cp.ServiceStop());
+}
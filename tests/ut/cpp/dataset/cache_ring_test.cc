@@ -0,0 +1,343 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
+#include "minddata/dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr int64_t kWaitInMs = 10000;
+
+struct alignas(kCacheRingAlignment) RingBuffer {
+  char data[sizeof(CacheRing)];
+};
+
+/// \brief Stands in for the cache server, it records the blocks given back through the registry.
+class FreedBlocks {
+ public:
+  void Free(int64_t addr) {
+    std::unique_lock<std::mutex> lck(mux_);
+    ++freed_[addr];
+    cv_.notify_all();
+  }
+
+  int32_t Count(int64_t addr) {
+    std::unique_lock<std::mutex> lck(mux_);
+    return freed_.count(addr) == 0 ? 0 : freed_[addr];
+  }
+
+  size_t Size() {
+    std::unique_lock<std::mutex> lck(mux_);
+    return freed_.size();
+  }
+
+  /// \brief Wait until sz blocks below the given offset are given back.
+  bool WaitForSize(size_t sz, int64_t below = std::numeric_limits<int64_t>::max()) {
+    std::unique_lock<std::mutex> lck(mux_);
+    return cv_.wait_for(lck, std::chrono::milliseconds(kWaitInMs), [this, sz, below]() {
+      return static_cast<size_t>(std::distance(freed_.begin(), freed_.lower_bound(below))) >= sz;
+    });
+  }
+
+ private:
+  std::mutex mux_;
+  std::condition_variable cv_;
+  std::map<int64_t, int32_t> freed_;
+};
+
+Status StartServing(TaskGroup *vg, CacheRingRegistry *registry, int32_t num_threads) {
+  RETURN_IF_NOT_OK(registry->Register(vg->GetIntrpService()));
+  for (auto i = 0; i < num_threads; ++i) {
+    RETURN_IF_NOT_OK(vg->CreateAsyncTask("ring worker", [registry]() -> Status {
+      TaskManager::FindMe()->Post();
+      return registry->Serve();
+    }));
+  }
+  return Status::OK();
+}
+}  // namespace
+
+class MindDataTestCacheRing : public UT::DatasetOpTesting {
+ public:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    GlobalInit();
+  }
+};
+
+/// Feature: CacheRingRegistry
+/// Description: Fetch through two rings from many client threads. The fetches are answered by a worker which keeps
+///     registering and unregistering another ring at the same time, like the workers of the cache server do.
+/// Expectation: Every fetch gets its own reply without a deadlock, and every block, including the blocks of the
+///     rings, is given back exactly once
+TEST_F(MindDataTestCacheRing, TestFetchWhileRegistering) {
+  constexpr int32_t kNumClients = 4;
+  constexpr int32_t kNumFetches = 500;
+  constexpr int32_t kChurnClientId = 100;
+  constexpr int64_t kRingBlockBase = 1L << 40;
+  constexpr int64_t kChurnBlockBase = 1L << 41;
+  TaskGroup vg;
+  FreedBlocks freed;
+  // The fetches wait for the worker below.
+  std::mutex mux;
+  std::condition_variable cv;
+  std::deque<std::pair<row_id_type, std::promise<int64_t> *>> pending;
+  auto fetch = [&mux, &cv, &pending](connection_id_type connection_id, int32_t client_id,
+                                     const std::vector<row_id_type> &row_id, int64_t *addr) -> Status {
+    std::promise<int64_t> promise;
+    auto future = promise.get_future();
+    {
+      std::unique_lock<std::mutex> lck(mux);
+      pending.emplace_back(row_id[0], &promise);
+    }
+    cv.notify_one();
+    *addr = future.get();
+    return Status::OK();
+  };
+  CacheRingRegistry registry(fetch, [&freed](int32_t client_id, int64_t addr) { freed.Free(addr); });
+  std::vector<std::unique_ptr<RingBuffer>> buffers;
+  std::vector<CacheRing *> rings;
+  for (auto i = 0; i < 3; ++i) {
+    buffers.push_back(std::make_unique<RingBuffer>());
+    rings.push_back(CacheRing::CreateInPlace(buffers.back()->data));
+  }
+  registry.AddRing(0, 1, rings[0], kRingBlockBase);
+  registry.AddRing(1, 1, rings[1], kRingBlockBase + 1);
+  ASSERT_OK(StartServing(&vg, &registry, 2));
+
+  std::atomic<bool> done(false);
+  int64_t num_churns = 0;
+  ASSERT_OK(vg.CreateAsyncTask("server worker", [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    while (!done) {
+      registry.RemoveRing(kChurnClientId, 1);
+      registry.AddRing(kChurnClientId, 1, rings[2], kChurnBlockBase + num_churns++);
+      std::unique_lock<std::mutex> lck(mux);
+      (void)cv.wait_for(lck, std::chrono::milliseconds(1), [&pending]() { return !pending.empty(); });
+      while (!pending.empty()) {
+        pending.front().second->set_value(pending.front().first);
+        pending.pop_front();
+      }
+    }
+    return Status::OK();
+  }));
+
+  std::atomic<int32_t> num_errors(0);
+  std::vector<std::thread> clients;
+  for (auto c = 0; c < kNumClients; ++c) {
+    clients.emplace_back([c, &rings, &num_errors]() {
+      CacheRing *ring = rings[c % 2];
+      for (auto i = 0; i < kNumFetches; ++i) {
+        row_id_type row_id = c * kNumFetches + i;
+        CacheReply reply;
+        Status rc = ring->BatchFetch({row_id}, &reply);
+        if (rc.IsError() || reply.rc() != static_cast<int32_t>(StatusCode::kSuccess) ||
+            reply.result() != std::to_string(row_id) || ring->FreeBlock(row_id).IsError()) {
+          ++num_errors;
+        }
+      }
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  EXPECT_EQ(num_errors, 0);
+  // The blocks are given back asynchronously.
+  EXPECT_TRUE(freed.WaitForSize(kNumClients * kNumFetches, kRingBlockBase));
+  done = true;
+  registry.Stop();
+  ASSERT_OK(vg.join_all());
+  EXPECT_EQ(registry.NumRings(), 0U);
+  for (row_id_type row_id = 0; row_id < kNumClients * kNumFetches; ++row_id) {
+    EXPECT_EQ(freed.Count(row_id), 1);
+  }
+  EXPECT_EQ(freed.Count(kRingBlockBase), 1);
+  EXPECT_EQ(freed.Count(kRingBlockBase + 1), 1);
+  EXPECT_GT(num_churns, 0);
+  for (int64_t i = 0; i < num_churns; ++i) {
+    EXPECT_EQ(freed.Count(kChurnBlockBase + i), 1);
+  }
+  EXPECT_EQ(freed.Size(), static_cast<size_t>(kNumClients * kNumFetches + 2 + num_churns));
+}
+
+/// Feature: CacheRing
+/// Description: The client stops waiting for a fetch before the server replies
+/// Expectation: The block of the late reply is given back by the server, and the ring keeps working
+TEST_F(MindDataTestCacheRing, TestLateReply) {
+  constexpr int64_t kLateBlock = 7;
+  constexpr int64_t kTimeoutInMs = 200;
+  TaskGroup vg;
+  FreedBlocks freed;
+  std::promise<void> start;
+  std::future<void> started = start.get_future();
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int32_t> num_fetches(0);
+  auto fetch = [&start, &released, &num_fetches](connection_id_type connection_id, int32_t client_id,
+                                                 const std::vector<row_id_type> &row_id, int64_t *addr) -> Status {
+    if (num_fetches++ == 0) {
+      start.set_value();
+      released.wait();
+      *addr = kLateBlock;
+    } else {
+      *addr = row_id[0];
+    }
+    return Status::OK();
+  };
+  CacheRingRegistry registry(fetch, [&freed](int32_t client_id, int64_t addr) { freed.Free(addr); });
+  auto buffer = std::make_unique<RingBuffer>();
+  CacheRing *ring = CacheRing::CreateInPlace(buffer->data);
+  registry.AddRing(0, 1, ring, -1);
+  ASSERT_OK(StartServing(&vg, &registry, 1));
+
+  CacheReply reply;
+  EXPECT_ERROR(ring->BatchFetch({1}, &reply, kTimeoutInMs));
+  // The server has taken the request and is still fetching the rows.
+  ASSERT_EQ(started.wait_for(std::chrono::milliseconds(kWaitInMs)), std::future_status::ready);
+  release.set_value();
+  EXPECT_TRUE(freed.WaitForSize(1));
+  EXPECT_EQ(freed.Count(kLateBlock), 1);
+
+  ASSERT_OK(ring->BatchFetch({2}, &reply));
+  EXPECT_EQ(reply.result(), "2");
+  registry.Stop();
+  ASSERT_OK(vg.join_all());
+  EXPECT_EQ(freed.Size(), 1U);
+}
+
+/// Feature: CacheRing
+/// Description: The client stops waiting for a fetch before any server thread takes it
+/// Expectation: The abandoned request is skipped without a fetch, and the ring keeps working
+TEST_F(MindDataTestCacheRing, TestAbandonedRequest) {
+  constexpr int64_t kTimeoutInMs = 10;
+  TaskGroup vg;
+  FreedBlocks freed;
+  std::atomic<int32_t> num_fetches(0);
+  auto fetch = [&num_fetches](connection_id_type connection_id, int32_t client_id,
+                              const std::vector<row_id_type> &row_id, int64_t *addr) -> Status {
+    ++num_fetches;
+    *addr = row_id[0];
+    return Status::OK();
+  };
+  CacheRingRegistry registry(fetch, [&freed](int32_t client_id, int64_t addr) { freed.Free(addr); });
+  auto buffer = std::make_unique<RingBuffer>();
+  CacheRing *ring = CacheRing::CreateInPlace(buffer->data);
+  registry.AddRing(0, 1, ring, -1);
+
+  CacheReply reply;
+  EXPECT_ERROR(ring->BatchFetch({1}, &reply, kTimeoutInMs));
+  ASSERT_OK(StartServing(&vg, &registry, 1));
+  ASSERT_OK(ring->BatchFetch({2}, &reply));
+  EXPECT_EQ(reply.result(), "2");
+  EXPECT_EQ(num_fetches, 1);
+  registry.Stop();
+  ASSERT_OK(vg.join_all());
+  EXPECT_EQ(freed.Size(), 0U);
+}
+
+/// Feature: CacheRingRegistry
+/// Description: Two caches of the same server each have a client with id 0, and both register a ring. Then one of
+///     them unregisters its ring.
+/// Expectation: Each ring gets the rows of its own connection, and unregistering one ring neither stops the other
+///     ring nor gives back its block
+TEST_F(MindDataTestCacheRing, TestSameClientIdOfTwoCaches) {
+  constexpr connection_id_type kFirstConnection = 1;
+  constexpr connection_id_type kSecondConnection = 2;
+  constexpr int64_t kRowsPerConnection = 1000;
+  constexpr int64_t kFirstBlock = 1L << 40;
+  constexpr int64_t kSecondBlock = kFirstBlock + 1;
+  TaskGroup vg;
+  FreedBlocks freed;
+  auto fetch = [](connection_id_type connection_id, int32_t client_id, const std::vector<row_id_type> &row_id,
+                  int64_t *addr) -> Status {
+    *addr = static_cast<int64_t>(connection_id) * kRowsPerConnection + row_id[0];
+    return Status::OK();
+  };
+  CacheRingRegistry registry(fetch, [&freed](int32_t client_id, int64_t addr) { freed.Free(addr); });
+  auto first_buffer = std::make_unique<RingBuffer>();
+  auto second_buffer = std::make_unique<RingBuffer>();
+  CacheRing *first = CacheRing::CreateInPlace(first_buffer->data);
+  CacheRing *second = CacheRing::CreateInPlace(second_buffer->data);
+  registry.AddRing(0, kFirstConnection, first, kFirstBlock);
+  registry.AddRing(0, kSecondConnection, second, kSecondBlock);
+  ASSERT_EQ(registry.NumRings(), 2U);
+  ASSERT_OK(StartServing(&vg, &registry, 1));
+
+  CacheReply reply;
+  ASSERT_OK(first->BatchFetch({1}, &reply));
+  EXPECT_EQ(reply.result(), std::to_string(kFirstConnection * kRowsPerConnection + 1));
+  ASSERT_OK(second->BatchFetch({1}, &reply));
+  EXPECT_EQ(reply.result(), std::to_string(kSecondConnection * kRowsPerConnection + 1));
+
+  registry.RemoveRing(0, kFirstConnection);
+  EXPECT_EQ(registry.NumRings(), 1U);
+  EXPECT_TRUE(freed.WaitForSize(1));
+  EXPECT_EQ(freed.Count(kFirstBlock), 1);
+  ASSERT_OK(second->BatchFetch({2}, &reply));
+  EXPECT_EQ(reply.result(), std::to_string(kSecondConnection * kRowsPerConnection + 2));
+  EXPECT_EQ(freed.Count(kSecondBlock), 0);
+  registry.Stop();
+  ASSERT_OK(vg.join_all());
+  EXPECT_EQ(freed.Count(kSecondBlock), 1);
+}
+
+/// Feature: CacheRing
+/// Description: The client keeps fetching through a ring no server thread serves until the ring is full, and then
+///     fetches once more
+/// Expectation: The fetch on the full ring gives up without taking a ticket, so the ring works again once it is served
+TEST_F(MindDataTestCacheRing, TestTimeoutOnFullRing) {
+  constexpr int64_t kTimeoutInMs = 10;
+  TaskGroup vg;
+  FreedBlocks freed;
+  auto fetch = [](connection_id_type connection_id, int32_t client_id, const std::vector<row_id_type> &row_id,
+                  int64_t *addr) -> Status {
+    *addr = row_id[0];
+    return Status::OK();
+  };
+  CacheRingRegistry registry(fetch, [&freed](int32_t client_id, int64_t addr) { freed.Free(addr); });
+  auto buffer = std::make_unique<RingBuffer>();
+  CacheRing *ring = CacheRing::CreateInPlace(buffer->data);
+  registry.AddRing(0, 1, ring, -1);
+
+  // Every abandoned request holds its slot until a server thread takes it.
+  CacheReply reply;
+  for (auto i = 0; i <= kCacheRingNumSlots; ++i) {
+    EXPECT_ERROR(ring->BatchFetch({i}, &reply, kTimeoutInMs));
+  }
+  ASSERT_OK(StartServing(&vg, &registry, 1));
+  for (auto i = 0; i < 2 * kCacheRingNumSlots; ++i) {
+    ASSERT_OK(ring->BatchFetch({i}, &reply));
+    EXPECT_EQ(reply.result(), std::to_string(i));
+  }
+  registry.Stop();
+  ASSERT_OK(vg.join_all());
+  EXPECT_EQ(freed.Size(), 0U);
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "gtest/gtest.h"
+
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/core/tensor.h"
+
+#include "minddata/dataset/engine/datasetops/source/sampler/global_shuffle_sampler.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/sequential_sampler.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace mindspore::dataset;
+
+class MindDataTestGlobalShuffleSampler : public UT::Common {
+ public:
+  class DummyRandomAccessOp : public RandomAccessOp {
+   public:
+    DummyRandomAccessOp(int64_t num_rows) {
+      num_rows_ = num_rows;  // base class
+    };
+  };
+
+  // Collect the ids of one epoch, and check that no tensor holds more ids than the window
+  void GetEpoch(SamplerRT *sampler, int64_t window_size, std::vector<int64_t> *out) {
+    TensorRow row;
+    out->clear();
+    ASSERT_EQ(sampler->GetNextSample(&row), Status::OK());
+    while (!row.eoe()) {
+      for (const auto &t : row) {
+        ASSERT_LE(t->Size(), window_size);
+        for (auto it = t->begin<int64_t>(); it != t->end<int64_t>(); it++) {
+          out->push_back(*it);
+        }
+      }
+      ASSERT_EQ(sampler->GetNextSample(&row), Status::OK());
+    }
+  }
+};
+
+/// Feature: GlobalShuffleSampler
+/// Description: Test GlobalShuffleSampler with a window smaller than the dataset, so the ids go through the index file
+/// Expectation: Every epoch is a permutation of all the rows, and the epochs are shuffled differently
+TEST_F(MindDataTestGlobalShuffleSampler, TestWindowed) {
+  int64_t num_rows = 10000;
+  int64_t window_size = 64;
+  GlobalShuffleSamplerRT sampler(0, 1, true, window_size);
+
+  DummyRandomAccessOp dummyRandomAccessOp(num_rows);
+  ASSERT_EQ(sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp), Status::OK());
+
+  std::vector<int64_t> expected(num_rows);
+  for (int64_t i = 0; i < num_rows; i++) {
+    expected[i] = i;
+  }
+  std::vector<int64_t> first;
+  GetEpoch(&sampler, window_size, &first);
+  ASSERT_NE(first, expected);
+  std::vector<int64_t> sorted(first);
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_EQ(sorted, expected);
+
+  // the rows of the first window come from all over the dataset, not from a window sized part of it
+  int64_t max_id = *std::max_element(first.begin(), first.begin() + window_size);
+  ASSERT_GT(max_id, num_rows / 2);
+
+  ASSERT_EQ(sampler.ResetSampler(), Status::OK());
+  std::vector<int64_t> second;
+  GetEpoch(&sampler, window_size, &second);
+  ASSERT_NE(first, second);
+  std::sort(second.begin(), second.end());
+  ASSERT_EQ(second, expected);
+}
+
+/// Feature: GlobalShuffleSampler
+/// Description: Test that GlobalShuffleSampler repeats its order when reshuffle_each_epoch is false
+/// Expectation: Both epochs are the same permutation
+TEST_F(MindDataTestGlobalShuffleSampler, TestNoReshuffle) {
+  int64_t num_rows = 1000;
+  int64_t window_size = 100;
+  GlobalShuffleSamplerRT sampler(0, 5, false, window_size);
+
+  DummyRandomAccessOp dummyRandomAccessOp(num_rows);
+  ASSERT_EQ(sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp), Status::OK());
+
+  std::vector<int64_t> first;
+  GetEpoch(&sampler, window_size, &first);
+  ASSERT_EQ(sampler.ResetSampler(), Status::OK());
+  std::vector<int64_t> second;
+  GetEpoch(&sampler, window_size, &second);
+  ASSERT_EQ(first.size(), num_rows);
+  ASSERT_EQ(first, second);
+}
+
+/// Feature: GlobalShuffleSampler
+/// Description: Test GlobalShuffleSampler with num_samples and a child sampler
+/// Expectation: The ids are drawn from the ids of the child, and only num_samples of them are returned
+TEST_F(MindDataTestGlobalShuffleSampler, TestChild) {
+  int64_t num_rows = 1000;
+  int64_t window_size = 30;
+  int64_t num_samples = 200;
+  auto sampler = std::make_shared<GlobalShuffleSamplerRT>(num_samples, 3, true, window_size);
+  // the child hands out the rows from 500 to 799
+  auto child = std::make_shared<SequentialSamplerRT>(500, 300);
+  ASSERT_EQ(sampler->AddChild(child), Status::OK());
+
+  DummyRandomAccessOp dummyRandomAccessOp(num_rows);
+  ASSERT_EQ(sampler->HandshakeRandomAccessOp(&dummyRandomAccessOp), Status::OK());
+
+  for (int epoch = 0; epoch < 2; epoch++) {
+    std::vector<int64_t> out;
+    GetEpoch(sampler.get(), window_size, &out);
+    ASSERT_EQ(out.size(), num_samples);
+    std::sort(out.begin(), out.end());
+    ASSERT_EQ(std::unique(out.begin(), out.end()), out.end());
+    ASSERT_GE(out.front(), 500);
+    ASSERT_LT(out.back(), 800);
+    ASSERT_EQ(sampler->ResetSampler(), Status::OK());
+  }
+}
+
+/// Feature: GlobalShuffleSampler
+/// Description: Test GlobalShuffleSampler with a window larger than the dataset
+/// Expectation: All the rows are shuffled in memory and returned in one tensor
+TEST_F(MindDataTestGlobalShuffleSampler, TestSingleWindow) {
+  int64_t num_rows = 50;
+  GlobalShuffleSamplerRT sampler(0, 7, true, 1000);
+
+  DummyRandomAccessOp dummyRandomAccessOp(num_rows);
+  ASSERT_EQ(sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp), Status::OK());
+
+  TensorRow row;
+  ASSERT_EQ(sampler.GetNextSample(&row), Status::OK());
+  ASSERT_EQ(row.size(), 1);
+  std::vector<int64_t> out(row[0]->begin<int64_t>(), row[0]->end<int64_t>());
+  ASSERT_EQ(out.size(), num_rows);
+  std::sort(out.begin(), out.end());
+  for (int64_t i = 0; i < num_rows; i++) {
+    ASSERT_EQ(out[i], i);
+  }
+  ASSERT_EQ(sampler.GetNextSample(&row), Status::OK());
+  ASSERT_EQ(row.eoe(), true);
+}
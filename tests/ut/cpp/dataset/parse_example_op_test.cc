@@ -0,0 +1,180 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "proto/example.pb.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/kernels/data/parse_example_op.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr int64_t kNumFixedInt = 3;
+constexpr int64_t kNumStrings = 2;
+
+/// \brief An example with a fixed length int64 list, a float list, a bytes list and a large feature which is never
+/// selected.
+dataengine::Example MakeExample(int64_t seed) {
+  dataengine::Example example;
+  auto *features = example.mutable_features()->mutable_feature();
+  auto *int_list = (*features)["int_fixed"].mutable_int64_list();
+  for (int64_t i = 0; i < kNumFixedInt; ++i) {
+    int_list->add_value(seed * 10 + i);
+  }
+  auto *float_list = (*features)["float_varlen"].mutable_float_list();
+  float_list->add_value(static_cast<float>(seed) + 0.5f);
+  float_list->add_value(static_cast<float>(seed) + 1.5f);
+  auto *bytes_list = (*features)["string_fixed"].mutable_bytes_list();
+  bytes_list->add_value("row_" + std::to_string(seed));
+  bytes_list->add_value("tail");
+  auto *unselected = (*features)["unselected"].mutable_int64_list();
+  for (int64_t i = 0; i < 1000; ++i) {
+    unselected->add_value(i);
+  }
+  return example;
+}
+
+DataSchema MakeSchema(int64_t num_fixed_int, const std::string &extra_column = "") {
+  DataSchema schema;
+  TensorShape int_shape({num_fixed_int});
+  TensorShape string_shape({kNumStrings});
+  EXPECT_OK(schema.AddColumn(ColDescriptor("int_fixed", DataType(DataType::DE_INT64), TensorImpl::kFlexible, 1,
+                                           &int_shape)));
+  EXPECT_OK(schema.AddColumn(ColDescriptor("float_varlen", DataType(DataType::DE_FLOAT32), TensorImpl::kFlexible, 1)));
+  EXPECT_OK(schema.AddColumn(ColDescriptor("string_fixed", DataType(DataType::DE_STRING), TensorImpl::kFlexible, 1,
+                                           &string_shape)));
+  if (!extra_column.empty()) {
+    EXPECT_OK(schema.AddColumn(ColDescriptor(extra_column, DataType(DataType::DE_INT64), TensorImpl::kFlexible, 1)));
+  }
+  return schema;
+}
+
+Status Parse(const std::vector<std::string> &serialized, DataSchema schema, bool parallel_parse, TensorRow *output) {
+  std::shared_ptr<Tensor> input;
+  auto shape = parallel_parse ? TensorShape({static_cast<dsize_t>(serialized.size())}) : TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(serialized, shape, &input));
+  ParseExampleOp op(std::move(schema), {}, parallel_parse);
+  return op.Compute(TensorRow(0, {input}), output);
+}
+
+/// \brief Check the parsed columns of a row against the features of the example parsed in full by protobuf.
+/// \param prefix Index of the row in a batch, empty if the row is not batched.
+void ExpectRowEq(const dataengine::Example &expected, const TensorRow &row, const std::vector<dsize_t> &prefix) {
+  ASSERT_EQ(row.size(), 3U);
+  const auto &feature_map = expected.features().feature();
+  auto index = [&prefix](dsize_t i) {
+    auto full_index = prefix;
+    full_index.push_back(i);
+    return full_index;
+  };
+
+  const auto &int_list = feature_map.at("int_fixed").int64_list();
+  EXPECT_EQ(row[0]->shape()[prefix.size()], int_list.value_size());
+  for (int i = 0; i < int_list.value_size(); ++i) {
+    int64_t value = 0;
+    ASSERT_OK(row[0]->GetItemAt(&value, index(i)));
+    EXPECT_EQ(value, int_list.value(i));
+  }
+
+  const auto &float_list = feature_map.at("float_varlen").float_list();
+  EXPECT_EQ(row[1]->shape()[prefix.size()], float_list.value_size());
+  for (int i = 0; i < float_list.value_size(); ++i) {
+    float value = 0;
+    ASSERT_OK(row[1]->GetItemAt(&value, index(i)));
+    EXPECT_EQ(value, float_list.value(i));
+  }
+
+  const auto &bytes_list = feature_map.at("string_fixed").bytes_list();
+  EXPECT_EQ(row[2]->shape()[prefix.size()], bytes_list.value_size());
+  for (int i = 0; i < bytes_list.value_size(); ++i) {
+    std::string_view value;
+    ASSERT_OK(row[2]->GetItemAt(&value, index(i)));
+    EXPECT_EQ(value, bytes_list.value(i));
+  }
+}
+}  // namespace
+
+class MindDataTestParseExampleOp : public UT::DatasetOpTesting {};
+
+/// Feature: ParseExampleOp
+/// Description: Parse the columns of the schema out of an example which also has a large unselected feature
+/// Expectation: The fixed length and the variable length columns equal the features parsed in full by protobuf
+TEST_F(MindDataTestParseExampleOp, TestSelectedColumns) {
+  auto serialized = MakeExample(1).SerializeAsString();
+  dataengine::Example expected;
+  ASSERT_TRUE(expected.ParseFromString(serialized));
+
+  TensorRow output;
+  ASSERT_OK(Parse({serialized}, MakeSchema(kNumFixedInt), false, &output));
+  ExpectRowEq(expected, output, {});
+}
+
+/// Feature: ParseExampleOp
+/// Description: Parse two serialized examples concatenated together, the second one overrides a feature
+/// Expectation: The last feature of the same name wins, as in the full parse by protobuf
+TEST_F(MindDataTestParseExampleOp, TestLastFeatureWins) {
+  auto first = MakeExample(1);
+  dataengine::Example second;
+  auto *int_list = (*second.mutable_features()->mutable_feature())["int_fixed"].mutable_int64_list();
+  for (int64_t i = 0; i < kNumFixedInt; ++i) {
+    int_list->add_value(-i);
+  }
+  auto serialized = first.SerializeAsString() + second.SerializeAsString();
+  dataengine::Example expected;
+  ASSERT_TRUE(expected.ParseFromString(serialized));
+  ASSERT_EQ(expected.features().feature().at("int_fixed").int64_list().value(1), -1);
+
+  TensorRow output;
+  ASSERT_OK(Parse({serialized}, MakeSchema(kNumFixedInt), false, &output));
+  ExpectRowEq(expected, output, {});
+}
+
+/// Feature: ParseExampleOp
+/// Description: Parse an example which lacks a column of the schema, and one whose fixed length column is too short
+/// Expectation: Both fail
+TEST_F(MindDataTestParseExampleOp, TestMissingAndMismatchedFeature) {
+  auto serialized = MakeExample(1).SerializeAsString();
+  TensorRow output;
+  EXPECT_ERROR(Parse({serialized}, MakeSchema(kNumFixedInt, "absent"), false, &output));
+  output.clear();
+  EXPECT_ERROR(Parse({serialized}, MakeSchema(kNumFixedInt + 1), false, &output));
+  output.clear();
+  EXPECT_ERROR(Parse({serialized}, MakeSchema(kNumFixedInt, "absent"), true, &output));
+}
+
+/// Feature: ParseExampleOp
+/// Description: Parse a batch of examples in parallel
+/// Expectation: Each row of the batched columns equals the features of its example parsed in full by protobuf
+TEST_F(MindDataTestParseExampleOp, TestParallelParse) {
+  constexpr int64_t kBatchSize = 4;
+  std::vector<std::string> serialized;
+  for (int64_t i = 0; i < kBatchSize; ++i) {
+    serialized.push_back(MakeExample(i).SerializeAsString());
+  }
+
+  TensorRow output;
+  ASSERT_OK(Parse(serialized, MakeSchema(kNumFixedInt), true, &output));
+  for (int64_t i = 0; i < kBatchSize; ++i) {
+    dataengine::Example expected;
+    ASSERT_TRUE(expected.ParseFromString(serialized[i]));
+    ExpectRowEq(expected, output, {i});
+  }
+}
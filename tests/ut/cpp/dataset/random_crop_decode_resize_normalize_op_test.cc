@@ -0,0 +1,90 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestRandomCropDecodeResizeNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestRandomCropDecodeResizeNormalizeOp() : CVOpCommon() {}
+
+  // Compares the fused op with RandomCropDecodeResize, Normalize and HWC2CHW applied one after another. The fused op
+  // does not round the resized pixels to uint8, so the outputs may differ by about one pixel level.
+  void Compare(bool hwc_to_chw) {
+    constexpr int target_height = 224;
+    constexpr int target_width = 160;
+    const std::vector<float> mean = {121.0, 115.0, 100.0};
+    const std::vector<float> std = {70.0, 68.0, 71.0};
+    GlobalContext::config_manager()->set_seed(42);
+    auto crop_and_decode = RandomCropDecodeResizeOp(target_height, target_width, 0.08, 1.0, 0.75, 1.333333,
+                                                    InterpolationMode::kLinear, 10);
+    auto fused = RandomCropDecodeResizeNormalizeOp(crop_and_decode, mean, std, hwc_to_chw);
+    NormalizeOp normalize(mean, std, true);
+    HwcToChwOp hwc_to_chw_op;
+    for (int k = 0; k < 10; k++) {
+      std::shared_ptr<Tensor> input1;
+      std::shared_ptr<Tensor> input2;
+      ASSERT_OK(Tensor::CreateFromTensor(raw_input_tensor_, &input1));
+      ASSERT_OK(Tensor::CreateFromTensor(raw_input_tensor_, &input2));
+      TensorRow fused_input;
+      fused_input.push_back(input1);
+      TensorRow fused_output;
+      ASSERT_OK(fused.Compute(fused_input, &fused_output));
+      TensorRow input;
+      input.push_back(input2);
+      TensorRow resized;
+      ASSERT_OK(crop_and_decode.Compute(input, &resized));
+      std::shared_ptr<Tensor> normalized;
+      ASSERT_OK(normalize.Compute(resized[0], &normalized));
+      std::shared_ptr<Tensor> expected = normalized;
+      if (hwc_to_chw) {
+        ASSERT_OK(hwc_to_chw_op.Compute(normalized, &expected));
+      }
+
+      ASSERT_EQ(fused_output[0]->shape(), expected->shape());
+      ASSERT_EQ(fused_output[0]->type(), DataType(DataType::DE_FLOAT32));
+      auto itr = fused_output[0]->begin<float>();
+      for (auto expected_itr = expected->begin<float>(); expected_itr != expected->end<float>(); ++expected_itr) {
+        EXPECT_NEAR(*itr, *expected_itr, 1.0 / 68.0 + 1e-4);
+        ++itr;
+      }
+    }
+  }
+};
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Test the fused op against RandomCropDecodeResize, Normalize and HWC2CHW
+/// Expectation: Output is equal to the output of the unfused ops up to the rounding of the resized pixels
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpCHW) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpCHW.";
+  Compare(true);
+}
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Test the fused op against RandomCropDecodeResize and Normalize
+/// Expectation: Output is equal to the output of the unfused ops up to the rounding of the resized pixels
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpHWC) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpHWC.";
+  Compare(false);
+}
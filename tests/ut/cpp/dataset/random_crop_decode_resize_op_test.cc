@@ -171,3 +171,28 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+/// Feature: RandomCropDecodeResize op
+/// Description: Test JpegCropAndDecode at a reduced resolution and the choice of the scale denominator
+/// Expectation: The crop is decoded at the scaled size, rounded outwards, and never below the target size
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestScaledDecode) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeOp-TestScaledDecode.";
+  EXPECT_EQ(GetJpegScaleDenom(3000, 4000, 224, 224), 8);
+  EXPECT_EQ(GetJpegScaleDenom(884, 718, 224, 224), 2);
+  EXPECT_EQ(GetJpegScaleDenom(884, 718, 884, 718), 1);
+  EXPECT_EQ(GetJpegScaleDenom(100, 100, 224, 224), 1);
+
+  int width = 0;
+  int height = 0;
+  ASSERT_OK(GetJpegImageInfo(raw_input_tensor_, &width, &height));
+  std::shared_ptr<Tensor> full;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &full, 0, 0, 0, 0, 4));
+  EXPECT_EQ(full->shape(), TensorShape({(height + 3) / 4, (width + 3) / 4, 3}));
+
+  std::shared_ptr<Tensor> cropped;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &cropped, 5, 7, 101, 99, 2));
+  EXPECT_EQ(cropped->shape(), TensorShape({(7 + 99 + 1) / 2 - 7 / 2, (5 + 101 + 1) / 2 - 5 / 2, 3}));
+
+  std::shared_ptr<Tensor> invalid;
+  EXPECT_ERROR(JpegCropAndDecode(raw_input_tensor_, &invalid, 0, 0, 0, 0, 3));
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include <list>
+#include <memory>
+
+#include "common/common_test.h"
+#include "distributed/embedding_cache/cache_strategy/slru_cache.h"
+
+namespace mindspore {
+namespace distributed {
+class TestSLRUCache : public UT::Common {
+ public:
+  TestSLRUCache() = default;
+  virtual ~TestSLRUCache() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+using Element = typename SLRUCache<int, int>::Element;
+/// Feature: test slru cache all api.
+/// Description: test slru cache data structure and interface.
+/// Expectation: all interface work normally or throw expectant exception.
+TEST_F(TestSLRUCache, test_slru_cache) {
+  distributed::SLRUCache<int, int> cache(5);
+  EXPECT_EQ(cache.capacity(), 5);
+  std::vector<Element> origin_elements = {{1, 11}, {2, 22}, {3, 33}};
+  for (const auto &item : origin_elements) {
+    EXPECT_NO_THROW(cache.Put(item.first, item.second));
+  }
+  EXPECT_TRUE(cache.Exists(1));
+  EXPECT_TRUE(cache.Exists(3));
+  EXPECT_FALSE(cache.Exists(4));
+  EXPECT_EQ(origin_elements.size(), cache.size());
+  EXPECT_FALSE(cache.IsFull());
+  EXPECT_EQ(cache.protected_size(), 0);
+
+  // The new elements are in the probation segment, the oldest one is evicted first.
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(3, 33)));
+  EXPECT_EQ((cache.Back()), (std::pair<int, int>(1, 11)));
+
+  // The element accessed is promoted to the protected segment.
+  int value = 0;
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_EQ(value, 11);
+  EXPECT_EQ(cache.protected_size(), 1);
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(1, 11)));
+  EXPECT_EQ((cache.Back()), (std::pair<int, int>(2, 22)));
+  EXPECT_EQ((cache.Export().front()), (std::pair<int, int>(1, 11)));
+  EXPECT_FALSE(cache.Get(4, &value));
+
+  std::vector<Element> evict_elements;
+  EXPECT_NO_THROW(cache.TryEvict(3, &evict_elements));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(evict_elements.size(), 1);
+  EXPECT_EQ((evict_elements.front()), (std::pair<int, int>(2, 22)));
+
+  EXPECT_NO_THROW(cache.Put(4, 44));
+  EXPECT_NO_THROW(cache.Put(5, 55));
+  EXPECT_NO_THROW(cache.Put(6, 66));
+  EXPECT_TRUE(cache.IsFull());
+  EXPECT_ANY_THROW(cache.Put(7, 77));
+  EXPECT_ANY_THROW(cache.TryEvict(6, &evict_elements));
+
+  // Update the value of an existing key.
+  EXPECT_NO_THROW(cache.Put(6, 666));
+  EXPECT_TRUE(cache.Get(6, &value));
+  EXPECT_EQ(value, 666);
+
+  evict_elements.clear();
+  EXPECT_NO_THROW(cache.TryEvict(5, &evict_elements));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(evict_elements.size(), 5);
+  EXPECT_ANY_THROW(cache.Front());
+  EXPECT_ANY_THROW(cache.Back());
+}
+
+/// Feature: test the scan resistance and the frequency based admission of slru cache.
+/// Description: scan a large number of one-off keys through the cache full of hot keys.
+/// Expectation: the hot keys stay in the cache, and the hot keys evicted come back to the protected segment.
+TEST_F(TestSLRUCache, test_slru_cache_scan_resistance) {
+  size_t capacity = 100;
+  distributed::SLRUCache<int, int> cache(capacity);
+
+  // Access the hot keys several times, they are promoted to the protected segment.
+  std::vector<int> hot_keys(capacity / 2);
+  for (size_t i = 0; i < hot_keys.size(); ++i) {
+    hot_keys[i] = static_cast<int>(i);
+  }
+  std::vector<int> values(hot_keys.size());
+  std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(hot_keys.size());
+  EXPECT_EQ(cache.BatchGet(hot_keys.data(), hot_keys.size(), values.data(), hits.get()), 0);
+  cache.BatchPut(hot_keys.data(), hot_keys.data(), hot_keys.size());
+  EXPECT_EQ(cache.BatchGet(hot_keys.data(), hot_keys.size(), values.data(), hits.get()), hot_keys.size());
+  EXPECT_EQ(values, hot_keys);
+  EXPECT_EQ(cache.protected_size(), hot_keys.size());
+
+  // Scan the one-off keys, which only evict each other.
+  std::vector<Element> evict_elements;
+  int value = 0;
+  for (int key = 10000; key < 20000; ++key) {
+    EXPECT_FALSE(cache.Get(key, &value));
+    cache.TryEvict(1, &evict_elements);
+    cache.Put(key, key);
+  }
+  for (auto key : hot_keys) {
+    EXPECT_TRUE(cache.Exists(key));
+  }
+
+  evict_elements.clear();
+  cache.TryEvict(capacity, &evict_elements);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+/// Feature: test the frequency based admission of slru cache.
+/// Description: put a key accessed frequently into the cache whose protected segment is full.
+/// Expectation: the key is put into the protected segment directly, and the coldest protected element is demoted.
+TEST_F(TestSLRUCache, test_slru_cache_admission) {
+  size_t capacity = 100;
+  size_t protected_capacity = 80;
+  distributed::SLRUCache<int, int> cache(capacity);
+
+  // Fill the protected segment with the keys accessed twice.
+  int value = 0;
+  for (size_t i = 0; i < protected_capacity; ++i) {
+    int key = static_cast<int>(i);
+    EXPECT_FALSE(cache.Get(key, &value));
+    cache.Put(key, key);
+    EXPECT_TRUE(cache.Get(key, &value));
+  }
+  EXPECT_EQ(cache.protected_size(), protected_capacity);
+
+  // A one-off key is put into the probation segment.
+  int one_off_key = 2000;
+  EXPECT_FALSE(cache.Get(one_off_key, &value));
+  cache.Put(one_off_key, one_off_key);
+  EXPECT_EQ(cache.protected_size(), protected_capacity);
+  EXPECT_EQ((cache.Back()), (std::pair<int, int>(one_off_key, one_off_key)));
+
+  // A hot key which missed several times is hotter than the coldest protected element.
+  int hot_key = 1000;
+  for (int round = 0; round < 5; ++round) {
+    EXPECT_FALSE(cache.Get(hot_key, &value));
+  }
+  cache.Put(hot_key, hot_key);
+  EXPECT_EQ(cache.protected_size(), protected_capacity);
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(hot_key, hot_key)));
+  EXPECT_EQ(cache.Export().front(), (std::pair<int, int>(hot_key, hot_key)));
+
+  // The demoted element is in front of the one-off key in the probation segment.
+  std::vector<Element> evict_elements;
+  cache.TryEvict(capacity - protected_capacity, &evict_elements);
+  ASSERT_EQ(evict_elements.size(), 2);
+  EXPECT_EQ((evict_elements[0]), (std::pair<int, int>(one_off_key, one_off_key)));
+  EXPECT_EQ((evict_elements[1]), (std::pair<int, int>(0, 0)));
+}
+}  // namespace distributed
+}  // namespace mindspore
@@ -20,9 +20,12 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <numeric>
 
 #include "distributed/persistent/storage/local_file.h"
 #include "utils/file_utils.h"
+#include "utils/convert_utils_base.h"
+#include "utils/system/sha256.h"
 
 namespace mindspore {
 namespace distributed {
@@ -118,6 +121,81 @@ TEST_F(TestLocalFileStorage, test_local_file_storage) {
 
   EXPECT_NO_THROW(local_file->Finalize());
 }
+
+/// Feature: Test asynchronous checkpoint of local file persistent storage.
+/// Description: Write the blob data in the async write mode, rewrite the dirty blocks and read them back, then recover
+/// from a checkpoint which is committed but not applied.
+/// Expectation: The data read is the latest data written and the interrupted checkpoint is finished by the recovery.
+TEST_F(TestLocalFileStorage, test_local_file_storage_async_write) {
+  std::string storage_file_path = "./local_file_storage_async";
+  if (!FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  if (!ret.has_value()) {
+    MS_LOG(EXCEPTION) << "Cannot get real path of local file storage.";
+  }
+
+  std::map<std::string, std::string> config_map;
+  std::string real_storage_file_path = ret.value();
+  config_map.emplace(kFileStoragePath, real_storage_file_path);
+  config_map.emplace(kElementSize, "1");
+  config_map.emplace(kAsyncWrite, "true");
+  // Every block holds 4 rows of 4 floats.
+  size_t max_block_len = 64;
+  config_map.emplace(kMaxBlockLength, std::to_string(max_block_len));
+
+  auto local_file = std::make_unique<LocalFile<int, float>>(config_map);
+  EXPECT_NO_THROW(local_file->Initialize());
+
+  size_t row_num = 16;
+  size_t col_num = 4;
+  std::vector<float> values_to_write(row_num * col_num);
+  std::iota(values_to_write.begin(), values_to_write.end(), 0.0);
+  std::vector<int> shape = {SizeToInt(row_num), SizeToInt(col_num)};
+  InputData input = std::make_tuple(shape, values_to_write.data(), values_to_write.size() * sizeof(float));
+  EXPECT_NO_THROW(local_file->Write(input, {}));
+
+  // The snapshot is taken in Write, so the data changed later must not be written until the next Write.
+  values_to_write[0] = -1.0;
+  std::vector<float> values_to_read(row_num * col_num);
+  OutputData output = std::make_pair(values_to_read.data(), values_to_read.size() * sizeof(float));
+  EXPECT_NO_THROW(local_file->Read(output));
+  EXPECT_EQ(values_to_read[0], 0.0);
+
+  // Rewrite the dirty rows in the first and the last blocks only.
+  values_to_write[(row_num - 1) * col_num] = -2.0;
+  EXPECT_NO_THROW(local_file->Write(input, {0, SizeToInt(row_num - 1)}));
+  EXPECT_NO_THROW(local_file->Read(output));
+  EXPECT_EQ(values_to_read, values_to_write);
+  EXPECT_NO_THROW(local_file->Finalize());
+  local_file.reset();
+
+  // Simulate the exit after committing a checkpoint of the first block: the block is in the temporary file and the
+  // manifest has been renamed.
+  std::vector<float> new_block(row_num * col_num / 4, 100.0);
+  std::string block_file_name = real_storage_file_path + "/" + kBlockFilePrefix + "0";
+  std::string tmp_file_name = block_file_name + kTmpSuffix;
+  EXPECT_TRUE(FileIOUtils::WriteAndSync(tmp_file_name, new_block.data(), new_block.size() * sizeof(float)));
+  std::string hash_seq = system::sha256::GetHashFromFile(tmp_file_name);
+  nlohmann::json manifest;
+  manifest[kManifestBlocks] = nlohmann::json::array({nlohmann::json::array({0, hash_seq})});
+  std::string manifest_content = manifest.dump();
+  std::string manifest_file_name = real_storage_file_path + "/" + kCheckpointManifest;
+  EXPECT_TRUE(FileIOUtils::WriteAndSync(manifest_file_name, manifest_content.data(), manifest_content.size()));
+  // The temporary file of an uncommitted checkpoint is dropped.
+  std::string dropped_file_name = real_storage_file_path + "/" + kBlockFilePrefix + "1" + kTmpSuffix;
+  EXPECT_TRUE(FileIOUtils::WriteAndSync(dropped_file_name, new_block.data(), new_block.size() * sizeof(float)));
+
+  local_file = std::make_unique<LocalFile<int, float>>(config_map);
+  EXPECT_NO_THROW(local_file->Initialize());
+  EXPECT_NO_THROW(local_file->Read(output));
+  std::copy(new_block.begin(), new_block.end(), values_to_write.begin());
+  EXPECT_EQ(values_to_read, values_to_write);
+  EXPECT_FALSE(FileIOUtils::IsFileOrDirExist(manifest_file_name));
+  EXPECT_FALSE(FileIOUtils::IsFileOrDirExist(dropped_file_name));
+  EXPECT_NO_THROW(local_file->Finalize());
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #include <sys/resource.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <algorithm>
 #include <atomic>
 #include <string>
 #include <thread>
@@ -27,6 +28,7 @@
 #include "include/backend/distributed/rpc/tcp/tcp_server.h"
 #include "include/backend/distributed/rpc/tcp/tcp_client.h"
 #include "include/backend/distributed/rpc/tcp/constants.h"
+#include "distributed/rpc/tcp/tcp_comm.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -335,6 +337,75 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test sending large messages through the shared memory ring to the server on the same host.
+/// Description: start a socket server and tcp client pair on the loopback address and send large messages.
+/// Expectation: the shared memory ring is attached by the server and the messages are received intact.
+TEST_F(TCPTest, SendLargeMessagesThroughSharedMemory) {
+  Init();
+
+  // Start the tcp server.
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+
+  static std::atomic<size_t> intact_msg_num(0);
+  intact_msg_num = 0;
+  server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+    const char *data = message->data != nullptr ? reinterpret_cast<const char *>(message->data) : message->body.data();
+    size_t size = message->data != nullptr ? message->size : message->body.size();
+    if (std::all_of(data, data + size, [](char c) { return c == 'A'; })) {
+      ++intact_msg_num;
+    }
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  auto ip = server->GetIP();
+  auto port = server->GetPort();
+  auto server_url = ip + ":" + std::to_string(port);
+  client->Connect(server_url);
+
+  // Wait for the server to attach the shared memory ring of the connection.
+  Connection *conn = client->tcp_comm_->conn_pool_->FindConnection(server_url);
+  ASSERT_NE(conn, nullptr);
+  ASSERT_NE(conn->send_shm_ring, nullptr);
+  int timeout = 5 * 1000 * 1000;
+  int usleepCount = 100000;
+  while (!conn->send_shm_ring->IsAttached() && timeout > 0) {
+    usleep(usleepCount);
+    timeout = timeout - usleepCount;
+  }
+  ASSERT_TRUE(conn->send_shm_ring->IsAttached());
+
+  // Send more bytes than the capacity of the ring, together with a small message through the socket.
+  size_t large_msg_size = 20 * 1024 * 1024;
+  size_t msg_cnt = 2 * kShmRingCapacity / large_msg_size;
+  for (size_t i = 0; i < msg_cnt; ++i) {
+    auto message = CreateMessage(server_url, client_url, large_msg_size);
+    client->SendAsync(std::move(message));
+  }
+  client->SendAsync(CreateMessage(server_url, client_url));
+
+  // Wait timeout: 15s
+  WaitForDataMsg(msg_cnt + 1, 15);
+
+  // Check result
+  EXPECT_EQ(msg_cnt + 1, GetDataMsgNum());
+  EXPECT_EQ(msg_cnt + 1, intact_msg_num.load());
+  EXPECT_GT(conn->send_shm_ring->write_pos_, 0);
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
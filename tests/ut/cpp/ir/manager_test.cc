@@ -13,6 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "mindspore/core/ops/sequence_ops.h"
 #include "mindspore/core/ops/math_ops.h"
@@ -766,4 +773,154 @@ TEST_F(TestManager, test_set_edge) {
   ASSERT_EQ(mgr->node_users()[t].front().first, get_item);
 }
 
+namespace {
+// root(x) = layer_n(...layer_1(x)), where layer_i(a) = child_i(a) and child_i(z) = z + a uses a as a free variable.
+struct NestedLayers {
+  FuncGraphPtr root;
+  std::vector<FuncGraphPtr> layers;
+  std::vector<FuncGraphPtr> children;
+  std::vector<CNodePtr> child_adds;
+  std::vector<AnfNodePtr> fvs;
+};
+
+NestedLayers BuildNestedLayers(size_t layer_num) {
+  NestedLayers graphs;
+  graphs.root = std::make_shared<FuncGraph>();
+  AnfNodePtr out = graphs.root->add_parameter();
+  for (size_t i = 0; i < layer_num; ++i) {
+    auto layer = std::make_shared<FuncGraph>();
+    auto a = layer->add_parameter();
+    auto child = std::make_shared<FuncGraph>();
+    auto z = child->add_parameter();
+    auto add = child->NewCNode({NewValueNode(prim::kPrimScalarAdd), z, a});
+    child->set_output(add);
+    layer->set_output(layer->NewCNode({NewValueNode(child), a}));
+    out = graphs.root->NewCNode({NewValueNode(layer), out});
+    graphs.layers.push_back(layer);
+    graphs.children.push_back(child);
+    graphs.child_adds.push_back(add);
+    graphs.fvs.push_back(a);
+  }
+  graphs.root->set_output(out);
+  return graphs;
+}
+
+// Describe the analyses of all the graphs after the edits, the graphs are named by their position so that the
+// analyses of two copies of the layers can be compared.
+std::string QueryLayers(const FuncGraphManagerPtr &mng, const NestedLayers &graphs) {
+  std::map<FuncGraphPtr, std::string> names = {{graphs.root, "root"}};
+  auto layer_num = graphs.layers.size();
+  for (size_t j = 0; j < layer_num; ++j) {
+    names[graphs.layers[j]] = "layer" + std::to_string(j);
+    names[graphs.children[j]] = "child" + std::to_string(j);
+  }
+  auto name_of = [&names](const FuncGraphPtr &fg) -> std::string {
+    auto iter = names.find(fg);
+    return fg == nullptr ? "null" : (iter == names.end() ? "unknown" : iter->second);
+  };
+  auto names_of = [&name_of](const FuncGraphSet &func_graphs) {
+    std::vector<std::string> sorted_names;
+    for (const auto &fg : func_graphs) {
+      sorted_names.push_back(name_of(fg));
+    }
+    std::sort(sorted_names.begin(), sorted_names.end());
+    std::string joined;
+    for (const auto &name : sorted_names) {
+      joined += name + ",";
+    }
+    return joined;
+  };
+  std::ostringstream buf;
+  for (size_t j = 0; j < layer_num; ++j) {
+    const auto &child = graphs.children[j];
+    const auto &layer = graphs.layers[j];
+    buf << name_of(child) << ": parent " << name_of(mng->parent(child)) << ", parents total "
+        << names_of(mng->func_graph_parents_total(child)) << "; " << name_of(layer) << ": recursive "
+        << mng->recursive(layer) << ", used total " << names_of(mng->func_graphs_used_total(layer)) << "; ";
+  }
+  buf << "root: used total " << mng->func_graphs_used_total(graphs.root).size();
+  return buf.str();
+}
+
+// Drop (edit 0) or add back (edit 1) the free variable of the child of the layer.
+void EditLayer(const FuncGraphManagerPtr &mng, const NestedLayers &graphs, size_t layer, size_t edit) {
+  const auto &add = graphs.child_adds[layer];
+  mng->SetEdge(add, 2, edit == 0 ? add->input(1) : graphs.fvs[layer]);
+}
+}  // namespace
+
+/// Feature: Incremental analyses of the manager.
+/// Description: Edit the free variables of the nested graphs of a large synthetic graph one by one and query the
+/// analyses of all the graphs after each edit. The same edits are applied to a copy of the graph whose analyses are
+/// all recomputed after each edit.
+/// Expectation: The incremental analyses equal the recomputed ones after each edit, and the time of both ways is
+/// reported.
+TEST_F(TestManager, test_incremental_analysis_benchmark) {
+  constexpr size_t kLayerNum = 200;
+  constexpr size_t kEditNum = 2;
+  auto graphs = BuildNestedLayers(kLayerNum);
+  auto mng = Manage(graphs.root);
+  auto recomputed_graphs = BuildNestedLayers(kLayerNum);
+  auto recomputed_mng = Manage(recomputed_graphs.root);
+  ASSERT_EQ(mng->func_graphs().size(), kLayerNum * 2 + 1);
+  int64_t incremental_us = 0;
+  int64_t invalidate_all_us = 0;
+  for (size_t i = 0; i < kLayerNum; ++i) {
+    for (size_t edit = 0; edit < kEditNum; ++edit) {
+      auto start = std::chrono::steady_clock::now();
+      EditLayer(mng, graphs, i, edit);
+      auto incremental = QueryLayers(mng, graphs);
+      auto end = std::chrono::steady_clock::now();
+      incremental_us += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+      start = std::chrono::steady_clock::now();
+      EditLayer(recomputed_mng, recomputed_graphs, i, edit);
+      // The way of the analyses before, all of them are recomputed after the edit.
+      recomputed_mng->signals()->InvalidateComputer();
+      auto recomputed = QueryLayers(recomputed_mng, recomputed_graphs);
+      end = std::chrono::steady_clock::now();
+      invalidate_all_us += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+      ASSERT_EQ(incremental, recomputed) << "layer " << i << ", edit " << edit;
+      auto expect_parent = edit == 0 ? nullptr : graphs.layers[i];
+      EXPECT_EQ(mng->parent(graphs.children[i]), expect_parent);
+      EXPECT_EQ(mng->func_graphs_used_total(graphs.root).size(), kLayerNum * 2);
+    }
+  }
+  MS_LOG(INFO) << "Edit and query " << kLayerNum << " layers, incremental: " << incremental_us
+               << "us, invalidate all: " << invalidate_all_us << "us.";
+}
+
+/// Feature: Incremental analyses of the manager.
+/// Description: Query the analyses of a graph called by the root, then replace the call so that the graph is dropped.
+/// Expectation: The manager drops the results of the graph and does not keep it alive.
+TEST_F(TestManager, test_dropped_graph_freed) {
+  auto root = std::make_shared<FuncGraph>();
+  auto x = root->add_parameter();
+  std::weak_ptr<FuncGraph> weak_sub;
+  {
+    auto sub = std::make_shared<FuncGraph>();
+    auto z = sub->add_parameter();
+    sub->set_output(sub->NewCNode({NewValueNode(prim::kPrimScalarAdd), z, z}));
+    root->set_output(root->NewCNode({NewValueNode(sub), x}));
+    weak_sub = sub;
+  }
+  auto mng = Manage(root);
+  ASSERT_EQ(mng->func_graphs().size(), 2);
+  {
+    auto sub = weak_sub.lock();
+    ASSERT_NE(sub, nullptr);
+    EXPECT_EQ(mng->parent(sub), nullptr);
+    EXPECT_EQ(mng->func_graph_parents_total(sub).size(), 0);
+    EXPECT_EQ(mng->func_graphs_used_total(sub).size(), 0);
+    EXPECT_FALSE(mng->recursive(sub));
+  }
+  EXPECT_EQ(mng->func_graphs_used_total(root).size(), 1);
+
+  ASSERT_TRUE(mng->Replace(root->output(), x));
+  EXPECT_EQ(mng->func_graphs().size(), 1);
+  EXPECT_TRUE(weak_sub.expired());
+  EXPECT_EQ(mng->func_graphs_used_total(root).size(), 0);
+}
+
 }  // namespace mindspore
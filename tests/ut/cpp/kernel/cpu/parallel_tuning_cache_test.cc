@@ -0,0 +1,72 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fstream>
+#include <string>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/utils/parallel_tuning_cache.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelTuningCacheTest : public UT::Common {
+ public:
+  ParallelTuningCacheTest() = default;
+};
+
+/// Feature: Parallel tuning cache of cpu kernels.
+/// Description: Update the search results of a signature and find them by the same and other keys.
+/// Expectation: The results are shared by the same signature, count bucket and thread num only, and the faster one
+/// is kept when the same key is updated twice.
+TEST_F(ParallelTuningCacheTest, test_find_and_update) {
+  EXPECT_EQ(ParallelTuningCache::CountBucket(0), 0);
+  EXPECT_EQ(ParallelTuningCache::CountBucket(1), 0);
+  EXPECT_EQ(ParallelTuningCache::CountBucket(1024), 10);
+  EXPECT_EQ(ParallelTuningCache::CountBucket(2047), 10);
+
+  auto &cache = ParallelTuningCache::GetInstance();
+  const std::string signature = "TestTuningOp(float32)->(float32)";
+  size_t best_pow = 0;
+  EXPECT_FALSE(cache.Find(signature, 10, 8, &best_pow));
+
+  cache.Update(signature, 10, 8, 3, 0.002);
+  EXPECT_TRUE(cache.Find(signature, 10, 8, &best_pow));
+  EXPECT_EQ(best_pow, 3);
+  EXPECT_FALSE(cache.Find(signature, 11, 8, &best_pow));
+  EXPECT_FALSE(cache.Find(signature, 10, 4, &best_pow));
+
+  cache.Update(signature, 10, 8, 2, 0.003);
+  EXPECT_TRUE(cache.Find(signature, 10, 8, &best_pow));
+  EXPECT_EQ(best_pow, 3);
+  cache.Update(signature, 10, 8, 2, 0.001);
+  EXPECT_TRUE(cache.Find(signature, 10, 8, &best_pow));
+  EXPECT_EQ(best_pow, 2);
+
+  bool found = false;
+  for (const auto &entry : cache.GetEntries()) {
+    if (entry.signature == signature && entry.count_bucket == 10 && entry.thread_num == 8) {
+      found = true;
+      EXPECT_EQ(entry.reuse_count, 3);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  const std::string dump_file = "./parallel_tuning_cache_test.csv";
+  EXPECT_TRUE(cache.Dump(dump_file));
+  std::ifstream ifs(dump_file);
+  std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  EXPECT_NE(content.find(signature + ",10,8,4,"), std::string::npos);
+}
+}  // namespace kernel
+}  // namespace mindspore
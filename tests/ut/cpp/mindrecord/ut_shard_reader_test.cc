@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <utime.h>
+
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -24,6 +26,8 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column_buffer.h"
+#include "minddata/mindrecord/include/shard_page_index.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -41,6 +45,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(ShardPageIndex::GetIndexPath(filename)));
     }
   }
 };
@@ -239,5 +244,151 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmapRead) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet through memory mapped files"));
+  std::string file_name = "./imagenet.shard01";
+
+  ShardReader stream_reader;
+  ASSERT_TRUE(stream_reader.Open({file_name}, true, 4).IsOk());
+  ASSERT_TRUE(stream_reader.Launch(true).IsOk());
+  EXPECT_FALSE(stream_reader.IsMmapRead());
+
+  ShardReader mmap_reader;
+  mmap_reader.SetMmapRead(true);
+  ASSERT_TRUE(mmap_reader.Open({file_name}, true, 4).IsOk());
+  ASSERT_TRUE(mmap_reader.Launch(true).IsOk());
+  ASSERT_TRUE(mmap_reader.IsMmapRead());
+  ASSERT_EQ(stream_reader.GetNumRows(), mmap_reader.GetNumRows());
+
+  for (int64_t task_id = 0; task_id < mmap_reader.GetNumRows(); ++task_id) {
+    std::shared_ptr<TASK_CONTENT> task_content;
+    ASSERT_TRUE(stream_reader.GetNextById(task_id, 0, &task_content).IsOk());
+    std::shared_ptr<TASK_CONTENT_VIEW> task_content_view;
+    ASSERT_TRUE(mmap_reader.GetNextViewById(task_id, 1, &task_content_view).IsOk());
+    ASSERT_EQ(task_content->second.size(), 1);
+    ASSERT_EQ(task_content_view->second.size(), 1);
+
+    const auto &blob = std::get<0>(task_content->second[0]);
+    const auto &view = std::get<0>(task_content_view->second[0]);
+    ASSERT_NE(view.file, nullptr);
+    ASSERT_EQ(blob.size(), view.size);
+    EXPECT_EQ(memcmp(blob.data(), view.data, view.size), 0);
+    EXPECT_EQ(std::get<1>(task_content->second[0]), std::get<1>(task_content_view->second[0]));
+  }
+  stream_reader.Close();
+  mmap_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderPageIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet through the binary page index"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  std::shared_ptr<ShardPageIndex> page_index;
+  ASSERT_TRUE(ShardPageIndex::Load(file_name, &page_index).IsOk());
+  ASSERT_GT(page_index->NumRows(), 0);
+  uint64_t pos = 0;
+  ASSERT_TRUE(page_index->FindRow(page_index->GetRecord(page_index->NumRows() - 1).row_id, &pos));
+  EXPECT_EQ(pos, page_index->NumRows() - 1);
+
+  ShardReader sqlite_reader;
+  sqlite_reader.SetPageIndexRead(false);
+  ASSERT_TRUE(sqlite_reader.Open({file_name}, true, 4, column_list).IsOk());
+  ASSERT_TRUE(sqlite_reader.Launch(true).IsOk());
+
+  ShardReader index_reader;
+  ASSERT_TRUE(index_reader.Open({file_name}, true, 4, column_list).IsOk());
+  ASSERT_TRUE(index_reader.Launch(true).IsOk());
+  ASSERT_EQ(sqlite_reader.GetNumRows(), index_reader.GetNumRows());
+
+  for (int64_t task_id = 0; task_id < index_reader.GetNumRows(); ++task_id) {
+    std::shared_ptr<TASK_CONTENT> sqlite_content;
+    ASSERT_TRUE(sqlite_reader.GetNextById(task_id, 0, &sqlite_content).IsOk());
+    std::shared_ptr<TASK_CONTENT> index_content;
+    ASSERT_TRUE(index_reader.GetNextById(task_id, 0, &index_content).IsOk());
+    ASSERT_EQ(sqlite_content->second.size(), 1);
+    ASSERT_EQ(index_content->second.size(), 1);
+    EXPECT_EQ(std::get<0>(sqlite_content->second[0]), std::get<0>(index_content->second[0]));
+    EXPECT_EQ(std::get<1>(sqlite_content->second[0]), std::get<1>(index_content->second[0]));
+  }
+
+  auto sqlite_classes = std::make_shared<std::set<std::string>>();
+  ASSERT_TRUE(sqlite_reader.GetAllClasses("label", sqlite_classes).IsOk());
+  auto index_classes = std::make_shared<std::set<std::string>>();
+  ASSERT_TRUE(index_reader.GetAllClasses("label", index_classes).IsOk());
+  EXPECT_EQ(*sqlite_classes, *index_classes);
+  sqlite_reader.Close();
+  index_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderStalePageIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet whose meta file changed after the page index"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+  std::shared_ptr<ShardPageIndex> page_index;
+  ASSERT_TRUE(ShardPageIndex::Load(file_name, &page_index).IsOk());
+
+  // only the modification time of the meta file changes, its size stays the same
+  struct utimbuf times {};
+  times.actime = 1;
+  times.modtime = 1;
+  ASSERT_EQ(utime(common::SafeCStr(file_name + ".db"), &times), 0);
+  EXPECT_FALSE(ShardPageIndex::Load(file_name, &page_index).IsOk());
+
+  ShardReader sqlite_reader;
+  sqlite_reader.SetPageIndexRead(false);
+  ASSERT_TRUE(sqlite_reader.Open({file_name}, true, 4, column_list).IsOk());
+  ShardReader index_reader;
+  ASSERT_TRUE(index_reader.Open({file_name}, true, 4, column_list).IsOk());
+  auto sqlite_classes = std::make_shared<std::set<std::string>>();
+  ASSERT_TRUE(sqlite_reader.GetAllClasses("label", sqlite_classes).IsOk());
+  auto index_classes = std::make_shared<std::set<std::string>>();
+  ASSERT_TRUE(index_reader.GetAllClasses("label", index_classes).IsOk());
+  EXPECT_EQ(*sqlite_classes, *index_classes);
+  sqlite_reader.Close();
+  index_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderColumnar) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet with raw fields decoded into column buffers"));
+  std::string file_name = "./imagenet.shard01";
+  // the selected columns are all index fields, and no columns are selected so the raw pages are decoded
+  std::vector<std::vector<std::string>> column_lists = {{"file_name", "label"}, {}};
+  for (const auto &column_list : column_lists) {
+    ShardReader json_reader;
+    ASSERT_TRUE(json_reader.Open({file_name}, true, 4, column_list).IsOk());
+    ASSERT_TRUE(json_reader.Launch(true).IsOk());
+
+    ShardReader columnar_reader;
+    columnar_reader.SetColumnarRead(true);
+    ASSERT_TRUE(columnar_reader.Open({file_name}, true, 4, column_list).IsOk());
+    ASSERT_TRUE(columnar_reader.Launch(true).IsOk());
+    ASSERT_EQ(json_reader.GetNumRows(), columnar_reader.GetNumRows());
+
+    for (int64_t task_id = 0; task_id < columnar_reader.GetNumRows(); ++task_id) {
+      std::shared_ptr<TASK_CONTENT> json_content;
+      ASSERT_TRUE(json_reader.GetNextById(task_id, 0, &json_content).IsOk());
+      ASSERT_EQ(json_content->second.size(), 1);
+      const auto &label = std::get<1>(json_content->second[0]);
+
+      std::shared_ptr<ShardColumnBuffer> raw_columns;
+      uint64_t row = 0;
+      ASSERT_TRUE(columnar_reader.GetRawColumnsById(task_id, &raw_columns, &row).IsOk());
+      ASSERT_NE(raw_columns, nullptr);
+      const unsigned char *data = nullptr;
+      uint64_t n_bytes = 0;
+      ASSERT_TRUE(raw_columns->GetColumnValue(raw_columns->GetColumnIndex("file_name"), row, &data, &n_bytes).IsOk());
+      EXPECT_EQ(std::string(reinterpret_cast<const char *>(data), n_bytes), label["file_name"].get<std::string>());
+      ASSERT_TRUE(raw_columns->GetColumnValue(raw_columns->GetColumnIndex("label"), row, &data, &n_bytes).IsOk());
+      ASSERT_EQ(n_bytes, sizeof(int32_t));
+      int32_t value = 0;
+      (void)memcpy(&value, data, sizeof(int32_t));
+      EXPECT_EQ(value, label["label"].get<int32_t>());
+    }
+    json_reader.Close();
+    columnar_reader.Close();
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "pipeline/jit/ps/static_analysis/evaluator.h"
 #include "pipeline/jit/ps/static_analysis/prim.h"
 
@@ -61,6 +66,58 @@ TEST_F(TestEvaluatorCacheMap, test_evaluator_cache_map) {
   ASSERT_TRUE(iter == cache.end());
 }
 
+/// Feature: Cache shared by the infer threads.
+/// Description: Set and get the entries of an evaluator attr cache from several threads.
+/// Expectation: All the entries are kept and found by the equal keys.
+TEST_F(TestEvaluatorCacheMap, test_multi_thread_cache) {
+  EvaluatorAttrCache cache;
+  constexpr int64_t kThreadNum = 4;
+  constexpr int64_t kKeyNum = 64;
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int64_t i = 0; i < kKeyNum; ++i) {
+        AbstractBasePtrList key = {FromValue(t, false), FromValue(i, false)};
+        cache.set(key, std::make_shared<AttrValueMap>());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(cache.size(), kThreadNum * kKeyNum);
+  AbstractBasePtrList key = {FromValue(static_cast<int64_t>(1), false), FromValue(static_cast<int64_t>(2), false)};
+  ASSERT_TRUE(cache.get(key) != nullptr);
+  AbstractBasePtrList missing_key = {FromValue(kThreadNum, false), FromValue(static_cast<int64_t>(0), false)};
+  ASSERT_TRUE(cache.get(missing_key) == nullptr);
+  cache.clear();
+  ASSERT_TRUE(cache.empty());
+}
+
+/// Feature: Infer workers of the analysis schedule.
+/// Description: Run the tasks which wait for the tasks submitted after them.
+/// Expectation: Each task gets a worker, so all of them finish.
+TEST_F(TestEvaluatorCacheMap, test_run_async_dependent_tasks) {
+  constexpr size_t kTaskNum = 4;
+  std::vector<std::promise<void>> done(kTaskNum);
+  std::vector<std::future<void>> finished;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    auto finish = std::make_shared<std::promise<void>>();
+    finished.push_back(finish->get_future());
+    AnalysisSchedule::GetInstance().RunAsync([&done, i, finish]() {
+      // Wait for the next task, the last one does not wait.
+      if (i + 1 < kTaskNum) {
+        done[i + 1].get_future().wait();
+      }
+      done[i].set_value();
+      finish->set_value();
+    });
+  }
+  for (auto &future : finished) {
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  }
+}
+
 /* skip ut test cases temporarily
 class TestStandardEvaluator : public UT::Common {
  public:
@@ -16,6 +16,8 @@
 
 #include <vector>
 #include <numeric>
+#include <thread>
+#include <algorithm>
 
 #include "common/common_test.h"
 #include "plugin/device/cpu/hal/device/cpu_hash_table.h"
@@ -363,6 +365,101 @@ TEST_F(TestCPUHashTable, test_cpu_hash_table_export_slice) {
 
   EXPECT_TRUE(hash_table.Clear());
 }
+
+/// Feature: test cpu hash table with the batches handled by the shards in parallel.
+/// Description: insert, find, erase and export a large number of keys, and access the hash table by several threads.
+/// Expectation: the results are the same as the elements inserted.
+TEST_F(TestCPUHashTable, test_cpu_hash_table_parallel) {
+  size_t value_dim = 8;
+  size_t key_num = 100000;
+  CPUHashTable<Key, Value> hash_table(value_dim, static_cast<Value>(-1));
+
+  std::vector<Key> keys(key_num);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<Value> values(key_num * value_dim);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<Value>(i / value_dim);
+  }
+  EXPECT_TRUE(hash_table.Insert(keys.data(), key_num, values.data(), nullptr));
+  EXPECT_EQ(hash_table.size(), key_num);
+
+  std::vector<Value> values_to_check(key_num * value_dim);
+  EXPECT_TRUE(hash_table.Find(keys.data(), key_num, false, values_to_check.data(), nullptr));
+  EXPECT_EQ(values_to_check, values);
+
+  // Erase the even keys, their value buffers are reused by the keys inserted later.
+  std::vector<Key> even_keys;
+  for (size_t i = 0; i < key_num; i += 2) {
+    even_keys.push_back(keys[i]);
+  }
+  EXPECT_TRUE(hash_table.Erase(even_keys.data(), even_keys.size(), nullptr));
+  EXPECT_EQ(hash_table.size(), key_num - even_keys.size());
+  EXPECT_FALSE(hash_table.Erase(even_keys.data(), 1, nullptr));
+  EXPECT_FALSE(hash_table.Find(even_keys.data(), even_keys.size(), false, values_to_check.data(), nullptr));
+
+  // The erased keys are padded by the default value.
+  EXPECT_TRUE(hash_table.Find(keys.data(), key_num, true, values_to_check.data(), nullptr));
+  for (size_t i = 0; i < key_num; ++i) {
+    Value expect = (i % 2 == 0) ? static_cast<Value>(-1) : static_cast<Value>(i);
+    EXPECT_EQ(values_to_check[i * value_dim], expect);
+    EXPECT_EQ(values_to_check[(i + 1) * value_dim - 1], expect);
+  }
+  EXPECT_EQ(hash_table.size(), key_num);
+
+  // Several threads insert and find the disjoint keys at the same time.
+  size_t thread_num = 4;
+  size_t key_num_per_thread = 10000;
+  std::vector<std::thread> threads;
+  std::vector<int> results(thread_num, 0);
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<Key> thread_keys(key_num_per_thread);
+      std::iota(thread_keys.begin(), thread_keys.end(), static_cast<Key>(key_num + t * key_num_per_thread));
+      std::vector<Value> thread_values(key_num_per_thread * value_dim, static_cast<Value>(t));
+      std::vector<Value> thread_outputs(key_num_per_thread * value_dim);
+      results[t] = hash_table.Insert(thread_keys.data(), key_num_per_thread, thread_values.data(), nullptr) &&
+                   hash_table.Find(thread_keys.data(), key_num_per_thread, false, thread_outputs.data(), nullptr) &&
+                   thread_outputs == thread_values;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t t = 0; t < thread_num; ++t) {
+    EXPECT_EQ(results[t], 1);
+  }
+  size_t total_key_num = key_num + thread_num * key_num_per_thread;
+  EXPECT_EQ(hash_table.size(), total_key_num);
+
+  // The full export and the keys and values got are in the same order.
+  HashTableExportData export_data;
+  EXPECT_NO_THROW(export_data = hash_table.Export(false));
+  std::vector<Key> keys_to_check(total_key_num);
+  values_to_check.resize(total_key_num * value_dim);
+  EXPECT_TRUE(hash_table.GetKeysAndValues(keys_to_check.data(), values_to_check.data(), nullptr));
+  EXPECT_EQ(export_data[0]->size(), total_key_num * sizeof(Key));
+  EXPECT_EQ(memcmp(export_data[0]->data(), keys_to_check.data(), export_data[0]->size()), 0);
+  EXPECT_EQ(memcmp(export_data[1]->data(), values_to_check.data(), export_data[1]->size()), 0);
+  std::sort(keys_to_check.begin(), keys_to_check.end());
+  for (size_t i = 0; i < total_key_num; ++i) {
+    EXPECT_EQ(keys_to_check[i], static_cast<Key>(i));
+  }
+
+  // Only the modified elements are exported incrementally after importing.
+  CPUHashTable<Key, Value> imported_table(value_dim, static_cast<Value>(0));
+  EXPECT_TRUE(imported_table.Import({export_data[0]->data(), export_data[0]->size()}));
+  EXPECT_TRUE(imported_table.Import({export_data[1]->data(), export_data[1]->size()}));
+  EXPECT_TRUE(imported_table.Import({export_data[2]->data(), export_data[2]->size()}));
+  EXPECT_EQ(imported_table.size(), total_key_num);
+  EXPECT_TRUE(imported_table.Insert(keys.data(), 1, values.data(), nullptr));
+  HashTableExportData incre_export_data;
+  EXPECT_NO_THROW(incre_export_data = imported_table.Export(true));
+  EXPECT_EQ(incre_export_data[0]->size(), sizeof(Key));
+  EXPECT_EQ(*reinterpret_cast<Key *>(incre_export_data[0]->data()), keys[0]);
+
+  EXPECT_TRUE(hash_table.Clear());
+  EXPECT_EQ(hash_table.size(), 0);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
\ No newline at end of file
@@ -0,0 +1,395 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/backend/device_address.h"
+#include "include/common/utils/tensor_future.h"
+#include "ir/graph_utils.h"
+#include "ops/sequence_ops.h"
+#include "pipeline/pynative/forward/segment_capture.h"
+#include "utils/convert_utils_base.h"
+#include "utils/flags.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+// The device address of the outputs of HostGraphRunner, it keeps the output data on the host.
+class HostDeviceAddress : public device::DeviceAddress {
+ public:
+  explicit HostDeviceAddress(std::vector<float> data)
+      : DeviceAddress(nullptr, data.size() * sizeof(float)), data_(std::move(data)) {}
+  ~HostDeviceAddress() override = default;
+  bool SyncDeviceToHost(const ShapeVector &, size_t, TypeId, void *) const override { return true; }
+  bool SyncHostToDevice(const ShapeVector &, size_t, TypeId, const void *, const std::string &) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+  const std::vector<float> &data() const { return data_; }
+
+ private:
+  std::vector<float> data_;
+};
+
+std::vector<float> TensorData(const tensor::TensorPtr &tensor) {
+  auto data = static_cast<const float *>(tensor->data_c());
+  return std::vector<float>(data, data + tensor->DataSize());
+}
+
+tensor::TensorPtr MakeTensor(const ShapeVector &shape, const std::vector<float> &data) {
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+  EXPECT_EQ(tensor->DataSize(), data.size());
+  std::copy(data.begin(), data.end(), static_cast<float *>(tensor->data_c()));
+  return tensor;
+}
+
+// Compiles the graph of a captured segment to a run on the host, which supports the Add, Mul and Split ops of the
+// tests. The output tensors carry their data by HostDeviceAddress.
+class HostGraphRunner {
+ public:
+  SegmentCapture::CompileGraphFunc CompileFunc() {
+    return [this](const FuncGraphPtr &func_graph, const std::string &) -> SegmentCapture::RunGraphFunc {
+      ++compile_count_;
+      graph_ = func_graph;
+      if (compile_failed_) {
+        MS_LOG(EXCEPTION) << "Compile failed.";
+      }
+      return [this, func_graph](const VectorRef &args, VectorRef *outputs) { Run(func_graph, args, outputs); };
+    };
+  }
+
+  size_t compile_count() const { return compile_count_; }
+  size_t run_count() const { return run_count_; }
+  const FuncGraphPtr &graph() const { return graph_; }
+  void set_compile_failed(bool compile_failed) { compile_failed_ = compile_failed; }
+  void set_drop_last_output(bool drop_last_output) { drop_last_output_ = drop_last_output; }
+
+ private:
+  void Run(const FuncGraphPtr &func_graph, const VectorRef &args, VectorRef *outputs) {
+    ++run_count_;
+    std::map<AnfNodePtr, BaseRef> values;
+    const auto &parameters = func_graph->parameters();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+      values[parameters[i]] = args[i];
+    }
+    for (const auto &node : TopoSort(func_graph->get_return())) {
+      if (node->isa<ValueNode>()) {
+        values[node] = node->cast<ValueNodePtr>()->value();
+      }
+      if (!node->isa<CNode>() || node == func_graph->get_return()) {
+        continue;
+      }
+      auto cnode = node->cast<CNodePtr>();
+      VectorRef inputs;
+      for (size_t i = 1; i < cnode->size(); ++i) {
+        (void)inputs.emplace_back(values.at(cnode->input(i)));
+      }
+      values[node] = RunPrim(GetCNodePrimitive(cnode)->name(), inputs);
+    }
+    auto graph_outputs = utils::cast<VectorRef>(values.at(func_graph->output()));
+    *outputs = drop_last_output_ ? VectorRef(graph_outputs.begin(), graph_outputs.end() - 1) : graph_outputs;
+  }
+
+  BaseRef RunPrim(const std::string &name, const VectorRef &inputs) {
+    if (name == prim::kPrimMakeTuple->name()) {
+      return inputs;
+    }
+    if (name == prim::kPrimTupleGetItem->name()) {
+      return utils::cast<VectorRef>(inputs[0])[LongToSize(GetValue<int64_t>(utils::cast<ValuePtr>(inputs[1])))];
+    }
+    auto x = utils::cast<tensor::TensorPtr>(inputs[0]);
+    auto x_data = TensorData(x);
+    if (name == "Split") {
+      // Split the rows into two halves.
+      auto half = x_data.size() / 2;
+      ShapeVector shape = x->shape();
+      shape[0] /= 2;
+      return VectorRef({MakeOutput(shape, std::vector<float>(x_data.begin(), x_data.begin() + half)),
+                        MakeOutput(shape, std::vector<float>(x_data.begin() + half, x_data.end()))});
+    }
+    auto y_data = TensorData(utils::cast<tensor::TensorPtr>(inputs[1]));
+    for (size_t i = 0; i < x_data.size(); ++i) {
+      x_data[i] = name == "Add" ? x_data[i] + y_data[i] : x_data[i] * y_data[i];
+    }
+    return MakeOutput(x->shape(), x_data);
+  }
+
+  static tensor::TensorPtr MakeOutput(const ShapeVector &shape, const std::vector<float> &data) {
+    auto tensor = MakeTensor(shape, data);
+    tensor->set_device_address(std::make_shared<HostDeviceAddress>(data));
+    return tensor;
+  }
+
+  size_t compile_count_{0};
+  size_t run_count_{0};
+  FuncGraphPtr graph_;
+  bool compile_failed_{false};
+  bool drop_last_output_{false};
+};
+
+// The data of an op output, which is set through its device address promise by the replay.
+std::vector<float> ReplayedData(const tensor::TensorPtr &output) {
+  auto address = std::dynamic_pointer_cast<HostDeviceAddress>(output->address_future()->Get());
+  EXPECT_NE(address, nullptr);
+  return address == nullptr ? std::vector<float>() : address->data();
+}
+}  // namespace
+
+class TestSegmentCapture : public UT::Common {
+ public:
+  TestSegmentCapture() = default;
+
+  // The inferred op with prepared inputs, the outputs are created with the device address promises. The op has a
+  // tuple output if there are several output shapes.
+  FrontendOpRunInfoPtr CreateOpRunInfo(const std::string &op_name, const std::vector<ValuePtr> &inputs,
+                                       const std::vector<ShapeVector> &output_shapes) {
+    auto op_run_info = std::make_shared<FrontendOpRunInfo>();
+    op_run_info->base_op_run_info.op_name = op_name;
+    op_run_info->base_op_run_info.device_target = kCPUDevice;
+    op_run_info->op_grad_info->op_prim = std::make_shared<Primitive>(op_name);
+    for (const auto &input : inputs) {
+      (void)op_run_info->base_op_run_info.expanded_input_values.emplace_back(input);
+      (void)op_run_info->base_op_run_info.input_types.emplace_back(input->isa<tensor::Tensor>() ? InputType::kInput
+                                                                                               : InputType::kConstant);
+    }
+    AbstractBasePtrList output_abs;
+    ValuePtrList outputs;
+    for (const auto &shape : output_shapes) {
+      (void)output_abs.emplace_back(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+      auto output = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+      auto promise = std::make_shared<DeviceAddressPromise>(std::promise<DeviceAddressFutureDataPtr>());
+      output->set_address_future(std::make_shared<DeviceAddressFuture>(promise->GetFuture()));
+      (void)op_run_info->base_op_run_info.output_tensors.emplace_back(output);
+      (void)op_run_info->device_sync_promises.emplace_back(promise);
+      (void)outputs.emplace_back(output);
+    }
+    if (output_shapes.size() == 1) {
+      op_run_info->base_op_run_info.abstract = output_abs[0];
+      op_run_info->real_out = outputs[0];
+    } else {
+      op_run_info->base_op_run_info.abstract = std::make_shared<abstract::AbstractTuple>(output_abs);
+      op_run_info->real_out = std::make_shared<ValueTuple>(outputs);
+    }
+    return op_run_info;
+  }
+
+  FrontendOpRunInfoPtr CreateOpRunInfo(const std::string &op_name, const std::vector<ValuePtr> &inputs,
+                                       const ShapeVector &shape) {
+    return CreateOpRunInfo(op_name, inputs, std::vector<ShapeVector>{shape});
+  }
+
+  // Capture add = Add(x, y), mul = Mul(add, x) with the given inputs, and return the ops.
+  std::vector<FrontendOpRunInfoPtr> CaptureAddMul(SegmentCapture *capture, const tensor::TensorPtr &x,
+                                                  const tensor::TensorPtr &y) {
+    auto add = CreateOpRunInfo("Add", {x, y}, x->shape());
+    EXPECT_TRUE(capture->IsCapturable(add));
+    capture->Capture(add);
+    auto mul = CreateOpRunInfo("Mul", {add->real_out, x}, x->shape());
+    EXPECT_TRUE(capture->IsCapturable(mul));
+    capture->Capture(mul);
+    return {add, mul};
+  }
+
+  // Capture out = Mul(Add(x, y), x) and return the key of the segment.
+  std::string CaptureAddMul(SegmentCapture *capture, const ShapeVector &shape) {
+    auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+    auto y = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+    (void)CaptureAddMul(capture, x, y);
+    return capture->PendingKey();
+  }
+};
+
+/// Feature: PyNative segment capture.
+/// Description: Capture the op sequences with the same and the different input shapes.
+/// Expectation: The key depends on the op sequence, the input shapes and the links between the ops.
+TEST_F(TestSegmentCapture, test_segment_key) {
+  SegmentCapture capture([](const FrontendOpRunInfoPtr &) {});
+  auto key = CaptureAddMul(&capture, {2, 3});
+  EXPECT_FALSE(key.empty());
+  capture.Clear();
+  EXPECT_FALSE(capture.HasPending());
+  EXPECT_EQ(CaptureAddMul(&capture, {2, 3}), key);
+  capture.Clear();
+  EXPECT_NE(CaptureAddMul(&capture, {2, 4}), key);
+  capture.Clear();
+
+  // The second input of Mul is an external tensor instead of the output of Add.
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto add = CreateOpRunInfo("Add", {x, x}, {2, 3});
+  capture.Capture(add);
+  capture.Capture(CreateOpRunInfo("Mul", {x, add->real_out}, {2, 3}));
+  EXPECT_NE(capture.PendingKey(), key);
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Check the ops which can not be deferred.
+/// Expectation: The ops with grad, dynamic shape outputs or side effects are not captured.
+TEST_F(TestSegmentCapture, test_not_capturable) {
+  SegmentCapture capture([](const FrontendOpRunInfoPtr &) {});
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto op_run_info = CreateOpRunInfo("Add", {x, x}, {2, 3});
+  EXPECT_TRUE(capture.IsCapturable(op_run_info));
+  op_run_info->requires_grad = true;
+  EXPECT_FALSE(capture.IsCapturable(op_run_info));
+
+  auto dynamic_op_run_info = CreateOpRunInfo("Add", {x, x}, {2, 3});
+  dynamic_op_run_info->base_op_run_info.abstract =
+    std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{-1});
+  EXPECT_FALSE(capture.IsCapturable(dynamic_op_run_info));
+
+  auto assign_op_run_info = CreateOpRunInfo("Assign", {x, x}, {2, 3});
+  assign_op_run_info->op_grad_info->op_prim->set_attr(GRAPH_FLAG_SIDE_EFFECT_MEM, MakeValue(true));
+  EXPECT_FALSE(capture.IsCapturable(assign_op_run_info));
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Flush a captured segment for the first time, and flush a segment whose op fails.
+/// Expectation: The ops run one by one in order, the outputs of the failed segment rethrow the error.
+TEST_F(TestSegmentCapture, test_flush_by_op) {
+  std::vector<std::string> run_ops;
+  SegmentCapture capture([&run_ops](const FrontendOpRunInfoPtr &op_run_info) {
+    (void)run_ops.emplace_back(op_run_info->base_op_run_info.op_name);
+  });
+  (void)CaptureAddMul(&capture, {2, 3});
+  capture.Flush();
+  EXPECT_FALSE(capture.HasPending());
+  EXPECT_EQ(run_ops, (std::vector<std::string>{"Add", "Mul"}));
+  // Flush again is a no-op.
+  capture.Flush();
+  EXPECT_EQ(run_ops.size(), 2);
+
+  SegmentCapture failed_capture([](const FrontendOpRunInfoPtr &) { MS_LOG(EXCEPTION) << "Run op failed."; });
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto op_run_info = CreateOpRunInfo("Add", {x, x}, {2, 3});
+  failed_capture.Capture(op_run_info);
+  EXPECT_ANY_THROW(failed_capture.Flush());
+  auto output = op_run_info->real_out->cast<tensor::TensorPtr>();
+  ASSERT_NE(output, nullptr);
+  EXPECT_ANY_THROW(output->address_future()->Get());
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Flush the same Add and Mul segment with new input values more times than kSegmentCompileThreshold.
+/// Expectation: The segment runs op by op until the threshold, then it is compiled once and replayed, and the
+///     promise of each op output is set to the output of the graph in the order of the ops.
+TEST_F(TestSegmentCapture, test_replay_by_graph) {
+  constexpr size_t kFlushNum = kSegmentCompileThreshold + 2;
+  const ShapeVector shape{2, 2};
+  size_t run_op_count = 0;
+  HostGraphRunner runner;
+  SegmentCapture capture([&run_op_count](const FrontendOpRunInfoPtr &) { ++run_op_count; }, runner.CompileFunc());
+  for (size_t i = 0; i < kFlushNum; ++i) {
+    auto start = static_cast<float>(i);
+    auto x = MakeTensor(shape, {start, start + 1, start + 2, start + 3});
+    auto y = MakeTensor(shape, {1, 2, 3, 4});
+    auto ops = CaptureAddMul(&capture, x, y);
+    capture.Flush();
+    if (i + 1 < kSegmentCompileThreshold) {
+      EXPECT_EQ(run_op_count, (i + 1) * ops.size());
+      EXPECT_EQ(runner.compile_count(), 0);
+      continue;
+    }
+    EXPECT_EQ(run_op_count, (kSegmentCompileThreshold - 1) * ops.size());
+    EXPECT_EQ(runner.compile_count(), 1);
+    EXPECT_EQ(runner.run_count(), i + 2 - kSegmentCompileThreshold);
+    std::vector<float> expect_add{start + 1, start + 3, start + 5, start + 7};
+    std::vector<float> expect_mul{(start + 1) * start, (start + 3) * (start + 1), (start + 5) * (start + 2),
+                                  (start + 7) * (start + 3)};
+    EXPECT_EQ(ReplayedData(ops[0]->real_out->cast<tensor::TensorPtr>()), expect_add);
+    EXPECT_EQ(ReplayedData(ops[1]->real_out->cast<tensor::TensorPtr>()), expect_mul);
+  }
+  // The graph has the external inputs as the parameters, and the outputs of all the ops.
+  ASSERT_NE(runner.graph(), nullptr);
+  EXPECT_EQ(runner.graph()->parameters().size(), 2);
+  auto output = runner.graph()->output()->cast<CNodePtr>();
+  ASSERT_NE(output, nullptr);
+  EXPECT_EQ(output->size(), 3);
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Replay a segment of Split with a tuple output and an Add of the split outputs.
+/// Expectation: The promises of the tuple elements and of the Add output are set to the matching graph outputs.
+TEST_F(TestSegmentCapture, test_replay_tuple_output) {
+  HostGraphRunner runner;
+  SegmentCapture capture([](const FrontendOpRunInfoPtr &) {}, runner.CompileFunc());
+  FrontendOpRunInfoPtr split;
+  FrontendOpRunInfoPtr add;
+  for (size_t i = 0; i < kSegmentCompileThreshold; ++i) {
+    auto x = MakeTensor({2, 2}, {1, 2, 3, 4});
+    split = CreateOpRunInfo("Split", {x}, std::vector<ShapeVector>{{1, 2}, {1, 2}});
+    EXPECT_TRUE(capture.IsCapturable(split));
+    capture.Capture(split);
+    const auto &split_outputs = split->base_op_run_info.output_tensors;
+    // Add the second element to the first one, so that a swapped mapping shows up.
+    add = CreateOpRunInfo("Add", {split_outputs[1], split_outputs[0]}, {1, 2});
+    capture.Capture(add);
+    capture.Flush();
+  }
+  ASSERT_EQ(runner.run_count(), 1);
+  const auto &split_outputs = split->base_op_run_info.output_tensors;
+  EXPECT_EQ(ReplayedData(split_outputs[0]), (std::vector<float>{1, 2}));
+  EXPECT_EQ(ReplayedData(split_outputs[1]), (std::vector<float>{3, 4}));
+  EXPECT_EQ(ReplayedData(add->real_out->cast<tensor::TensorPtr>()), (std::vector<float>{4, 6}));
+  // The elements of the tuple output are taken by TupleGetItem.
+  auto output = runner.graph()->output()->cast<CNodePtr>();
+  ASSERT_NE(output, nullptr);
+  ASSERT_EQ(output->size(), 4);
+  EXPECT_TRUE(IsPrimitiveCNode(output->input(1), prim::kPrimTupleGetItem));
+  EXPECT_TRUE(IsPrimitiveCNode(output->input(2), prim::kPrimTupleGetItem));
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Replay a segment whose graph returns less outputs than the ops have.
+/// Expectation: The flush throws, and every output of the segment rethrows the error instead of a wrong address.
+TEST_F(TestSegmentCapture, test_replay_output_mismatch) {
+  HostGraphRunner runner;
+  SegmentCapture capture([](const FrontendOpRunInfoPtr &) {}, runner.CompileFunc());
+  for (size_t i = 0; i + 1 < kSegmentCompileThreshold; ++i) {
+    (void)CaptureAddMul(&capture, MakeTensor({2}, {1, 2}), MakeTensor({2}, {3, 4}));
+    capture.Flush();
+  }
+  runner.set_drop_last_output(true);
+  auto ops = CaptureAddMul(&capture, MakeTensor({2}, {1, 2}), MakeTensor({2}, {3, 4}));
+  EXPECT_ANY_THROW(capture.Flush());
+  EXPECT_EQ(runner.run_count(), 1);
+  for (const auto &op : ops) {
+    EXPECT_ANY_THROW(op->real_out->cast<tensor::TensorPtr>()->address_future()->Get());
+  }
+}
+
+/// Feature: PyNative segment capture.
+/// Description: Flush a segment whose graph fails to compile more times than kSegmentCompileThreshold.
+/// Expectation: The compile is tried once, and the segment keeps running op by op.
+TEST_F(TestSegmentCapture, test_compile_failure_fallback) {
+  constexpr size_t kFlushNum = kSegmentCompileThreshold + 2;
+  size_t run_op_count = 0;
+  HostGraphRunner runner;
+  runner.set_compile_failed(true);
+  SegmentCapture capture([&run_op_count](const FrontendOpRunInfoPtr &) { ++run_op_count; }, runner.CompileFunc());
+  for (size_t i = 0; i < kFlushNum; ++i) {
+    auto ops = CaptureAddMul(&capture, MakeTensor({2}, {1, 2}), MakeTensor({2}, {3, 4}));
+    EXPECT_NO_THROW(capture.Flush());
+    EXPECT_EQ(run_op_count, (i + 1) * ops.size());
+  }
+  EXPECT_EQ(runner.compile_count(), 1);
+  EXPECT_EQ(runner.run_count(), 0);
+}
+}  // namespace pynative
+}  // namespace mindspore
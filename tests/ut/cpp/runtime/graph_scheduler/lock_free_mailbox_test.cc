@@ -0,0 +1,182 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actor/mailbox.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr int64_t kWaitInMs = 10000;
+
+// Stands in for the actor thread pool: the notify hook schedules the actor, and the consumer thread runs it like
+// ActorBase::Run does, taking the messages until GetMsg returns nullptr.
+class MailBoxConsumer {
+ public:
+  explicit MailBoxConsumer(LockFreeMailBox *mailbox) : mailbox_(mailbox) {
+    mailbox_->SetNotifyHook(std::make_unique<std::function<void()>>([this]() { Schedule(); }));
+  }
+
+  // Run the scheduled actor until the handler returns false.
+  void Run(const std::function<bool(std::unique_ptr<MessageBase>)> &handler) {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cond_.wait_for(lock, std::chrono::milliseconds(kWaitInMs), [this]() { return scheduled_ > 0; })) {
+          return;
+        }
+        --scheduled_;
+      }
+      while (auto msg = mailbox_->GetMsg()) {
+        if (!handler(std::move(msg))) {
+          return;
+        }
+      }
+    }
+  }
+
+  // The number of times the actor was scheduled while it was already scheduled.
+  int64_t double_scheduled() const { return double_scheduled_; }
+
+ private:
+  void Schedule() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (scheduled_ > 0) {
+      ++double_scheduled_;
+    }
+    ++scheduled_;
+    cond_.notify_one();
+  }
+
+  LockFreeMailBox *mailbox_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  int64_t scheduled_{0};
+  std::atomic<int64_t> double_scheduled_{0};
+};
+}  // namespace
+
+class TestLockFreeMailBox : public UT::Common {
+ public:
+  TestLockFreeMailBox() = default;
+};
+
+/// Feature: Lock-free mailbox of the shared thread actors.
+/// Description: Many producers enqueue concurrently while the actor drains the mailbox and is released again.
+/// Expectation: No message is lost, the messages of every producer are taken in order, and the actor is never
+///     scheduled twice.
+TEST_F(TestLockFreeMailBox, test_multi_producer_stress) {
+  constexpr size_t kProducerNum = 8;
+  constexpr int64_t kMessageNum = 20000;
+  LockFreeMailBox mailbox;
+  MailBoxConsumer consumer(&mailbox);
+  std::vector<int64_t> next_seq(kProducerNum, 0);
+  int64_t received = 0;
+  int64_t out_of_order = 0;
+  std::thread consumer_thread([&]() {
+    consumer.Run([&](std::unique_ptr<MessageBase> msg) {
+      auto producer = std::stoul(msg->Name());
+      if (std::stoll(msg->Body()) != next_seq[producer]) {
+        ++out_of_order;
+      }
+      next_seq[producer] = std::stoll(msg->Body()) + 1;
+      return ++received < static_cast<int64_t>(kProducerNum) * kMessageNum;
+    });
+  });
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < kProducerNum; ++p) {
+    (void)producers.emplace_back([&mailbox, p]() {
+      for (int64_t i = 0; i < kMessageNum; ++i) {
+        auto msg = std::make_unique<MessageBase>(std::to_string(p));
+        msg->body = std::to_string(i);
+        (void)mailbox.EnqueueMessage(std::move(msg));
+        if (i % 1024 == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  consumer_thread.join();
+  EXPECT_EQ(received, static_cast<int64_t>(kProducerNum) * kMessageNum);
+  EXPECT_EQ(out_of_order, 0);
+  for (auto seq : next_seq) {
+    EXPECT_EQ(seq, kMessageNum);
+  }
+  EXPECT_EQ(consumer.double_scheduled(), 0);
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+}
+
+/// Feature: Lock-free mailbox of the shared thread actors.
+/// Description: Enqueue a message after the actor has drained the mailbox and stayed idle for a while, several
+///     times.
+/// Expectation: Every message schedules the idle actor again and is taken.
+TEST_F(TestLockFreeMailBox, test_wakeup_after_idle) {
+  constexpr int64_t kRoundNum = 5;
+  constexpr int64_t kIdleInMs = 50;
+  LockFreeMailBox mailbox;
+  MailBoxConsumer consumer(&mailbox);
+  std::mutex mutex;
+  std::condition_variable cond;
+  int64_t received = 0;
+  std::thread consumer_thread([&]() {
+    consumer.Run([&](std::unique_ptr<MessageBase> msg) {
+      std::unique_lock<std::mutex> lock(mutex);
+      ++received;
+      cond.notify_one();
+      return received < kRoundNum;
+    });
+  });
+
+  for (int64_t i = 0; i < kRoundNum; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(kIdleInMs));
+    std::thread producer([&mailbox]() { (void)mailbox.EnqueueMessage(std::make_unique<MessageBase>("idle")); });
+    producer.join();
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cond.wait_for(lock, std::chrono::milliseconds(kWaitInMs), [&]() { return received == i + 1; }));
+  }
+  consumer_thread.join();
+  EXPECT_EQ(received, kRoundNum);
+  EXPECT_EQ(consumer.double_scheduled(), 0);
+}
+
+/// Feature: Lock-free mailbox of the shared thread actors.
+/// Description: Destroy a mailbox which still has messages.
+/// Expectation: The messages are freed with the mailbox.
+TEST_F(TestLockFreeMailBox, test_destroy_with_messages) {
+  auto mailbox = std::make_unique<LockFreeMailBox>();
+  for (int64_t i = 0; i < 3; ++i) {
+    (void)mailbox->EnqueueMessage(std::make_unique<MessageBase>("left"));
+  }
+  auto msg = mailbox->GetMsg();
+  ASSERT_NE(msg, nullptr);
+  EXPECT_EQ(msg->Name(), "left");
+  mailbox.reset();
+}
+}  // namespace runtime
+}  // namespace mindspore
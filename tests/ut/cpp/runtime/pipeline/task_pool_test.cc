@@ -0,0 +1,80 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/pipeline/task/task.h"
+#include "runtime/pipeline/task/task_pool.h"
+
+namespace mindspore {
+namespace runtime {
+class TestTaskPool : public UT::Common {
+ public:
+  TestTaskPool() = default;
+};
+
+class PooledTestTask : public AsyncTask {
+ public:
+  explicit PooledTestTask(std::function<void()> run_func) : AsyncTask(kFrontendTask), run_func_(std::move(run_func)) {}
+  ~PooledTestTask() override = default;
+  void Run() override { run_func_(); }
+
+ private:
+  std::function<void()> run_func_;
+};
+
+/// Feature: Pooled async task.
+/// Description: Create a task after the previous one is released.
+/// Expectation: The block of the released task is reused, and the task runs through the base pointer.
+TEST_F(TestTaskPool, test_reuse_block) {
+  size_t run_count = 0;
+  const void *released_block = nullptr;
+  {
+    std::shared_ptr<AsyncTask> task = MakePooledTask<PooledTestTask>([&run_count]() { ++run_count; });
+    released_block = task.get();
+    task->Run();
+  }
+  auto task = MakePooledTask<PooledTestTask>([&run_count]() { ++run_count; });
+  EXPECT_EQ(static_cast<const void *>(task.get()), released_block);
+  task->Run();
+  EXPECT_EQ(run_count, 2);
+}
+
+/// Feature: Pooled async task.
+/// Description: Allocate the blocks in one thread and free them in another thread, more than the pool keeps.
+/// Expectation: At most kMaxPooledTaskNum blocks are kept, and the kept blocks are allocated again.
+TEST_F(TestTaskPool, test_free_in_other_thread) {
+  TaskBlockPool pool(sizeof(PooledTestTask));
+  std::vector<void *> blocks;
+  for (size_t i = 0; i < kMaxPooledTaskNum + 1; ++i) {
+    (void)blocks.emplace_back(pool.Allocate());
+  }
+  std::thread worker([&pool, &blocks]() {
+    for (auto block : blocks) {
+      pool.Free(block);
+    }
+  });
+  worker.join();
+  EXPECT_EQ(pool.free_num(), kMaxPooledTaskNum);
+  auto block = pool.Allocate();
+  EXPECT_EQ(block, blocks[kMaxPooledTaskNum - 1]);
+  EXPECT_EQ(pool.free_num(), kMaxPooledTaskNum - 1);
+  pool.Free(block);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include "common/common_test.h"
+#include "mindspore/core/ops/sequence_ops.h"
+#include "mindspore/core/ops/math_ops.h"
+#include "backend/common/session/kernel_select_cache.h"
+#include "include/backend/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/utils/utils.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace session {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+namespace {
+// Stands in for the kernel registry of the device, every op has one float32 kernel.
+std::string Float32Kernels(const CNodePtr &kernel) { return common::AnfAlgo::GetCNodeName(kernel) + ":float32"; }
+}  // namespace
+
+class KernelSelectCacheTest : public UT::Common {
+ public:
+  KernelSelectCacheTest() = default;
+  void SetUp() override { KernelSelectCache::GetInstance().Clear(); }
+  void TearDown() override { KernelSelectCache::GetInstance().Clear(); }
+
+  // Build the graph (x op y) of the shape, the kernels have not been selected.
+  KernelGraphPtr BuildGraph(const PrimitivePtr &prim, const ShapeVector &shape) {
+    auto kernel_graph = std::make_shared<KernelGraph>();
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    auto x_parameter = kernel_graph->NewParameter();
+    x_parameter->set_abstract(abstract);
+    auto y_parameter = kernel_graph->NewParameter();
+    y_parameter->set_abstract(abstract);
+    auto cnode = kernel_graph->NewCNode({NewValueNode(prim), x_parameter, y_parameter});
+    cnode->set_abstract(abstract);
+    auto make_tuple = kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), cnode});
+    kernel_graph->set_output(make_tuple);
+    kernel_graph->SetExecOrderByDefault();
+    return kernel_graph;
+  }
+};
+
+/// Feature: Kernel select cache.
+/// Description: Compute the keys of the graphs with the same and the different structure.
+/// Expectation: The key depends on the structure of the graph and the device.
+TEST_F(KernelSelectCacheTest, test_graph_key) {
+  auto key = KernelSelectCache::GraphKey(BuildGraph(prim::kPrimAdd, {2, 3}), kCPUDevice, Float32Kernels);
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(KernelSelectCache::GraphKey(BuildGraph(prim::kPrimAdd, {2, 3}), kCPUDevice, Float32Kernels), key);
+  EXPECT_NE(KernelSelectCache::GraphKey(BuildGraph(prim::kPrimAdd, {2, 4}), kCPUDevice, Float32Kernels), key);
+  EXPECT_NE(KernelSelectCache::GraphKey(BuildGraph(prim::kPrimMul, {2, 3}), kCPUDevice, Float32Kernels), key);
+  EXPECT_NE(KernelSelectCache::GraphKey(BuildGraph(prim::kPrimAdd, {2, 3}), kGPUDevice, Float32Kernels), key);
+}
+
+/// Feature: Kernel select cache.
+/// Description: Compute the keys of the same graph under another device id, precision mode and kernel registry.
+/// Expectation: Each of them changes the key, and the key comes back with the original settings.
+TEST_F(KernelSelectCacheTest, test_graph_key_environment) {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto graph = BuildGraph(prim::kPrimAdd, {2, 3});
+  auto key = KernelSelectCache::GraphKey(graph, kCPUDevice, Float32Kernels);
+  auto device_id = context->get_param<uint32_t>(MS_CTX_DEVICE_ID);
+  auto precision_mode = context->get_param<std::string>(MS_CTX_PRECISION_MODE);
+
+  context->set_param<uint32_t>(MS_CTX_DEVICE_ID, device_id + 1);
+  EXPECT_NE(KernelSelectCache::GraphKey(graph, kCPUDevice, Float32Kernels), key);
+  context->set_param<uint32_t>(MS_CTX_DEVICE_ID, device_id);
+
+  context->set_param<std::string>(MS_CTX_PRECISION_MODE, precision_mode + "_other");
+  EXPECT_NE(KernelSelectCache::GraphKey(graph, kCPUDevice, Float32Kernels), key);
+  context->set_param<std::string>(MS_CTX_PRECISION_MODE, precision_mode);
+
+  auto more_kernels = [](const CNodePtr &kernel) { return Float32Kernels(kernel) + ";float16"; };
+  EXPECT_NE(KernelSelectCache::GraphKey(graph, kCPUDevice, more_kernels), key);
+  EXPECT_EQ(KernelSelectCache::GraphKey(graph, kCPUDevice, Float32Kernels), key);
+}
+
+/// Feature: Kernel select cache.
+/// Description: Save the kernel build info of a graph and load it to an identical graph and to another graph.
+/// Expectation: The identical graph gets the same kernel build info, the other graph is not changed.
+TEST_F(KernelSelectCacheTest, test_save_and_load) {
+  auto &cache = KernelSelectCache::GetInstance();
+  auto graph = BuildGraph(prim::kPrimAdd, {2, 3});
+  auto key = KernelSelectCache::GraphKey(graph, kCPUDevice, Float32Kernels);
+  const auto &kernels = graph->execution_order();
+  ASSERT_EQ(kernels.size(), 1);
+  KernelBuildInfoBuilder builder;
+  builder.SetKernelType(KernelType::CPU_KERNEL);
+  builder.SetInputsFormat({kOpFormat_DEFAULT, kOpFormat_DEFAULT});
+  builder.SetOutputsFormat({kOpFormat_DEFAULT});
+  builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeFloat32});
+  builder.SetOutputsDeviceType({kNumberTypeFloat32});
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernels[0].get());
+  common::AnfAlgo::SetNodeAttr(kAttrDynInputSizes, MakeValue(std::vector<int64_t>{-1, -1}), kernels[0]);
+  cache.SaveKernelBuildInfo(key, kernels);
+
+  auto same_graph = BuildGraph(prim::kPrimAdd, {2, 3});
+  const auto &same_kernels = same_graph->execution_order();
+  auto same_key = KernelSelectCache::GraphKey(same_graph, kCPUDevice, Float32Kernels);
+  EXPECT_TRUE(cache.LoadKernelBuildInfo(same_key, same_kernels));
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(same_kernels[0]);
+  ASSERT_NE(build_info, nullptr);
+  EXPECT_EQ(build_info->kernel_type(), KernelType::CPU_KERNEL);
+  EXPECT_EQ(build_info->GetAllInputDeviceTypes().size(), 2);
+  EXPECT_EQ(build_info->GetOutputDeviceType(0), kNumberTypeFloat32);
+  EXPECT_EQ(common::AnfAlgo::GetNodeAttr<std::vector<int64_t>>(same_kernels[0], kAttrDynInputSizes).size(), 2);
+
+  auto other_graph = BuildGraph(prim::kPrimMul, {2, 3});
+  const auto &other_kernels = other_graph->execution_order();
+  auto other_key = KernelSelectCache::GraphKey(other_graph, kCPUDevice, Float32Kernels);
+  EXPECT_FALSE(cache.LoadKernelBuildInfo(other_key, other_kernels));
+  // The kernels which do not match the cached ones are not changed even if the key hits.
+  EXPECT_FALSE(cache.LoadKernelBuildInfo(key, other_kernels));
+  EXPECT_EQ(AnfAlgo::GetSelectKernelBuildInfo(other_kernels[0]), nullptr);
+}
+}  // namespace session
+}  // namespace mindspore
@@ -197,6 +197,47 @@ class TestAutotuneSaveLoad:
 
         ds.config.set_seed(original_seed)
 
+    @staticmethod
+    def test_autotune_model_reuse_config(tmp_path):
+        """
+        Feature: Autotuning
+        Description: Test the AutoTune model applies the configuration saved for the same pipeline
+        Expectation: The final configuration of the second run holds the saved workers and prefetch size
+        """
+        original_autotune = ds.config.get_enable_autotune()
+        original_model = ds.config.get_enable_autotune_model()
+        prefix = "test_autotune_model_reuse_config_atfinal"
+        ds.config.set_enable_autotune(True, str(tmp_path / prefix))
+        ds.config.set_enable_autotune_model(True)
+
+        def run_pipeline():
+            data1 = ds.MnistDataset(MNIST_DATA_DIR, num_samples=1000)
+            data1 = data1.map(operations=transforms.OneHot(10), input_columns="label")
+            data1 = data1.batch(batch_size=4, drop_remainder=True)
+            for _ in data1.create_dict_iterator(num_epochs=1, output_numpy=True):
+                pass
+
+        def read_summary():
+            final_config = tmp_path / (prefix + "_" + os.environ['RANK_ID'] + ".json")
+            with final_config.open() as f:
+                return json.load(f)["summary"]
+
+        run_pipeline()
+        names = [line.split("(num_parallel_workers")[0].strip() for line in read_summary()]
+        map_name = next(name for name in names if name.startswith("MapOp"))
+        model_config = {"pipeline": names,
+                        "ops": [{"name": map_name, "num_parallel_workers": 3, "prefetch_size": 5}]}
+        with (tmp_path / (prefix + "_" + os.environ['RANK_ID'] + "_model.json")).open("w") as f:
+            json.dump(model_config, f)
+
+        run_pipeline()
+        map_summary = next(line for line in read_summary() if line.startswith(map_name))
+        assert "num_parallel_workers: 3" in map_summary
+        assert "prefetch_size: 5" in map_summary
+
+        ds.config.set_enable_autotune_model(original_model)
+        ds.config.set_enable_autotune(original_autotune)
+
     @staticmethod
     def test_autotune_imagefolder_pipeline_enum_parms(tmp_path):
         """
@@ -2992,6 +2992,56 @@ def test_minddataset_with_empty_file():
     os.remove(file_name2 + ".db")
 
 
+def test_minddataset_mmap_write_to_sample():
+    """
+    Feature: MindDataset
+    Description: Read the files through memory mapped files, write in place to the samples in a pyfunc and in the
+        output numpy arrays, and read the samples again in the next epoch
+    Expectation: The writes do not change the samples of the next epoch
+    """
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    for x in [file_name, file_name + ".db"]:
+        if os.path.exists(x):
+            os.remove(x)
+    writer = FileWriter(file_name, 1)
+    writer.add_schema({"label": {"type": "int32"}, "data": {"type": "float32", "shape": [-1]}}, "mmap_schema")
+    expected = [np.arange(idx, idx + 16, dtype=np.float32) for idx in range(10)]
+    writer.write_raw_data([{"label": idx, "data": expected[idx]} for idx in range(10)])
+    writer.commit()
+
+    def add_in_place(data):
+        data += 100
+        return data
+
+    origin_mmap = ds.config.get_enable_mindrecord_mmap()
+    ds.config.set_enable_mindrecord_mmap(True)
+    try:
+        num_epochs = 2
+        data_set = ds.MindDataset(file_name, shuffle=False)
+        iterator = data_set.create_dict_iterator(num_epochs=num_epochs, output_numpy=True)
+        for _ in range(num_epochs):
+            num_rows = 0
+            for item in iterator:
+                np.testing.assert_array_equal(item["data"], expected[item["label"]])
+                item["data"][:] = -1
+                num_rows += 1
+            assert num_rows == 10
+
+        data_set = ds.MindDataset(file_name, shuffle=False)
+        data_set = data_set.map(operations=add_in_place, input_columns=["data"])
+        iterator = data_set.create_dict_iterator(num_epochs=num_epochs, output_numpy=True)
+        for _ in range(num_epochs):
+            num_rows = 0
+            for item in iterator:
+                np.testing.assert_array_equal(item["data"], expected[item["label"]] + 100)
+                num_rows += 1
+            assert num_rows == 10
+    finally:
+        ds.config.set_enable_mindrecord_mmap(origin_mmap)
+        os.remove(file_name)
+        os.remove(file_name + ".db")
+
+
 if __name__ == '__main__':
     test_nlp_compress_data(add_and_remove_nlp_compress_file)
     test_nlp_compress_data_old_version(add_and_remove_nlp_compress_file)
@@ -3031,3 +3081,4 @@ if __name__ == '__main__':
     test_for_loop_dataset_iterator(add_and_remove_nlp_compress_file)
     test_minddataset_with_encode_and_hash_check()
     test_minddataset_with_empty_file()
+    test_minddataset_mmap_write_to_sample()